@@ -0,0 +1,286 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Animation/AnimationBlendTree.h>
+#include <Animation/AnimationClipBuilder.h>
+#include <Animation/AnimationPoseBlend.hpp>
+
+class AnimationBlendTreeTests : public testing::Test
+{
+protected:
+	static constexpr size_t JointCount = 8;
+
+	// Every joint moves along x from offset to offset + 1 while turning about y by up to angle
+	static std::vector<std::uint8_t> MakeClip(float offset, float angle)
+	{
+		Epic::AnimationClipBuilderf builder{ JointCount };
+
+		for (size_t joint = 0; joint < JointCount; ++joint)
+		{
+			for (size_t frame = 0; frame <= 10; ++frame)
+			{
+				const float time = float(frame) * 0.1f;
+
+				builder.AddTranslationKey(joint, time, Epic::Vector3f{ offset + time, float(joint), 0.f });
+				builder.AddRotationKey(joint, time, Epic::Quaternionf{ Epic::Vector3f{ 0.f, 1.f, 0.f }, Epic::Radianf{ angle * time } });
+			}
+		}
+
+		return builder.Build();
+	}
+
+	static Epic::AnimationPosef MakeRandomPose(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> dist{ -1.f, 1.f };
+
+		Epic::AnimationPosef pose{ JointCount };
+
+		for (size_t joint = 0; joint < JointCount; ++joint)
+		{
+			pose.SetTranslation(joint, Epic::Vector3f{ dist(rng), dist(rng), dist(rng) });
+			pose.SetRotation(joint, Epic::Quaternionf{ Epic::Vector3f{ dist(rng), dist(rng), 1.f }.Normalize(), Epic::Radianf{ dist(rng) * 3.f } });
+			pose.SetScale(joint, Epic::Vector3f{ 1.5f + dist(rng), 1.5f + dist(rng), 1.5f + dist(rng) });
+		}
+
+		return pose;
+	}
+};
+
+TEST_F(AnimationBlendTreeTests, BlendPose_HalfWeight_AveragesPoses)
+{
+	Epic::AnimationPosef from{ JointCount };
+	Epic::AnimationPosef to{ JointCount };
+	Epic::AnimationPosef result{ JointCount };
+
+	for (size_t joint = 0; joint < JointCount; ++joint)
+	{
+		to.SetTranslation(joint, Epic::Vector3f{ 2.f, 4.f, -2.f });
+
+		// The negated quaternion is the same rotation; the blend must take the shorter arc
+		const Epic::Quaternionf rotation{ Epic::Vector3f{ 0.f, 1.f, 0.f }, Epic::Radianf{ 1.f } };
+		const float values[4] = { -rotation.x, -rotation.y, -rotation.z, -rotation.w };
+		to.SetRotation(joint, Epic::Quaternionf{ values });
+	}
+
+	Epic::BlendPose(from, to, 0.5f, result);
+
+	const Epic::Quaternionf expected{ Epic::Vector3f{ 0.f, 1.f, 0.f }, Epic::Radianf{ 0.5f } };
+
+	for (size_t joint = 0; joint < JointCount; ++joint)
+	{
+		EXPECT_NEAR(result.Translation(joint).y, 2.f, 1e-6f);
+		EXPECT_NEAR(std::abs(result.Rotation(joint).Dot(expected)), 1.f, 1e-5f);
+	}
+}
+
+TEST_F(AnimationBlendTreeTests, ApplyAdditivePose_MadeFromSource_ReproducesSource)
+{
+	std::mt19937 rng{ 42u };
+
+	const auto source = MakeRandomPose(rng);
+	const auto reference = MakeRandomPose(rng);
+
+	Epic::AnimationPosef additive{ JointCount };
+	Epic::AnimationPosef result{ JointCount };
+
+	Epic::MakeAdditivePose(source, reference, additive);
+	Epic::ApplyAdditivePose(reference, additive, 1.f, result);
+
+	for (size_t joint = 0; joint < JointCount; ++joint)
+	{
+		for (size_t c = 0; c < 3; ++c)
+		{
+			EXPECT_NEAR(result.Translation(joint)[c], source.Translation(joint)[c], 1e-5f);
+			EXPECT_NEAR(result.Scale(joint)[c], source.Scale(joint)[c], 1e-5f);
+		}
+
+		EXPECT_NEAR(std::abs(result.Rotation(joint).Dot(source.Rotation(joint))), 1.f, 1e-5f);
+	}
+
+	// A weight of 0 leaves the base alone
+	Epic::ApplyAdditivePose(reference, additive, 0.f, result);
+	EXPECT_EQ(result.Translation(3), reference.Translation(3));
+}
+
+TEST_F(AnimationBlendTreeTests, Evaluate_Blend1D_BlendsSurroundingSamples)
+{
+	const auto walk = MakeClip(0.f, 0.f);
+	const auto run = MakeClip(10.f, 0.f);
+	const auto sprint = MakeClip(20.f, 0.f);
+
+	Epic::AnimationBlendTreef tree{ JointCount };
+
+	const auto speed = tree.AddParameter();
+	const auto nodes = std::vector<Epic::AnimationBlendTreef::node_type>
+	{
+		tree.AddClip({ walk.data(), walk.size() }),
+		tree.AddClip({ run.data(), run.size() }),
+		tree.AddClip({ sprint.data(), sprint.size() })
+	};
+
+	tree.SetRoot(tree.AddBlend1D(nodes, { 1.f, 3.f, 6.f }, speed));
+
+	auto instance = tree.CreateInstance();
+	Epic::AnimationPosePoolf pool;
+	Epic::AnimationPosef pose{ JointCount };
+
+	instance.SetTime(0.5f);
+
+	const std::pair<float, float> cases[] = { { 0.f, 0.5f }, { 2.f, 5.5f }, { 4.5f, 15.5f }, { 9.f, 20.5f } };
+
+	for (const auto& [parameter, expected] : cases)
+	{
+		instance.SetParameter(speed, parameter);
+		tree.Evaluate(instance, pool, pose);
+
+		EXPECT_NEAR(pose.Translation(2).x, expected, 1e-4f);
+		EXPECT_NEAR(pose.Translation(2).y, 2.f, 1e-5f);
+	}
+
+	EXPECT_EQ(pool.AcquiredCount(), 0u);
+	EXPECT_LE(pool.Size(), 1u);
+}
+
+TEST_F(AnimationBlendTreeTests, Evaluate_Blend2D_AtSampleReproducesSample)
+{
+	const auto clips = std::vector<std::vector<std::uint8_t>>{ MakeClip(0.f, 0.f), MakeClip(4.f, 0.f), MakeClip(8.f, 0.f), MakeClip(12.f, 0.f) };
+
+	Epic::AnimationBlendTreef tree{ JointCount };
+
+	const auto x = tree.AddParameter();
+	const auto y = tree.AddParameter();
+
+	std::vector<Epic::AnimationBlendTreef::node_type> samples;
+	for (const auto& clip : clips)
+		samples.push_back(tree.AddClip({ clip.data(), clip.size() }));
+
+	tree.SetRoot(tree.AddBlend2D(samples, { { 0.f, 0.f }, { 1.f, 0.f }, { 0.f, 1.f }, { 1.f, 1.f } }, x, y));
+
+	auto instance = tree.CreateInstance();
+	Epic::AnimationPosePoolf pool;
+	Epic::AnimationPosef pose{ JointCount };
+
+	instance.SetParameter(x, 1.f);
+	instance.SetParameter(y, 0.f);
+	tree.Evaluate(instance, pool, pose);
+
+	EXPECT_NEAR(pose.Translation(0).x, 4.f, 1e-5f);
+
+	// The centre weighs all four corners equally
+	instance.SetParameter(x, 0.5f);
+	instance.SetParameter(y, 0.5f);
+	tree.Evaluate(instance, pool, pose);
+
+	EXPECT_NEAR(pose.Translation(0).x, 6.f, 1e-4f);
+	EXPECT_EQ(pool.AcquiredCount(), 0u);
+}
+
+TEST_F(AnimationBlendTreeTests, Blend2DWeights_AreContinuousAcrossNeighborhoodChanges)
+{
+	const auto clip = MakeClip(0.f, 0.f);
+
+	Epic::AnimationBlendTreef tree{ JointCount };
+
+	const auto x = tree.AddParameter();
+	const auto y = tree.AddParameter();
+
+	const std::vector<Epic::Vector2f> positions = { { 0.f, 0.f }, { 1.f, 0.f }, { 0.f, 1.f }, { 1.f, 1.f }, { 0.3f, 0.6f } };
+
+	std::vector<Epic::AnimationBlendTreef::node_type> samples;
+	for (size_t i = 0; i < positions.size(); ++i)
+		samples.push_back(tree.AddClip({ clip.data(), clip.size() }));
+
+	const auto space = tree.AddBlend2D(samples, positions, x, y);
+	tree.SetRoot(space);
+
+	auto instance = tree.CreateInstance();
+
+	std::vector<float> previous(positions.size());
+	std::vector<float> weights(positions.size());
+
+	// Crosses x = 0.5, where the nearest three samples change from the left corners to the right corners
+	constexpr size_t Steps = 1000;
+	const float step = 0.8f / float(Steps);
+
+	for (size_t i = 0; i <= Steps; ++i)
+	{
+		instance.SetParameter(x, 0.1f + float(i) * step);
+		instance.SetParameter(y, 0.2f);
+		tree.Blend2DWeights(space, instance, weights.data());
+
+		float total = 0.f;
+
+		for (size_t s = 0; s < weights.size(); ++s)
+		{
+			EXPECT_GE(weights[s], 0.f);
+			total += weights[s];
+
+			if (i > 0)
+			{
+				EXPECT_LT(std::abs(weights[s] - previous[s]), 0.01f);
+			}
+		}
+
+		EXPECT_NEAR(total, 1.f, 1e-5f);
+
+		previous = weights;
+	}
+}
+
+TEST_F(AnimationBlendTreeTests, Evaluate_ParallelInstances_MatchSequential)
+{
+	const auto base = MakeClip(0.f, 1.f);
+	const auto upper = MakeClip(5.f, -2.f);
+	const auto lean = MakeClip(0.f, 0.5f);
+	const auto reference = MakeClip(0.f, 0.f);
+
+	Epic::AnimationBlendTreef tree{ JointCount };
+
+	const auto layer = tree.AddParameter(1.f);
+	const auto amount = tree.AddParameter(0.5f);
+
+	std::vector<float> mask(JointCount, 0.f);
+	std::fill(std::begin(mask) + JointCount / 2, std::end(mask), 1.f);
+
+	const auto layered = tree.AddBlend(tree.AddClip({ base.data(), base.size() }), tree.AddClip({ upper.data(), upper.size() }, 2.f), layer, mask);
+	tree.SetRoot(tree.AddAdditive(layered, tree.AddClip({ lean.data(), lean.size() }), tree.AddClip({ reference.data(), reference.size() }), amount));
+
+	const size_t count = 64;
+
+	std::vector<Epic::AnimationBlendTreef::Instance> instances;
+	std::vector<Epic::AnimationPosef> poses(count, Epic::AnimationPosef{ JointCount });
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		instances.push_back(tree.CreateInstance());
+		instances.back().SetTime(float(i) * 0.037f);
+		instances.back().SetParameter(amount, float(i % 5) * 0.25f);
+	}
+
+	std::vector<Epic::AnimationPosePoolf> pools;
+	tree.Evaluate(instances.data(), poses.data(), count, pools);
+
+	Epic::AnimationPosePoolf pool;
+	Epic::AnimationPosef expected{ JointCount };
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		tree.Evaluate(instances[i], pool, expected);
+
+		for (size_t joint = 0; joint < JointCount; ++joint)
+		{
+			EXPECT_EQ(poses[i].Translation(joint), expected.Translation(joint));
+			EXPECT_EQ(poses[i].Rotation(joint), expected.Rotation(joint));
+		}
+	}
+
+	// The mask keeps the lower joints on the base clip
+	EXPECT_NEAR(poses[0].Translation(0).x, 0.f, 1e-5f);
+	EXPECT_NEAR(poses[0].Translation(JointCount - 1).x, 5.f, 1e-5f);
+
+	for (const auto& p : pools)
+		EXPECT_EQ(p.AcquiredCount(), 0u);
+}
@@ -0,0 +1,145 @@
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Animation/AnimationClip.h>
+#include <Animation/AnimationClipBuilder.h>
+
+class AnimationClipTests : public testing::Test
+{
+protected:
+	static constexpr size_t JointCount = 24;
+	static constexpr size_t FrameCount = 31;
+	static constexpr float FrameTime = 1.f / 30.f;
+
+	static Epic::Vector3f TranslationAt(size_t joint, float time)
+	{
+		return Epic::Vector3f{ float(joint), std::sin(time * 3.f), time * 2.f };
+	}
+
+	static Epic::Quaternionf RotationAt(size_t joint, float time)
+	{
+		return Epic::Quaternionf{ Epic::Vector3f{ 0.f, 1.f, 0.f }, Epic::Radianf{ time * float(joint % 5) } };
+	}
+
+	// Every joint is keyed at 30Hz, except joint 0 which has no scale keys and joint 1 which has one translation key
+	static std::vector<std::uint8_t> MakeClip()
+	{
+		Epic::AnimationClipBuilderf builder{ JointCount };
+
+		for (size_t joint = 0; joint < JointCount; ++joint)
+		{
+			for (size_t frame = FrameCount; frame-- > 0;)
+			{
+				const float time = float(frame) * FrameTime;
+
+				if (joint != 1 || frame == 0)
+					builder.AddTranslationKey(joint, time, TranslationAt(joint, time));
+
+				builder.AddRotationKey(joint, time, RotationAt(joint, time));
+
+				if (joint != 0)
+					builder.AddScaleKey(joint, time, Epic::Vector3f{ 1.f + time, 1.f, 1.f });
+			}
+		}
+
+		return builder.Build();
+	}
+};
+
+TEST_F(AnimationClipTests, Build_SortsKeysAndFillsEmptyTracks)
+{
+	const auto data = MakeClip();
+	const Epic::AnimationClipf clip{ data.data(), data.size() };
+
+	ASSERT_TRUE(clip.IsValid());
+	EXPECT_EQ(clip.JointCount(), JointCount);
+	EXPECT_NEAR(clip.Duration(), float(FrameCount - 1) * FrameTime, 1e-6f);
+
+	EXPECT_EQ(clip.KeyCount(Epic::AnimationChannel::Scale, 0), 1u);
+	EXPECT_EQ(clip.KeyCount(Epic::AnimationChannel::Translation, 1), 1u);
+	EXPECT_EQ(clip.KeyCount(Epic::AnimationChannel::Rotation, 5), FrameCount);
+
+	const float* pTimes = clip.KeyTimes(Epic::AnimationChannel::Rotation, 5);
+	for (size_t i = 1; i < FrameCount; ++i)
+		EXPECT_LT(pTimes[i - 1], pTimes[i]);
+}
+
+TEST_F(AnimationClipTests, Sample_Keyframes_ReproduceKeys)
+{
+	const auto data = MakeClip();
+	const Epic::AnimationClipf clip{ data.data(), data.size() };
+
+	Epic::AnimationClipf::Cursor cursor;
+	Epic::AnimationPosef pose{ JointCount };
+
+	for (size_t frame = 0; frame < FrameCount; ++frame)
+	{
+		const float time = float(frame) * FrameTime;
+		clip.Sample(time, cursor, pose);
+
+		for (size_t joint = 2; joint < JointCount; ++joint)
+		{
+			const auto expected = TranslationAt(joint, time);
+			const auto actual = pose.Translation(joint);
+
+			for (size_t c = 0; c < 3; ++c)
+				EXPECT_NEAR(actual[c], expected[c], 1e-5f);
+
+			EXPECT_NEAR(std::abs(pose.Rotation(joint).Dot(RotationAt(joint, time))), 1.f, 1e-5f);
+			EXPECT_NEAR(pose.Scale(joint).x, 1.f + time, 1e-5f);
+		}
+
+		EXPECT_FLOAT_EQ(pose.Scale(0).x, 1.f);
+		EXPECT_FLOAT_EQ(pose.Translation(1).y, 0.f);
+	}
+}
+
+TEST_F(AnimationClipTests, Sample_CursorOrder_DoesNotAffectResult)
+{
+	const auto data = MakeClip();
+	const Epic::AnimationClipf clip{ data.data(), data.size() };
+
+	Epic::AnimationClipf::Cursor sequential;
+	Epic::AnimationPosef sequentialPose{ JointCount };
+	Epic::AnimationPosef randomPose{ JointCount };
+
+	for (size_t step = 0; step < 200; ++step)
+	{
+		const float time = float(step) * 0.0051f;
+
+		// A fresh cursor has to search every track from scratch
+		Epic::AnimationClipf::Cursor fresh;
+
+		clip.Sample(time, sequential, sequentialPose);
+		clip.Sample(time, fresh, randomPose);
+
+		for (size_t joint = 0; joint < JointCount; ++joint)
+		{
+			EXPECT_EQ(sequentialPose.Translation(joint), randomPose.Translation(joint));
+			EXPECT_EQ(sequentialPose.Scale(joint), randomPose.Scale(joint));
+		}
+	}
+
+	// Jumping back to the start has to search backwards
+	clip.Sample(0.f, sequential, sequentialPose);
+	EXPECT_NEAR(sequentialPose.Translation(3).z, 0.f, 1e-6f);
+}
+
+TEST_F(AnimationClipTests, Constructor_CopiedOrMalformedData_Validates)
+{
+	const auto data = MakeClip();
+
+	// A copy stands in for a mapped file
+	std::vector<std::uint8_t> mapped(data.size());
+	std::memcpy(mapped.data(), data.data(), data.size());
+
+	EXPECT_TRUE(Epic::AnimationClipf(mapped.data(), mapped.size()).IsValid());
+	EXPECT_FALSE(Epic::AnimationClipf(mapped.data(), mapped.size() - 16).IsValid());
+	EXPECT_FALSE(Epic::AnimationClipd(mapped.data(), mapped.size()).IsValid());
+
+	mapped[0] ^= 0xFF;
+	EXPECT_FALSE(Epic::AnimationClipf(mapped.data(), mapped.size()).IsValid());
+}
@@ -0,0 +1,150 @@
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Animation/AnimationClipBuilder.h>
+#include <Animation/AnimationCompressor.h>
+#include <Animation/CompressedAnimationClip.h>
+
+class AnimationCompressorTests : public testing::Test
+{
+protected:
+	static constexpr size_t JointCount = 16;
+	static constexpr size_t FrameCount = 61;
+	static constexpr float FrameTime = 1.f / 30.f;
+
+	static Epic::Vector3f TranslationAt(size_t joint, float time)
+	{
+		return Epic::Vector3f{ float(joint), std::sin(time * 3.f) * 2.f, time * 0.5f };
+	}
+
+	static Epic::Quaternionf RotationAt(size_t joint, float time)
+	{
+		return Epic::Quaternionf{ Epic::Vector3f{ 0.f, 0.6f, 0.8f }, Epic::Radianf{ std::sin(time * 2.f) * float(joint % 4) } };
+	}
+
+	// Joints are keyed at 30Hz; scale is constant on every joint but the last
+	static std::vector<std::uint8_t> MakeClip()
+	{
+		Epic::AnimationClipBuilderf builder{ JointCount };
+
+		for (size_t joint = 0; joint < JointCount; ++joint)
+		{
+			for (size_t frame = 0; frame < FrameCount; ++frame)
+			{
+				const float time = float(frame) * FrameTime;
+				const float scale = (joint == JointCount - 1) ? 1.f + time : 2.f;
+
+				builder.AddTranslationKey(joint, time, TranslationAt(joint, time));
+				builder.AddRotationKey(joint, time, RotationAt(joint, time));
+				builder.AddScaleKey(joint, time, Epic::Vector3f{ scale, scale, scale });
+			}
+		}
+
+		return builder.Build();
+	}
+};
+
+TEST_F(AnimationCompressorTests, SmallestThree_RoundTrip_PreservesRotation)
+{
+	const Epic::Vector3f axes[] = { { 1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }, { 0.f, 0.f, 1.f }, { 0.48f, -0.6f, 0.64f } };
+
+	for (const auto& axis : axes)
+	{
+		for (float angle = -6.f; angle <= 6.f; angle += 0.37f)
+		{
+			const Epic::Quaternionf source{ axis, Epic::Radianf{ angle } };
+			const auto words = Epic::detail::EncodeSmallestThree(source.x, source.y, source.z, source.w);
+
+			float x, y, z, w;
+			Epic::detail::DecodeSmallestThree(words[0], words[1], words[2], x, y, z, w);
+
+			const float dot = std::abs(source.x * x + source.y * y + source.z * z + source.w * w);
+			EXPECT_LT(2.f * std::acos(std::min(dot, 1.f)), 1e-3f);
+		}
+	}
+}
+
+TEST_F(AnimationCompressorTests, Sample_CompressedClip_StaysWithinTolerance)
+{
+	const auto data = MakeClip();
+	const Epic::AnimationClipf clip{ data.data(), data.size() };
+
+	Epic::AnimationCompressorf::Settings settings;
+	settings.TranslationTolerance = 0.002f;
+	settings.RotationTolerance = 0.004f;
+	settings.ScaleTolerance = 0.002f;
+
+	const auto compressedData = Epic::AnimationCompressorf{ settings }.Compress(clip);
+	const Epic::CompressedAnimationClipf compressed{ compressedData.data(), compressedData.size() };
+
+	ASSERT_TRUE(compressed.IsValid());
+	ASSERT_EQ(compressed.JointCount(), JointCount);
+
+	Epic::CompressedAnimationClipf::Cursor cursor;
+	Epic::AnimationPosef pose{ JointCount };
+
+	for (size_t frame = 0; frame < FrameCount; ++frame)
+	{
+		const float time = float(frame) * FrameTime;
+		compressed.Sample(time, cursor, pose);
+
+		for (size_t joint = 0; joint < JointCount; ++joint)
+		{
+			const auto translation = TranslationAt(joint, time);
+			EXPECT_LT((pose.Translation(joint) - translation).Magnitude(), 0.0025f);
+
+			const float dot = std::min(std::abs(pose.Rotation(joint).Dot(RotationAt(joint, time))), 1.f);
+			EXPECT_LT(2.f * std::acos(dot), 0.005f);
+		}
+
+		EXPECT_NEAR(pose.Scale(JointCount - 1).x, 1.f + time, 0.0025f);
+	}
+}
+
+TEST_F(AnimationCompressorTests, Compress_ConstantTracks_CollapseToOneKey)
+{
+	const auto data = MakeClip();
+	const Epic::AnimationClipf clip{ data.data(), data.size() };
+
+	const auto compressedData = Epic::AnimationCompressorf{}.Compress(clip);
+	const Epic::CompressedAnimationClipf compressed{ compressedData.data(), compressedData.size() };
+
+	ASSERT_TRUE(compressed.IsValid());
+
+	// Joint 0 never rotates and joints 0..n-2 have a constant scale
+	EXPECT_EQ(compressed.KeyCount(Epic::AnimationChannel::Rotation, 0), 1u);
+	EXPECT_EQ(compressed.KeyCount(Epic::AnimationChannel::Scale, 0), 1u);
+	EXPECT_GT(compressed.KeyCount(Epic::AnimationChannel::Scale, JointCount - 1), 1u);
+
+	// The linear translation z and scale tracks reduce to their end points
+	EXPECT_LT(compressed.KeyCount(Epic::AnimationChannel::Scale, JointCount - 1), 4u);
+
+	Epic::CompressedAnimationClipf::Cursor cursor;
+	Epic::AnimationPosef pose{ JointCount };
+
+	compressed.Sample(0.5f, cursor, pose);
+	EXPECT_NEAR(pose.Scale(3).y, 2.f, 1e-3f);
+}
+
+TEST_F(AnimationCompressorTests, Compress_Statistics_ReportSizesAndErrors)
+{
+	const auto data = MakeClip();
+	const Epic::AnimationClipf clip{ data.data(), data.size() };
+
+	Epic::AnimationCompressorf compressor;
+	Epic::AnimationCompressorf::Statistics statistics;
+
+	const auto compressedData = compressor.Compress(clip, &statistics);
+
+	EXPECT_EQ(statistics.SourceSize, data.size());
+	EXPECT_EQ(statistics.CompressedSize, compressedData.size());
+	EXPECT_EQ(statistics.SourceKeyCount, JointCount * FrameCount * 3);
+	EXPECT_LT(statistics.CompressedKeyCount, statistics.SourceKeyCount);
+	EXPECT_GT(statistics.Ratio(), 3.0);
+
+	EXPECT_LE(statistics.MaxTranslationError, compressor.GetSettings().TranslationTolerance);
+	EXPECT_LE(statistics.MaxRotationError, compressor.GetSettings().RotationTolerance);
+	EXPECT_LE(statistics.MaxScaleError, compressor.GetSettings().ScaleTolerance);
+}
@@ -0,0 +1,169 @@
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Animation/InverseKinematics.hpp>
+
+class InverseKinematicsTests : public testing::Test
+{
+protected:
+	static constexpr size_t JointCount = 6;
+
+	// A chain of unit bones curling up in the xy plane
+	struct Chain
+	{
+		std::array<std::vector<float>, 3> Positions;
+		std::array<std::vector<float>, 4> Deltas;
+
+		explicit Chain(size_t chainCount = 1)
+		{
+			for (auto& lane : Positions)
+				lane.resize(JointCount * chainCount);
+
+			for (auto& lane : Deltas)
+				lane.resize(JointCount * chainCount);
+
+			for (size_t chain = 0; chain < chainCount; ++chain)
+			{
+				Epic::Vector3f point{ float(chain), 0.f, 0.f };
+				float angle = 0.f;
+
+				for (size_t i = 0; i < JointCount; ++i)
+				{
+					Set(chain * JointCount + i, point);
+
+					angle += 0.3f;
+					point += Epic::Vector3f{ std::cos(angle), std::sin(angle), 0.f };
+				}
+			}
+		}
+
+		std::array<float*, 3> PositionLanes() { return { Positions[0].data(), Positions[1].data(), Positions[2].data() }; }
+		std::array<float*, 4> DeltaLanes() { return { Deltas[0].data(), Deltas[1].data(), Deltas[2].data(), Deltas[3].data() }; }
+
+		Epic::Vector3f Get(size_t i) const { return { Positions[0][i], Positions[1][i], Positions[2][i] }; }
+		void Set(size_t i, const Epic::Vector3f& p) { Positions[0][i] = p.x; Positions[1][i] = p.y; Positions[2][i] = p.z; }
+
+		Epic::Quaternionf Delta(size_t i) const
+		{
+			const float values[4] = { Deltas[0][i], Deltas[1][i], Deltas[2][i], Deltas[3][i] };
+			return Epic::Quaternionf{ values };
+		}
+	};
+};
+
+TEST_F(InverseKinematicsTests, TwoBoneIK_ReachableTarget_ReachesTargetTowardPole)
+{
+	const Epic::Vector3f root{ 0.f, 0.f, 0.f };
+	const Epic::Vector3f mid{ 0.f, -1.f, 0.1f };
+	const Epic::Vector3f end{ 0.f, -2.f, 0.f };
+	const Epic::Vector3f target{ 0.5f, -1.2f, 0.3f };
+	const Epic::Vector3f pole{ 0.f, -1.f, 5.f };
+
+	Epic::Quaternionf rootDelta, midDelta;
+	EXPECT_TRUE(Epic::TwoBoneIK(root, mid, end, target, pole, rootDelta, midDelta));
+
+	Epic::Vector3f upper = mid - root;
+	Epic::Vector3f lower = end - mid;
+	rootDelta.Transform(upper);
+	midDelta.Transform(lower);
+
+	const auto solvedMid = root + upper;
+	const auto solvedEnd = solvedMid + lower;
+
+	EXPECT_LT((solvedEnd - target).Magnitude(), 1e-4f);
+	EXPECT_NEAR(upper.Magnitude(), (mid - root).Magnitude(), 1e-5f);
+	EXPECT_GT(float(solvedMid.z), 0.f);
+
+	// Out of reach, the chain points straight at the target
+	EXPECT_FALSE(Epic::TwoBoneIK(root, mid, end, Epic::Vector3f{ 0.f, 0.f, -10.f }, pole, rootDelta, midDelta));
+
+	upper = mid - root;
+	rootDelta.Transform(upper);
+	EXPECT_GT(upper.Normalize().Dot(Epic::Vector3f{ 0.f, 0.f, -1.f }), 0.99f);
+}
+
+TEST_F(InverseKinematicsTests, SolveCCD_ReachableTarget_ConvergesAndDeltasMatchBones)
+{
+	Chain chain;
+	const Chain source;
+	const Epic::Vector3f target{ 1.5f, 2.5f, 1.f };
+
+	Epic::IKSettings<float> settings;
+	settings.MaxIterations = 64;
+
+	const auto result = Epic::SolveCCD(chain.PositionLanes(), JointCount, target, settings, chain.DeltaLanes());
+
+	EXPECT_LE(result.Error, settings.Tolerance);
+	EXPECT_LT(result.Iterations, settings.MaxIterations);
+
+	for (size_t i = 0; i + 1 < JointCount; ++i)
+	{
+		Epic::Vector3f bone = source.Get(i + 1) - source.Get(i);
+		chain.Delta(i).Transform(bone);
+
+		const auto solved = chain.Get(i + 1) - chain.Get(i);
+
+		for (size_t c = 0; c < 3; ++c)
+			EXPECT_NEAR(bone[c], solved[c], 1e-4f);
+	}
+}
+
+TEST_F(InverseKinematicsTests, SolveFABRIK_Target_KeepsBoneLengths)
+{
+	Chain chain;
+	const Epic::Vector3f target{ -1.f, 3.f, 2.f };
+
+	const auto result = Epic::SolveFABRIK(chain.PositionLanes(), JointCount, target, Epic::IKSettings<float>{}, chain.DeltaLanes());
+
+	EXPECT_LE(result.Error, 1e-3f);
+	EXPECT_NEAR(chain.Get(0).x, 0.f, 1e-6f);
+
+	for (size_t i = 0; i + 1 < JointCount; ++i)
+		EXPECT_NEAR((chain.Get(i + 1) - chain.Get(i)).Magnitude(), 1.f, 1e-4f);
+
+	// Out of reach, the chain is stretched toward the target
+	Chain stretched;
+	const auto far = Epic::SolveFABRIK(stretched.PositionLanes(), JointCount, Epic::Vector3f{ 0.f, 0.f, 20.f }, Epic::IKSettings<float>{});
+
+	EXPECT_NEAR(far.Error, 15.f, 1e-4f);
+	EXPECT_NEAR(stretched.Get(JointCount - 1).z, 5.f, 1e-4f);
+}
+
+TEST_F(InverseKinematicsTests, BatchSolve_ManyChains_MatchSingleSolves)
+{
+	const size_t chainCount = 300;
+
+	Chain batch{ chainCount };
+	Chain single{ chainCount };
+
+	std::array<std::vector<float>, 3> targets;
+	for (size_t chain = 0; chain < chainCount; ++chain)
+	{
+		targets[0].push_back(float(chain) + std::sin(float(chain)));
+		targets[1].push_back(2.f + std::cos(float(chain)));
+		targets[2].push_back(float(chain % 3) - 1.f);
+	}
+
+	const Epic::IKSettings<float> settings;
+	std::vector<Epic::IKResult<float>> results(chainCount);
+
+	Epic::BatchSolveFABRIK(batch.PositionLanes(), chainCount, JointCount,
+		{ targets[0].data(), targets[1].data(), targets[2].data() }, settings, results.data());
+
+	for (size_t chain = 0; chain < chainCount; ++chain)
+	{
+		const Epic::Vector3f target{ targets[0][chain], targets[1][chain], targets[2][chain] };
+		auto lanes = single.PositionLanes();
+
+		for (auto& lane : lanes)
+			lane += chain * JointCount;
+
+		const auto expected = Epic::SolveFABRIK(lanes, JointCount, target, settings);
+
+		EXPECT_EQ(results[chain].Iterations, expected.Iterations);
+		EXPECT_EQ(batch.Get(chain * JointCount + JointCount - 1), single.Get(chain * JointCount + JointCount - 1));
+	}
+}
@@ -0,0 +1,170 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Geometry/BoundingVolumes.hpp>
+
+class BoundingVolumesTests : public testing::Test
+{
+protected:
+	// Points on and inside a sphere, with every 8th point on the surface
+	static std::vector<Epic::Vector3f> MakeBall(const Epic::Vector3f& center, float radius, size_t count)
+	{
+		std::mt19937 rng{ 1234u };
+		std::normal_distribution<float> normal;
+		std::uniform_real_distribution<float> uniform{ 0.f, 1.f };
+
+		std::vector<Epic::Vector3f> points;
+		points.reserve(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			Epic::Vector3f direction{ normal(rng), normal(rng), normal(rng) };
+			direction.Normalize();
+
+			const float r = (i % 8 == 0) ? radius : radius * std::cbrt(uniform(rng));
+			points.push_back(center + direction * r);
+		}
+
+		return points;
+	}
+
+	static void ExpectContainsAll(const Epic::SphereShape<float>& sphere, const std::vector<Epic::Vector3f>& points)
+	{
+		size_t outside = 0;
+		for (const auto& p : points)
+			outside += ((p - sphere.Position).Magnitude() > sphere.Radius * 1.0001f) ? 1 : 0;
+
+		EXPECT_EQ(outside, 0u);
+	}
+};
+
+TEST_F(BoundingVolumesTests, BoundingBoxOf_ManyPoints_MatchesSerialFit)
+{
+	const auto points = MakeBall(Epic::Vector3f{ 1.f, -2.f, 3.f }, 5.f, 200000);
+
+	const auto expected = Epic::AABBf::FitOf(points.data(), points.size());
+	const auto box = Epic::BoundingBoxOf(points.data(), points.size());
+
+	for (size_t k = 0; k < 3; ++k)
+	{
+		EXPECT_EQ(box.Min[k], expected.Min[k]);
+		EXPECT_EQ(box.Max[k], expected.Max[k]);
+	}
+
+	EXPECT_TRUE(Epic::BoundingBoxOf(points.data(), 0).IsEmpty());
+}
+
+TEST_F(BoundingVolumesTests, MinimumSphereOf_Ball_RecoversSphere)
+{
+	const auto points = MakeBall(Epic::Vector3f{ 1.f, -2.f, 3.f }, 5.f, 200000);
+
+	const auto sphere = Epic::MinimumSphereOf(points.data(), points.size());
+	const auto ritter = Epic::RitterSphereOf(points.data(), points.size());
+
+	EXPECT_NEAR(sphere.Radius, 5.f, 1e-3f);
+	EXPECT_NEAR(sphere.Position[0], 1.f, 1e-2f);
+	EXPECT_NEAR(sphere.Position[1], -2.f, 1e-2f);
+	EXPECT_NEAR(sphere.Position[2], 3.f, 1e-2f);
+
+	ExpectContainsAll(sphere, points);
+	ExpectContainsAll(ritter, points);
+
+	EXPECT_GE(ritter.Radius, sphere.Radius);
+	EXPECT_LT(ritter.Radius, sphere.Radius * 1.2f);
+}
+
+TEST_F(BoundingVolumesTests, MinimumSphereOf_Tetrahedron_IsCircumsphere)
+{
+	const std::vector<Epic::Vector3f> points = {
+		{ 1.f, 1.f, 1.f }, { 1.f, -1.f, -1.f }, { -1.f, 1.f, -1.f }, { -1.f, -1.f, 1.f },
+		{ 0.f, 0.f, 0.f }, { 0.5f, 0.5f, 0.1f }
+	};
+
+	const auto sphere = Epic::MinimumSphereOf(points.data(), points.size());
+
+	EXPECT_NEAR(sphere.Radius, std::sqrt(3.f), 1e-5f);
+	for (size_t k = 0; k < 3; ++k)
+		EXPECT_NEAR(sphere.Position[k], 0.f, 1e-5f);
+
+	// Collinear points only need the outer pair
+	const std::vector<Epic::Vector3f> line = { { 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f }, { 2.f, 2.f, 2.f }, { 4.f, 4.f, 4.f } };
+	const auto lineSphere = Epic::MinimumSphereOf(line.data(), line.size());
+
+	EXPECT_NEAR(lineSphere.Radius, std::sqrt(12.f), 1e-5f);
+	EXPECT_LT(Epic::MinimumSphereOf(line.data(), 0).Radius, 0.f);
+}
+
+TEST_F(BoundingVolumesTests, BoundsAccumulator_ChunkedStream_MatchesSingleAdd)
+{
+	const auto points = MakeBall(Epic::Vector3f{ 10.f, 20.f, -30.f }, 2.f, 100000);
+
+	Epic::BoundsAccumulator<float> whole;
+	whole.Add(points.data(), points.size());
+
+	Epic::BoundsAccumulator<float> first, second;
+	first.Add(points.data(), 12345);
+	first.Add(points.data() + 12345, 40000);
+	second.Add(points.data() + 52345, points.size() - 52345);
+	first.Merge(second);
+
+	ASSERT_EQ(first.Count(), points.size());
+
+	const auto covariance = whole.Covariance();
+	const auto streamed = first.Covariance();
+
+	for (size_t k = 0; k < 3; ++k)
+	{
+		EXPECT_EQ(first.Box().Min[k], whole.Box().Min[k]);
+		EXPECT_EQ(first.Box().Max[k], whole.Box().Max[k]);
+		EXPECT_NEAR(first.Mean()[k], whole.Mean()[k], 1e-4f);
+
+		// The variance along each axis is r^2/5 for the solid ball and r^2/3 for the eighth on its surface
+		for (size_t j = 0; j < 3; ++j)
+		{
+			EXPECT_NEAR(streamed[k][j], covariance[k][j], 1e-4f);
+			EXPECT_NEAR(covariance[k][j], k == j ? 0.86667f : 0.f, 0.02f);
+		}
+	}
+
+	ExpectContainsAll(first.Sphere(), points);
+	ExpectContainsAll(whole.Sphere(), points);
+}
+
+TEST_F(BoundingVolumesTests, OrientedBoxOf_RotatedBox_RecoversAxesAndExtents)
+{
+	const Epic::Quaternionf rotation{ Epic::Vector3f{ 1.f, -2.f, 0.5f }.Normalize(), Epic::Radianf{ 0.8f } };
+	const Epic::Matrix3f axes{ rotation };
+	const Epic::Vector3f center{ 5.f, -1.f, 2.f };
+	const Epic::Vector3f extents{ 4.f, 2.f, 1.f };
+
+	std::mt19937 rng{ 99u };
+	std::uniform_real_distribution<float> uniform{ -1.f, 1.f };
+
+	std::vector<Epic::Vector3f> points(100000);
+	for (auto& p : points)
+	{
+		p = center;
+		for (size_t k = 0; k < 3; ++k)
+			p += axes[k] * (uniform(rng) * extents[k]);
+	}
+
+	const auto box = Epic::OrientedBoxOf(points.data(), points.size());
+
+	for (size_t k = 0; k < 3; ++k)
+	{
+		EXPECT_NEAR(std::abs(box.Axis(k).Dot(axes[k])), 1.f, 1e-3f);
+		EXPECT_NEAR(box.Extents[k], extents[k], 1e-2f);
+		EXPECT_NEAR(box.Center[k], center[k], 1e-2f);
+	}
+
+	const Epic::OBBf padded{ box.Center, box.Orientation, box.Extents + Epic::Vector3f{ 1e-4f, 1e-4f, 1e-4f } };
+
+	size_t outside = 0;
+	for (const auto& p : points)
+		outside += padded.Contains(p) ? 0 : 1;
+
+	EXPECT_EQ(outside, 0u);
+}
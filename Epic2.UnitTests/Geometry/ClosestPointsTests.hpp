@@ -0,0 +1,210 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Geometry/ClosestPoints.hpp>
+
+class ClosestPointsTests : public testing::Test
+{
+protected:
+	std::mt19937 m_Random{ 7u };
+
+	Epic::Vector3f RandomPoint(float extent = 2.f)
+	{
+		std::uniform_real_distribution<float> uniform{ -extent, extent };
+
+		return Epic::Vector3f{ uniform(m_Random), uniform(m_Random), uniform(m_Random) };
+	}
+
+	// The closest sample of a dense barycentric grid over the triangle
+	static float BruteForceDistanceSq(const Epic::Vector3f& p, const Epic::Vector3f& a, const Epic::Vector3f& b, const Epic::Vector3f& c)
+	{
+		constexpr int Steps = 200;
+
+		float result = std::numeric_limits<float>::max();
+
+		for (int i = 0; i <= Steps; ++i)
+		{
+			for (int j = 0; i + j <= Steps; ++j)
+			{
+				const float u = float(i) / Steps;
+				const float v = float(j) / Steps;
+				const Epic::Vector3f q = a + (b - a) * u + (c - a) * v;
+
+				result = std::min(result, (q - p).MagnitudeSq());
+			}
+		}
+
+		return result;
+	}
+
+	static float BruteForceSegmentsDistanceSq(const Epic::Vector3f& p1, const Epic::Vector3f& q1, const Epic::Vector3f& p2, const Epic::Vector3f& q2)
+	{
+		constexpr int Steps = 400;
+
+		float result = std::numeric_limits<float>::max();
+
+		for (int i = 0; i <= Steps; ++i)
+		{
+			const Epic::Vector3f x = p1 + (q1 - p1) * (float(i) / Steps);
+			result = std::min(result, (Epic::ClosestPointOnSegment(x, p2, q2) - x).MagnitudeSq());
+		}
+
+		return result;
+	}
+};
+
+TEST_F(ClosestPointsTests, ClosestPointOnTriangle_RandomPoints_MatchesBruteForce)
+{
+	for (int n = 0; n < 50; ++n)
+	{
+		const auto a = RandomPoint(), b = RandomPoint(), c = RandomPoint(), p = RandomPoint(3.f);
+
+		const auto closest = Epic::ClosestPointOnTriangle(p, a, b, c);
+		const float distanceSq = (closest - p).MagnitudeSq();
+
+		// The exact answer can only be closer than any sample, and a sample lies within a grid cell of it
+		EXPECT_LE(distanceSq, BruteForceDistanceSq(p, a, b, c) + 1e-5f);
+		EXPECT_NEAR(std::sqrt(distanceSq), std::sqrt(BruteForceDistanceSq(p, a, b, c)), 0.03f);
+	}
+
+	// Each Voronoi region of a right triangle
+	const Epic::Vector3f a{ 0.f, 0.f, 0.f }, b{ 1.f, 0.f, 0.f }, c{ 0.f, 1.f, 0.f };
+	const auto face = Epic::ClosestPointOnTriangle(Epic::Vector3f{ 0.25f, 0.25f, 5.f }, a, b, c);
+	const auto edge = Epic::ClosestPointOnTriangle(Epic::Vector3f{ 1.f, 1.f, -1.f }, a, b, c);
+	const auto vertex = Epic::ClosestPointOnTriangle(Epic::Vector3f{ -1.f, -2.f, 0.f }, a, b, c);
+
+	EXPECT_NEAR(face[0], 0.25f, 1e-6f); EXPECT_NEAR(face[1], 0.25f, 1e-6f); EXPECT_NEAR(face[2], 0.f, 1e-6f);
+	EXPECT_NEAR(edge[0], 0.5f, 1e-6f); EXPECT_NEAR(edge[1], 0.5f, 1e-6f);
+	EXPECT_NEAR(vertex[0], 0.f, 1e-6f); EXPECT_NEAR(vertex[1], 0.f, 1e-6f);
+}
+
+TEST_F(ClosestPointsTests, ClosestPointsSegmentSegment_RandomSegments_MatchesBruteForce)
+{
+	for (int n = 0; n < 100; ++n)
+	{
+		const auto p1 = RandomPoint(), q1 = RandomPoint(), p2 = RandomPoint(), q2 = RandomPoint();
+
+		float s, t;
+		const auto result = Epic::ClosestPointsSegmentSegment(p1, q1, p2, q2, s, t);
+
+		EXPECT_GE(s, 0.f); EXPECT_LE(s, 1.f);
+		EXPECT_GE(t, 0.f); EXPECT_LE(t, 1.f);
+		EXPECT_LE(result.DistanceSq, BruteForceSegmentsDistanceSq(p1, q1, p2, q2) + 1e-5f);
+		EXPECT_NEAR(std::sqrt(result.DistanceSq), std::sqrt(BruteForceSegmentsDistanceSq(p1, q1, p2, q2)), 0.02f);
+	}
+
+	// Parallel and degenerate segments
+	const auto parallel = Epic::ClosestPointsSegmentSegment(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Vector3f{ 2.f, 0.f, 0.f },
+		Epic::Vector3f{ 1.f, 1.f, 0.f }, Epic::Vector3f{ 3.f, 1.f, 0.f });
+	EXPECT_NEAR(parallel.DistanceSq, 1.f, 1e-6f);
+
+	const auto point = Epic::ClosestPointsSegmentSegment(Epic::Vector3f{ 1.f, 1.f, 1.f }, Epic::Vector3f{ 1.f, 1.f, 1.f },
+		Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Vector3f{ 0.f, 0.f, 2.f });
+	EXPECT_NEAR(point.DistanceSq, 2.f, 1e-6f);
+	EXPECT_NEAR(point.PointB[2], 1.f, 1e-6f);
+}
+
+TEST_F(ClosestPointsTests, ClosestPointOnOBB_OutsideAndInside_ClampsToBox)
+{
+	const Epic::OBBf box{ Epic::Vector3f{ 1.f, 0.f, 0.f }, Epic::Quaternionf{ Epic::Vector3f{ 0.f, 0.f, 1.f }, Epic::Radianf{ 0.78539816f } }, Epic::Vector3f{ 1.f, 1.f, 1.f } };
+
+	const auto outside = Epic::ClosestPointOnOBB(Epic::Vector3f{ 5.f, 0.f, 0.f }, box);
+	EXPECT_NEAR(outside[0], 1.f + std::sqrt(2.f), 1e-5f);
+	EXPECT_NEAR(Epic::DistanceSq(Epic::Vector3f{ 5.f, 0.f, 3.f }, box), (4.f - std::sqrt(2.f)) * (4.f - std::sqrt(2.f)) + 4.f, 1e-4f);
+
+	const auto inside = Epic::ClosestPointOnOBB(Epic::Vector3f{ 1.2f, 0.1f, 0.f }, box);
+	EXPECT_NEAR(inside[0], 1.2f, 1e-6f);
+	EXPECT_NEAR(Epic::DistanceSq(Epic::Vector3f{ 1.2f, 0.1f, 0.f }, box), 0.f, 1e-10f);
+}
+
+TEST_F(ClosestPointsTests, ClosestPointsTriangleTriangle_SeparatedAndIntersecting_MatchesBruteForce)
+{
+	const Epic::Vector3f a0{ 0.f, 0.f, 0.f }, a1{ 1.f, 0.f, 0.f }, a2{ 0.f, 1.f, 0.f };
+
+	// Vertex over face
+	const auto over = Epic::ClosestPointsTriangleTriangle(a0, a1, a2,
+		Epic::Vector3f{ 0.2f, 0.2f, 0.5f }, Epic::Vector3f{ 0.f, 0.f, 2.f }, Epic::Vector3f{ 1.f, 1.f, 2.f });
+	EXPECT_NEAR(over.DistanceSq, 0.25f, 1e-6f);
+	EXPECT_NEAR(over.PointA[0], 0.2f, 1e-6f);
+
+	// Piercing
+	const auto pierce = Epic::ClosestPointsTriangleTriangle(a0, a1, a2,
+		Epic::Vector3f{ 0.2f, 0.2f, -1.f }, Epic::Vector3f{ 0.2f, 0.2f, 1.f }, Epic::Vector3f{ 3.f, 3.f, 0.f });
+	EXPECT_EQ(pierce.DistanceSq, 0.f);
+	EXPECT_NEAR(pierce.PointA[2], 0.f, 1e-6f);
+
+	// Random pairs; brute force samples the vertices and edges of each against the other
+	for (int n = 0; n < 30; ++n)
+	{
+		const Epic::Vector3f a[3] = { RandomPoint(), RandomPoint(), RandomPoint() };
+		const Epic::Vector3f offset = RandomPoint(1.f);
+		const Epic::Vector3f b[3] = { RandomPoint() + offset, RandomPoint() + offset, RandomPoint() + offset };
+
+		const auto result = Epic::ClosestPointsTriangleTriangle(a[0], a[1], a[2], b[0], b[1], b[2]);
+
+		float expected = std::numeric_limits<float>::max();
+		for (int i = 0; i < 3; ++i)
+		{
+			expected = std::min(expected, BruteForceDistanceSq(a[i], b[0], b[1], b[2]));
+			expected = std::min(expected, BruteForceDistanceSq(b[i], a[0], a[1], a[2]));
+
+			for (int j = 0; j < 3; ++j)
+				expected = std::min(expected, BruteForceSegmentsDistanceSq(a[i], a[(i + 1) % 3], b[j], b[(j + 1) % 3]));
+		}
+
+		const bool intersecting = result.DistanceSq == 0.f;
+
+		EXPECT_NEAR((result.PointB - result.PointA).MagnitudeSq(), result.DistanceSq, 1e-5f);
+		EXPECT_LE(result.DistanceSq, expected + 1e-5f);
+
+		if (!intersecting)
+		{
+			EXPECT_NEAR(std::sqrt(result.DistanceSq), std::sqrt(expected), 0.03f);
+		}
+	}
+}
+
+TEST_F(ClosestPointsTests, BatchClosestPointOnTriangles_ManyTriangles_MatchesScalar)
+{
+	std::vector<Epic::Vector3f> triangles;
+	for (int n = 0; n < 300; ++n)
+		triangles.push_back(RandomPoint(4.f));
+
+	// A degenerate triangle
+	triangles.push_back(Epic::Vector3f{ 0.f, 0.f, 0.f });
+	triangles.push_back(Epic::Vector3f{ 1.f, 1.f, 1.f });
+	triangles.push_back(Epic::Vector3f{ 2.f, 2.f, 2.f });
+
+	const size_t count = triangles.size() / 3;
+
+	for (int q = 0; q < 10; ++q)
+	{
+		const auto p = RandomPoint(5.f);
+
+		std::vector<Epic::Vector3f> points(count);
+		std::vector<float> distances(count);
+		Epic::BatchClosestPointOnTriangles(p, triangles.data(), count, points.data(), distances.data());
+
+		size_t expectedIndex = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const auto expected = Epic::ClosestPointOnTriangle(p, triangles[i * 3], triangles[i * 3 + 1], triangles[i * 3 + 2]);
+
+			EXPECT_NEAR(distances[i], (expected - p).MagnitudeSq(), 1e-3f);
+			for (size_t k = 0; k < 3; ++k)
+				EXPECT_NEAR(points[i][k], expected[k], 1e-3f);
+
+			if (distances[i] < distances[expectedIndex])
+				expectedIndex = i;
+		}
+
+		Epic::Vector3f closest;
+		float distanceSq;
+		EXPECT_EQ(Epic::ClosestTriangle(p, triangles.data(), count, closest, distanceSq), expectedIndex);
+		EXPECT_EQ(distanceSq, distances[expectedIndex]);
+	}
+}
@@ -0,0 +1,265 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Geometry/ConvexHull.h>
+
+class ConvexHullTests : public testing::Test
+{
+protected:
+	static std::vector<Epic::Vector3f> MakeSphere(size_t count, float interiorFraction)
+	{
+		std::mt19937 rng{ 42u };
+		std::normal_distribution<float> normal;
+		std::uniform_real_distribution<float> uniform{ 0.f, 1.f };
+
+		std::vector<Epic::Vector3f> points;
+		points.reserve(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			Epic::Vector3f direction{ normal(rng), normal(rng), normal(rng) };
+			direction.Normalize();
+
+			points.push_back(direction * (uniform(rng) < interiorFraction ? uniform(rng) : 1.f));
+		}
+
+		return points;
+	}
+
+	// Checks the twin and face links and the Euler characteristic of a closed hull
+	static void ExpectValidTopology(const Epic::ConvexHullf& hull)
+	{
+		const auto& edges = hull.Edges();
+		const auto& faces = hull.Faces();
+
+		for (size_t f = 0; f < faces.size(); ++f)
+		{
+			EXPECT_GE(faces[f].EdgeCount, 3u);
+
+			for (size_t e = faces[f].FirstEdge; e < faces[f].FirstEdge + faces[f].EdgeCount; ++e)
+			{
+				const auto& edge = edges[e];
+
+				ASSERT_LT(edge.Twin, edges.size());
+				EXPECT_EQ(edge.Face, f);
+				EXPECT_EQ(edges[edge.Twin].Twin, e);
+				EXPECT_EQ(edges[edge.Twin].Origin, edges[edge.Next].Origin);
+				EXPECT_NE(edges[edge.Twin].Face, f);
+			}
+		}
+
+		EXPECT_EQ(int(hull.Vertices().size()) - int(edges.size() / 2) + int(faces.size()), 2);
+	}
+
+	// Every vertex must lie on or below every face plane
+	static void ExpectConvex(const Epic::ConvexHullf& hull, float tolerance)
+	{
+		size_t violations = 0;
+
+		for (const auto& face : hull.Faces())
+		{
+			for (const auto& v : hull.Vertices())
+				violations += (face.Normal.Dot(v) - face.Offset > tolerance) ? 1 : 0;
+		}
+
+		EXPECT_EQ(violations, 0u);
+	}
+};
+
+TEST_F(ConvexHullTests, Build_CubeLattice_MergesIntoSixQuads)
+{
+	std::vector<Epic::Vector3f> points;
+	for (int x = 0; x <= 4; ++x)
+		for (int y = 0; y <= 4; ++y)
+			for (int z = 0; z <= 4; ++z)
+				points.push_back(Epic::Vector3f{ float(x) - 2.f, float(y) - 2.f, float(z) - 2.f });
+
+	Epic::ConvexHullf hull;
+	ASSERT_TRUE(hull.Build(points));
+
+	EXPECT_EQ(hull.Vertices().size(), 8u);
+	EXPECT_EQ(hull.Faces().size(), 6u);
+	EXPECT_EQ(hull.Edges().size(), 24u);
+
+	for (const auto& face : hull.Faces())
+	{
+		EXPECT_EQ(face.EdgeCount, 4u);
+		EXPECT_NEAR(face.Offset, 2.f, 1e-5f);
+		EXPECT_NEAR(std::abs(face.Normal[0]) + std::abs(face.Normal[1]) + std::abs(face.Normal[2]), 1.f, 1e-5f);
+	}
+
+	for (size_t i = 0; i < hull.Vertices().size(); ++i)
+	{
+		for (size_t k = 0; k < 3; ++k)
+			EXPECT_EQ(std::abs(hull.Vertices()[i][k]), 2.f);
+
+		EXPECT_EQ(points[hull.SourceIndices()[i]][0], hull.Vertices()[i][0]);
+	}
+
+	ExpectValidTopology(hull);
+
+	std::vector<Epic::ConvexHullf::index_type> indices;
+	EXPECT_EQ(hull.Triangulate(indices), 12u);
+	EXPECT_EQ(indices.size(), 36u);
+}
+
+TEST_F(ConvexHullTests, Build_SpherePoints_ContainsEveryPoint)
+{
+	const auto points = MakeSphere(4000, 0.5f);
+
+	Epic::ConvexHullf hull;
+	ASSERT_TRUE(hull.Build(points));
+
+	ExpectValidTopology(hull);
+	ExpectConvex(hull, 1e-5f);
+
+	size_t outside = 0;
+	for (const auto& p : points)
+		outside += hull.Contains(p, 1e-5f) ? 0 : 1;
+
+	EXPECT_EQ(outside, 0u);
+
+	// Roughly half of the points were placed on the surface
+	EXPECT_GT(hull.Vertices().size(), 1800u);
+	EXPECT_TRUE(hull.Contains(Epic::Vector3f{ 0.f, 0.f, 0.f }));
+	EXPECT_FALSE(hull.Contains(Epic::Vector3f{ 0.f, 1.01f, 0.f }));
+}
+
+TEST_F(ConvexHullTests, Build_SerialPartition_MatchesParallel)
+{
+	const auto points = MakeSphere(50000, 0.9f);
+
+	Epic::ConvexHullf parallel;
+	Epic::ConvexHullf serial{ Epic::ConvexHullf::Settings{ 0.f, 0.f, 0, false } };
+
+	ASSERT_TRUE(parallel.Build(points));
+	ASSERT_TRUE(serial.Build(points));
+
+	EXPECT_EQ(parallel.SourceIndices(), serial.SourceIndices());
+	EXPECT_EQ(parallel.Faces().size(), serial.Faces().size());
+	EXPECT_EQ(parallel.Edges().size(), serial.Edges().size());
+}
+
+TEST_F(ConvexHullTests, Build_MaxVertices_LimitsVertexCount)
+{
+	const auto points = MakeSphere(20000, 0.f);
+
+	Epic::ConvexHullf::Settings settings;
+	settings.MaxVertices = 32;
+
+	Epic::ConvexHullf hull{ settings };
+	ASSERT_TRUE(hull.Build(points));
+
+	EXPECT_LE(hull.Vertices().size(), 32u);
+	EXPECT_GE(hull.Vertices().size(), 24u);
+	ExpectValidTopology(hull);
+	ExpectConvex(hull, 1e-5f);
+
+	// The furthest points are added first, so even a coarse hull reaches most of the sphere
+	size_t inside = 0;
+	for (const auto& p : points)
+		inside += hull.Contains(p * 0.8f) ? 1 : 0;
+
+	EXPECT_EQ(inside, points.size());
+}
+
+TEST_F(ConvexHullTests, Build_FaceNestedInCoplanarRing_KeepsValidTopology)
+{
+	// A prism whose top is a ring of coplanar points around a slightly raised triangle
+	const float pi = 3.14159265f;
+
+	std::vector<Epic::Vector3f> points;
+	for (int i = 0; i < 16; ++i)
+	{
+		const float angle = float(i) * pi / 8.f;
+		points.push_back(Epic::Vector3f{ 3.f * std::cos(angle), 3.f * std::sin(angle), 1.f });
+		points.push_back(Epic::Vector3f{ 3.f * std::cos(angle), 3.f * std::sin(angle), -1.f });
+	}
+
+	for (int i = 0; i < 3; ++i)
+	{
+		const float angle = float(i) * 2.f * pi / 3.f + 0.1f;
+		points.push_back(Epic::Vector3f{ std::cos(angle), std::sin(angle), 1.02f });
+	}
+
+	for (const float mergeTolerance : { 0.005f, 0.01f, 0.03f, 0.2f })
+	{
+		Epic::ConvexHullf hull{ Epic::ConvexHullf::Settings{ 1e-4f, mergeTolerance, 0, true } };
+		ASSERT_TRUE(hull.Build(points));
+
+		ExpectValidTopology(hull);
+		ExpectConvex(hull, mergeTolerance);
+
+		size_t outside = 0;
+		for (const auto& p : points)
+			outside += hull.Contains(p, mergeTolerance) ? 0 : 1;
+
+		EXPECT_EQ(outside, 0u);
+
+		// Below the height of the raised triangle it must survive as its own face
+		size_t nested = 0;
+		for (const auto& face : hull.Faces())
+			nested += (face.EdgeCount == 3 && face.Normal[2] > 0.9999f && std::abs(face.Offset - 1.02f) < 1e-4f) ? 1 : 0;
+
+		EXPECT_EQ(nested, mergeTolerance < 0.02f ? 1u : 0u);
+	}
+}
+
+TEST_F(ConvexHullTests, Build_NoisyBoxes_KeepsValidTopology)
+{
+	// Noisy box faces produce many nearly coplanar triangles for the merge to group
+	std::mt19937 rng{ 7u };
+	std::uniform_real_distribution<float> uniform{ -1.f, 1.f };
+	std::uniform_int_distribution<int> axis{ 0, 2 };
+
+	for (const float noise : { 1e-3f, 1e-2f, 3e-2f })
+	{
+		std::normal_distribution<float> jitter{ 0.f, noise };
+
+		std::vector<Epic::Vector3f> points;
+		for (int i = 0; i < 200; ++i)
+		{
+			Epic::Vector3f p{ uniform(rng), uniform(rng), uniform(rng) };
+			const int a = axis(rng);
+			p[a] = p[a] < 0.f ? -1.f : 1.f;
+
+			points.push_back(p + Epic::Vector3f{ jitter(rng), jitter(rng), jitter(rng) });
+		}
+
+		for (const float mergeTolerance : { 0.01f, 0.03f, 0.1f })
+		{
+			Epic::ConvexHullf hull{ Epic::ConvexHullf::Settings{ 1e-5f, mergeTolerance, 0, true } };
+			ASSERT_TRUE(hull.Build(points));
+
+			ExpectValidTopology(hull);
+			ExpectConvex(hull, mergeTolerance);
+		}
+	}
+}
+
+TEST_F(ConvexHullTests, Build_DegenerateInput_ReturnsFalse)
+{
+	Epic::ConvexHullf hull;
+
+	std::vector<Epic::Vector3f> plane;
+	for (int i = 0; i < 100; ++i)
+		plane.push_back(Epic::Vector3f{ std::cos(float(i)), std::sin(float(i)), 1.f });
+
+	EXPECT_FALSE(hull.Build(plane));
+	EXPECT_TRUE(hull.Empty());
+
+	const std::vector<Epic::Vector3f> line = { { 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f }, { 2.f, 2.f, 2.f }, { 3.f, 3.f, 3.f }, { 4.f, 4.f, 4.f } };
+	EXPECT_FALSE(hull.Build(line));
+
+	EXPECT_FALSE(hull.Build(line.data(), 3));
+
+	const std::vector<Epic::Vector3f> tetrahedron = { { 0.f, 0.f, 0.f }, { 1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }, { 0.f, 0.f, 1.f } };
+	ASSERT_TRUE(hull.Build(tetrahedron));
+
+	EXPECT_EQ(hull.Vertices().size(), 4u);
+	EXPECT_EQ(hull.Faces().size(), 4u);
+	ExpectValidTopology(hull);
+}
@@ -0,0 +1,131 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <Geometry/GJK.hpp>
+
+class GJKTests : public testing::Test
+{
+protected:
+	static Epic::BoxShape<float> MakeBox(const Epic::Vector3f& position, const Epic::Vector3f& halfExtents, float angle = 0.f)
+	{
+		return Epic::BoxShape<float>{ position, Epic::Quaternionf{ Epic::Vector3f{ 0.f, 0.f, 1.f }, Epic::Radianf{ angle } }, halfExtents };
+	}
+
+	static void ExpectNear(const Epic::Vector3f& actual, const Epic::Vector3f& expected, float tolerance)
+	{
+		for (size_t k = 0; k < 3; ++k)
+			EXPECT_NEAR(actual[k], expected[k], tolerance);
+	}
+};
+
+TEST_F(GJKTests, GJK_SeparatedSpheres_ReturnsDistanceAndClosestPoints)
+{
+	const Epic::SphereShape<float> a{ Epic::Vector3f{ 0.f, 0.f, 0.f }, 1.f };
+	const Epic::SphereShape<float> b{ Epic::Vector3f{ 3.f, 0.f, 0.f }, 1.f };
+
+	const auto result = Epic::GJK(a, b);
+
+	EXPECT_FALSE(result.Intersecting);
+	EXPECT_NEAR(result.Distance, 1.f, 1e-4f);
+	ExpectNear(result.PointA, Epic::Vector3f{ 1.f, 0.f, 0.f }, 1e-3f);
+	ExpectNear(result.PointB, Epic::Vector3f{ 2.f, 0.f, 0.f }, 1e-3f);
+}
+
+TEST_F(GJKTests, GJK_RotatedBoxAndCapsule_ReturnsDistance)
+{
+	const auto box = MakeBox(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Vector3f{ 1.f, 1.f, 1.f }, 0.78539816f);
+	const Epic::CapsuleShape<float> capsule{ Epic::Vector3f{ 3.f, -1.f, 0.f }, Epic::Vector3f{ 3.f, 1.f, 0.f }, 0.5f };
+
+	const auto result = Epic::GJK(box, capsule);
+
+	EXPECT_FALSE(result.Intersecting);
+	EXPECT_NEAR(result.Distance, 3.f - std::sqrt(2.f) - 0.5f, 1e-4f);
+	EXPECT_NEAR(result.PointA[0], std::sqrt(2.f), 1e-4f);
+}
+
+TEST_F(GJKTests, GJK_OverlappingHullAndBox_Intersect)
+{
+	const Epic::Vector3f points[] = { { -1.f, -1.f, -1.f }, { 1.f, -1.f, -1.f }, { 0.f, 1.f, -1.f }, { 0.f, 0.f, 1.f } };
+	const Epic::ConvexHullShape<float> hull{ Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Quaternionf{ Epic::Identity }, points, 4 };
+
+	EXPECT_TRUE(Epic::Intersects(hull, MakeBox(Epic::Vector3f{ 0.5f, 0.f, 0.f }, Epic::Vector3f{ 0.5f, 0.5f, 0.5f })));
+	EXPECT_FALSE(Epic::Intersects(hull, MakeBox(Epic::Vector3f{ 0.f, 0.f, 2.f }, Epic::Vector3f{ 0.5f, 0.5f, 0.5f })));
+}
+
+TEST_F(GJKTests, Penetration_OverlappingBoxes_ReturnsDepthAndNormal)
+{
+	const auto a = MakeBox(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Vector3f{ 1.f, 1.f, 1.f });
+	const auto b = MakeBox(Epic::Vector3f{ 1.5f, 0.2f, 0.1f }, Epic::Vector3f{ 1.f, 1.f, 1.f });
+
+	const auto result = Epic::Penetration(a, b);
+
+	EXPECT_TRUE(result.Intersecting);
+	EXPECT_NEAR(result.Depth, 0.5f, 1e-4f);
+	ExpectNear(result.Normal, Epic::Vector3f{ 1.f, 0.f, 0.f }, 1e-4f);
+	EXPECT_NEAR(result.PointA[0] - result.PointB[0], 0.5f, 1e-4f);
+}
+
+TEST_F(GJKTests, Penetration_OverlappingSpheres_ReturnsDepthAndNormal)
+{
+	const Epic::SphereShape<float> a{ Epic::Vector3f{ 0.f, 0.f, 0.f }, 1.f };
+	const Epic::SphereShape<float> b{ Epic::Vector3f{ 0.f, 1.5f, 0.f }, 1.f };
+
+	const auto result = Epic::Penetration(a, b);
+
+	EXPECT_TRUE(result.Intersecting);
+	EXPECT_NEAR(result.Depth, 0.5f, 1e-2f);
+	ExpectNear(result.Normal, Epic::Vector3f{ 0.f, 1.f, 0.f }, 1e-2f);
+
+	EXPECT_FALSE(Epic::Penetration(a, Epic::SphereShape<float>{ Epic::Vector3f{ 0.f, 2.5f, 0.f }, 1.f }).Intersecting);
+}
+
+TEST_F(GJKTests, GJK_IterationCap_ReturnsConsistentWitnesses)
+{
+	const Epic::SphereShape<float> a{ Epic::Vector3f{ 0.f, 0.f, 0.f }, 1.f };
+	const Epic::SphereShape<float> b{ Epic::Vector3f{ 3.f, 0.7f, -0.4f }, 1.f };
+
+	const float distance = std::sqrt(9.f + 0.49f + 0.16f) - 2.f;
+
+	for (size_t maxIterations = 0; maxIterations < 4; ++maxIterations)
+	{
+		Epic::GJKCache<float> cache;
+		const auto capped = Epic::GJK(a, b, &cache, maxIterations);
+
+		EXPECT_FALSE(capped.Intersecting);
+		EXPECT_NEAR(capped.Distance, (capped.PointB - capped.PointA).Magnitude(), 1e-5f);
+		EXPECT_GE(capped.Distance, distance - 1e-4f);
+
+		// The cache holds the solved simplex, so a full run resumes from it
+		const auto resumed = Epic::GJK(a, b, &cache);
+
+		EXPECT_NEAR(resumed.Distance, distance, 1e-4f);
+	}
+}
+
+TEST_F(GJKTests, GJK_CachedSimplex_ConvergesInFewerIterations)
+{
+	const auto a = MakeBox(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Vector3f{ 1.f, 1.f, 1.f }, 0.3f);
+
+	Epic::GJKCache<float> cache;
+	size_t uncachedIterations = 0;
+	size_t cachedIterations = 0;
+
+	for (size_t frame = 0; frame < 10; ++frame)
+	{
+		const auto b = MakeBox(Epic::Vector3f{ 3.f - 0.01f * frame, 0.5f, 0.2f }, Epic::Vector3f{ 0.5f, 0.5f, 0.5f }, 0.1f * frame);
+
+		const auto uncached = Epic::GJK(a, b);
+		const auto cached = Epic::GJK(a, b, &cache);
+
+		EXPECT_NEAR(cached.Distance, uncached.Distance, 1e-5f);
+
+		if (frame > 0)
+		{
+			uncachedIterations += uncached.Iterations;
+			cachedIterations += cached.Iterations;
+		}
+	}
+
+	EXPECT_LT(cachedIterations, uncachedIterations);
+}
@@ -0,0 +1,149 @@
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Geometry/OBB.h>
+
+class OBBTests : public testing::Test
+{
+protected:
+	static Epic::OBBf MakeBox(const Epic::Vector3f& center, const Epic::Vector3f& extents, const Epic::Vector3f& axis, float angle)
+	{
+		return Epic::OBBf{ center, Epic::Quaternionf{ axis, Epic::Radianf{ angle } }, extents };
+	}
+
+	static Epic::OBBf MakeBox(const Epic::Vector3f& center, const Epic::Vector3f& extents)
+	{
+		return Epic::OBBf{ center, Epic::Quaternionf{ Epic::Identity }, extents };
+	}
+};
+
+TEST_F(OBBTests, Intersects_SeparatedAlongFaceAxis_ReturnsFalse)
+{
+	const auto a = MakeBox(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Vector3f{ 1.f, 1.f, 1.f });
+	const auto b = MakeBox(Epic::Vector3f{ 2.1f, 0.f, 0.f }, Epic::Vector3f{ 1.f, 1.f, 1.f });
+	const auto c = MakeBox(Epic::Vector3f{ 1.9f, 0.5f, -0.5f }, Epic::Vector3f{ 1.f, 1.f, 1.f });
+
+	EXPECT_FALSE(a.Intersects(b));
+	EXPECT_TRUE(a.Intersects(c));
+	EXPECT_TRUE(c.Intersects(a));
+}
+
+TEST_F(OBBTests, Intersects_RotatedBoxes_UsesAllAxes)
+{
+	const auto a = MakeBox(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Vector3f{ 1.f, 1.f, 1.f });
+
+	// Rotated 45 degrees about z the corner of b reaches sqrt(2) along x
+	const auto b = MakeBox(Epic::Vector3f{ 2.3f, 0.f, 0.f }, Epic::Vector3f{ 1.f, 1.f, 1.f }, Epic::Vector3f{ 0.f, 0.f, 1.f }, 0.78539816f);
+	const auto c = MakeBox(Epic::Vector3f{ 2.5f, 0.f, 0.f }, Epic::Vector3f{ 1.f, 1.f, 1.f }, Epic::Vector3f{ 0.f, 0.f, 1.f }, 0.78539816f);
+
+	EXPECT_TRUE(a.Intersects(b));
+	EXPECT_FALSE(a.Intersects(c));
+
+	// Tilted bars crossing over each other
+	const auto d = MakeBox(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Vector3f{ 2.f, 0.1f, 0.1f }, Epic::Vector3f{ 1.f, 1.f, 0.f }.Normalize(), 0.78539816f);
+	const auto e = MakeBox(Epic::Vector3f{ 0.f, 0.f, 0.5f }, Epic::Vector3f{ 0.1f, 2.f, 0.1f }, Epic::Vector3f{ 1.f, 1.f, 0.f }.Normalize(), 0.78539816f);
+	const auto f = MakeBox(Epic::Vector3f{ 0.f, 0.f, 0.15f }, Epic::Vector3f{ 0.1f, 2.f, 0.1f }, Epic::Vector3f{ 1.f, 1.f, 0.f }.Normalize(), 0.78539816f);
+
+	EXPECT_FALSE(d.Intersects(e));
+	EXPECT_TRUE(d.Intersects(f));
+}
+
+TEST_F(OBBTests, Intersects_AABBAndSphere_MatchesClosestPoint)
+{
+	const auto box = MakeBox(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Vector3f{ 1.f, 1.f, 1.f }, Epic::Vector3f{ 0.f, 0.f, 1.f }, 0.78539816f);
+
+	EXPECT_TRUE(box.Intersects(Epic::AABBf{ Epic::Vector3f{ 1.3f, -0.2f, -0.2f }, Epic::Vector3f{ 2.f, 0.2f, 0.2f } }));
+	EXPECT_FALSE(box.Intersects(Epic::AABBf{ Epic::Vector3f{ 1.5f, -0.2f, -0.2f }, Epic::Vector3f{ 2.f, 0.2f, 0.2f } }));
+
+	EXPECT_TRUE(box.Intersects(Epic::Vector3f{ 1.8f, 0.f, 0.f }, 0.4f));
+	EXPECT_FALSE(box.Intersects(Epic::Vector3f{ 1.9f, 0.f, 0.f }, 0.4f));
+
+	const auto closest = box.ClosestPoint(Epic::Vector3f{ 3.f, 0.f, 0.f });
+	EXPECT_NEAR(closest[0], std::sqrt(2.f), 1e-5f);
+	EXPECT_NEAR(closest[1], 0.f, 1e-5f);
+
+	const auto bounds = box.Bounds();
+	EXPECT_NEAR(bounds.Max[0], std::sqrt(2.f), 1e-5f);
+	EXPECT_NEAR(bounds.Min[1], -std::sqrt(2.f), 1e-5f);
+	EXPECT_NEAR(bounds.Max[2], 1.f, 1e-5f);
+}
+
+TEST_F(OBBTests, Raycast_HitsAndMisses_ReturnsEntryDistance)
+{
+	const auto box = MakeBox(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Vector3f{ 1.f, 1.f, 1.f }, Epic::Vector3f{ 0.f, 0.f, 1.f }, 0.78539816f);
+
+	float distance = -1.f;
+	EXPECT_TRUE(box.Raycast(Epic::Vector3f{ -5.f, 0.f, 0.f }, Epic::Vector3f{ 1.f, 0.f, 0.f }, distance));
+	EXPECT_NEAR(distance, 5.f - std::sqrt(2.f), 1e-5f);
+
+	EXPECT_FALSE(box.Raycast(Epic::Vector3f{ -5.f, 0.f, 0.f }, Epic::Vector3f{ 1.f, 0.f, 0.f }, distance, 3.f));
+	EXPECT_FALSE(box.Raycast(Epic::Vector3f{ -5.f, 2.f, 0.f }, Epic::Vector3f{ 1.f, 0.f, 0.f }, distance));
+	EXPECT_FALSE(box.Raycast(Epic::Vector3f{ -5.f, 0.f, 1.5f }, Epic::Vector3f{ 1.f, 0.f, 0.f }, distance));
+
+	EXPECT_TRUE(box.Raycast(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Vector3f{ 0.f, 1.f, 0.f }, distance));
+	EXPECT_EQ(distance, 0.f);
+}
+
+TEST_F(OBBTests, BatchIntersects_ManyBoxes_MatchesIntersects)
+{
+	const auto box = MakeBox(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Vector3f{ 1.f, 0.5f, 2.f }, Epic::Vector3f{ 0.f, 1.f, 0.f }, 0.3f);
+
+	std::vector<Epic::OBBf> others;
+	for (size_t i = 0; i < 150; ++i)
+	{
+		const float f = float(i);
+		const Epic::Vector3f center{ std::sin(f * 0.7f) * 3.f, std::cos(f * 1.3f) * 3.f, std::sin(f * 2.1f) * 3.f };
+		const Epic::Vector3f axis = Epic::Vector3f{ std::cos(f), std::sin(f * 0.5f), 0.5f }.Normalize();
+
+		others.push_back(MakeBox(center, Epic::Vector3f{ 0.5f + 0.01f * f, 1.f, 0.25f }, axis, f * 0.37f));
+	}
+
+	std::vector<std::uint8_t> results(others.size(), 2);
+	Epic::OBBf::BatchIntersects(box, others.data(), others.size(), results.data());
+
+	size_t hits = 0;
+	for (size_t i = 0; i < others.size(); ++i)
+	{
+		EXPECT_EQ(results[i] != 0, box.Intersects(others[i]));
+		hits += results[i];
+	}
+
+	EXPECT_GT(hits, 0u);
+	EXPECT_LT(hits, others.size());
+}
+
+TEST_F(OBBTests, FitOf_RotatedBoxCorners_RecoversBox)
+{
+	const auto box = MakeBox(Epic::Vector3f{ 1.f, 2.f, 3.f }, Epic::Vector3f{ 3.f, 2.f, 1.f }, Epic::Vector3f{ 1.f, 2.f, 3.f }.Normalize(), 0.6f);
+
+	std::vector<Epic::Vector3f> points;
+	for (int i = 0; i < 8; ++i)
+	{
+		Epic::Vector3f p = box.Center;
+		for (size_t k = 0; k < 3; ++k)
+			p += box.Axis(k) * (((i >> k) & 1) ? box.Extents[k] : -box.Extents[k]);
+
+		points.push_back(p);
+	}
+
+	const auto fit = Epic::OBBf::FitOf(points.data(), points.size());
+
+	for (size_t k = 0; k < 3; ++k)
+	{
+		EXPECT_NEAR(fit.Center[k], box.Center[k], 1e-4f);
+		EXPECT_NEAR(fit.Extents[k], box.Extents[k], 1e-4f);
+		EXPECT_NEAR(std::abs(fit.Axis(k).Dot(box.Axis(k))), 1.f, 1e-4f);
+	}
+
+	const Epic::OBBf padded{ fit.Center, fit.Orientation, fit.Extents + Epic::Vector3f{ 1e-4f, 1e-4f, 1e-4f } };
+	const auto bounds = Epic::AABBf::FitOf(points.data(), points.size());
+
+	for (const auto& p : points)
+	{
+		EXPECT_TRUE(padded.Contains(p));
+		EXPECT_TRUE(bounds.Contains(p));
+	}
+}
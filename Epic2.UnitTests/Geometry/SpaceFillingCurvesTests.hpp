@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Geometry/SpatialSort.hpp>
+
+class SpaceFillingCurvesTests : public testing::Test
+{
+};
+
+TEST_F(SpaceFillingCurvesTests, MortonEncode_InterleavesBits)
+{
+	EXPECT_EQ(Epic::MortonEncode<std::uint32_t>(1u, 0u, 0u), 1u);
+	EXPECT_EQ(Epic::MortonEncode<std::uint32_t>(0u, 1u, 0u), 2u);
+	EXPECT_EQ(Epic::MortonEncode<std::uint32_t>(0u, 0u, 1u), 4u);
+	EXPECT_EQ(Epic::MortonEncode<std::uint32_t>(3u, 3u, 3u), 63u);
+	EXPECT_EQ(Epic::MortonEncode<std::uint64_t>(0x1FFFFFu, 0x1FFFFFu, 0x1FFFFFu), 0x7FFFFFFFFFFFFFFFull);
+}
+
+TEST_F(SpaceFillingCurvesTests, MortonDecode_InvertsEncode)
+{
+	for (std::uint32_t x = 0; x < 16; ++x)
+		for (std::uint32_t y = 0; y < 16; ++y)
+			for (std::uint32_t z = 0; z < 16; ++z)
+			{
+				const auto decoded = Epic::MortonDecode3(Epic::MortonEncode<std::uint64_t>(x << 17, y, z << 9));
+
+				EXPECT_EQ(decoded[0], x << 17);
+				EXPECT_EQ(decoded[1], y);
+				EXPECT_EQ(decoded[2], z << 9);
+			}
+}
+
+TEST_F(SpaceFillingCurvesTests, HilbertDecode_InvertsEncode)
+{
+	for (std::uint32_t x = 0; x < 16; ++x)
+		for (std::uint32_t y = 0; y < 16; ++y)
+			for (std::uint32_t z = 0; z < 16; ++z)
+			{
+				const auto decoded = Epic::HilbertDecode3(Epic::HilbertEncode<std::uint32_t>(x << 6, y, z << 3));
+
+				EXPECT_EQ(decoded[0], x << 6);
+				EXPECT_EQ(decoded[1], y);
+				EXPECT_EQ(decoded[2], z << 3);
+			}
+}
+
+TEST_F(SpaceFillingCurvesTests, HilbertDecode_ConsecutiveCodesAreNeighbors)
+{
+	for (std::uint32_t code = 0; code < 4096; ++code)
+	{
+		const auto a = Epic::HilbertDecode3(code);
+		const auto b = Epic::HilbertDecode3(code + 1);
+
+		const int distance =
+			std::abs(int(a[0]) - int(b[0])) +
+			std::abs(int(a[1]) - int(b[1])) +
+			std::abs(int(a[2]) - int(b[2]));
+
+		EXPECT_EQ(distance, 1);
+	}
+}
+
+TEST_F(SpaceFillingCurvesTests, SpatialSort_SortsCodesAndPermutation)
+{
+	std::mt19937 rng{ 42u };
+	std::uniform_real_distribution<float> dist{ -10.f, 10.f };
+
+	std::vector<Epic::Vector3f> points(100000);
+	for (auto& p : points)
+		p = Epic::Vector3f{ dist(rng), dist(rng), dist(rng) };
+
+	const auto bounds = Epic::BoundsOf(points.data(), points.size());
+	const Epic::CurveQuantizer<float, 3, std::uint64_t> quantizer{ bounds.first, bounds.second };
+
+	std::vector<std::uint64_t> codes(points.size());
+	Epic::MortonEncode(quantizer, points.data(), points.size(), codes.data());
+
+	const auto source = codes;
+	std::vector<std::uint32_t> permutation(codes.size());
+	Epic::SpatialSort(codes.data(), permutation.data(), codes.size());
+
+	EXPECT_TRUE(std::is_sorted(std::begin(codes), std::end(codes)));
+
+	for (size_t i = 0; i < codes.size(); ++i)
+		EXPECT_EQ(source[permutation[i]], codes[i]);
+}
+
+TEST_F(SpaceFillingCurvesTests, CurveQuantizer_ClampsMaxEdgeWithFullWidthCells)
+{
+	using Quantizer = Epic::CurveQuantizer<float, 2, std::uint64_t>;
+
+	const Epic::Vector2f lo{ -1.f, -1.f };
+	const Epic::Vector2f hi{ 3.f, 5.f };
+	const Quantizer quantizer{ lo, hi };
+
+	static_assert(Quantizer::MaxCell == 0xFFFFFFFFu, "Expected full 32-bit cells");
+
+	EXPECT_EQ(quantizer.Quantize(hi[0], 0), Quantizer::MaxCell);
+	EXPECT_EQ(quantizer.Quantize(hi[1], 1), Quantizer::MaxCell);
+	EXPECT_EQ(quantizer.Quantize(lo[0], 0), 0u);
+	EXPECT_EQ(quantizer.Quantize(100.f, 0), Quantizer::MaxCell);
+	EXPECT_EQ(quantizer.Quantize(-100.f, 1), 0u);
+
+	const Epic::Vector2f points[] = { lo, Epic::Vector2f{ 1.f, 2.f }, hi };
+	std::uint64_t codes[3];
+	Epic::MortonEncode(quantizer, points, 3, codes);
+
+	EXPECT_LT(codes[0], codes[1]);
+	EXPECT_LT(codes[1], codes[2]);
+	EXPECT_EQ(codes[2], ~std::uint64_t(0));
+}
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Geometry/SpatialHashGrid.h>
+
+class SpatialHashGridTests : public testing::Test
+{
+protected:
+	static std::vector<Epic::Vector3f> MakePoints(size_t count, float extent)
+	{
+		std::mt19937 rng{ 1234u };
+		std::uniform_real_distribution<float> dist{ -extent, extent };
+
+		std::vector<Epic::Vector3f> points(count);
+
+		for (auto& p : points)
+			p = Epic::Vector3f{ dist(rng), dist(rng), dist(rng) };
+
+		return points;
+	}
+};
+
+TEST_F(SpatialHashGridTests, Build_StoresEveryPointOnce)
+{
+	const auto points = MakePoints(5000, 50.f);
+
+	Epic::SpatialHashGrid3f grid{ 2.f };
+	grid.Build(points);
+
+	auto indices = grid.Indices();
+	std::sort(std::begin(indices), std::end(indices));
+
+	ASSERT_EQ(indices.size(), points.size());
+
+	for (size_t i = 0; i < indices.size(); ++i)
+		EXPECT_EQ(indices[i], i);
+}
+
+TEST_F(SpatialHashGridTests, QueryRadius_MatchesBruteForce)
+{
+	const auto points = MakePoints(5000, 50.f);
+	const Epic::Vector3f center{ 3.f, -7.f, 11.f };
+	const float radius = 9.f;
+
+	Epic::SpatialHashGrid3f grid{ 2.f };
+	grid.Build(points);
+
+	std::vector<Epic::SpatialHashGrid3f::index_type> actual;
+	grid.QueryRadius(center, radius, actual);
+	std::sort(std::begin(actual), std::end(actual));
+
+	std::vector<Epic::SpatialHashGrid3f::index_type> expected;
+	for (size_t i = 0; i < points.size(); ++i)
+		if ((points[i] - center).MagnitudeSq() <= radius * radius)
+			expected.push_back(static_cast<Epic::SpatialHashGrid3f::index_type>(i));
+
+	EXPECT_EQ(actual, expected);
+}
+
+TEST_F(SpatialHashGridTests, QueryNearest_MatchesBruteForce)
+{
+	const auto points = MakePoints(5000, 50.f);
+	const Epic::Vector3f center{ -12.f, 4.f, 0.5f };
+	const size_t k = 16;
+
+	Epic::SpatialHashGrid3f grid{ 2.f };
+	grid.Build(points);
+
+	std::vector<Epic::SpatialHashGrid3f::index_type> actual;
+	ASSERT_EQ(grid.QueryNearest(center, k, 100.f, actual), k);
+
+	std::vector<std::pair<float, size_t>> expected;
+	for (size_t i = 0; i < points.size(); ++i)
+		expected.emplace_back((points[i] - center).MagnitudeSq(), i);
+
+	std::sort(std::begin(expected), std::end(expected));
+
+	for (size_t i = 0; i < k; ++i)
+		EXPECT_EQ(actual[i], expected[i].second);
+}
+
+TEST_F(SpatialHashGridTests, FindPairs_MatchesBruteForce)
+{
+	const auto points = MakePoints(3000, 20.f);
+	const float radius = 1.5f;
+
+	Epic::SpatialHashGrid3f grid{ radius };
+	grid.Build(points);
+
+	std::vector<Epic::SpatialHashGrid3f::pair_type> actual;
+	grid.FindPairs(radius, actual);
+
+	for (auto& pair : actual)
+		if (pair.first > pair.second) std::swap(pair.first, pair.second);
+
+	std::sort(std::begin(actual), std::end(actual));
+
+	std::vector<Epic::SpatialHashGrid3f::pair_type> expected;
+	for (size_t i = 0; i < points.size(); ++i)
+		for (size_t j = i + 1; j < points.size(); ++j)
+			if ((points[i] - points[j]).MagnitudeSq() <= radius * radius)
+				expected.emplace_back(static_cast<uint32_t>(i), static_cast<uint32_t>(j));
+
+	EXPECT_EQ(actual, expected);
+}
+
+TEST_F(SpatialHashGridTests, ForEachPair_VisitsEveryPairOnce)
+{
+	const auto points = MakePoints(20000, 40.f);
+	const float radius = 1.f;
+
+	Epic::SpatialHashGrid3f grid{ radius };
+	grid.Build(points);
+
+	std::vector<Epic::SpatialHashGrid3f::pair_type> expected;
+	grid.FindPairs(radius, expected);
+
+	std::atomic<size_t> count{ 0 };
+	std::atomic<std::uint64_t> checksum{ 0 };
+
+	grid.ForEachPair(radius, [&](std::uint32_t a, std::uint32_t b, float)
+	{
+		count.fetch_add(1, std::memory_order_relaxed);
+		checksum.fetch_add((std::uint64_t(std::min(a, b)) << 32) ^ std::max(a, b), std::memory_order_relaxed);
+	});
+
+	std::uint64_t expectedChecksum = 0;
+	for (const auto& pair : expected)
+		expectedChecksum += (std::uint64_t(std::min(pair.first, pair.second)) << 32) ^ std::max(pair.first, pair.second);
+
+	EXPECT_EQ(count.load(), expected.size());
+	EXPECT_EQ(checksum.load(), expectedChecksum);
+}
@@ -0,0 +1,212 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Geometry/SweptQueries.hpp>
+
+class SweptQueriesTests : public testing::Test
+{
+protected:
+	std::mt19937 m_Random{ 11u };
+
+	Epic::Vector3f RandomPoint(float extent)
+	{
+		std::uniform_real_distribution<float> uniform{ -extent, extent };
+
+		return Epic::Vector3f{ uniform(m_Random), uniform(m_Random), uniform(m_Random) };
+	}
+
+	// The first sampled time at which distance(t) falls to radius, or 2 if it never does
+	template<class Distance>
+	static float BruteForceTime(Distance distance, float radius)
+	{
+		constexpr int Steps = 20000;
+
+		for (int i = 0; i <= Steps; ++i)
+		{
+			const float t = float(i) / Steps;
+
+			if (distance(t) <= radius)
+				return t;
+		}
+
+		return 2.f;
+	}
+};
+
+TEST_F(SweptQueriesTests, SweepSphereTriangle_FaceEdgeAndVertex_ReturnsTimeAndNormal)
+{
+	const Epic::Vector3f a{ 0.f, 0.f, 0.f }, b{ 1.f, 0.f, 0.f }, c{ 0.f, 1.f, 0.f };
+
+	const auto face = Epic::SweepSphereTriangle(Epic::Vector3f{ 0.25f, 0.25f, 2.f }, 0.5f, Epic::Vector3f{ 0.f, 0.f, -4.f }, a, b, c);
+	ASSERT_TRUE(face.Hit);
+	EXPECT_NEAR(face.Time, 0.375f, 1e-6f);
+	EXPECT_NEAR(face.Normal[2], 1.f, 1e-6f);
+	EXPECT_NEAR(face.Point[0], 0.25f, 1e-6f);
+
+	// Moving along -y into the edge on the x axis from below the plane
+	const auto edge = Epic::SweepSphereTriangle(Epic::Vector3f{ 0.5f, -2.f, -0.3f }, 0.5f, Epic::Vector3f{ 0.f, 4.f, 0.f }, a, b, c);
+	ASSERT_TRUE(edge.Hit);
+	EXPECT_NEAR(edge.Time, (2.f - 0.4f) / 4.f, 1e-5f);
+	EXPECT_NEAR(edge.Point[1], 0.f, 1e-5f);
+	EXPECT_NEAR(edge.Normal[1], -0.8f, 1e-4f);
+	EXPECT_NEAR(edge.Normal[2], -0.6f, 1e-4f);
+
+	const auto vertex = Epic::SweepSphereTriangle(Epic::Vector3f{ -3.f, -3.f, 0.f }, 0.5f, Epic::Vector3f{ 4.f, 4.f, 0.f }, a, b, c);
+	ASSERT_TRUE(vertex.Hit);
+	EXPECT_NEAR(vertex.Point[0], 0.f, 1e-6f);
+	EXPECT_NEAR(vertex.Time, (3.f * std::sqrt(2.f) - 0.5f) / (4.f * std::sqrt(2.f)), 1e-5f);
+
+	// A fast sphere passing through a thin triangle between frames still hits it
+	const auto tunnel = Epic::SweepSphereTriangle(Epic::Vector3f{ 0.2f, 0.2f, 10.f }, 0.1f, Epic::Vector3f{ 0.f, 0.f, -20.f }, a, b, c);
+	EXPECT_TRUE(tunnel.Hit);
+
+	EXPECT_FALSE(Epic::SweepSphereTriangle(Epic::Vector3f{ 0.2f, 0.2f, 10.f }, 0.1f, Epic::Vector3f{ 0.f, 0.f, 5.f }, a, b, c).Hit);
+	EXPECT_FALSE(Epic::SweepSphereTriangle(Epic::Vector3f{ 0.25f, 0.25f, 2.f }, 0.5f, Epic::Vector3f{ 0.f, 0.f, -1.f }, a, b, c).Hit);
+
+	const auto overlap = Epic::SweepSphereTriangle(Epic::Vector3f{ 0.25f, 0.25f, 0.1f }, 0.5f, Epic::Vector3f{ 1.f, 0.f, 0.f }, a, b, c);
+	ASSERT_TRUE(overlap.Hit);
+	EXPECT_EQ(overlap.Time, 0.f);
+	EXPECT_NEAR(overlap.Normal[2], 1.f, 1e-6f);
+}
+
+TEST_F(SweptQueriesTests, SweepSphereTriangle_RandomSweeps_MatchesBruteForce)
+{
+	for (int n = 0; n < 100; ++n)
+	{
+		const Epic::Vector3f a = RandomPoint(1.f), b = RandomPoint(1.f), c = RandomPoint(1.f);
+		const Epic::Vector3f center = RandomPoint(3.f);
+		const Epic::Vector3f motion = -center * 2.f + RandomPoint(1.f);
+		const float radius = 0.3f;
+
+		const auto result = Epic::SweepSphereTriangle(center, radius, motion, a, b, c);
+		const float expected = BruteForceTime([&](float t)
+		{
+			const Epic::Vector3f p = center + motion * t;
+			return (Epic::ClosestPointOnTriangle(p, a, b, c) - p).Magnitude();
+		}, radius);
+
+		EXPECT_EQ(result.Hit, expected <= 1.f);
+
+		if (result.Hit && expected <= 1.f)
+		{
+			EXPECT_NEAR(result.Time, expected, 2e-4f);
+			EXPECT_NEAR(result.Normal.Magnitude(), 1.f, 1e-4f);
+		}
+	}
+}
+
+TEST_F(SweptQueriesTests, SweepAABB_MovingBox_ReturnsEntryFace)
+{
+	const Epic::AABBf target{ Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Vector3f{ 1.f, 1.f, 1.f } };
+	const Epic::AABBf box{ Epic::Vector3f{ -3.f, 0.25f, 0.25f }, Epic::Vector3f{ -2.f, 0.75f, 0.75f } };
+
+	const auto hit = Epic::SweepAABB(box, Epic::Vector3f{ 4.f, 0.f, 0.f }, target);
+	ASSERT_TRUE(hit.Hit);
+	EXPECT_NEAR(hit.Time, 0.5f, 1e-6f);
+	EXPECT_EQ(hit.Normal[0], -1.f);
+	EXPECT_EQ(hit.Point[0], 0.f);
+	EXPECT_NEAR(hit.Point[1], 0.5f, 1e-6f);
+
+	EXPECT_FALSE(Epic::SweepAABB(box, Epic::Vector3f{ 1.f, 0.f, 0.f }, target).Hit);
+	EXPECT_FALSE(Epic::SweepAABB(box, Epic::Vector3f{ 4.f, 2.f, 0.f }, target).Hit);
+	EXPECT_FALSE(Epic::SweepAABB(box, Epic::Vector3f{ -4.f, 0.f, 0.f }, target).Hit);
+
+	const Epic::AABBf inside{ Epic::Vector3f{ 0.1f, 0.4f, 0.4f }, Epic::Vector3f{ 0.3f, 0.6f, 0.6f } };
+	const auto overlap = Epic::SweepAABB(inside, Epic::Vector3f{ 0.f, 1.f, 0.f }, target);
+	ASSERT_TRUE(overlap.Hit);
+	EXPECT_EQ(overlap.Time, 0.f);
+	EXPECT_EQ(overlap.Normal[0], -1.f);
+}
+
+TEST_F(SweptQueriesTests, CapsuleCast_TrianglesAndSpheres_MatchesBruteForce)
+{
+	for (int n = 0; n < 60; ++n)
+	{
+		const Epic::Vector3f a = RandomPoint(1.f), b = RandomPoint(1.f), c = RandomPoint(1.f);
+		const Epic::Vector3f pointA = RandomPoint(3.f);
+		const Epic::Vector3f pointB = pointA + RandomPoint(1.f);
+		const Epic::Vector3f motion = -pointA * 2.f + RandomPoint(1.f);
+		const float radius = 0.25f;
+
+		const auto result = Epic::CapsuleCastTriangle(pointA, pointB, radius, motion, a, b, c);
+		const float expected = BruteForceTime([&](float t)
+		{
+			const Epic::Vector3f shift = motion * t;
+			return std::sqrt(Epic::ClosestPointsSegmentTriangle(pointA + shift, pointB + shift, a, b, c).DistanceSq);
+		}, radius);
+
+		EXPECT_EQ(result.Hit, expected <= 1.f);
+
+		if (result.Hit && expected <= 1.f)
+		{
+			EXPECT_NEAR(result.Time, expected, 1e-3f);
+			EXPECT_LE(result.Time, expected + 1e-4f);
+		}
+	}
+
+	// A capsule grazing a vertex converges slowly; running out of iterations must not miss the contact
+	const Epic::Vector3f grazeA{ -5.f, 0.2499f, -0.1f }, grazeB{ -5.f, 0.2499f, 0.1f };
+	const Epic::Vector3f grazeMotion{ 10.f, 0.f, 0.f };
+	const Epic::Vector3f vertex{ 0.f, 0.f, 0.f }, lowerA{ 0.f, -2.f, 1.f }, lowerB{ 0.f, -2.f, -1.f };
+
+	const auto graze = Epic::CapsuleCastTriangle(grazeA, grazeB, 0.25f, grazeMotion, vertex, lowerA, lowerB, 1.f, 3);
+	ASSERT_TRUE(graze.Hit);
+	EXPECT_GT(graze.Time, 0.48f);
+	EXPECT_LE(graze.Time, 0.5f - std::sqrt(0.25f * 0.25f - 0.2499f * 0.2499f) / 10.f + 1e-4f);
+
+	// A horizontal capsule dropping onto a sphere
+	const auto sphere = Epic::CapsuleCastSphere(Epic::Vector3f{ -1.f, 3.f, 0.f }, Epic::Vector3f{ 1.f, 3.f, 0.f }, 0.5f,
+		Epic::Vector3f{ 0.f, -4.f, 0.f }, Epic::Vector3f{ 0.5f, 0.f, 0.f }, 1.f);
+	ASSERT_TRUE(sphere.Hit);
+	EXPECT_NEAR(sphere.Time, 1.5f / 4.f, 1e-5f);
+	EXPECT_NEAR(sphere.Normal[1], 1.f, 1e-5f);
+	EXPECT_NEAR(sphere.Point[0], 0.5f, 1e-5f);
+	EXPECT_NEAR(sphere.Point[1], 1.f, 1e-5f);
+}
+
+TEST_F(SweptQueriesTests, BatchSweeps_CandidateLists_ReturnFirstHit)
+{
+	// A corridor of walls along x
+	std::vector<Epic::Vector3f> triangles;
+	std::vector<Epic::AABBf> boxes;
+
+	for (int i = 0; i < 8; ++i)
+	{
+		const float x = 2.f + float(i);
+
+		triangles.push_back(Epic::Vector3f{ x, -1.f, -1.f });
+		triangles.push_back(Epic::Vector3f{ x, 3.f, -1.f });
+		triangles.push_back(Epic::Vector3f{ x, -1.f, 3.f });
+
+		boxes.push_back(Epic::AABBf{ Epic::Vector3f{ x, -1.f, -1.f }, Epic::Vector3f{ x + 0.1f, 1.f, 1.f } });
+	}
+
+	const std::vector<std::uint32_t> candidates = { 6, 3, 5 };
+	const Epic::Vector3f motion{ 20.f, 0.f, 0.f };
+
+	const auto sphere = Epic::SweepSphereTriangles(Epic::Vector3f{ 0.f, 0.f, 0.f }, 0.5f, motion, triangles.data(), candidates.data(), candidates.size());
+	ASSERT_TRUE(sphere.Hit);
+	EXPECT_EQ(sphere.Index, 3u);
+	EXPECT_NEAR(sphere.Time, 4.5f / 20.f, 1e-6f);
+
+	const auto all = Epic::SweepSphereTriangles(Epic::Vector3f{ 0.f, 0.f, 0.f }, 0.5f, motion, triangles.data(), nullptr, triangles.size() / 3);
+	EXPECT_EQ(all.Index, 0u);
+
+	const auto capsule = Epic::CapsuleCastTriangles(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Vector3f{ 0.f, 1.f, 0.f }, 0.5f, motion,
+		triangles.data(), candidates.data(), candidates.size());
+	ASSERT_TRUE(capsule.Hit);
+	EXPECT_EQ(capsule.Index, 3u);
+	EXPECT_NEAR(capsule.Time, 4.5f / 20.f, 1e-4f);
+
+	const Epic::AABBf box{ Epic::Vector3f{ -0.5f, -0.5f, -0.5f }, Epic::Vector3f{ 0.5f, 0.5f, 0.5f } };
+	const auto boxHit = Epic::SweepAABBs(box, motion, boxes.data(), candidates.data(), candidates.size());
+	ASSERT_TRUE(boxHit.Hit);
+	EXPECT_EQ(boxHit.Index, 3u);
+	EXPECT_NEAR(boxHit.Time, 4.5f / 20.f, 1e-6f);
+
+	EXPECT_FALSE(Epic::SweepAABBs(box, Epic::Vector3f{ 0.f, 20.f, 0.f }, boxes.data(), candidates.data(), candidates.size()).Hit);
+}
@@ -0,0 +1,370 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Math/MatrixDecomposition.hpp>
+#include <Math/Quaternion.h>
+
+class MatrixDecompositionTests : public testing::Test
+{
+protected:
+	template<class T>
+	static Epic::Matrix<T, 3> RotationMatrix(T x, T y, T z, T angle)
+	{
+		return Epic::Matrix<T, 3>{ Epic::Quaternion<T>{ Epic::Vector<T, 3>{ x, y, z }.Normalize(), Epic::Radian<T>{ angle } } };
+	}
+
+	template<class T>
+	static Epic::Matrix<T, 3> Make3(const T(&values)[9])
+	{
+		Epic::Matrix<T, 3> result;
+
+		for (size_t k = 0; k < 9; ++k)
+			result.Values[k] = values[k];
+
+		return result;
+	}
+
+	template<class T, size_t N>
+	static T MaxDifference(const Epic::Matrix<T, N>& a, const Epic::Matrix<T, N>& b)
+	{
+		T result = T(0);
+
+		for (size_t k = 0; k < N * N; ++k)
+			result = std::max(result, std::abs(a.Values[k] - b.Values[k]));
+
+		return result;
+	}
+};
+
+TEST_F(MatrixDecompositionTests, Orthonormalize_DriftedRotation_RestoresRotation)
+{
+	const auto rotation = RotationMatrix(1.0, 2.0, -0.5, 1.3);
+
+	auto drifted = rotation;
+	drifted.Values[1] += 0.01;
+	drifted.Values[5] -= 0.02;
+	drifted.Values[6] *= 1.03;
+
+	drifted.Orthonormalize();
+
+	const auto identity = Epic::Matrix3d::TransposeOf(drifted) * drifted;
+
+	EXPECT_LT(MaxDifference(identity, Epic::Matrix3d{ Epic::Identity }), 1e-12);
+	EXPECT_NEAR(drifted.Determinant(), 1.0, 1e-12);
+	EXPECT_LT(MaxDifference(drifted, rotation), 0.05);
+}
+
+TEST_F(MatrixDecompositionTests, Orthonormalize_Matrix4_KeepsTranslation)
+{
+	Epic::Matrix4f mat{ Epic::Identity };
+	mat.Values = { 2.f, 0.1f, 0.f, 0.f, 0.f, 3.f, 0.f, 0.f, 0.f, 0.f, 0.5f, 0.f, 4.f, 5.f, 6.f, 1.f };
+
+	mat.Orthonormalize();
+
+	EXPECT_NEAR(mat.Values[0] * mat.Values[0] + mat.Values[1] * mat.Values[1] + mat.Values[2] * mat.Values[2], 1.f, 1e-6f);
+	EXPECT_NEAR(mat.Values[4] * mat.Values[0] + mat.Values[5] * mat.Values[1], 0.f, 1e-6f);
+	EXPECT_FLOAT_EQ(mat.Values[12], 4.f);
+	EXPECT_FLOAT_EQ(mat.Values[14], 6.f);
+	EXPECT_FLOAT_EQ(mat.Values[15], 1.f);
+}
+
+TEST_F(MatrixDecompositionTests, BatchOrthonormalize_RandomMatrices_MatchScalar)
+{
+	std::mt19937 rng{ 11u };
+	std::uniform_real_distribution<double> dist{ -2.0, 2.0 };
+
+	// More than one block, with a partial last block
+	std::vector<Epic::Matrix3d> matrices3(150);
+	std::vector<Epic::Matrix4d> matrices4(70);
+
+	for (auto& mat : matrices3)
+		for (auto& value : mat.Values)
+			value = dist(rng);
+
+	for (auto& mat : matrices4)
+		for (auto& value : mat.Values)
+			value = dist(rng);
+
+	auto batch3 = matrices3;
+	auto batch4 = matrices4;
+
+	Epic::BatchOrthonormalize(batch3.data(), batch3.size());
+	Epic::BatchOrthonormalize(batch4.data(), batch4.size());
+
+	for (size_t i = 0; i < matrices3.size(); ++i)
+		EXPECT_LT(MaxDifference(batch3[i], matrices3[i].Orthonormalize()), 1e-12);
+
+	for (size_t i = 0; i < matrices4.size(); ++i)
+		EXPECT_LT(MaxDifference(batch4[i], matrices4[i].Orthonormalize()), 1e-12);
+}
+
+TEST_F(MatrixDecompositionTests, PolarDecompose_RotationTimesStretch_RecoversFactors)
+{
+	const auto rotation = RotationMatrix(0.3, -1.0, 0.7, 2.1);
+	const auto stretch = Make3<double>({ 3.0, 0.4, -0.2, 0.4, 0.5, 0.1, -0.2, 0.1, 1.5 });
+
+	Epic::Matrix3d actualRotation, actualStretch;
+	const size_t iterations = Epic::PolarDecompose(rotation * stretch, actualRotation, actualStretch);
+
+	EXPECT_LT(iterations, 16u);
+	EXPECT_LT(MaxDifference(actualRotation, rotation), 1e-9);
+	EXPECT_LT(MaxDifference(actualStretch, stretch), 1e-9);
+}
+
+TEST_F(MatrixDecompositionTests, BatchPolarDecompose_RandomMatrices_MatchScalar)
+{
+	std::mt19937 rng{ 7u };
+	std::uniform_real_distribution<float> dist{ -1.f, 1.f };
+	std::uniform_real_distribution<float> scale{ 0.1f, 10.f };
+
+	std::vector<Epic::Matrix3f> matrices;
+
+	for (size_t i = 0; i < 150; ++i)
+	{
+		const auto rotation = RotationMatrix(dist(rng), dist(rng), dist(rng), dist(rng) * 3.f);
+		const float sign = (i % 10 == 0) ? -1.f : 1.f;
+		const auto stretch = Make3<float>({ scale(rng) * sign, 0.f, 0.f, 0.f, scale(rng), 0.f, 0.f, 0.f, scale(rng) });
+
+		matrices.push_back(rotation * stretch);
+	}
+
+	std::vector<Epic::Matrix3f> rotations(matrices.size());
+	std::vector<Epic::Matrix3f> stretches(matrices.size());
+
+	Epic::BatchPolarDecompose(matrices.data(), rotations.data(), stretches.data(), matrices.size());
+
+	for (size_t i = 0; i < matrices.size(); ++i)
+	{
+		Epic::Matrix3f rotation, stretch;
+		Epic::PolarDecompose(matrices[i], rotation, stretch);
+
+		EXPECT_LT(MaxDifference(rotations[i], rotation), 1e-4f);
+		EXPECT_LT(MaxDifference(rotations[i] * stretches[i], matrices[i]), 1e-3f);
+		EXPECT_NEAR(rotations[i].Determinant(), 1.f, 1e-4f);
+	}
+}
+
+TEST_F(MatrixDecompositionTests, SymmetricEigen_Symmetric_ReconstructsSortedRotation)
+{
+	const auto basis = RotationMatrix(0.2, 1.0, -0.4, 0.9);
+	const auto diagonal = Make3<double>({ 2.0, 0.0, 0.0, 0.0, -1.0, 0.0, 0.0, 0.0, 5.0 });
+	const auto mat = basis * diagonal * Epic::Matrix3d::TransposeOf(basis);
+
+	Epic::Vector3d eigenvalues;
+	Epic::Matrix3d eigenvectors;
+	const size_t sweeps = Epic::SymmetricEigen(mat, eigenvalues, eigenvectors);
+
+	EXPECT_LE(sweeps, 6u);
+	EXPECT_NEAR(eigenvalues[0], 5.0, 1e-9);
+	EXPECT_NEAR(eigenvalues[1], 2.0, 1e-9);
+	EXPECT_NEAR(eigenvalues[2], -1.0, 1e-9);
+	EXPECT_NEAR(eigenvectors.Determinant(), 1.0, 1e-9);
+
+	const auto values = Make3<double>({ eigenvalues[0], 0.0, 0.0, 0.0, eigenvalues[1], 0.0, 0.0, 0.0, eigenvalues[2] });
+	EXPECT_LT(MaxDifference(eigenvectors * values * Epic::Matrix3d::TransposeOf(eigenvectors), mat), 1e-9);
+}
+
+TEST_F(MatrixDecompositionTests, SingularValueDecompose_GeneralMatrices_Reconstruct)
+{
+	const Epic::Matrix3d matrices[] =
+	{
+		Make3<double>({ 1.0, 2.0, 3.0, -4.0, 0.5, 6.0, 0.7, -8.0, 9.0 }),
+		Make3<double>({ -1.0, 0.0, 0.0, 0.0, 2.0, 0.0, 0.0, 0.0, 3.0 }),
+		Make3<double>({ 1.0, 2.0, 3.0, 2.0, 4.0, 6.0, 0.0, 0.0, 0.0 }),
+		Make3<double>({ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 })
+	};
+
+	for (const auto& mat : matrices)
+	{
+		Epic::Matrix3d u, v;
+		Epic::Vector3d sigma;
+		Epic::SingularValueDecompose(mat, u, sigma, v);
+
+		const auto diagonal = Make3<double>({ sigma[0], 0.0, 0.0, 0.0, sigma[1], 0.0, 0.0, 0.0, sigma[2] });
+
+		EXPECT_LT(MaxDifference(u * diagonal * Epic::Matrix3d::TransposeOf(v), mat), 1e-9);
+		EXPECT_NEAR(u.Determinant(), 1.0, 1e-9);
+		EXPECT_NEAR(v.Determinant(), 1.0, 1e-9);
+		EXPECT_GE(sigma[0], std::abs(sigma[1]));
+		EXPECT_GE(sigma[1], std::abs(sigma[2]) - 1e-12);
+		EXPECT_EQ(sigma[2] < -1e-12, mat.Determinant() < -1e-12);
+	}
+}
+
+TEST_F(MatrixDecompositionTests, BatchSingularValueDecompose_RandomMatrices_MatchScalar)
+{
+	std::mt19937 rng{ 11u };
+	std::uniform_real_distribution<float> dist{ -2.f, 2.f };
+
+	std::vector<Epic::Matrix3f> matrices(100);
+	for (auto& mat : matrices)
+		for (auto& value : mat.Values)
+			value = dist(rng);
+
+	std::vector<Epic::Matrix3f> us(matrices.size()), vs(matrices.size());
+	std::vector<Epic::Vector3f> sigmas(matrices.size());
+
+	Epic::BatchSingularValueDecompose(matrices.data(), us.data(), sigmas.data(), vs.data(), matrices.size());
+
+	std::vector<Epic::Matrix3f> symmetric(matrices.size());
+	std::vector<Epic::Matrix3f> eigenvectors(matrices.size());
+	std::vector<Epic::Vector3f> eigenvalues(matrices.size());
+
+	for (size_t i = 0; i < matrices.size(); ++i)
+		symmetric[i] = Epic::Matrix3f::TransposeOf(matrices[i]) * matrices[i];
+
+	Epic::BatchSymmetricEigen(symmetric.data(), eigenvalues.data(), eigenvectors.data(), symmetric.size());
+
+	for (size_t i = 0; i < matrices.size(); ++i)
+	{
+		Epic::Matrix3f u, v;
+		Epic::Vector3f sigma;
+		Epic::SingularValueDecompose(matrices[i], u, sigma, v);
+
+		const auto diagonal = Make3<float>({ sigmas[i][0], 0.f, 0.f, 0.f, sigmas[i][1], 0.f, 0.f, 0.f, sigmas[i][2] });
+
+		EXPECT_LT(MaxDifference(us[i] * diagonal * Epic::Matrix3f::TransposeOf(vs[i]), matrices[i]), 1e-4f);
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			EXPECT_NEAR(sigmas[i][k], sigma[k], 1e-4f);
+			EXPECT_NEAR(eigenvalues[i][k], sigma[k] * sigma[k], 1e-3f);
+		}
+	}
+}
+
+TEST_F(MatrixDecompositionTests, Decompose_TRSMatrix_RecoversComponents)
+{
+	const Epic::Vector3f translations[] = { { 1.f, -2.f, 3.f }, { 0.f, 0.f, 0.f }, { -50.f, 10.f, 0.25f } };
+	const Epic::Vector3f scales[] = { { 1.f, 1.f, 1.f }, { 2.f, 0.5f, 3.f }, { -1.5f, 2.f, 0.75f } };
+	const Epic::Quaternionf rotations[] =
+	{
+		Epic::Identity,
+		{ Epic::Vector3f{ 1.f, 2.f, 3.f }.Normalize(), Epic::Radian<float>{ 0.7f } },
+		{ Epic::Vector3f{ 1.f, -1.f, 0.f }.Normalize(), Epic::Radian<float>{ 3.14159265f } },
+		{ Epic::Vector3f{ 0.f, 0.f, 1.f }, Epic::Radian<float>{ -2.5f } }
+	};
+
+	for (const auto& expectedTranslation : translations)
+	{
+		for (const auto& expectedScale : scales)
+		{
+			for (const auto& expectedRotation : rotations)
+			{
+				Epic::Matrix4f mat;
+				mat.MakeTRS(expectedTranslation, expectedRotation, expectedScale);
+
+				Epic::Vector3f translation, scale;
+				Epic::Quaternionf rotation;
+				Epic::Decompose(mat, translation, rotation, scale);
+
+				float dot = 0.f;
+				for (size_t k = 0; k < 4; ++k)
+					dot += rotation.Values[k] * expectedRotation.Values[k];
+
+				EXPECT_NEAR(std::abs(dot), 1.f, 1e-5f);
+				EXPECT_GE(rotation.w, 0.f);
+
+				for (size_t k = 0; k < 3; ++k)
+				{
+					EXPECT_NEAR(translation[k], expectedTranslation[k], 1e-5f);
+					EXPECT_NEAR(scale[k], expectedScale[k], 1e-5f);
+				}
+			}
+		}
+	}
+}
+
+TEST_F(MatrixDecompositionTests, Decompose_MirroredMatrix_RecomposesWithNegativeXScale)
+{
+	const Epic::Quaternionf expectedRotation{ Epic::Vector3f{ -2.f, 1.f, 0.5f }.Normalize(), Epic::Radian<float>{ 1.2f } };
+
+	Epic::Matrix4f mat;
+	mat.MakeTRS(Epic::Vector3f{ 4.f, 5.f, 6.f }, expectedRotation, Epic::Vector3f{ 2.f, -3.f, 1.f });
+
+	Epic::Vector3f translation, scale;
+	Epic::Quaternionf rotation;
+	Epic::Decompose(mat, translation, rotation, scale);
+
+	EXPECT_LT(scale[0], 0.f);
+	EXPECT_GT(scale[1], 0.f);
+	EXPECT_GT(scale[2], 0.f);
+
+	Epic::Matrix4f recomposed;
+	recomposed.MakeTRS(translation, rotation, scale);
+
+	EXPECT_LT(MaxDifference(recomposed, mat), 1e-5f);
+}
+
+TEST_F(MatrixDecompositionTests, BatchDecompose_RandomMatrices_MatchScalar)
+{
+	std::mt19937 rng{ 37 };
+	std::uniform_real_distribution<float> unit{ -1.f, 1.f };
+	std::uniform_real_distribution<float> angle{ -3.14159265f, 3.14159265f };
+
+	std::vector<Epic::Matrix4f> matrices(200);
+
+	for (auto& mat : matrices)
+	{
+		const Epic::Quaternionf rotation{ Epic::Vector3f{ unit(rng), unit(rng), unit(rng) + 2.f }.Normalize(), Epic::Radian<float>{ angle(rng) } };
+		const Epic::Vector3f scale{ 2.f * unit(rng) + 2.5f * (unit(rng) < 0.f ? -1.f : 1.f), unit(rng) + 1.5f, unit(rng) + 1.5f };
+
+		mat.MakeTRS(Epic::Vector3f{ 10.f * unit(rng), 10.f * unit(rng), 10.f * unit(rng) }, rotation, scale);
+	}
+
+	std::vector<Epic::Vector3f> translations(matrices.size()), scales(matrices.size());
+	std::vector<Epic::Quaternionf> rotations(matrices.size());
+
+	Epic::BatchDecompose(matrices.data(), translations.data(), rotations.data(), scales.data(), matrices.size());
+
+	for (size_t i = 0; i < matrices.size(); ++i)
+	{
+		Epic::Vector3f translation, scale;
+		Epic::Quaternionf rotation;
+		Epic::Decompose(matrices[i], translation, rotation, scale);
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			EXPECT_EQ(translations[i][k], translation[k]);
+			EXPECT_EQ(scales[i][k], scale[k]);
+		}
+
+		for (size_t k = 0; k < 4; ++k)
+			EXPECT_EQ(rotations[i].Values[k], rotation.Values[k]);
+
+		Epic::Matrix4f recomposed;
+		recomposed.MakeTRS(translations[i], rotations[i], scales[i]);
+
+		EXPECT_LT(MaxDifference(recomposed, matrices[i]), 1e-4f);
+	}
+}
+
+TEST_F(MatrixDecompositionTests, ToQuaternion_RotationMatrices_MatchSource)
+{
+	const Epic::Quaternionf rotations[] =
+	{
+		{ Epic::Vector3f{ 0.f, 1.f, 0.f }, Epic::Radian<float>{ 0.5f } },
+		{ Epic::Vector3f{ 3.f, -1.f, 0.5f }.Normalize(), Epic::Radian<float>{ 2.8f } },
+		{ Epic::Vector3f{ -0.5f, 3.f, 1.f }.Normalize(), Epic::Radian<float>{ 2.8f } },
+		{ Epic::Vector3f{ 0.5f, 1.f, -3.f }.Normalize(), Epic::Radian<float>{ 2.8f } }
+	};
+
+	for (const auto& expected : rotations)
+	{
+		const auto actual3 = Epic::Matrix3f{ expected }.ToQuaternion();
+		const auto actual4 = Epic::Matrix4f{ expected }.ToQuaternion();
+
+		float dot3 = 0.f, dot4 = 0.f;
+		for (size_t k = 0; k < 4; ++k)
+		{
+			dot3 += actual3.Values[k] * expected.Values[k];
+			dot4 += actual4.Values[k] * expected.Values[k];
+		}
+
+		EXPECT_NEAR(std::abs(dot3), 1.f, 1e-5f);
+		EXPECT_NEAR(std::abs(dot4), 1.f, 1e-5f);
+	}
+}
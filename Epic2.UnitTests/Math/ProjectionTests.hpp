@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <Math/Projection.hpp>
+
+class ProjectionTests : public testing::Test
+{
+protected:
+	// The NDC depth of a point at view distance d along the -z axis
+	template<class T>
+	static T DepthOf(const Epic::Matrix<T, 4>& projection, T d)
+	{
+		const auto clip = projection * Epic::Vector<T, 4>{ T(0), T(0), -d, T(1) };
+
+		return clip[2] / clip[3];
+	}
+
+	template<class T>
+	static T MaxDifference(const Epic::Matrix<T, 4>& a, const Epic::Matrix<T, 4>& b)
+	{
+		T result = T(0);
+
+		for (size_t k = 0; k < 16; ++k)
+			result = std::max(result, std::abs(a.Values[k] - b.Values[k]));
+
+		return result;
+	}
+};
+
+TEST_F(ProjectionTests, MakePerspective_Variants_MapNearAndFar)
+{
+	const Epic::Degreed fovy{ 70.0 };
+
+	const auto standard = Epic::MakePerspective(fovy, 1.5, 0.1, 1000.0);
+	EXPECT_LT(MaxDifference(standard, Epic::CreatePerspectiveMatrix(fovy, 1.5, 0.1, 1000.0)), 1e-12);
+	EXPECT_NEAR(DepthOf(standard, 0.1), -1.0, 1e-9);
+	EXPECT_NEAR(DepthOf(standard, 1000.0), 1.0, 1e-9);
+
+	const auto reversed = Epic::MakePerspectiveReversedZ(fovy, 1.5, 0.1, 1000.0);
+	EXPECT_NEAR(DepthOf(reversed, 0.1), 1.0, 1e-12);
+	EXPECT_NEAR(DepthOf(reversed, 1000.0), 0.0, 1e-12);
+	EXPECT_GT(DepthOf(reversed, 10.0), DepthOf(reversed, 11.0));
+
+	const auto infinite = Epic::MakePerspectiveInfinite(fovy, 1.5, 0.1);
+	EXPECT_NEAR(DepthOf(infinite, 0.1), -1.0, 1e-12);
+	EXPECT_NEAR(DepthOf(infinite, 1e9), 1.0, 1e-9);
+
+	const auto infiniteReversed = Epic::MakePerspectiveInfiniteReversedZ(fovy, 1.5, 0.1);
+	EXPECT_NEAR(DepthOf(infiniteReversed, 0.1), 1.0, 1e-12);
+	EXPECT_NEAR(DepthOf(infiniteReversed, 1e9), 0.0, 1e-9);
+	EXPECT_NEAR(DepthOf(infiniteReversed, 50.0), 0.1 / 50.0, 1e-12);
+
+	// The edge of the field of view maps to the edge of NDC
+	const double edge = std::tan(35.0 * 3.14159265358979323846 / 180.0) * 10.0;
+	const auto clip = reversed * Epic::Vector4d{ edge * 1.5, edge, -10.0, 1.0 };
+	EXPECT_NEAR(clip[0] / clip[3], 1.0, 1e-9);
+	EXPECT_NEAR(clip[1] / clip[3], 1.0, 1e-9);
+}
+
+TEST_F(ProjectionTests, ReversedZ_FloatDepth_KeepsPrecisionAtDistance)
+{
+	// Neighbouring distances far from the camera stay distinct in float with reversed-Z, but not without it
+	const auto standard = Epic::MakePerspective(Epic::Degreef(60.f), 1.f, 0.1f, 10000.f);
+	const auto reversed = Epic::MakePerspectiveReversedZ(Epic::Degreef(60.f), 1.f, 0.1f, 10000.f);
+
+	size_t standardDistinct = 0, reversedDistinct = 0;
+
+	for (float d = 5000.f; d < 5100.f; d += 1.f)
+	{
+		standardDistinct += DepthOf(standard, d) != DepthOf(standard, d + 1.f) ? 1 : 0;
+		reversedDistinct += DepthOf(reversed, d) != DepthOf(reversed, d + 1.f) ? 1 : 0;
+	}
+
+	EXPECT_EQ(reversedDistinct, 100u);
+	EXPECT_LT(standardDistinct, 50u);
+}
+
+TEST_F(ProjectionTests, MakeOrthographic_Variants_MapTheBox)
+{
+	const auto standard = Epic::MakeOrthographic(-4.0, 8.0, 3.0, -1.0, 2.0, 50.0);
+	EXPECT_LT(MaxDifference(standard, Epic::CreateOrthoMatrix(-4.0, 8.0, 3.0, -1.0, 2.0, 50.0)), 1e-12);
+
+	const auto reversed = Epic::MakeOrthographicReversedZ(-4.0, 8.0, 3.0, -1.0, 2.0, 50.0);
+	const auto lo = reversed * Epic::Vector4d{ -4.0, -1.0, -2.0, 1.0 };
+	const auto hi = reversed * Epic::Vector4d{ 8.0, 3.0, -50.0, 1.0 };
+
+	EXPECT_NEAR(lo[0], -1.0, 1e-12);
+	EXPECT_NEAR(lo[1], -1.0, 1e-12);
+	EXPECT_NEAR(lo[2], 1.0, 1e-12);
+	EXPECT_NEAR(hi[0], 1.0, 1e-12);
+	EXPECT_NEAR(hi[1], 1.0, 1e-12);
+	EXPECT_NEAR(hi[2], 0.0, 1e-12);
+}
+
+TEST_F(ProjectionTests, InverseOf_Projections_MatchGeneralInverse)
+{
+	const Epic::Degreed fovy{ 55.0 };
+	const Epic::Matrix4d identity = Epic::Identity;
+
+	for (const auto& projection : {
+		Epic::MakePerspective(fovy, 1.8, 0.3, 300.0),
+		Epic::MakePerspectiveInfinite(fovy, 1.8, 0.3),
+		Epic::MakePerspectiveReversedZ(fovy, 1.8, 0.3, 300.0),
+		Epic::MakePerspectiveInfiniteReversedZ(fovy, 1.8, 0.3),
+		Epic::CreateFrustumMatrix(-0.2, 0.5, 0.4, -0.1, 0.3, 300.0) })
+	{
+		const auto inverse = Epic::PerspectiveInverseOf(projection);
+
+		EXPECT_LT(MaxDifference(inverse * projection, identity), 1e-9);
+		EXPECT_LT(MaxDifference(projection * inverse, identity), 1e-9);
+	}
+
+	for (const auto& projection : {
+		Epic::MakeOrthographic(-4.0, 8.0, 3.0, -1.0, 2.0, 50.0),
+		Epic::MakeOrthographicReversedZ(-4.0, 8.0, 3.0, -1.0, 2.0, 50.0) })
+	{
+		const auto inverse = Epic::OrthographicInverseOf(projection);
+
+		EXPECT_LT(MaxDifference(inverse * projection, identity), 1e-12);
+		EXPECT_LT(MaxDifference(inverse, Epic::Matrix4d::InverseOf(projection)), 1e-12);
+	}
+}
+
+TEST_F(ProjectionTests, MakeCubeFaceViewProjections_Directions_LandOnTheirFace)
+{
+	const Epic::Vector3f position{ 3.f, -2.f, 7.f };
+	const auto projection = Epic::MakePerspectiveReversedZ(Epic::Degreef(90.f), 1.f, 0.05f, 100.f);
+
+	Epic::Matrix4f faces[6];
+	Epic::MakeCubeFaceViewProjections(position, projection, faces);
+
+	// The OpenGL face orientations: the +X face has -Y up and -Z to the right
+	const auto right = faces[0] * Epic::Vector4f{ position[0] + 5.f, position[1], position[2] - 1.f, 1.f };
+	const auto up = faces[0] * Epic::Vector4f{ position[0] + 5.f, position[1] - 1.f, position[2], 1.f };
+
+	EXPECT_NEAR(right[0] / right[3], 0.2f, 1e-5f);
+	EXPECT_NEAR(right[1] / right[3], 0.f, 1e-5f);
+	EXPECT_NEAR(up[1] / up[3], 0.2f, 1e-5f);
+
+	std::mt19937 random{ 3u };
+	std::uniform_real_distribution<float> unit{ -1.f, 1.f };
+
+	for (int n = 0; n < 500; ++n)
+	{
+		const Epic::Vector3f direction{ unit(random), unit(random), unit(random) };
+
+		size_t major = 0;
+		for (size_t k = 1; k < 3; ++k)
+		{
+			if (std::abs(direction[k]) > std::abs(direction[major]))
+				major = k;
+		}
+
+		const size_t face = 2 * major + (direction[major] < 0.f ? 1 : 0);
+		const Epic::Vector3f point = position + direction * 10.f;
+
+		for (size_t f = 0; f < 6; ++f)
+		{
+			const auto clip = faces[f] * Epic::Vector4f{ point[0], point[1], point[2], 1.f };
+			const bool inside = clip[3] > 0.f && std::abs(clip[0]) <= clip[3] && std::abs(clip[1]) <= clip[3];
+
+			EXPECT_EQ(inside, f == face) << "face " << f;
+
+			if (f == face)
+			{
+				EXPECT_NEAR(clip[3], std::abs(direction[major]) * 10.f, 1e-4f);
+			}
+		}
+	}
+}
@@ -0,0 +1,145 @@
+#include <array>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Math/Quaternion.h>
+#include <Math/QuaternionBatch.hpp>
+
+class QuaternionBatchTests : public testing::Test
+{
+protected:
+	struct Arrays
+	{
+		std::array<std::vector<float>, 4> Components;
+
+		explicit Arrays(size_t count)
+		{
+			for (auto& c : Components)
+				c.resize(count);
+		}
+
+		std::array<const float*, 4> In() const
+		{
+			return { Components[0].data(), Components[1].data(), Components[2].data(), Components[3].data() };
+		}
+
+		std::array<float*, 4> Out()
+		{
+			return { Components[0].data(), Components[1].data(), Components[2].data(), Components[3].data() };
+		}
+
+		Epic::Quaternionf At(size_t i) const
+		{
+			const float values[4] = { Components[0][i], Components[1][i], Components[2][i], Components[3][i] };
+			return Epic::Quaternionf{ values };
+		}
+	};
+
+	static Arrays MakeRotations(size_t count, unsigned seed)
+	{
+		std::mt19937 rng{ seed };
+		std::uniform_real_distribution<float> dist{ -1.f, 1.f };
+
+		Arrays result{ count };
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Epic::Vector3f axis = Epic::Vector3f{ dist(rng), dist(rng), dist(rng) + 2.f }.Normalize();
+			const Epic::Quaternionf q{ axis, Epic::Radianf{ dist(rng) * 3.f } };
+
+			for (size_t c = 0; c < 4; ++c)
+				result.Components[c][i] = q.Values[c];
+		}
+
+		return result;
+	}
+
+	static void ExpectNear(const Epic::Quaternionf& actual, const Epic::Quaternionf& expected, float tolerance)
+	{
+		for (size_t c = 0; c < 4; ++c)
+			EXPECT_NEAR(actual.Values[c], expected.Values[c], tolerance);
+	}
+};
+
+TEST_F(QuaternionBatchTests, BatchNlerp_MatchesLerp)
+{
+	const size_t count = 256;
+	const auto from = MakeRotations(count, 1u);
+	const auto to = MakeRotations(count, 2u);
+
+	Arrays result{ count };
+	Epic::BatchNlerp(from.In(), to.In(), 0.3f, result.Out(), count);
+
+	for (size_t i = 0; i < count; ++i)
+		ExpectNear(result.At(i), Epic::Quaternionf::Lerp(from.At(i), to.At(i), 0.3f), 1e-5f);
+}
+
+TEST_F(QuaternionBatchTests, BatchSlerp_MatchesSlerp)
+{
+	const size_t count = 256;
+	const auto from = MakeRotations(count, 3u);
+	const auto to = MakeRotations(count, 4u);
+
+	std::vector<float> t(count);
+	for (size_t i = 0; i < count; ++i)
+		t[i] = float(i) / float(count - 1);
+
+	Arrays result{ count };
+	Epic::BatchSlerp(from.In(), to.In(), t.data(), result.Out(), count);
+
+	for (size_t i = 0; i < count; ++i)
+		ExpectNear(result.At(i), Epic::Quaternionf::Slerp(from.At(i), to.At(i), t[i]), 1e-5f);
+}
+
+TEST_F(QuaternionBatchTests, BatchSlerp_NearlyParallel_MatchesSlerp)
+{
+	const size_t count = 64;
+	const auto from = MakeRotations(count, 5u);
+
+	// Rotate each quaternion by a tiny angle
+	Arrays to{ count };
+	for (size_t i = 0; i < count; ++i)
+	{
+		const Epic::Quaternionf delta{ Epic::Vector3f{ 0.f, 1.f, 0.f }, Epic::Radianf{ 1e-3f * float(i % 8) } };
+		const auto q = Epic::Quaternionf::ConcatenationOf(from.At(i), delta);
+
+		for (size_t c = 0; c < 4; ++c)
+			to.Components[c][i] = q.Values[c];
+	}
+
+	Arrays result{ count };
+	Epic::BatchSlerp(from.In(), to.In(), 0.5f, result.Out(), count);
+
+	for (size_t i = 0; i < count; ++i)
+		ExpectNear(result.At(i), Epic::Quaternionf::Slerp(from.At(i), to.At(i), 0.5f), 1e-5f);
+}
+
+TEST_F(QuaternionBatchTests, BatchSquad_InPlace_MatchesSquad)
+{
+	const size_t count = 128;
+	const auto from = MakeRotations(count, 6u);
+	const auto to = MakeRotations(count, 7u);
+	const auto a = MakeRotations(count, 8u);
+	const auto b = MakeRotations(count, 9u);
+
+	Arrays result = from;
+	Epic::BatchSquad(result.In(), to.In(), a.In(), b.In(), 0.7f, result.Out(), count);
+
+	for (size_t i = 0; i < count; ++i)
+		ExpectNear(result.At(i), Epic::Quaternionf::Squad(from.At(i), to.At(i), a.At(i), b.At(i), 0.7f), 1e-4f);
+}
+
+TEST_F(QuaternionBatchTests, BatchSlerpFast_MatchesSlerpFast)
+{
+	const size_t count = 256;
+	const auto from = MakeRotations(count, 10u);
+	const auto to = MakeRotations(count, 11u);
+
+	Arrays result{ count };
+	Epic::BatchSlerpFast(from.In(), to.In(), 0.25f, result.Out(), count);
+
+	for (size_t i = 0; i < count; ++i)
+		ExpectNear(result.At(i), Epic::Quaternionf::SlerpFast(from.At(i), to.At(i), 0.25f), 1e-6f);
+}
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <Math/Quaternion.h>
+
+class QuaternionTests : public testing::Test
+{
+protected:
+	// The angle of the rotation that takes a to b
+	static double AngleBetween(const Epic::Quaterniond& a, const Epic::Quaterniond& b)
+	{
+		const double dot = std::abs(a.Dot(b));
+		return 2.0 * std::acos(std::min(dot, 1.0));
+	}
+
+	static Epic::Quaterniond Negated(const Epic::Quaterniond& q)
+	{
+		const double values[4] = { -q.x, -q.y, -q.z, -q.w };
+		return Epic::Quaterniond{ values };
+	}
+};
+
+TEST_F(QuaternionTests, SlerpFast_Endpoints_MatchInputs)
+{
+	const Epic::Quaterniond from{ Epic::Vector3d{ 0.0, 1.0, 0.0 }, Epic::Radiand{ 0.4 } };
+	const Epic::Quaterniond to{ Epic::Vector3d{ 1.0, 0.0, 0.0 }, Epic::Radiand{ 2.5 } };
+
+	EXPECT_NEAR(AngleBetween(Epic::Quaterniond::SlerpFast(from, to, 0.0), from), 0.0, 1e-6);
+	EXPECT_NEAR(AngleBetween(Epic::Quaterniond::SlerpFast(from, to, 1.0), to), 0.0, 1e-6);
+}
+
+TEST_F(QuaternionTests, SlerpFast_AngleSweep_WithinDocumentedError)
+{
+	std::mt19937 rng{ 1234u };
+	std::uniform_real_distribution<double> dist{ -1.0, 1.0 };
+
+	double maxError = 0.0;
+
+	for (size_t pair = 0; pair < 64; ++pair)
+	{
+		const Epic::Vector3d axisA = Epic::Vector3d{ dist(rng), dist(rng), dist(rng) + 2.0 }.Normalize();
+		const Epic::Vector3d axisB = Epic::Vector3d{ dist(rng) + 2.0, dist(rng), dist(rng) }.Normalize();
+		const Epic::Quaterniond from{ axisA, Epic::Radiand{ dist(rng) * 3.0 } };
+
+		// Sweep the relative rotation through a full turn, covering both signs of the dot product
+		for (size_t step = 0; step <= 64; ++step)
+		{
+			const Epic::Quaterniond delta{ axisB, Epic::Radiand{ Epic::TwoPi<double> * double(step) / 64.0 } };
+			const auto to = Epic::Quaterniond::ConcatenationOf(from, delta);
+			const auto nearTo = (from.Dot(to) < 0.0) ? Negated(to) : to;
+
+			for (size_t i = 0; i <= 32; ++i)
+			{
+				const double t = double(i) / 32.0;
+
+				const auto expected = Epic::Quaterniond::Slerp(from, nearTo, t);
+				const auto actual = Epic::Quaterniond::SlerpFast(from, to, t);
+
+				maxError = std::max(maxError, AngleBetween(actual, expected));
+			}
+		}
+	}
+
+	EXPECT_LE(maxError, 8e-4);
+}
+
+TEST_F(QuaternionTests, SlerpFast_OutperformsLerp)
+{
+	const Epic::Quaterniond from{ Epic::Vector3d{ 0.0, 0.0, 1.0 }, Epic::Radiand{ 0.0 } };
+	const Epic::Quaterniond to{ Epic::Vector3d{ 0.0, 0.0, 1.0 }, Epic::Radiand{ 2.0 } };
+
+	for (size_t i = 1; i < 8; ++i)
+	{
+		const double t = double(i) / 8.0;
+		const auto expected = Epic::Quaterniond::Slerp(from, to, t);
+
+		EXPECT_LT(AngleBetween(Epic::Quaterniond::SlerpFast(from, to, t), expected),
+			AngleBetween(Epic::Quaterniond::Lerp(from, to, t), expected) + 1e-12);
+	}
+}
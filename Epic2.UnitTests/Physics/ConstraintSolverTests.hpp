@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <Physics/ConstraintSolver.h>
+
+class ConstraintSolverTests : public testing::Test
+{
+protected:
+	using BodySet = Epic::RigidBodySetf;
+	using Solver = Epic::ConstraintSolverf;
+	using body_type = BodySet::body_type;
+
+	static constexpr float Dt = 1.f / 60.f;
+
+	// A unit cube of mass 1
+	static body_type CreateBox(BodySet& bodies, const Epic::Vector3f& position)
+	{
+		return bodies.Create(position, Epic::Quaternionf{ Epic::Identity }, 1.f, Epic::Vector3f{ 1.f / 6.f, 1.f / 6.f, 1.f / 6.f });
+	}
+
+	// Adds contacts between the ground plane y = 0 and the bottom corners of an axis aligned box
+	static void AddGroundContacts(Solver& solver, const BodySet& bodies, body_type ground, body_type box, float friction)
+	{
+		const auto position = bodies.Position(box);
+		const float depth = std::max(0.5f - position[1], 0.f);
+
+		for (size_t corner = 0; corner < 4; ++corner)
+		{
+			const Epic::Vector3f point{ position[0] + ((corner & 1) ? 0.5f : -0.5f), 0.f, position[2] + ((corner & 2) ? 0.5f : -0.5f) };
+			const Solver::key_type key = (Solver::key_type(box) << 8) | (corner + 1);
+
+			solver.AddContact(ground, box, point, Epic::Vector3f{ 0.f, 1.f, 0.f }, depth, friction, key);
+		}
+	}
+
+	template<class AddConstraints>
+	static void Step(BodySet& bodies, Solver& solver, AddConstraints addConstraints)
+	{
+		bodies.IntegrateVelocities(Dt, Epic::Vector3f{ 0.f, -10.f, 0.f });
+		addConstraints();
+		solver.Solve(bodies, Dt);
+		bodies.IntegratePositions(Dt);
+	}
+};
+
+TEST_F(ConstraintSolverTests, Solve_RestingBox_StaysOnGround)
+{
+	BodySet bodies;
+	Solver solver;
+
+	const auto ground = bodies.Create(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Quaternionf{ Epic::Identity });
+	const auto box = CreateBox(bodies, Epic::Vector3f{ 0.f, 0.5f, 0.f });
+
+	for (size_t n = 0; n < 120; ++n)
+		Step(bodies, solver, [&] { AddGroundContacts(solver, bodies, ground, box, 0.5f); });
+
+	EXPECT_NEAR(bodies.Position(box)[1], 0.5f, 0.01f);
+	EXPECT_NEAR(bodies.LinearVelocity(box)[1], 0.f, 0.05f);
+	EXPECT_NEAR(bodies.Orientation(box).w, 1.f, 1e-4f);
+	EXPECT_EQ(solver.ContactCount(), 0u);
+}
+
+TEST_F(ConstraintSolverTests, Solve_SlidingBox_DeceleratesByFriction)
+{
+	BodySet bodies;
+	Solver solver;
+
+	const auto ground = bodies.Create(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Quaternionf{ Epic::Identity });
+	const auto box = CreateBox(bodies, Epic::Vector3f{ 0.f, 0.5f, 0.f });
+
+	bodies.SetLinearVelocity(box, Epic::Vector3f{ 2.f, 0.f, 0.f });
+
+	// mu * g = 5, so the box loses 0.5 m/s every 0.1 s
+	for (size_t n = 0; n < 12; ++n)
+		Step(bodies, solver, [&] { AddGroundContacts(solver, bodies, ground, box, 0.5f); });
+
+	EXPECT_NEAR(bodies.LinearVelocity(box)[0], 1.f, 0.05f);
+}
+
+TEST_F(ConstraintSolverTests, Solve_BallSocketPendulum_KeepsLength)
+{
+	BodySet bodies;
+	Solver solver;
+
+	const auto pivot = bodies.Create(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Quaternionf{ Epic::Identity });
+	const auto bob = CreateBox(bodies, Epic::Vector3f{ 1.f, 0.f, 0.f });
+
+	solver.AddBallSocket(bodies, pivot, bob, Epic::Vector3f{ 0.f, 0.f, 0.f });
+
+	float lowest = 0.f;
+
+	for (size_t n = 0; n < 60; ++n)
+	{
+		Step(bodies, solver, [] {});
+
+		const auto position = bodies.Position(bob);
+		const auto orientation = bodies.Orientation(bob);
+
+		// The anchor is at (-1, 0, 0) in the bob's frame
+		Epic::Vector3f anchor{ -1.f, 0.f, 0.f };
+		orientation.Transform(anchor);
+
+		EXPECT_NEAR((position + anchor).Magnitude(), 0.f, 0.02f);
+
+		lowest = std::min(lowest, position[1]);
+	}
+
+	// The bob swings through the bottom of its arc
+	EXPECT_LT(lowest, -0.9f);
+}
+
+TEST_F(ConstraintSolverTests, Solve_Hinge_RemovesOffAxisRotation)
+{
+	BodySet bodies;
+	Solver solver{ Solver::Settings{ 16 } };
+
+	const auto frame = bodies.Create(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Quaternionf{ Epic::Identity });
+	const auto door = CreateBox(bodies, Epic::Vector3f{ 0.f, 0.f, 0.f });
+
+	solver.AddHinge(bodies, frame, door, Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Vector3f{ 0.f, 0.f, 1.f });
+
+	bodies.SetAngularVelocity(door, Epic::Vector3f{ 1.f, -2.f, 1.f });
+	solver.Solve(bodies, Dt);
+
+	const auto angular = bodies.AngularVelocity(door);
+
+	EXPECT_NEAR(angular[0], 0.f, 1e-4f);
+	EXPECT_NEAR(angular[1], 0.f, 1e-4f);
+	EXPECT_NEAR(angular[2], 1.f, 1e-4f);
+}
+
+TEST_F(ConstraintSolverTests, Solve_SeparateStacks_FormSeparateIslands)
+{
+	BodySet bodies;
+	Solver solver;
+
+	const auto ground = bodies.Create(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Quaternionf{ Epic::Identity });
+	const auto first = CreateBox(bodies, Epic::Vector3f{ -5.f, 0.5f, 0.f });
+	const auto second = CreateBox(bodies, Epic::Vector3f{ 5.f, 0.5f, 0.f });
+	const auto chainA = CreateBox(bodies, Epic::Vector3f{ 0.f, 5.f, 0.f });
+	const auto chainB = CreateBox(bodies, Epic::Vector3f{ 0.f, 6.f, 0.f });
+
+	solver.AddBallSocket(bodies, chainA, chainB, Epic::Vector3f{ 0.f, 5.5f, 0.f });
+
+	Step(bodies, solver, [&]
+	{
+		AddGroundContacts(solver, bodies, ground, first, 0.5f);
+		AddGroundContacts(solver, bodies, ground, second, 0.5f);
+	});
+
+	EXPECT_EQ(solver.IslandCount(), 3u);
+
+	// Every row of a box touches the box, so each of its 12 rows gets a color of its own
+	EXPECT_EQ(solver.BatchCount(), 12u + 12u + 3u);
+
+	EXPECT_NEAR(bodies.LinearVelocity(first)[1], 0.f, 1e-3f);
+	EXPECT_NEAR(bodies.LinearVelocity(second)[1], 0.f, 1e-3f);
+}
@@ -0,0 +1,145 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Physics/RigidBodySet.h>
+
+class RigidBodySetTests : public testing::Test
+{
+protected:
+	using BodySet = Epic::RigidBodySetf;
+	using body_type = BodySet::body_type;
+
+	static void ExpectNear(const Epic::Vector3f& actual, const Epic::Vector3f& expected, float tolerance)
+	{
+		for (size_t k = 0; k < 3; ++k)
+			EXPECT_NEAR(actual[k], expected[k], tolerance);
+	}
+};
+
+TEST_F(RigidBodySetTests, Integrate_FreeFall_MatchesSemiImplicitEuler)
+{
+	BodySet bodies;
+	const auto falling = bodies.Create(Epic::Vector3f{ 0.f, 10.f, 0.f }, Epic::Quaternionf{ Epic::Identity }, 2.f, Epic::Vector3f{ 1.f, 1.f, 1.f });
+	const auto ground = bodies.Create(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Quaternionf{ Epic::Identity });
+
+	const Epic::Vector3f gravity{ 0.f, -10.f, 0.f };
+	const float dt = 0.01f;
+	const size_t steps = 100;
+
+	for (size_t n = 0; n < steps; ++n)
+		bodies.Integrate(dt, gravity);
+
+	// v(n) = g * n * dt, x(n) = x(0) + g * dt^2 * n * (n + 1) / 2
+	ExpectNear(bodies.LinearVelocity(falling), Epic::Vector3f{ 0.f, -10.f, 0.f }, 1e-4f);
+	ExpectNear(bodies.Position(falling), Epic::Vector3f{ 0.f, 10.f - 10.f * dt * dt * steps * (steps + 1) / 2.f, 0.f }, 1e-3f);
+
+	EXPECT_TRUE(bodies.IsStatic(ground));
+	ExpectNear(bodies.Position(ground), Epic::Vector3f{ 0.f, 0.f, 0.f }, 0.f);
+}
+
+TEST_F(RigidBodySetTests, Integrate_AngularVelocity_RotatesAboutWorldAxis)
+{
+	BodySet bodies;
+	const auto body = bodies.Create(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Quaternionf{ Epic::Identity }, 1.f, Epic::Vector3f{ 1.f, 1.f, 1.f });
+
+	bodies.SetAngularVelocity(body, Epic::Vector3f{ 0.f, 0.f, 1.f });
+
+	for (size_t n = 0; n < 1000; ++n)
+		bodies.Integrate(0.001f, Epic::Vector3f{ 0.f, 0.f, 0.f });
+
+	const Epic::Quaternionf expected{ Epic::Vector3f{ 0.f, 0.f, 1.f }, Epic::Radianf{ 1.f } };
+	const auto actual = bodies.Orientation(body);
+
+	float dot = 0.f;
+	for (size_t k = 0; k < 4; ++k)
+		dot += actual.Values[k] * expected.Values[k];
+
+	EXPECT_NEAR(std::abs(dot), 1.f, 1e-5f);
+}
+
+TEST_F(RigidBodySetTests, WorldInverseInertia_RotatedBody_MatchesRotatedTensor)
+{
+	const Epic::Quaternionf orientation{ Epic::Vector3f{ 1.f, 2.f, -1.f }.Normalize(), Epic::Radianf{ 0.8f } };
+
+	BodySet bodies;
+	const auto body = bodies.Create(Epic::Vector3f{ 0.f, 0.f, 0.f }, orientation, 3.f, Epic::Vector3f{ 1.f, 2.f, 4.f });
+
+	const Epic::Matrix3f rotation{ orientation };
+
+	Epic::Matrix3f inverseInertia{ Epic::Identity };
+	inverseInertia.Values[0] = 1.f;
+	inverseInertia.Values[4] = 0.5f;
+	inverseInertia.Values[8] = 0.25f;
+
+	const auto expected = rotation * inverseInertia * Epic::Matrix3f::TransposeOf(rotation);
+	const auto actual = bodies.WorldInverseInertia(body);
+
+	for (size_t k = 0; k < 9; ++k)
+		EXPECT_NEAR(actual.Values[k], expected.Values[k], 1e-5f);
+}
+
+TEST_F(RigidBodySetTests, Integrate_ForcesAndDamping_AreAppliedOnce)
+{
+	BodySet bodies;
+	const auto body = bodies.Create(Epic::Vector3f{ 0.f, 0.f, 0.f }, Epic::Quaternionf{ Epic::Identity }, 2.f, Epic::Vector3f{ 1.f, 1.f, 1.f });
+
+	bodies.SetDamping(body, 1.f, 0.f);
+	bodies.ApplyForce(body, Epic::Vector3f{ 4.f, 0.f, 0.f }, Epic::Vector3f{ 0.f, 1.f, 0.f });
+
+	bodies.Integrate(0.5f, Epic::Vector3f{ 0.f, 0.f, 0.f });
+
+	// v = (F / m) * dt / (1 + dt * damping); the torque (0, 1, 0) x (4, 0, 0) spins about -z
+	ExpectNear(bodies.LinearVelocity(body), Epic::Vector3f{ 1.f / 1.5f, 0.f, 0.f }, 1e-6f);
+	ExpectNear(bodies.AngularVelocity(body), Epic::Vector3f{ 0.f, 0.f, -2.f }, 1e-6f);
+
+	// Accumulated forces are cleared
+	bodies.Integrate(0.5f, Epic::Vector3f{ 0.f, 0.f, 0.f });
+
+	ExpectNear(bodies.LinearVelocity(body), Epic::Vector3f{ 1.f / 2.25f, 0.f, 0.f }, 1e-6f);
+	ExpectNear(bodies.AngularVelocity(body), Epic::Vector3f{ 0.f, 0.f, -2.f }, 1e-6f);
+}
+
+TEST_F(RigidBodySetTests, Integrate_ManyBodies_MatchesIndividualIntegration)
+{
+	std::mt19937 rng{ 38u };
+	std::uniform_real_distribution<float> dist{ -1.f, 1.f };
+
+	BodySet bodies;
+	std::vector<BodySet> singles(5000);
+
+	for (auto& single : singles)
+	{
+		const Epic::Vector3f position{ dist(rng), dist(rng), dist(rng) };
+		const Epic::Quaternionf orientation{ Epic::Vector3f{ dist(rng), dist(rng), dist(rng) + 2.f }.Normalize(), Epic::Radianf{ dist(rng) * 3.f } };
+		const Epic::Vector3f inertia{ dist(rng) + 2.f, dist(rng) + 2.f, dist(rng) + 2.f };
+		const Epic::Vector3f velocity{ dist(rng), dist(rng), dist(rng) };
+		const Epic::Vector3f torque{ dist(rng), dist(rng), dist(rng) };
+
+		for (BodySet* pSet : { &bodies, &single })
+		{
+			const auto body = pSet->Create(position, orientation, 1.f, inertia);
+			pSet->SetAngularVelocity(body, velocity);
+			pSet->ApplyTorque(body, torque);
+		}
+	}
+
+	bodies.Integrate(0.016f, Epic::Vector3f{ 0.f, -9.8f, 0.f });
+
+	for (size_t i = 0; i < singles.size(); ++i)
+	{
+		singles[i].Integrate(0.016f, Epic::Vector3f{ 0.f, -9.8f, 0.f });
+
+		const auto body = static_cast<body_type>(i);
+		const auto expected = singles[i].Orientation(0);
+		const auto actual = bodies.Orientation(body);
+
+		ExpectNear(bodies.Position(body), singles[i].Position(0), 0.f);
+		ExpectNear(bodies.AngularVelocity(body), singles[i].AngularVelocity(0), 0.f);
+
+		for (size_t k = 0; k < 4; ++k)
+			EXPECT_EQ(actual.Values[k], expected.Values[k]);
+	}
+}
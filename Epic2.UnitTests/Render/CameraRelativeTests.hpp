@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Render/CameraRelative.hpp>
+
+class CameraRelativeTests : public testing::Test
+{
+protected:
+	// A transform rotated about Y by angle and translated to (x, y, z)
+	static Epic::Matrix4d MakeWorld(double angle, double x, double y, double z)
+	{
+		Epic::Matrix4d m{ Epic::Identity };
+		const double c = std::cos(angle), s = std::sin(angle);
+
+		m.Values[0] = c;  m.Values[2] = -s;
+		m.Values[8] = s;  m.Values[10] = c;
+		m.Values[12] = x; m.Values[13] = y; m.Values[14] = z;
+
+		return m;
+	}
+};
+
+TEST_F(CameraRelativeTests, CameraRelativeOf_FarFromOrigin_KeepsPrecision)
+{
+	const Epic::Matrix4d world = MakeWorld(0.3, 1.0e7 + 0.125, -2.0e7 + 0.25, 3.0e7 + 0.5);
+	const Epic::Vector3d camera{ 1.0e7, -2.0e7, 3.0e7 };
+
+	const Epic::Matrix4f relative = Epic::CameraRelativeOf(world, camera);
+
+	EXPECT_FLOAT_EQ(relative.Values[12], 0.125f);
+	EXPECT_FLOAT_EQ(relative.Values[13], 0.25f);
+	EXPECT_FLOAT_EQ(relative.Values[14], 0.5f);
+	EXPECT_FLOAT_EQ(relative.Values[0], float(std::cos(0.3)));
+	EXPECT_FLOAT_EQ(relative.Values[15], 1.0f);
+
+	// Narrowing first loses the offset entirely
+	const float naive = float(world.Values[12]) - float(camera[0]);
+	EXPECT_NE(naive, 0.125f);
+}
+
+TEST_F(CameraRelativeTests, BatchCameraRelative_ManyMatrices_MatchesSingle)
+{
+	const Epic::Vector3d camera{ 5.0e6 + 0.3, 12.0, -7.0e6 };
+
+	std::vector<Epic::Matrix4d> worlds;
+	std::vector<Epic::Vector3d> positions;
+	for (size_t i = 0; i < 200; ++i)
+	{
+		worlds.push_back(MakeWorld(0.01 * i, 5.0e6 + i * 1.5, 12.0 - i, -7.0e6 + i * 0.25));
+		positions.push_back(Epic::Vector3d{ 5.0e6 - i, 3.0 * i, -7.0e6 + 0.5 * i });
+	}
+
+	std::vector<Epic::Matrix4f> results(worlds.size());
+	Epic::BatchCameraRelative(worlds.data(), worlds.size(), camera, results.data());
+
+	std::vector<Epic::Vector3f> relativePositions(positions.size());
+	Epic::BatchCameraRelative(positions.data(), positions.size(), camera, relativePositions.data());
+
+	for (size_t i = 0; i < worlds.size(); ++i)
+	{
+		const Epic::Matrix4f expected = Epic::CameraRelativeOf(worlds[i], camera);
+		for (size_t k = 0; k < 16; ++k)
+			EXPECT_EQ(results[i].Values[k], expected.Values[k]);
+
+		const Epic::Vector3f expectedPosition = Epic::CameraRelativeOf(positions[i], camera);
+		for (size_t k = 0; k < 3; ++k)
+			EXPECT_EQ(relativePositions[i][k], expectedPosition[k]);
+	}
+}
+
+TEST_F(CameraRelativeTests, CameraRelativeViewOf_RelativeWorld_MatchesDoubleView)
+{
+	const Epic::Vector3d eye{ 2.0e7, 150.0, -4.0e6 };
+
+	// Rigid view: rotation about Y followed by translation of -eye
+	const Epic::Matrix4d rotation = MakeWorld(0.7, 0.0, 0.0, 0.0);
+	Epic::Matrix4d view = rotation;
+	for (size_t r = 0; r < 3; ++r)
+		view.Values[12 + r] = -(rotation.Values[r] * eye[0] + rotation.Values[4 + r] * eye[1] + rotation.Values[8 + r] * eye[2]);
+
+	const Epic::Vector3d camera = Epic::CameraPositionOf(view);
+	for (size_t k = 0; k < 3; ++k)
+		EXPECT_NEAR(camera[k], eye[k], 1e-6);
+
+	const Epic::Matrix4d world = MakeWorld(-0.2, 2.0e7 + 3.0, 151.0, -4.0e6 - 10.0);
+	const Epic::Matrix4d expected = view * world;
+	const Epic::Matrix4f actual = Epic::CameraRelativeViewOf(view, camera) * Epic::CameraRelativeOf(world, camera);
+
+	for (size_t k = 0; k < 16; ++k)
+		EXPECT_NEAR(actual.Values[k], expected.Values[k], 1e-5);
+}
+
+TEST_F(CameraRelativeTests, RebaseOrigin_BeyondThreshold_SnapsAndShifts)
+{
+	Epic::Vector3d origin{ 0.0, 0.0, 0.0 };
+	Epic::Vector3d shift;
+
+	EXPECT_FALSE(Epic::RebaseOrigin(origin, Epic::Vector3d{ 900.0, -50.0, 10.0 }, 1000.0, shift, 256.0));
+	EXPECT_EQ(shift[0], 0.0);
+	EXPECT_EQ(origin[0], 0.0);
+
+	EXPECT_TRUE(Epic::RebaseOrigin(origin, Epic::Vector3d{ 1300.0, -50.0, 10.0 }, 1000.0, shift, 256.0));
+	EXPECT_EQ(origin[0], 1280.0);
+	EXPECT_EQ(origin[1], 0.0);
+	EXPECT_EQ(origin[2], 0.0);
+	EXPECT_EQ(shift[0], 1280.0);
+
+	// Data relative to the old origin is re-expressed relative to the new one
+	Epic::Vector3f positions[2] = { { 1300.0f, -50.0f, 10.0f }, { 0.0f, 0.0f, 0.0f } };
+	Epic::BatchRebase(positions, 2, shift);
+	EXPECT_FLOAT_EQ(positions[0][0], 20.0f);
+	EXPECT_FLOAT_EQ(positions[1][0], -1280.0f);
+	EXPECT_FLOAT_EQ(positions[0][1], -50.0f);
+
+	Epic::Matrix4f transforms[1] = { Epic::Matrix4f{ Epic::Identity } };
+	transforms[0].Values[12] = 1290.0f;
+	Epic::BatchRebase(transforms, 1, shift);
+	EXPECT_FLOAT_EQ(transforms[0].Values[12], 10.0f);
+	EXPECT_FLOAT_EQ(transforms[0].Values[0], 1.0f);
+	EXPECT_FLOAT_EQ(transforms[0].Values[15], 1.0f);
+}
@@ -0,0 +1,249 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Render/LightClusters.h>
+
+class LightClustersTests : public testing::Test
+{
+protected:
+	std::mt19937 m_Random{ 23u };
+
+	static Epic::Matrix4f Projection()
+	{
+		return Epic::CreatePerspectiveMatrix(Epic::Degreef(60.f), 16.f / 9.f, 0.5f, 200.f);
+	}
+
+	// The cluster lists of cluster c as a sorted vector of point (then spot, offset by 1 << 16) indices
+	static std::vector<std::uint32_t> ListOf(const Epic::LightClustersf& clusters, size_t c)
+	{
+		const auto& cluster = clusters.GetCluster(c);
+		const auto& indices = clusters.LightIndices();
+
+		std::vector<std::uint32_t> result;
+
+		for (std::uint32_t n = 0; n < cluster.PointCount; ++n)
+			result.push_back(indices[cluster.Offset + n]);
+
+		for (std::uint32_t n = 0; n < cluster.SpotCount; ++n)
+			result.push_back((1u << 16) + indices[cluster.Offset + cluster.PointCount + n]);
+
+		std::sort(std::begin(result), std::end(result));
+
+		return result;
+	}
+
+	static bool Contains(const std::vector<std::uint32_t>& list, std::uint32_t value)
+	{
+		return std::binary_search(std::begin(list), std::end(list), value);
+	}
+};
+
+TEST_F(LightClustersTests, SetProjection_Slices_CoverTheFrustum)
+{
+	Epic::LightClustersf clusters;
+	clusters.SetProjection(Projection());
+
+	EXPECT_NEAR(clusters.Near(), 0.5f, 1e-4f);
+	EXPECT_NEAR(clusters.Far(), 200.f, 0.05f);
+	EXPECT_NEAR(clusters.SliceDepth(0), 0.5f, 1e-4f);
+	EXPECT_EQ(clusters.SliceDepth(24), clusters.Far());
+
+	// Exponential slices have a constant depth ratio
+	const float ratio = clusters.SliceDepth(1) / clusters.SliceDepth(0);
+	EXPECT_NEAR(clusters.SliceDepth(13) / clusters.SliceDepth(12), ratio, 1e-3f);
+
+	// Random points inside the frustum fall inside the bounds of their cluster
+	std::uniform_real_distribution<float> unit{ -0.999f, 0.999f };
+	const auto inverse = Epic::Matrix4f::InverseOf(Projection());
+
+	for (int n = 0; n < 2000; ++n)
+	{
+		auto p = inverse * Epic::Vector4f{ unit(m_Random), unit(m_Random), unit(m_Random), 1.f };
+		const Epic::Vector3f view{ p[0] / p[3], p[1] / p[3], p[2] / p[3] };
+
+		const auto& box = clusters.Bounds(clusters.ClusterOf(view));
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			EXPECT_GE(view[k], box.Min[k] - 1e-3f * std::abs(view[2]));
+			EXPECT_LE(view[k], box.Max[k] + 1e-3f * std::abs(view[2]));
+		}
+	}
+
+	// An infinite projection needs a maximum distance
+	auto infinite = Projection();
+	infinite.Values[10] = -1.f;
+	infinite.Values[14] = -1.f;
+
+	Epic::LightClustersf::Settings settings;
+	settings.MaxDistance = 100.f;
+
+	Epic::LightClustersf bounded{ settings };
+	bounded.SetProjection(infinite);
+
+	EXPECT_NEAR(bounded.Far(), 100.f, 1e-4f);
+}
+
+TEST_F(LightClustersTests, Build_PointLights_MatchBruteForce)
+{
+	Epic::LightClustersf clusters;
+	clusters.SetProjection(Projection());
+
+	std::uniform_real_distribution<float> lateral{ -40.f, 40.f };
+	std::uniform_real_distribution<float> depth{ -150.f, 2.f };
+	std::uniform_real_distribution<float> radius{ 0.2f, 8.f };
+
+	std::vector<Epic::LightClustersf::PointLight> lights;
+
+	for (int n = 0; n < 500; ++n)
+		lights.push_back({ Epic::Vector3f{ lateral(m_Random), lateral(m_Random) * 0.5f, depth(m_Random) }, radius(m_Random) });
+
+	clusters.Build(Epic::Matrix4f{ Epic::Identity }, lights.data(), lights.size(), nullptr, 0);
+
+	size_t total = 0;
+
+	for (size_t c = 0; c < clusters.ClusterCount(); ++c)
+	{
+		const auto list = ListOf(clusters, c);
+		const auto& box = clusters.Bounds(c);
+
+		std::vector<std::uint32_t> expected;
+
+		for (std::uint32_t i = 0; i < lights.size(); ++i)
+		{
+			const auto closest = box.ClosestPoint(lights[i].Position);
+
+			if ((closest - lights[i].Position).MagnitudeSq() <= lights[i].Radius * lights[i].Radius)
+				expected.push_back(i);
+		}
+
+		ASSERT_EQ(list, expected) << "cluster " << c;
+		total += list.size();
+	}
+
+	EXPECT_EQ(clusters.LightIndices().size(), total);
+	EXPECT_GT(total, lights.size());
+}
+
+TEST_F(LightClustersTests, Build_SpotLights_AreConservative)
+{
+	Epic::LightClustersf clusters;
+	clusters.SetProjection(Projection());
+
+	std::uniform_real_distribution<float> lateral{ -20.f, 20.f };
+	std::uniform_real_distribution<float> depth{ -80.f, 0.f };
+	std::uniform_real_distribution<float> unit{ -1.f, 1.f };
+	std::uniform_real_distribution<float> angle{ 0.1f, 1.4f };
+	std::uniform_real_distribution<float> range{ 1.f, 20.f };
+
+	std::vector<Epic::LightClustersf::SpotLight> lights;
+
+	for (int n = 0; n < 200; ++n)
+	{
+		Epic::Vector3f direction{ unit(m_Random), unit(m_Random), unit(m_Random) };
+		direction.Normalize();
+
+		lights.push_back({ Epic::Vector3f{ lateral(m_Random), lateral(m_Random), depth(m_Random) }, direction, range(m_Random), angle(m_Random) });
+	}
+
+	// The camera is moved back along +z and turned a little about y
+	Epic::Matrix4f translation = Epic::Identity;
+	translation.Values[14] = -10.f;
+
+	const Epic::Matrix4f view = Epic::Matrix4f{ Epic::YRotation, Epic::Radianf(0.3f) } * translation;
+
+	clusters.Build(view, nullptr, 0, lights.data(), lights.size());
+
+	size_t total = 0;
+
+	for (size_t c = 0; c < clusters.ClusterCount(); ++c)
+		total += clusters.GetCluster(c).SpotCount;
+
+	EXPECT_GT(total, 0u);
+	EXPECT_LT(total, lights.size() * clusters.ClusterCount() / 4);
+
+	// Every point lit by a spot light lies in a cluster that lists it
+	for (std::uint32_t i = 0; i < lights.size(); ++i)
+	{
+		const auto& light = lights[i];
+
+		for (int n = 0; n < 200; ++n)
+		{
+			Epic::Vector3f offset{ unit(m_Random), unit(m_Random), unit(m_Random) };
+
+			if (offset.MagnitudeSq() > 1.f)
+				continue;
+
+			offset *= light.Range;
+
+			const float along = offset.Dot(light.Direction);
+
+			if (along <= 0.f || along < offset.Magnitude() * std::cos(light.Angle))
+				continue;
+
+			const Epic::Vector3f viewPoint = view * (light.Position + offset);
+
+			if (-viewPoint[2] < clusters.Near() || -viewPoint[2] > clusters.Far())
+				continue;
+
+			auto clip = Projection() * Epic::Vector4f{ viewPoint[0], viewPoint[1], viewPoint[2], 1.f };
+
+			if (std::abs(clip[0]) > clip[3] || std::abs(clip[1]) > clip[3])
+				continue;
+
+			ASSERT_TRUE(Contains(ListOf(clusters, clusters.ClusterOf(viewPoint)), (1u << 16) + i)) << "light " << i;
+		}
+	}
+}
+
+TEST_F(LightClustersTests, Build_MixedLights_OrdersPointsBeforeSpots)
+{
+	Epic::LightClustersf::Settings settings;
+	settings.TilesX = 4;
+	settings.TilesY = 4;
+	settings.Slices = 8;
+
+	Epic::LightClustersf clusters{ settings };
+	clusters.SetProjection(Projection());
+
+	const std::vector<Epic::LightClustersf::PointLight> points =
+	{
+		{ Epic::Vector3f{ 0.f, 0.f, -15.f }, 1.f },
+		{ Epic::Vector3f{ 0.f, 0.f, 50.f }, 1.f }
+	};
+
+	const std::vector<Epic::LightClustersf::SpotLight> spots =
+	{
+		{ Epic::Vector3f{ 0.f, 0.f, -5.f }, Epic::Vector3f{ 0.f, 0.f, -1.f }, 20.f, 0.3f },
+		{ Epic::Vector3f{ 0.f, 0.f, 1.f }, Epic::Vector3f{ 0.f, 0.f, 1.f }, 5.f, 0.3f }
+	};
+
+	clusters.Build(Epic::Matrix4f{ Epic::Identity }, points.data(), points.size(), spots.data(), spots.size());
+
+	const size_t center = clusters.ClusterOf(Epic::Vector3f{ 0.01f, 0.01f, -15.f });
+	const auto& cluster = clusters.GetCluster(center);
+
+	ASSERT_EQ(cluster.PointCount, 1u);
+	ASSERT_EQ(cluster.SpotCount, 1u);
+	EXPECT_EQ(clusters.LightIndices()[cluster.Offset], 0u);
+	EXPECT_EQ(clusters.LightIndices()[cluster.Offset + 1], 0u);
+
+	// The lights behind the camera are in no cluster
+	for (size_t c = 0; c < clusters.ClusterCount(); ++c)
+	{
+		const auto list = ListOf(clusters, c);
+
+		EXPECT_FALSE(Contains(list, 1u));
+		EXPECT_FALSE(Contains(list, (1u << 16) + 1u));
+	}
+
+	clusters.Build(Epic::Matrix4f{ Epic::Identity }, nullptr, 0, nullptr, 0);
+
+	EXPECT_TRUE(clusters.LightIndices().empty());
+	EXPECT_EQ(clusters.GetCluster(center).PointCount, 0u);
+}
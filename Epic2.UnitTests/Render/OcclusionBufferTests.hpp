@@ -0,0 +1,311 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Render/OcclusionBuffer.h>
+
+class OcclusionBufferTests : public testing::Test
+{
+protected:
+	std::mt19937 m_Random{ 5u };
+
+	// A 90 degree perspective projection (aspect 2, near 1, far 100) looking down -z from the origin
+	static Epic::Matrix4f Perspective()
+	{
+		Epic::Matrix4f result = Epic::Zero;
+
+		result.Values[0] = 0.5f;
+		result.Values[5] = 1.f;
+		result.Values[10] = -101.f / 99.f;
+		result.Values[11] = -1.f;
+		result.Values[14] = -200.f / 99.f;
+
+		return result;
+	}
+
+	// Appends a quad facing +z with its corners counter-clockwise
+	static void AddQuad(std::vector<Epic::Vector3f>& vertices, std::vector<std::uint32_t>& indices,
+		float x0, float y0, float x1, float y1, float z0, float z1)
+	{
+		const auto base = static_cast<std::uint32_t>(vertices.size());
+
+		vertices.push_back(Epic::Vector3f{ x0, y0, z0 });
+		vertices.push_back(Epic::Vector3f{ x1, y0, z1 });
+		vertices.push_back(Epic::Vector3f{ x1, y1, z1 });
+		vertices.push_back(Epic::Vector3f{ x0, y1, z0 });
+
+		for (std::uint32_t index : { 0u, 1u, 2u, 0u, 2u, 3u })
+			indices.push_back(base + index);
+	}
+
+	static Epic::AABBf Box(float x, float y, float z, float extent)
+	{
+		return Epic::AABBf{ Epic::Vector3f{ x - extent, y - extent, z - extent }, Epic::Vector3f{ x + extent, y + extent, z + extent } };
+	}
+};
+
+TEST_F(OcclusionBufferTests, Settings_Dimensions_RoundedToTiles)
+{
+	Epic::OcclusionBufferf::Settings settings;
+	settings.Width = 100;
+	settings.Height = 50;
+	settings.TileSize = 16;
+
+	const Epic::OcclusionBufferf buffer{ settings };
+
+	EXPECT_EQ(buffer.Width(), 112u);
+	EXPECT_EQ(buffer.Height(), 64u);
+	EXPECT_EQ(buffer.TileCount(), 28u);
+	EXPECT_EQ(buffer.GetLevel(buffer.LevelCount() - 1).Width, 1u);
+	EXPECT_EQ(buffer.GetLevel(buffer.LevelCount() - 1).Height, 1u);
+	EXPECT_EQ(buffer.Depth(5, 5), 1.f);
+}
+
+TEST_F(OcclusionBufferTests, Rasterize_SlopedQuad_InterpolatesDepth)
+{
+	Epic::OcclusionBufferf buffer;
+	std::vector<Epic::Vector3f> vertices;
+	std::vector<std::uint32_t> indices;
+
+	// Clip space is passed straight through; the quad's NDC depth equals its x
+	AddQuad(vertices, indices, -1.f, -1.f, 1.f, 1.f, -1.f, 1.f);
+
+	buffer.Begin(Epic::Matrix4f{ Epic::Identity });
+	buffer.AddOccluders(vertices.data(), vertices.size(), indices.data(), indices.size());
+	buffer.Rasterize();
+
+	const float width = float(buffer.Width());
+
+	for (size_t x : { 0u, 17u, 256u, 511u })
+	{
+		for (size_t y : { 0u, 100u, 255u })
+			EXPECT_NEAR(buffer.Depth(x, y), (float(x) + 0.5f) / width, 1e-5f);
+	}
+
+	EXPECT_NEAR(buffer.GetLevel(buffer.LevelCount() - 1).Depth[0], 511.5f / width, 1e-5f);
+
+	// The same quad wound clockwise is culled, unless back faces are kept
+	std::swap(indices[1], indices[2]);
+	std::swap(indices[4], indices[5]);
+
+	buffer.Begin(Epic::Matrix4f{ Epic::Identity });
+	buffer.AddOccluders(vertices.data(), vertices.size(), indices.data(), indices.size());
+	buffer.Rasterize();
+
+	EXPECT_EQ(buffer.TriangleCount(), 0u);
+	EXPECT_EQ(buffer.Depth(256, 128), 1.f);
+
+	auto settings = buffer.GetSettings();
+	settings.CullBackFaces = false;
+	buffer.SetSettings(settings);
+
+	buffer.Begin(Epic::Matrix4f{ Epic::Identity });
+	buffer.AddOccluders(vertices.data(), vertices.size(), indices.data(), indices.size());
+	buffer.Rasterize();
+
+	EXPECT_NEAR(buffer.Depth(256, 128), 256.5f / width, 1e-5f);
+}
+
+TEST_F(OcclusionBufferTests, Rasterize_FloorThroughNearPlane_IsClipped)
+{
+	Epic::OcclusionBufferf buffer;
+	std::vector<Epic::Vector3f> vertices;
+	std::vector<std::uint32_t> indices;
+
+	// A floor under the camera that extends behind it
+	vertices = { { -50.f, -1.f, 10.f }, { 50.f, -1.f, 10.f }, { 50.f, -1.f, -50.f }, { -50.f, -1.f, -50.f } };
+	indices = { 0, 1, 2, 0, 2, 3 };
+
+	buffer.Begin(Perspective());
+	buffer.AddOccluders(vertices.data(), vertices.size(), indices.data(), indices.size());
+	buffer.Rasterize();
+
+	EXPECT_GE(buffer.TriangleCount(), 3u);
+
+	// The bottom row sees the floor just past the near plane, the top half sees nothing
+	EXPECT_LT(buffer.Depth(256, 0), 0.1f);
+	EXPECT_EQ(buffer.Depth(256, 200), 1.f);
+
+	// Below the horizon the floor is at distance 1 / (y_ndc) along -z
+	const float yNdc = (64.5f / 128.f) - 1.f;
+	const float z = 1.f / yNdc;
+	const float expected = (((-101.f / 99.f) * z - 200.f / 99.f) / -z) * 0.5f + 0.5f;
+	EXPECT_NEAR(buffer.Depth(256, 64), expected, 1e-4f);
+}
+
+TEST_F(OcclusionBufferTests, IsVisible_WallInFront_OccludesBoxesBehind)
+{
+	Epic::OcclusionBufferf buffer;
+	std::vector<Epic::Vector3f> vertices;
+	std::vector<std::uint32_t> indices;
+
+	AddQuad(vertices, indices, -4.f, -4.f, 4.f, 4.f, -10.f, -10.f);
+
+	buffer.Begin(Perspective());
+	buffer.AddOccluders(vertices.data(), vertices.size(), indices.data(), indices.size());
+	buffer.Rasterize();
+
+	EXPECT_FALSE(buffer.IsVisible(Box(0.f, 0.f, -20.f, 1.f)));
+	EXPECT_FALSE(buffer.IsVisible(Box(0.f, 0.f, -90.f, 8.f)));
+	EXPECT_TRUE(buffer.IsVisible(Box(0.f, 0.f, -5.f, 1.f)));
+	EXPECT_TRUE(buffer.IsVisible(Box(8.f, 0.f, -20.f, 1.f)));
+	EXPECT_TRUE(buffer.IsVisible(Box(0.f, 0.f, -20.f, 12.f)));
+
+	// Near plane, behind the camera, off-screen and beyond the far plane
+	EXPECT_TRUE(buffer.IsVisible(Box(0.f, 0.f, 0.f, 2.f)));
+	EXPECT_FALSE(buffer.IsVisible(Box(0.f, 0.f, 10.f, 1.f)));
+	EXPECT_FALSE(buffer.IsVisible(Box(100.f, 0.f, -20.f, 1.f)));
+	EXPECT_FALSE(buffer.IsVisible(Box(0.f, 0.f, -200.f, 1.f)));
+
+	// Occluders can be placed with a model matrix
+	Epic::Matrix4f model = Epic::Identity;
+	model.Values[12] = 50.f;
+
+	buffer.Begin(Perspective());
+	buffer.AddOccluders(model, vertices.data(), vertices.size(), indices.data(), indices.size());
+	buffer.Rasterize();
+
+	EXPECT_TRUE(buffer.IsVisible(Box(0.f, 0.f, -20.f, 1.f)));
+}
+
+TEST_F(OcclusionBufferTests, BatchIsVisible_RandomScene_IsConservative)
+{
+	Epic::OcclusionBufferf buffer;
+	std::vector<Epic::Vector3f> vertices;
+	std::vector<std::uint32_t> indices;
+
+	std::uniform_real_distribution<float> lateral{ -30.f, 30.f };
+	std::uniform_real_distribution<float> depth{ -60.f, -5.f };
+	std::uniform_real_distribution<float> size{ 0.5f, 6.f };
+
+	for (int n = 0; n < 200; ++n)
+	{
+		const float x = lateral(m_Random), y = lateral(m_Random), z = depth(m_Random), s = size(m_Random);
+		AddQuad(vertices, indices, x - s, y - s, x + s, y + s, z, z + lateral(m_Random) * 0.1f);
+	}
+
+	buffer.Begin(Perspective());
+	buffer.AddOccluders(vertices.data(), vertices.size(), indices.data(), indices.size());
+	buffer.Rasterize();
+
+	// Every texel holds the farthest depth beneath it
+	for (size_t level = 1; level < buffer.LevelCount(); ++level)
+	{
+		const auto& src = buffer.GetLevel(level - 1);
+		const auto& dst = buffer.GetLevel(level);
+
+		for (size_t y = 0; y < dst.Height; ++y)
+		{
+			for (size_t x = 0; x < dst.Width; ++x)
+			{
+				float expected = 0.f;
+
+				for (size_t sy = 2 * y; sy < std::min(2 * y + 2, src.Height); ++sy)
+				{
+					for (size_t sx = 2 * x; sx < std::min(2 * x + 2, src.Width); ++sx)
+						expected = std::max(expected, src.Depth[sy * src.Width + sx]);
+				}
+
+				ASSERT_EQ(dst.Depth[y * dst.Width + x], expected);
+			}
+		}
+	}
+
+	std::vector<Epic::AABBf> boxes;
+
+	for (int n = 0; n < 3000; ++n)
+		boxes.push_back(Box(lateral(m_Random), lateral(m_Random), depth(m_Random) - 10.f, size(m_Random) * 0.3f));
+
+	std::vector<std::uint8_t> results(boxes.size());
+	buffer.BatchIsVisible(boxes.data(), boxes.size(), results.data());
+
+	const Epic::Matrix4f viewProjection = Perspective();
+	size_t occluded = 0;
+
+	for (size_t i = 0; i < boxes.size(); ++i)
+	{
+		ASSERT_EQ(results[i] != 0, buffer.IsVisible(boxes[i]));
+
+		if (results[i])
+			continue;
+
+		++occluded;
+
+		// An occluded box must lie behind the rasterized depth of every pixel it touches
+		float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f, minZ = 1e30f;
+
+		for (int corner = 0; corner < 8; ++corner)
+		{
+			Epic::Vector4f p{ (corner & 1) ? boxes[i].Max[0] : boxes[i].Min[0],
+				(corner & 2) ? boxes[i].Max[1] : boxes[i].Min[1],
+				(corner & 4) ? boxes[i].Max[2] : boxes[i].Min[2], 1.f };
+
+			p = viewProjection * p;
+
+			minX = std::min(minX, (p[0] / p[3] * 0.5f + 0.5f) * buffer.Width());
+			maxX = std::max(maxX, (p[0] / p[3] * 0.5f + 0.5f) * buffer.Width());
+			minY = std::min(minY, (p[1] / p[3] * 0.5f + 0.5f) * buffer.Height());
+			maxY = std::max(maxY, (p[1] / p[3] * 0.5f + 0.5f) * buffer.Height());
+			minZ = std::min(minZ, p[2] / p[3] * 0.5f + 0.5f);
+		}
+
+		const auto x0 = size_t(std::max(minX, 0.f)), x1 = size_t(std::min(maxX, float(buffer.Width() - 1)));
+		const auto y0 = size_t(std::max(minY, 0.f)), y1 = size_t(std::min(maxY, float(buffer.Height() - 1)));
+
+		if (minX >= float(buffer.Width()) || maxX < 0.f || minY >= float(buffer.Height()) || maxY < 0.f)
+			continue;
+
+		for (size_t y = y0; y <= y1; ++y)
+		{
+			for (size_t x = x0; x <= x1; ++x)
+				ASSERT_LT(buffer.Depth(x, y), minZ);
+		}
+	}
+
+	EXPECT_GT(occluded, 100u);
+	EXPECT_LT(occluded, boxes.size());
+}
+
+TEST_F(OcclusionBufferTests, AddOccluders_SplitAcrossCalls_MatchesSingleCall)
+{
+	std::uniform_real_distribution<float> position{ -1.2f, 1.f };
+	std::uniform_real_distribution<float> size{ 0.01f, 0.2f };
+	std::uniform_real_distribution<float> depth{ -0.9f, 0.9f };
+
+	std::vector<Epic::Vector3f> vertices;
+	std::vector<std::uint32_t> indices;
+
+	for (size_t i = 0; i < 20000; ++i)
+	{
+		const float x = position(m_Random);
+		const float y = position(m_Random);
+		const float z = depth(m_Random);
+
+		AddQuad(vertices, indices, x, y, x + size(m_Random), y + size(m_Random), z, z + 0.05f);
+	}
+
+	Epic::OcclusionBufferf whole;
+	whole.Begin(Epic::Matrix4f{ Epic::Identity });
+	whole.AddOccluders(vertices.data(), vertices.size(), indices.data(), indices.size());
+	whole.Rasterize();
+
+	// Submit the first half one quad at a time, then the rest at once
+	Epic::OcclusionBufferf split;
+	split.Begin(Epic::Matrix4f{ Epic::Identity });
+
+	const size_t half = indices.size() / 2;
+
+	for (size_t i = 0; i < half; i += 6)
+		split.AddOccluders(vertices.data(), vertices.size(), indices.data() + i, 6);
+
+	split.AddOccluders(vertices.data(), vertices.size(), indices.data() + half, indices.size() - half);
+	split.Rasterize();
+
+	EXPECT_EQ(split.TriangleCount(), whole.TriangleCount());
+
+	for (size_t level = 0; level < whole.LevelCount(); ++level)
+		EXPECT_EQ(split.GetLevel(level).Depth, whole.GetLevel(level).Depth);
+}
@@ -0,0 +1,148 @@
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Render/ShadowCascades.h>
+
+class ShadowCascadesTests : public testing::Test
+{
+protected:
+	static Epic::Matrix4f Projection()
+	{
+		return Epic::CreatePerspectiveMatrix(Epic::Degreef(60.f), 16.f / 9.f, 0.5f, 500.f);
+	}
+
+	static Epic::Matrix4f View(float yaw, float x, float z)
+	{
+		Epic::Matrix4f translation = Epic::Identity;
+		translation.Values[12] = -x;
+		translation.Values[14] = -z;
+
+		return Epic::Matrix4f{ Epic::YRotation, Epic::Radianf(yaw) } * translation;
+	}
+
+	static Epic::Vector3f Light()
+	{
+		return Epic::Vector3f{ 0.3f, -1.f, 0.2f };
+	}
+
+	static Epic::Vector4f Transform(const Epic::Matrix4f& m, const Epic::Vector3f& p)
+	{
+		return m * Epic::Vector4f{ p[0], p[1], p[2], 1.f };
+	}
+};
+
+TEST_F(ShadowCascadesTests, ComputeSplits_Lambda_BlendsLogarithmicAndUniform)
+{
+	float splits[5];
+
+	Epic::ShadowCascadesf::ComputeSplits(1.f, 81.f, 4, 0.f, splits);
+	EXPECT_FLOAT_EQ(splits[1], 21.f);
+	EXPECT_FLOAT_EQ(splits[2], 41.f);
+
+	Epic::ShadowCascadesf::ComputeSplits(1.f, 81.f, 4, 1.f, splits);
+	EXPECT_FLOAT_EQ(splits[1], 3.f);
+	EXPECT_FLOAT_EQ(splits[2], 9.f);
+	EXPECT_FLOAT_EQ(splits[3], 27.f);
+
+	Epic::ShadowCascadesf::ComputeSplits(1.f, 81.f, 4, 0.5f, splits);
+	EXPECT_FLOAT_EQ(splits[0], 1.f);
+	EXPECT_FLOAT_EQ(splits[1], 12.f);
+	EXPECT_FLOAT_EQ(splits[4], 81.f);
+}
+
+TEST_F(ShadowCascadesTests, Update_Cascades_ContainTheirSlices)
+{
+	Epic::ShadowCascadesf::Settings settings;
+	settings.MaxDistance = 200.f;
+	settings.CasterDistance = 50.f;
+
+	Epic::ShadowCascadesf cascades{ settings };
+	cascades.Update(View(0.4f, 10.f, 5.f), Projection(), Light());
+
+	ASSERT_EQ(cascades.CascadeCount(), 4u);
+	EXPECT_NEAR(cascades.Splits().front(), 0.5f, 1e-4f);
+	EXPECT_NEAR(cascades.Splits().back(), 200.f, 1e-3f);
+
+	for (size_t i = 0; i < cascades.CascadeCount(); ++i)
+	{
+		const auto& cascade = cascades.GetCascade(i);
+
+		EXPECT_EQ(cascade.Near, cascades.Splits()[i]);
+		EXPECT_EQ(cascade.Far, cascades.Splits()[i + 1]);
+
+		for (size_t c = 4 * i; c < 4 * i + 8; ++c)
+		{
+			const auto& corner = cascades.Corners()[c];
+
+			for (const auto* pMatrix : { &cascade.ViewProjection, &cascade.CullingViewProjection })
+			{
+				const auto clip = Transform(*pMatrix, corner);
+
+				EXPECT_NEAR(clip[3], 1.f, 1e-5f);
+
+				for (size_t k = 0; k < 3; ++k)
+					EXPECT_LE(std::abs(clip[k]), 1.f + 1e-4f);
+			}
+
+			// A caster toward the light is still inside the cascade
+			const auto caster = Transform(cascade.ViewProjection, corner - Light() * (40.f / Light().Magnitude()));
+			EXPECT_GE(caster[2], -1.f - 1e-4f);
+
+			const auto lightCorner = Transform(cascades.LightView(), corner);
+			EXPECT_TRUE(cascade.CullingBounds.Contains(Epic::Vector3f{ lightCorner[0], lightCorner[1], lightCorner[2] }));
+		}
+
+		// The culling box is fitted to the slice, so it is no larger than the cascade
+		const auto size = cascade.CullingBounds.Size();
+		EXPECT_LE(size[0], 2.f * (cascade.Radius + cascade.TexelSize) + 1e-3f);
+		EXPECT_LE(size[1], 2.f * (cascade.Radius + cascade.TexelSize) + 1e-3f);
+	}
+}
+
+TEST_F(ShadowCascadesTests, Update_MovingCamera_IsTexelStable)
+{
+	Epic::ShadowCascadesf::Settings settings;
+	settings.MaxDistance = 150.f;
+	settings.Resolution = 1024;
+
+	Epic::ShadowCascadesf cascades{ settings };
+	cascades.Update(View(0.f, 0.f, 0.f), Projection(), Light());
+
+	const auto first = cascades.Cascades();
+
+	for (int frame = 1; frame < 20; ++frame)
+	{
+		cascades.Update(View(0.05f * frame, 0.37f * frame, -0.21f * frame), Projection(), Light());
+
+		for (size_t i = 0; i < cascades.CascadeCount(); ++i)
+		{
+			const auto& cascade = cascades.GetCascade(i);
+
+			// Turning and moving the camera leaves the size of a texel unchanged
+			EXPECT_EQ(cascade.Radius, first[i].Radius);
+			EXPECT_EQ(cascade.TexelSize, first[i].TexelSize);
+
+			// The world origin stays on a texel corner of the shadow map
+			const auto clip = Transform(cascade.ViewProjection, Epic::Vector3f{ 0.f, 0.f, 0.f });
+
+			for (size_t k = 0; k < 2; ++k)
+			{
+				const float texel = (clip[k] * 0.5f + 0.5f) * float(settings.Resolution);
+				EXPECT_NEAR(texel, std::round(texel), 2e-2f);
+			}
+		}
+	}
+
+	// Without fitting, the culling frustum is the cascade itself
+	settings.FitCullingBounds = false;
+	cascades.SetSettings(settings);
+	cascades.Update(View(0.f, 0.f, 0.f), Projection(), Light());
+
+	for (const auto& cascade : cascades.Cascades())
+	{
+		for (size_t n = 0; n < 16; ++n)
+			EXPECT_EQ(cascade.CullingViewProjection.Values[n], cascade.ViewProjection.Values[n]);
+	}
+}
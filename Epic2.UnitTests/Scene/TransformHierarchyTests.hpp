@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Scene/TransformHierarchy.h>
+
+class TransformHierarchyTests : public testing::Test
+{
+protected:
+	using Hierarchy = Epic::TransformHierarchyf;
+	using node_type = Hierarchy::node_type;
+
+	// Creates count nodes, each parented to a random earlier node (or none)
+	static std::vector<node_type> MakeTree(Hierarchy& hierarchy, size_t count)
+	{
+		std::mt19937 rng{ 1234u };
+		std::uniform_real_distribution<float> dist{ -1.f, 1.f };
+		std::uniform_real_distribution<float> scaleDist{ 0.5f, 1.5f };
+
+		std::vector<node_type> nodes;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const node_type parent = (i == 0 || rng() % 8 == 0) ? Hierarchy::InvalidNode : nodes[rng() % i];
+
+			const Epic::Vector3f axis = Epic::Vector3f{ dist(rng), dist(rng), dist(rng) + 2.f }.Normalize();
+			const Epic::Quaternionf rotation{ axis, Epic::Radianf{ dist(rng) * 3.f } };
+
+			nodes.push_back(hierarchy.Create(parent,
+				Epic::Vector3f{ dist(rng), dist(rng), dist(rng) },
+				rotation,
+				Epic::Vector3f{ scaleDist(rng), scaleDist(rng), scaleDist(rng) }));
+		}
+
+		return nodes;
+	}
+
+	// Composes the world matrix by walking the parent chain
+	static Epic::Matrix4f NaiveWorld(const Hierarchy& hierarchy, node_type node)
+	{
+		const Epic::Matrix4f local{ hierarchy.Translation(node), hierarchy.Rotation(node), hierarchy.Scale(node) };
+		const node_type parent = hierarchy.Parent(node);
+
+		if (parent == Hierarchy::InvalidNode)
+			return local;
+
+		return Epic::Matrix4f::CompositeOf(NaiveWorld(hierarchy, parent), local);
+	}
+
+	static void ExpectWorldsMatch(const Hierarchy& hierarchy, const std::vector<node_type>& nodes)
+	{
+		for (const node_type node : nodes)
+		{
+			const auto expected = NaiveWorld(hierarchy, node);
+			const auto& actual = hierarchy.World(node);
+
+			for (size_t i = 0; i < 16; ++i)
+				EXPECT_NEAR(actual.Values[i], expected.Values[i], 1e-3f);
+		}
+	}
+};
+
+TEST_F(TransformHierarchyTests, Update_MatchesParentChainComposition)
+{
+	Hierarchy hierarchy;
+	const auto nodes = MakeTree(hierarchy, 2000);
+
+	hierarchy.Update();
+
+	EXPECT_EQ(hierarchy.Changes().size(), nodes.size());
+	ExpectWorldsMatch(hierarchy, nodes);
+}
+
+TEST_F(TransformHierarchyTests, Update_OnlyRecomputesDirtySubtrees)
+{
+	Hierarchy hierarchy;
+
+	const auto root = hierarchy.Create();
+	const auto a = hierarchy.Create(root);
+	const auto b = hierarchy.Create(root);
+	const auto a1 = hierarchy.Create(a);
+	const auto b1 = hierarchy.Create(b);
+
+	hierarchy.Update();
+	hierarchy.Update();
+	EXPECT_TRUE(hierarchy.Changes().empty());
+
+	hierarchy.SetTranslation(a, Epic::Vector3f{ 1.f, 2.f, 3.f });
+	hierarchy.Update();
+
+	std::vector<node_type> expected{ a, a1 };
+	EXPECT_EQ(hierarchy.Changes(), expected);
+	EXPECT_FLOAT_EQ(hierarchy.World(a1).Values[13], 2.f);
+	EXPECT_FLOAT_EQ(hierarchy.World(b1).Values[13], 0.f);
+}
+
+TEST_F(TransformHierarchyTests, SetParent_ResortsLevels)
+{
+	Hierarchy hierarchy;
+	auto nodes = MakeTree(hierarchy, 500);
+
+	hierarchy.Update();
+
+	// Move a few subtrees underneath the deepest node
+	const node_type deepest = nodes.back();
+
+	for (size_t i = 1; i < 50; i += 7)
+	{
+		node_type ancestor = deepest;
+		bool isAncestor = false;
+
+		for (; ancestor != Hierarchy::InvalidNode; ancestor = hierarchy.Parent(ancestor))
+			isAncestor |= (ancestor == nodes[i]);
+
+		if (!isAncestor)
+			hierarchy.SetParent(nodes[i], deepest);
+	}
+
+	hierarchy.Update();
+
+	ExpectWorldsMatch(hierarchy, nodes);
+}
+
+TEST_F(TransformHierarchyTests, Destroy_RemovesDescendants)
+{
+	Hierarchy hierarchy;
+
+	const auto root = hierarchy.Create();
+	const auto a = hierarchy.Create(root);
+	const auto a1 = hierarchy.Create(a);
+	const auto a2 = hierarchy.Create(a1);
+	const auto b = hierarchy.Create(root, Epic::Vector3f{ 5.f, 0.f, 0.f }, Epic::Quaternionf{ Epic::Identity }, Epic::Vector3f{ Epic::One });
+
+	hierarchy.Update();
+	hierarchy.Destroy(a);
+
+	EXPECT_EQ(hierarchy.Size(), 2u);
+	EXPECT_FALSE(hierarchy.IsValid(a));
+	EXPECT_FALSE(hierarchy.IsValid(a1));
+	EXPECT_FALSE(hierarchy.IsValid(a2));
+	EXPECT_TRUE(hierarchy.IsValid(b));
+
+	hierarchy.SetTranslation(root, Epic::Vector3f{ 0.f, 1.f, 0.f });
+	hierarchy.Update();
+
+	EXPECT_FLOAT_EQ(hierarchy.World(b).Values[12], 5.f);
+	EXPECT_FLOAT_EQ(hierarchy.World(b).Values[13], 1.f);
+}
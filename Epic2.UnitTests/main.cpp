@@ -1,7 +1,30 @@
 #include <gtest/gtest.h>
 
+#include "Animation/AnimationBlendTreeTests.hpp"
+#include "Animation/AnimationClipTests.hpp"
+#include "Animation/AnimationCompressorTests.hpp"
+#include "Animation/InverseKinematicsTests.hpp"
+#include "Geometry/BoundingVolumesTests.hpp"
+#include "Geometry/ClosestPointsTests.hpp"
+#include "Geometry/ConvexHullTests.hpp"
+#include "Geometry/GJKTests.hpp"
+#include "Geometry/OBBTests.hpp"
+#include "Geometry/SpaceFillingCurvesTests.hpp"
+#include "Geometry/SpatialHashGridTests.hpp"
+#include "Geometry/SweptQueriesTests.hpp"
 #include "Math/AngleTests.hpp"
+#include "Math/MatrixDecompositionTests.hpp"
+#include "Math/ProjectionTests.hpp"
+#include "Math/QuaternionBatchTests.hpp"
+#include "Math/QuaternionTests.hpp"
 #include "Math/VectorTests.hpp"
+#include "Physics/ConstraintSolverTests.hpp"
+#include "Physics/RigidBodySetTests.hpp"
+#include "Render/CameraRelativeTests.hpp"
+#include "Render/LightClustersTests.hpp"
+#include "Render/OcclusionBufferTests.hpp"
+#include "Render/ShadowCascadesTests.hpp"
+#include "Scene/TransformHierarchyTests.hpp"
 
 int main(int argc, char **argv) 
 {
@@ -0,0 +1,32 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "detail/AnimationBlendTree_impl.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Externs
+namespace Epic
+{
+	extern template class AnimationBlendTree<float>;
+	extern template class AnimationBlendTree<double>;
+}
+
+// Aliases
+namespace Epic
+{
+	using AnimationBlendTreef = AnimationBlendTree<float>;
+	using AnimationBlendTreed = AnimationBlendTree<double>;
+}
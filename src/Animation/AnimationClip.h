@@ -0,0 +1,32 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "detail/AnimationClip_impl.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Externs
+namespace Epic
+{
+	extern template class AnimationClip<float>;
+	extern template class AnimationClip<double>;
+}
+
+// Aliases
+namespace Epic
+{
+	using AnimationClipf = AnimationClip<float>;
+	using AnimationClipd = AnimationClip<double>;
+}
@@ -0,0 +1,23 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "detail/AnimationClipBuilder_impl.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Explicit Instantiations
+namespace Epic
+{
+	template class AnimationClipBuilder<float>;
+	template class AnimationClipBuilder<double>;
+}
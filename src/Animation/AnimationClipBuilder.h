@@ -0,0 +1,32 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "detail/AnimationClipBuilder_impl.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Externs
+namespace Epic
+{
+	extern template class AnimationClipBuilder<float>;
+	extern template class AnimationClipBuilder<double>;
+}
+
+// Aliases
+namespace Epic
+{
+	using AnimationClipBuilderf = AnimationClipBuilder<float>;
+	using AnimationClipBuilderd = AnimationClipBuilder<double>;
+}
@@ -0,0 +1,23 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "detail/AnimationCompressor_impl.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Explicit Instantiations
+namespace Epic
+{
+	template class AnimationCompressor<float>;
+	template class AnimationCompressor<double>;
+}
@@ -0,0 +1,32 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "detail/AnimationPose_impl.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Externs
+namespace Epic
+{
+	extern template class AnimationPose<float>;
+	extern template class AnimationPose<double>;
+}
+
+// Aliases
+namespace Epic
+{
+	using AnimationPosef = AnimationPose<float>;
+	using AnimationPosed = AnimationPose<double>;
+}
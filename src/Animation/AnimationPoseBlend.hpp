@@ -0,0 +1,266 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cmath>
+
+#include "AnimationPose.h"
+#include "../Math/QuaternionBatch.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Pose blend kernels
+//	Branch-free per-joint kernels, inlined into the pose loops below so that they can be auto-vectorized.
+namespace Epic::detail
+{
+	// Normalized lerp along the shorter arc
+	template<class T>
+	inline void BlendRotationKernel(
+		T ax, T ay, T az, T aw,
+		T bx, T by, T bz, T bw,
+		T t, T& rx, T& ry, T& rz, T& rw) noexcept
+	{
+		const T dot = ax * bx + ay * by + az * bz + aw * bw;
+		const T s = T(1) - t;
+		const T u = (dot < T(0)) ? -t : t;
+
+		T x = ax * s + bx * u;
+		T y = ay * s + by * u;
+		T z = az * s + bz * u;
+		T w = aw * s + bw * u;
+
+		BatchNormalize(x, y, z, w);
+
+		rx = x; ry = y; rz = z; rw = w;
+	}
+
+	// r = a * b; matches Quaternion::Concatenate
+	template<class T>
+	inline void ConcatenateKernel(
+		T ax, T ay, T az, T aw,
+		T bx, T by, T bz, T bw,
+		T& rx, T& ry, T& rz, T& rw) noexcept
+	{
+		const T x = (ay * bz) - (az * by) + (aw * bx) + (ax * bw);
+		const T y = (az * bx) - (ax * bz) + (aw * by) + (ay * bw);
+		const T z = (ax * by) - (ay * bx) + (aw * bz) + (az * bw);
+		const T w = (aw * bw) - ((ax * bx) + (ay * by) + (az * bz));
+
+		rx = x; ry = y; rz = z; rw = w;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Pose blending
+//	Whole-pose operations over the SoA lanes of AnimationPose. Every pose must have the same joint count.
+//	Unless noted, the result may be any of the inputs. Where pJointWeights is given, the weight of each joint
+//	is scaled by it (e.g. to mask a layer to the upper body).
+namespace Epic
+{
+	// BlendPose - Blends from toward to; translation and scale are lerped and rotation is nlerped along the shorter arc.
+	template<class T>
+	void BlendPose(const AnimationPose<T>& from, const AnimationPose<T>& to, T weight, AnimationPose<T>& result,
+		const T* pJointWeights = nullptr) noexcept
+	{
+		const size_t count = result.JointCount();
+
+		assert(from.JointCount() == count && to.JointCount() == count);
+
+		const auto lerp = [&](const std::array<const T*, 3>& a, const std::array<const T*, 3>& b, const std::array<T*, 3>& r)
+		{
+			for (size_t c = 0; c < 3; ++c)
+			{
+				const T* pA = a[c];
+				const T* pB = b[c];
+				T* pR = r[c];
+
+				for (size_t j = 0; j < count; ++j)
+				{
+					const T t = pJointWeights ? weight * pJointWeights[j] : weight;
+					pR[j] = pA[j] + (pB[j] - pA[j]) * t;
+				}
+			}
+		};
+
+		lerp(from.Translations(), to.Translations(), result.Translations());
+		lerp(from.Scales(), to.Scales(), result.Scales());
+
+		const auto a = from.Rotations();
+		const auto b = to.Rotations();
+		const auto r = result.Rotations();
+
+		for (size_t j = 0; j < count; ++j)
+		{
+			const T t = pJointWeights ? weight * pJointWeights[j] : weight;
+
+			detail::BlendRotationKernel(
+				a[0][j], a[1][j], a[2][j], a[3][j],
+				b[0][j], b[1][j], b[2][j], b[3][j],
+				t, r[0][j], r[1][j], r[2][j], r[3][j]);
+		}
+	}
+
+	// BlendPoses - The weighted average of count poses, e.g. the samples of a blend space.
+	//	Rotations are summed on the hemisphere of the running sum and normalized (a weighted nlerp).
+	//	Weights should sum to 1. The result may only be the first pose.
+	template<class T>
+	void BlendPoses(const AnimationPose<T>* const* ppPoses, const T* pWeights, size_t count, AnimationPose<T>& result) noexcept
+	{
+		assert(count > 0);
+
+		const size_t jointCount = result.JointCount();
+
+		for (size_t p = 0; p < count; ++p)
+		{
+			const AnimationPose<T>& pose = *ppPoses[p];
+			const T weight = pWeights[p];
+
+			assert(pose.JointCount() == jointCount);
+			assert(p == 0 || &pose != &result);
+
+			const auto accumulate = [&](const std::array<const T*, 3>& a, const std::array<T*, 3>& r)
+			{
+				for (size_t c = 0; c < 3; ++c)
+				{
+					const T* pA = a[c];
+					T* pR = r[c];
+
+					if (p == 0)
+						for (size_t j = 0; j < jointCount; ++j) pR[j] = pA[j] * weight;
+					else
+						for (size_t j = 0; j < jointCount; ++j) pR[j] += pA[j] * weight;
+				}
+			};
+
+			accumulate(pose.Translations(), result.Translations());
+			accumulate(pose.Scales(), result.Scales());
+
+			const auto a = pose.Rotations();
+			const auto r = result.Rotations();
+
+			if (p == 0)
+			{
+				for (size_t c = 0; c < 4; ++c)
+					for (size_t j = 0; j < jointCount; ++j) r[c][j] = a[c][j] * weight;
+
+				continue;
+			}
+
+			for (size_t j = 0; j < jointCount; ++j)
+			{
+				const T dot = a[0][j] * r[0][j] + a[1][j] * r[1][j] + a[2][j] * r[2][j] + a[3][j] * r[3][j];
+				const T w = (dot < T(0)) ? -weight : weight;
+
+				for (size_t c = 0; c < 4; ++c)
+					r[c][j] += a[c][j] * w;
+			}
+		}
+
+		const auto r = result.Rotations();
+
+		for (size_t j = 0; j < jointCount; ++j)
+			detail::BatchNormalize(r[0][j], r[1][j], r[2][j], r[3][j]);
+	}
+
+	// MakeAdditivePose - The difference that takes reference to source, to be layered with ApplyAdditivePose.
+	//	translation = source - reference, rotation = Conjugate(reference) * source, scale = source / reference
+	template<class T>
+	void MakeAdditivePose(const AnimationPose<T>& source, const AnimationPose<T>& reference, AnimationPose<T>& result) noexcept
+	{
+		const size_t count = result.JointCount();
+
+		assert(source.JointCount() == count && reference.JointCount() == count);
+
+		const auto st = source.Translations();
+		const auto rt = reference.Translations();
+		const auto ss = source.Scales();
+		const auto rs = reference.Scales();
+		const auto dt = result.Translations();
+		const auto ds = result.Scales();
+
+		for (size_t c = 0; c < 3; ++c)
+		{
+			for (size_t j = 0; j < count; ++j)
+			{
+				dt[c][j] = st[c][j] - rt[c][j];
+				ds[c][j] = ss[c][j] / rs[c][j];
+			}
+		}
+
+		const auto a = reference.Rotations();
+		const auto b = source.Rotations();
+		const auto r = result.Rotations();
+
+		for (size_t j = 0; j < count; ++j)
+		{
+			detail::ConcatenateKernel(
+				-a[0][j], -a[1][j], -a[2][j], a[3][j],
+				b[0][j], b[1][j], b[2][j], b[3][j],
+				r[0][j], r[1][j], r[2][j], r[3][j]);
+		}
+	}
+
+	// ApplyAdditivePose - Layers an additive pose (see MakeAdditivePose) over base.
+	//	translation = base + additive * weight, rotation = base * Nlerp(Identity, additive, weight),
+	//	scale = base * Lerp(1, additive, weight)
+	template<class T>
+	void ApplyAdditivePose(const AnimationPose<T>& base, const AnimationPose<T>& additive, T weight, AnimationPose<T>& result,
+		const T* pJointWeights = nullptr) noexcept
+	{
+		const size_t count = result.JointCount();
+
+		assert(base.JointCount() == count && additive.JointCount() == count);
+
+		const auto bt = base.Translations();
+		const auto at = additive.Translations();
+		const auto bs = base.Scales();
+		const auto as = additive.Scales();
+		const auto rt = result.Translations();
+		const auto rs = result.Scales();
+
+		for (size_t c = 0; c < 3; ++c)
+		{
+			for (size_t j = 0; j < count; ++j)
+			{
+				const T t = pJointWeights ? weight * pJointWeights[j] : weight;
+
+				rt[c][j] = bt[c][j] + at[c][j] * t;
+				rs[c][j] = bs[c][j] * (T(1) + (as[c][j] - T(1)) * t);
+			}
+		}
+
+		const auto b = base.Rotations();
+		const auto a = additive.Rotations();
+		const auto r = result.Rotations();
+
+		for (size_t j = 0; j < count; ++j)
+		{
+			const T t = pJointWeights ? weight * pJointWeights[j] : weight;
+
+			T x, y, z, w;
+			detail::BlendRotationKernel(
+				T(0), T(0), T(0), T(1),
+				a[0][j], a[1][j], a[2][j], a[3][j],
+				t, x, y, z, w);
+
+			detail::ConcatenateKernel(
+				b[0][j], b[1][j], b[2][j], b[3][j],
+				x, y, z, w,
+				r[0][j], r[1][j], r[2][j], r[3][j]);
+		}
+	}
+}
@@ -0,0 +1,435 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "../Math/Quaternion.h"
+#include "../Math/Vector.h"
+#include "../Parallel/ParallelFor.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// IKSettings, IKResult
+namespace Epic
+{
+	// IKSettings - Limits of the iterative solvers.
+	//	A solver stops once the end effector is within Tolerance of the target or after MaxIterations.
+	template<class T>
+	struct IKSettings
+	{
+		size_t MaxIterations = 16;
+		T Tolerance = T(0.001);
+	};
+
+	// IKResult - The number of iterations run and the final distance between the end effector and the target
+	template<class T>
+	struct IKResult
+	{
+		size_t Iterations = 0;
+		T Error = T(0);
+	};
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace Epic::detail
+{
+	template<class T>
+	inline Vector<T, 3> LoadIKPoint(const std::array<T*, 3>& lanes, size_t i) noexcept
+	{
+		return { lanes[0][i], lanes[1][i], lanes[2][i] };
+	}
+
+	template<class T>
+	inline Vector<T, 3> LoadIKPoint(const std::array<const T*, 3>& lanes, size_t i) noexcept
+	{
+		return { lanes[0][i], lanes[1][i], lanes[2][i] };
+	}
+
+	template<class T>
+	inline void StoreIKPoint(const std::array<T*, 3>& lanes, size_t i, const Vector<T, 3>& point) noexcept
+	{
+		lanes[0][i] = point.x; lanes[1][i] = point.y; lanes[2][i] = point.z;
+	}
+
+	template<class T>
+	inline void StoreIKRotation(const std::array<T*, 4>& lanes, size_t i, const Quaternion<T>& rotation) noexcept
+	{
+		for (size_t c = 0; c < 4; ++c)
+			lanes[c][i] = rotation.Values[c];
+	}
+
+	template<class T>
+	inline Quaternion<T> LoadIKRotation(const std::array<T*, 4>& lanes, size_t i) noexcept
+	{
+		const T values[4] = { lanes[0][i], lanes[1][i], lanes[2][i], lanes[3][i] };
+		return Quaternion<T>{ values };
+	}
+
+	template<class T, size_t N>
+	inline std::array<T*, N> OffsetIKLanes(const std::array<T*, N>& lanes, size_t offset) noexcept
+	{
+		std::array<T*, N> result;
+
+		for (size_t c = 0; c < N; ++c)
+			result[c] = lanes[c] ? lanes[c] + offset : nullptr;
+
+		return result;
+	}
+
+	// Any unit vector perpendicular to v
+	template<class T>
+	inline Vector<T, 3> PerpendicularOf(const Vector<T, 3>& v) noexcept
+	{
+		const Vector<T, 3> axis = (std::abs(v.x) < std::abs(v.y)) ? Vector<T, 3>{ T(1), T(0), T(0) } : Vector<T, 3>{ T(0), T(1), T(0) };
+		return Vector<T, 3>{ v.Cross(axis) }.NormalizeSafe();
+	}
+
+	// The shortest rotation that turns the direction of from into the direction of to
+	template<class T>
+	inline Quaternion<T> RotationBetween(const Vector<T, 3>& from, const Vector<T, 3>& to) noexcept
+	{
+		const T m = std::sqrt(from.MagnitudeSq() * to.MagnitudeSq());
+
+		if (m <= T(0))
+			return Quaternion<T>{ Identity };
+
+		const T w = m + from.Dot(to);
+
+		// Opposite directions turn half way around any perpendicular axis
+		if (w <= m * T(1e-6))
+		{
+			const auto axis = PerpendicularOf(from);
+			const T values[4] = { axis.x, axis.y, axis.z, T(0) };
+			return Quaternion<T>{ values };
+		}
+
+		const Vector<T, 3> axis{ from.Cross(to) };
+		const T values[4] = { axis.x, axis.y, axis.z, w };
+
+		return Quaternion<T>{ values }.Normalize();
+	}
+
+	template<class T>
+	inline Vector<T, 3> RotatedIKPoint(const Quaternion<T>& rotation, const Vector<T, 3>& pivot, const Vector<T, 3>& point) noexcept
+	{
+		Vector<T, 3> offset = point - pivot;
+		rotation.Transform(offset);
+
+		return pivot + offset;
+	}
+
+	// FABRIK on one chain. pScratch holds 4 * count values: the bone lengths and the source positions.
+	template<class T>
+	IKResult<T> SolveFABRIK(const std::array<T*, 3>& positions, size_t count, const Vector<T, 3>& target,
+		const IKSettings<T>& settings, const std::array<T*, 4>& deltas, T* pScratch) noexcept
+	{
+		assert(count >= 2);
+
+		T* pLengths = pScratch;
+		const std::array<T*, 3> source = { pScratch + count, pScratch + count * 2, pScratch + count * 3 };
+
+		T reach = T(0);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			StoreIKPoint(source, i, LoadIKPoint(positions, i));
+
+			if (i + 1 < count)
+			{
+				pLengths[i] = (LoadIKPoint(positions, i + 1) - LoadIKPoint(positions, i)).Magnitude();
+				reach += pLengths[i];
+			}
+		}
+
+		const auto root = LoadIKPoint(positions, 0);
+
+		IKResult<T> result;
+		result.Error = (LoadIKPoint(positions, count - 1) - target).Magnitude();
+
+		if ((target - root).Magnitude() >= reach)
+		{
+			// Out of reach; stretch the chain toward the target
+			const Vector<T, 3> direction = Vector<T, 3>{ target - root }.NormalizeSafe();
+
+			for (size_t i = 1; i < count; ++i)
+				StoreIKPoint(positions, i, LoadIKPoint(positions, i - 1) + direction * pLengths[i - 1]);
+
+			result.Iterations = 1;
+			result.Error = (LoadIKPoint(positions, count - 1) - target).Magnitude();
+		}
+		else
+		{
+			while (result.Error > settings.Tolerance && result.Iterations < settings.MaxIterations)
+			{
+				// Backward: pin the end effector to the target
+				StoreIKPoint(positions, count - 1, target);
+
+				for (size_t i = count - 1; i-- > 0;)
+				{
+					const auto next = LoadIKPoint(positions, i + 1);
+					const Vector<T, 3> direction = Vector<T, 3>{ LoadIKPoint(positions, i) - next }.NormalizeSafe();
+
+					StoreIKPoint(positions, i, next + direction * pLengths[i]);
+				}
+
+				// Forward: pin the root back in place
+				StoreIKPoint(positions, 0, root);
+
+				for (size_t i = 1; i < count; ++i)
+				{
+					const auto previous = LoadIKPoint(positions, i - 1);
+					const Vector<T, 3> direction = Vector<T, 3>{ LoadIKPoint(positions, i) - previous }.NormalizeSafe();
+
+					StoreIKPoint(positions, i, previous + direction * pLengths[i - 1]);
+				}
+
+				++result.Iterations;
+				result.Error = (LoadIKPoint(positions, count - 1) - target).Magnitude();
+			}
+		}
+
+		if (deltas[0])
+		{
+			for (size_t i = 0; i + 1 < count; ++i)
+			{
+				const auto from = LoadIKPoint(source, i + 1) - LoadIKPoint(source, i);
+				const auto to = LoadIKPoint(positions, i + 1) - LoadIKPoint(positions, i);
+
+				StoreIKRotation(deltas, i, RotationBetween(from, to));
+			}
+
+			StoreIKRotation(deltas, count - 1, LoadIKRotation(deltas, count - 2));
+		}
+
+		return result;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Inverse kinematics
+//	Chains are given as SoA arrays of world space joint positions, from the root to the end effector.
+//	Solvers move the positions and can also write the world space rotation that takes each joint from its
+//	source orientation to its solved one (new world rotation = delta * old world rotation).
+namespace Epic
+{
+	// TwoBoneIK - Analytic IK of a root, mid and end joint (e.g. hip, knee and ankle).
+	//	The chain bends in the plane of the pole so that the mid joint points toward it. Writes the world space
+	//	deltas of the root and mid joints and returns whether the target is within reach.
+	template<class T>
+	bool TwoBoneIK(const Vector<T, 3>& root, const Vector<T, 3>& mid, const Vector<T, 3>& end,
+		const Vector<T, 3>& target, const Vector<T, 3>& pole, Quaternion<T>& rootDelta, Quaternion<T>& midDelta) noexcept
+	{
+		constexpr T Epsilon = T(1e-5);
+
+		const auto clampedAcos = [](T value) { return std::acos(std::clamp(value, T(-1), T(1))); };
+
+		const auto ab = mid - root;
+		const auto ac = end - root;
+		const auto bc = end - mid;
+		const auto at = target - root;
+
+		const T lab = ab.Magnitude();
+		const T lbc = bc.Magnitude();
+		const T lac = ac.Magnitude();
+		const T targetDistance = at.Magnitude();
+
+		if (lab <= Epsilon || lbc <= Epsilon || lac <= Epsilon || targetDistance <= Epsilon)
+		{
+			rootDelta = Identity;
+			midDelta = Identity;
+			return false;
+		}
+
+		const T lat = std::clamp(targetDistance, std::abs(lab - lbc) + Epsilon, lab + lbc - Epsilon);
+
+		// Open or close the chain so that the end is lat away from the root
+		const T rootAngle0 = clampedAcos(ac.Dot(ab) / (lac * lab));
+		const T midAngle0 = clampedAcos(-ab.Dot(bc) / (lab * lbc));
+		const T rootAngle1 = clampedAcos((lab * lab + lat * lat - lbc * lbc) / (T(2) * lab * lat));
+		const T midAngle1 = clampedAcos((lab * lab + lbc * lbc - lat * lat) / (T(2) * lab * lbc));
+
+		Vector<T, 3> axis{ ac.Cross(ab) };
+
+		if (axis.MagnitudeSq() <= Epsilon * Epsilon * lac * lab)
+			axis = Vector<T, 3>{ ac.Cross(pole - root) };
+
+		if (axis.MagnitudeSq() <= Epsilon * Epsilon)
+			axis = detail::PerpendicularOf(ac);
+
+		axis.Normalize();
+
+		const Quaternion<T> bendRoot{ axis, Radian<T>{ rootAngle1 - rootAngle0 } };
+		const Quaternion<T> bendMid{ axis, Radian<T>{ midAngle1 - midAngle0 } };
+
+		Vector<T, 3> bentMid = ab;
+		bendRoot.Transform(bentMid);
+
+		Vector<T, 3> bentEnd = bc;
+		bendMid.Transform(bentEnd);
+		bendRoot.Transform(bentEnd);
+		bentEnd += bentMid;
+
+		// Swing the end onto the target
+		const auto swing = detail::RotationBetween(bentEnd, at);
+		swing.Transform(bentMid);
+
+		// Twist about the target direction so that the mid joint faces the pole
+		const Vector<T, 3> direction = at / targetDistance;
+		const auto midOffset = bentMid - direction * bentMid.Dot(direction);
+		const auto poleOffset = (pole - root) - direction * (pole - root).Dot(direction);
+
+		T twistAngle = T(0);
+
+		if (midOffset.MagnitudeSq() > Epsilon * Epsilon && poleOffset.MagnitudeSq() > Epsilon * Epsilon)
+			twistAngle = std::atan2(Vector<T, 3>{ midOffset.Cross(poleOffset) }.Dot(direction), midOffset.Dot(poleOffset));
+
+		const Quaternion<T> twist{ direction, Radian<T>{ twistAngle } };
+		const Quaternion<T> solvedRoot = twist * swing * bendRoot;
+		const Quaternion<T> solvedMid = solvedRoot * bendMid;
+
+		rootDelta = solvedRoot;
+		midDelta = solvedMid;
+
+		return targetDistance <= lab + lbc && targetDistance >= std::abs(lab - lbc);
+	}
+
+	// SolveCCD - Cyclic coordinate descent; each iteration turns every joint from the end toward the root so
+	//	that the end effector points at the target.
+	template<class T>
+	IKResult<T> SolveCCD(const std::array<T*, 3>& positions, size_t count, const Vector<T, 3>& target,
+		const IKSettings<T>& settings, const std::array<T*, 4>& deltas = {}) noexcept
+	{
+		assert(count >= 2);
+
+		if (deltas[0])
+		{
+			for (size_t i = 0; i < count; ++i)
+				detail::StoreIKRotation(deltas, i, Quaternion<T>{ Identity });
+		}
+
+		IKResult<T> result;
+		result.Error = (detail::LoadIKPoint(positions, count - 1) - target).Magnitude();
+
+		while (result.Error > settings.Tolerance && result.Iterations < settings.MaxIterations)
+		{
+			for (size_t joint = count - 1; joint-- > 0;)
+			{
+				const auto pivot = detail::LoadIKPoint(positions, joint);
+				const auto rotation = detail::RotationBetween(detail::LoadIKPoint(positions, count - 1) - pivot, target - pivot);
+
+				for (size_t i = joint + 1; i < count; ++i)
+					detail::StoreIKPoint(positions, i, detail::RotatedIKPoint(rotation, pivot, detail::LoadIKPoint(positions, i)));
+
+				if (deltas[0])
+				{
+					for (size_t i = joint; i < count; ++i)
+						detail::StoreIKRotation(deltas, i, rotation * detail::LoadIKRotation(deltas, i));
+				}
+			}
+
+			++result.Iterations;
+			result.Error = (detail::LoadIKPoint(positions, count - 1) - target).Magnitude();
+		}
+
+		return result;
+	}
+
+	// SolveFABRIK - Forward and backward reaching IK (Aristidou & Lasenby, 2011).
+	//	Alternately pins the end effector to the target and the root to its origin, keeping bone lengths.
+	//	A target out of reach stretches the chain toward it. Deltas are the swing of each bone.
+	template<class T>
+	IKResult<T> SolveFABRIK(const std::array<T*, 3>& positions, size_t count, const Vector<T, 3>& target,
+		const IKSettings<T>& settings, const std::array<T*, 4>& deltas = {})
+	{
+		std::vector<T> scratch(count * 4);
+		return detail::SolveFABRIK(positions, count, target, settings, deltas, scratch.data());
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Batch inverse kinematics
+//	Solves many independent chains in parallel. Chains of jointCount joints are stored back to back in the
+//	position (and delta) lanes; targets, results and two-bone inputs hold one element per chain.
+namespace Epic
+{
+	template<class T>
+	void BatchTwoBoneIK(const std::array<const T*, 3>& roots, const std::array<const T*, 3>& mids, const std::array<const T*, 3>& ends,
+		const std::array<const T*, 3>& targets, const std::array<const T*, 3>& poles,
+		const std::array<T*, 4>& rootDeltas, const std::array<T*, 4>& midDeltas, size_t count)
+	{
+		ParallelFor(0, count, ParallelGrainSize(count, 256), [&](size_t begin, size_t end)
+		{
+			Quaternion<T> rootDelta, midDelta;
+
+			for (size_t i = begin; i < end; ++i)
+			{
+				TwoBoneIK(detail::LoadIKPoint(roots, i), detail::LoadIKPoint(mids, i), detail::LoadIKPoint(ends, i),
+					detail::LoadIKPoint(targets, i), detail::LoadIKPoint(poles, i), rootDelta, midDelta);
+
+				detail::StoreIKRotation(rootDeltas, i, rootDelta);
+				detail::StoreIKRotation(midDeltas, i, midDelta);
+			}
+		});
+	}
+
+	template<class T>
+	void BatchSolveCCD(const std::array<T*, 3>& positions, size_t chainCount, size_t jointCount,
+		const std::array<const T*, 3>& targets, const IKSettings<T>& settings,
+		IKResult<T>* pResults = nullptr, const std::array<T*, 4>& deltas = {})
+	{
+		ParallelFor(0, chainCount, ParallelGrainSize(chainCount, 64), [&](size_t begin, size_t end)
+		{
+			for (size_t chain = begin; chain < end; ++chain)
+			{
+				const size_t offset = chain * jointCount;
+
+				const auto result = SolveCCD(detail::OffsetIKLanes(positions, offset), jointCount, detail::LoadIKPoint(targets, chain),
+					settings, detail::OffsetIKLanes(deltas, offset));
+
+				if (pResults)
+					pResults[chain] = result;
+			}
+		});
+	}
+
+	template<class T>
+	void BatchSolveFABRIK(const std::array<T*, 3>& positions, size_t chainCount, size_t jointCount,
+		const std::array<const T*, 3>& targets, const IKSettings<T>& settings,
+		IKResult<T>* pResults = nullptr, const std::array<T*, 4>& deltas = {})
+	{
+		ParallelFor(0, chainCount, ParallelGrainSize(chainCount, 64), [&](size_t begin, size_t end)
+		{
+			std::vector<T> scratch(jointCount * 4);
+
+			for (size_t chain = begin; chain < end; ++chain)
+			{
+				const size_t offset = chain * jointCount;
+
+				const auto result = detail::SolveFABRIK(detail::OffsetIKLanes(positions, offset), jointCount, detail::LoadIKPoint(targets, chain),
+					settings, detail::OffsetIKLanes(deltas, offset), scratch.data());
+
+				if (pResults)
+					pResults[chain] = result;
+			}
+		});
+	}
+}
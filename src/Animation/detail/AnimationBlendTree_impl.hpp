@@ -0,0 +1,519 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "AnimationBlendTree_decl.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "../AnimationClip.h"
+#include "../AnimationPose.h"
+#include "../AnimationPoseBlend.hpp"
+#include "../AnimationPosePool.h"
+#include "../../Math/Vector.h"
+#include "../../Parallel/ParallelFor.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// AnimationBlendTree
+//	A tree of clips and blend nodes that evaluates into a whole AnimationPose.
+//	The tree is immutable once built and can be shared by any number of Instances, each of which holds the
+//	parameters, playback time and clip cursors of one character. Blending is done a whole pose at a time with
+//	the kernels of AnimationPoseBlend.hpp; intermediate poses come from an AnimationPosePool.
+//	Nodes whose weight is 0 or 1 only evaluate the child that contributes.
+template<class T>
+class Epic::AnimationBlendTree
+{
+	static_assert(std::is_floating_point_v<T>, "AnimationBlendTree requires floating point poses.");
+
+public:
+	using type = Epic::AnimationBlendTree<T>;
+	using value_type = T;
+	using node_type = std::uint32_t;
+	using parameter_type = std::uint32_t;
+	using clip_type = Epic::AnimationClip<T>;
+	using pose_type = Epic::AnimationPose<T>;
+	using pool_type = Epic::AnimationPosePool<T>;
+	using position_type = Epic::Vector<T, 2>;
+
+	static constexpr node_type InvalidNode = ~node_type(0);
+
+private:
+	enum class NodeKind
+	{
+		Clip,
+		Blend,
+		Additive,
+		Blend1D,
+		Blend2D
+	};
+
+	struct Node
+	{
+		NodeKind Kind;
+		std::uint32_t Clip;
+		std::array<parameter_type, 2> Parameters;
+		T Speed;
+		bool IsLooping;
+
+		// Blend: { from, to }; Additive: { base, additive, reference }; Blend1D/2D: the samples
+		std::vector<node_type> Children;
+
+		// Blend1D: the threshold of each sample; Blend2D: the x, y position of each sample
+		std::vector<T> Positions;
+
+		// Blend/Additive: optional per joint weights
+		std::vector<T> JointWeights;
+	};
+
+public:
+	// Instance - The state of one character evaluating the tree
+	class Instance
+	{
+		friend class Epic::AnimationBlendTree<T>;
+
+	private:
+		std::vector<T> m_Parameters;
+		std::vector<typename clip_type::Cursor> m_Cursors;
+		T m_Time;
+
+		// Blend2D scratch; used as stacks so that nested blend spaces share them
+		std::vector<T> m_BlendWeights;
+		std::vector<pose_type*> m_BlendPoses;
+
+	public:
+		Instance() noexcept
+			: m_Time{ T(0) }
+		{ }
+
+	public:
+		T Time() const noexcept { return m_Time; }
+		void SetTime(T time) noexcept { m_Time = time; }
+		void Advance(T deltaTime) noexcept { m_Time += deltaTime; }
+
+		T Parameter(parameter_type parameter) const noexcept
+		{
+			assert(parameter < m_Parameters.size());
+			return m_Parameters[parameter];
+		}
+
+		void SetParameter(parameter_type parameter, T value) noexcept
+		{
+			assert(parameter < m_Parameters.size());
+			m_Parameters[parameter] = value;
+		}
+	};
+
+private:
+	size_t m_JointCount;
+	node_type m_Root;
+
+	std::vector<Node> m_Nodes;
+	std::vector<clip_type> m_Clips;
+	std::vector<T> m_DefaultParameters;
+
+public:
+	explicit AnimationBlendTree(size_t jointCount)
+		: m_JointCount{ jointCount }, m_Root{ InvalidNode }
+	{ }
+
+	AnimationBlendTree(const AnimationBlendTree&) = default;
+	AnimationBlendTree(AnimationBlendTree&&) noexcept = default;
+	~AnimationBlendTree() = default;
+
+	AnimationBlendTree& operator = (const AnimationBlendTree&) = default;
+	AnimationBlendTree& operator = (AnimationBlendTree&&) noexcept = default;
+
+public:
+	size_t JointCount() const noexcept { return m_JointCount; }
+	size_t NodeCount() const noexcept { return m_Nodes.size(); }
+	size_t ParameterCount() const noexcept { return m_DefaultParameters.size(); }
+
+	node_type Root() const noexcept { return m_Root; }
+
+	void SetRoot(node_type node) noexcept
+	{
+		assert(node < m_Nodes.size());
+		m_Root = node;
+	}
+
+public:
+	// Adds a parameter that instances start with at value
+	parameter_type AddParameter(T value = T(0))
+	{
+		m_DefaultParameters.push_back(value);
+		return static_cast<parameter_type>(m_DefaultParameters.size() - 1);
+	}
+
+	// Plays a clip at speed times the instance time; a looping clip wraps at its duration, otherwise it holds its last pose.
+	//	The clip data must outlive the tree.
+	node_type AddClip(const clip_type& clip, T speed = T(1), bool isLooping = true)
+	{
+		assert(clip.IsValid() && clip.JointCount() == m_JointCount);
+
+		Node node = MakeNode(NodeKind::Clip);
+		node.Clip = static_cast<std::uint32_t>(m_Clips.size());
+		node.Speed = speed;
+		node.IsLooping = isLooping;
+
+		m_Clips.push_back(clip);
+
+		return Push(std::move(node));
+	}
+
+	// Blends from toward to by the value of weight, clamped to [0, 1].
+	//	With joint weights the blend acts as a layer, e.g. an upper body masked over locomotion.
+	node_type AddBlend(node_type from, node_type to, parameter_type weight, std::vector<T> jointWeights = {})
+	{
+		assert(jointWeights.empty() || jointWeights.size() == m_JointCount);
+
+		Node node = MakeNode(NodeKind::Blend);
+		node.Children = { from, to };
+		node.Parameters[0] = weight;
+		node.JointWeights = std::move(jointWeights);
+
+		return Push(std::move(node));
+	}
+
+	// Layers the difference between additive and reference over base, scaled by the value of weight.
+	//	If reference is InvalidNode, additive must already evaluate to an additive pose (see MakeAdditivePose).
+	node_type AddAdditive(node_type base, node_type additive, node_type reference, parameter_type weight, std::vector<T> jointWeights = {})
+	{
+		assert(jointWeights.empty() || jointWeights.size() == m_JointCount);
+
+		Node node = MakeNode(NodeKind::Additive);
+		node.Children = { base, additive, reference };
+		node.Parameters[0] = weight;
+		node.JointWeights = std::move(jointWeights);
+
+		return Push(std::move(node));
+	}
+
+	// A one dimensional blend space; blends the two samples whose thresholds surround the value of parameter.
+	//	Thresholds must be increasing.
+	node_type AddBlend1D(std::vector<node_type> samples, std::vector<T> thresholds, parameter_type parameter)
+	{
+		assert(!samples.empty() && samples.size() == thresholds.size());
+		assert(std::is_sorted(std::begin(thresholds), std::end(thresholds)));
+
+		Node node = MakeNode(NodeKind::Blend1D);
+		node.Children = std::move(samples);
+		node.Positions = std::move(thresholds);
+		node.Parameters[0] = parameter;
+
+		return Push(std::move(node));
+	}
+
+	// A two dimensional blend space; blends the samples around (x, y) with gradient band interpolation.
+	//	Weights vary continuously with (x, y), are 1 at a sample's own position and 0 at every other sample's position.
+	node_type AddBlend2D(std::vector<node_type> samples, const std::vector<position_type>& positions, parameter_type x, parameter_type y)
+	{
+		assert(!samples.empty() && samples.size() == positions.size());
+
+		Node node = MakeNode(NodeKind::Blend2D);
+		node.Children = std::move(samples);
+		node.Parameters = { x, y };
+
+		for (const auto& position : positions)
+		{
+			node.Positions.push_back(position.x);
+			node.Positions.push_back(position.y);
+		}
+
+		return Push(std::move(node));
+	}
+
+public:
+	// Creates an instance with the default parameters, at time 0
+	Instance CreateInstance() const
+	{
+		Instance instance;
+
+		instance.m_Parameters = m_DefaultParameters;
+		instance.m_Cursors.resize(m_Clips.size());
+
+		return instance;
+	}
+
+	// Calculates the weight of each sample of the Blend2D node for the parameters of instance.
+	//	pWeights must hold one weight per sample; the weights sum to 1.
+	void Blend2DWeights(node_type index, const Instance& instance, T* pWeights) const
+	{
+		const Node& node = m_Nodes[index];
+
+		assert(node.Kind == NodeKind::Blend2D);
+
+		CalculateBlend2DWeights(node, instance.m_Parameters[node.Parameters[0]], instance.m_Parameters[node.Parameters[1]], pWeights);
+	}
+
+	// Evaluates the tree for one instance into result
+	void Evaluate(Instance& instance, pool_type& pool, pose_type& result) const
+	{
+		assert(m_Root != InvalidNode);
+		assert(instance.m_Cursors.size() == m_Clips.size() && instance.m_Parameters.size() == m_DefaultParameters.size());
+		assert(result.JointCount() == m_JointCount);
+
+		EvaluateNode(m_Root, instance, pool, result);
+	}
+
+	// Evaluates count instances in parallel, instance i into pPoses[i].
+	//	pools is grown to one pool per chunk of instances and should be kept between calls, so that warm pools are reused.
+	void Evaluate(Instance* pInstances, pose_type* pPoses, size_t count, std::vector<pool_type>& pools) const
+	{
+		const size_t grainSize = ParallelGrainSize(count, 4);
+		const size_t chunkCount = ParallelChunkCount(count, grainSize);
+
+		if (pools.size() < chunkCount)
+			pools.resize(chunkCount);
+
+		ParallelForChunks(0, count, grainSize, [&](size_t chunk, size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+				Evaluate(pInstances[i], pools[chunk], pPoses[i]);
+		});
+	}
+
+private:
+	static Node MakeNode(NodeKind kind) noexcept
+	{
+		Node node;
+
+		node.Kind = kind;
+		node.Clip = 0;
+		node.Parameters = { 0, 0 };
+		node.Speed = T(1);
+		node.IsLooping = false;
+
+		return node;
+	}
+
+	node_type Push(Node&& node)
+	{
+		assert(std::all_of(std::begin(node.Children), std::end(node.Children),
+			[&](node_type child) { return child < m_Nodes.size() || child == InvalidNode; }));
+		assert(std::all_of(std::begin(node.Parameters), std::end(node.Parameters),
+			[&](parameter_type p) { return p < m_DefaultParameters.size() || node.Kind == NodeKind::Clip; }));
+
+		m_Nodes.emplace_back(std::move(node));
+
+		return static_cast<node_type>(m_Nodes.size() - 1);
+	}
+
+	void EvaluateNode(node_type index, Instance& instance, pool_type& pool, pose_type& result) const
+	{
+		const Node& node = m_Nodes[index];
+
+		switch (node.Kind)
+		{
+		case NodeKind::Clip:		EvaluateClip(node, instance, result); break;
+		case NodeKind::Blend:		EvaluateBlend(node, instance, pool, result); break;
+		case NodeKind::Additive:	EvaluateAdditive(node, instance, pool, result); break;
+		case NodeKind::Blend1D:		EvaluateBlend1D(node, instance, pool, result); break;
+		case NodeKind::Blend2D:		EvaluateBlend2D(node, instance, pool, result); break;
+		}
+	}
+
+	void EvaluateClip(const Node& node, Instance& instance, pose_type& result) const
+	{
+		const clip_type& clip = m_Clips[node.Clip];
+		const T duration = clip.Duration();
+
+		T time = instance.m_Time * node.Speed;
+
+		if (node.IsLooping && duration > T(0))
+		{
+			time = std::fmod(time, duration);
+
+			if (time < T(0))
+				time += duration;
+		}
+
+		clip.Sample(time, instance.m_Cursors[node.Clip], result);
+	}
+
+	// Evaluates result = Blend(from, to, weight), skipping whichever child does not contribute
+	void EvaluatePair(node_type from, node_type to, T weight, const T* pJointWeights, Instance& instance, pool_type& pool, pose_type& result) const
+	{
+		if (!pJointWeights && weight <= T(0))
+			return EvaluateNode(from, instance, pool, result);
+
+		if (!pJointWeights && weight >= T(1))
+			return EvaluateNode(to, instance, pool, result);
+
+		pose_type& pose = pool.Acquire(m_JointCount);
+
+		EvaluateNode(from, instance, pool, result);
+		EvaluateNode(to, instance, pool, pose);
+
+		BlendPose(result, pose, weight, result, pJointWeights);
+
+		pool.Release(pose);
+	}
+
+	void EvaluateBlend(const Node& node, Instance& instance, pool_type& pool, pose_type& result) const
+	{
+		const T weight = std::clamp(instance.m_Parameters[node.Parameters[0]], T(0), T(1));
+		const T* pJointWeights = node.JointWeights.empty() ? nullptr : node.JointWeights.data();
+
+		EvaluatePair(node.Children[0], node.Children[1], weight, pJointWeights, instance, pool, result);
+	}
+
+	void EvaluateAdditive(const Node& node, Instance& instance, pool_type& pool, pose_type& result) const
+	{
+		const T weight = instance.m_Parameters[node.Parameters[0]];
+		const T* pJointWeights = node.JointWeights.empty() ? nullptr : node.JointWeights.data();
+
+		EvaluateNode(node.Children[0], instance, pool, result);
+
+		if (weight == T(0))
+			return;
+
+		pose_type& additive = pool.Acquire(m_JointCount);
+
+		EvaluateNode(node.Children[1], instance, pool, additive);
+
+		if (node.Children[2] != InvalidNode)
+		{
+			pose_type& reference = pool.Acquire(m_JointCount);
+
+			EvaluateNode(node.Children[2], instance, pool, reference);
+			MakeAdditivePose(additive, reference, additive);
+
+			pool.Release(reference);
+		}
+
+		ApplyAdditivePose(result, additive, weight, result, pJointWeights);
+
+		pool.Release(additive);
+	}
+
+	void EvaluateBlend1D(const Node& node, Instance& instance, pool_type& pool, pose_type& result) const
+	{
+		const T value = instance.m_Parameters[node.Parameters[0]];
+		const auto& thresholds = node.Positions;
+
+		const size_t upper = std::upper_bound(std::begin(thresholds), std::end(thresholds), value) - std::begin(thresholds);
+
+		if (upper == 0)
+			return EvaluateNode(node.Children.front(), instance, pool, result);
+
+		if (upper == thresholds.size())
+			return EvaluateNode(node.Children.back(), instance, pool, result);
+
+		const size_t lower = upper - 1;
+		const T span = thresholds[upper] - thresholds[lower];
+		const T weight = (span > T(0)) ? (value - thresholds[lower]) / span : T(0);
+
+		EvaluatePair(node.Children[lower], node.Children[upper], weight, nullptr, instance, pool, result);
+	}
+
+	// Gradient band interpolation: each sample's influence falls off linearly along the direction toward every
+	//	other sample and is the minimum over them. The nearest sample always has an influence of at least 1/2.
+	static void CalculateBlend2DWeights(const Node& node, T x, T y, T* pWeights) noexcept
+	{
+		const size_t count = node.Children.size();
+		const T* pPositions = node.Positions.data();
+
+		T total = T(0);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const T px = x - pPositions[i * 2];
+			const T py = y - pPositions[i * 2 + 1];
+
+			T influence = (count == 1) ? T(1) : std::numeric_limits<T>::max();
+
+			for (size_t j = 0; j < count && influence > T(0); ++j)
+			{
+				const T ex = pPositions[j * 2] - pPositions[i * 2];
+				const T ey = pPositions[j * 2 + 1] - pPositions[i * 2 + 1];
+				const T lengthSq = ex * ex + ey * ey;
+
+				// Skips i itself and any coincident sample
+				if (lengthSq <= T(1e-12))
+					continue;
+
+				influence = std::min(influence, T(1) - (px * ex + py * ey) / lengthSq);
+			}
+
+			pWeights[i] = std::max(influence, T(0));
+			total += pWeights[i];
+		}
+
+		assert(total > T(0));
+
+		const T invTotal = T(1) / total;
+
+		for (size_t i = 0; i < count; ++i)
+			pWeights[i] *= invTotal;
+	}
+
+	void EvaluateBlend2D(const Node& node, Instance& instance, pool_type& pool, pose_type& result) const
+	{
+		const size_t count = node.Children.size();
+		const size_t weightBase = instance.m_BlendWeights.size();
+		const size_t poseBase = instance.m_BlendPoses.size();
+
+		instance.m_BlendWeights.resize(weightBase + count);
+
+		CalculateBlend2DWeights(node,
+			instance.m_Parameters[node.Parameters[0]], instance.m_Parameters[node.Parameters[1]],
+			instance.m_BlendWeights.data() + weightBase);
+
+		const size_t contributing = static_cast<size_t>(std::count_if(
+			std::begin(instance.m_BlendWeights) + weightBase, std::end(instance.m_BlendWeights),
+			[](T weight) { return weight > T(0); }));
+
+		// Evaluate the contributing samples, compacting their weights to the front of the scratch.
+		//	Children may push onto the scratch stacks, so only offsets are held across EvaluateNode.
+		size_t sampleCount = 0;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const T weight = instance.m_BlendWeights[weightBase + i];
+
+			if (weight <= T(0))
+				continue;
+
+			if (contributing == 1)
+			{
+				instance.m_BlendWeights.resize(weightBase);
+				return EvaluateNode(node.Children[i], instance, pool, result);
+			}
+
+			pose_type& pose = (sampleCount == 0) ? result : pool.Acquire(m_JointCount);
+
+			EvaluateNode(node.Children[i], instance, pool, pose);
+
+			instance.m_BlendWeights[weightBase + sampleCount] = weight;
+			instance.m_BlendPoses.push_back(&pose);
+			++sampleCount;
+		}
+
+		BlendPoses(instance.m_BlendPoses.data() + poseBase, instance.m_BlendWeights.data() + weightBase, sampleCount, result);
+
+		for (size_t s = 1; s < sampleCount; ++s)
+			pool.Release(*instance.m_BlendPoses[poseBase + s]);
+
+		instance.m_BlendWeights.resize(weightBase);
+		instance.m_BlendPoses.resize(poseBase);
+	}
+};
@@ -0,0 +1,226 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "AnimationClipBuilder_decl.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "../AnimationClip.h"
+#include "../../Math/Quaternion.h"
+#include "../../Math/Vector.h"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// AnimationClipBuilder
+//	Collects keyframes per joint and serializes them into the layout viewed by AnimationClip.
+//	The result can be written to disk as-is and later mapped back into memory.
+template<class T>
+class Epic::AnimationClipBuilder
+{
+	static_assert(std::is_floating_point_v<T>, "AnimationClipBuilder requires floating point keys.");
+
+public:
+	using type = Epic::AnimationClipBuilder<T>;
+	using value_type = T;
+	using vector_type = Epic::Vector<T, 3>;
+	using quaternion_type = Epic::Quaternion<T>;
+	using header_type = Epic::detail::AnimationClipHeader;
+
+private:
+	struct Key
+	{
+		T Time;
+		std::array<T, 4> Value;
+	};
+
+	using track_type = std::vector<Key>;
+
+private:
+	size_t m_JointCount;
+	std::array<std::vector<track_type>, 3> m_Tracks;
+
+public:
+	explicit AnimationClipBuilder(size_t jointCount)
+		: m_JointCount{ jointCount }
+	{
+		for (auto& tracks : m_Tracks)
+			tracks.resize(jointCount);
+	}
+
+	AnimationClipBuilder(const AnimationClipBuilder&) = default;
+	AnimationClipBuilder(AnimationClipBuilder&&) noexcept = default;
+	~AnimationClipBuilder() = default;
+
+	AnimationClipBuilder& operator = (const AnimationClipBuilder&) = default;
+	AnimationClipBuilder& operator = (AnimationClipBuilder&&) noexcept = default;
+
+public:
+	size_t JointCount() const noexcept { return m_JointCount; }
+
+	// The time of the last key of any track
+	T Duration() const noexcept
+	{
+		T result = T(0);
+
+		for (const auto& tracks : m_Tracks)
+			for (const auto& track : tracks)
+				for (const auto& key : track)
+					result = std::max(result, key.Time);
+
+		return result;
+	}
+
+	void Clear() noexcept
+	{
+		for (auto& tracks : m_Tracks)
+			for (auto& track : tracks)
+				track.clear();
+	}
+
+public:
+	void AddTranslationKey(size_t joint, T time, const vector_type& translation)
+	{
+		AddKey(AnimationChannel::Translation, joint, time, { translation.x, translation.y, translation.z, T(0) });
+	}
+
+	void AddRotationKey(size_t joint, T time, const quaternion_type& rotation)
+	{
+		AddKey(AnimationChannel::Rotation, joint, time, { rotation.x, rotation.y, rotation.z, rotation.w });
+	}
+
+	void AddScaleKey(size_t joint, T time, const vector_type& scale)
+	{
+		AddKey(AnimationChannel::Scale, joint, time, { scale.x, scale.y, scale.z, T(0) });
+	}
+
+public:
+	// Serializes the clip. Keys are stably sorted by time; a track without keys receives a single identity key.
+	std::vector<std::uint8_t> Build() const
+	{
+		header_type header{};
+
+		header.Magic = header_type::MagicValue;
+		header.Version = header_type::CurrentVersion;
+		header.ValueSize = static_cast<std::uint32_t>(sizeof(T));
+		header.JointCount = static_cast<std::uint32_t>(m_JointCount);
+		header.Duration = static_cast<double>(Duration());
+
+		std::array<std::vector<std::uint32_t>, 3> keyStarts;
+		std::array<std::vector<T>, 3> times;
+		std::array<std::array<std::vector<T>, 4>, 3> values;
+
+		size_t offset = AlignOffset(sizeof(header_type));
+
+		for (size_t channel = 0; channel < 3; ++channel)
+		{
+			const size_t componentCount = detail::ComponentCountOf(AnimationChannel(channel));
+
+			keyStarts[channel].push_back(0);
+
+			for (const auto& source : m_Tracks[channel])
+			{
+				track_type track = source;
+
+				if (track.empty())
+					track.push_back({ T(0), IdentityOf(AnimationChannel(channel)) });
+
+				std::stable_sort(std::begin(track), std::end(track), [](const Key& a, const Key& b) { return a.Time < b.Time; });
+
+				for (const auto& key : track)
+				{
+					times[channel].push_back(key.Time);
+
+					for (size_t c = 0; c < componentCount; ++c)
+						values[channel][c].push_back(key.Value[c]);
+				}
+
+				keyStarts[channel].push_back(static_cast<std::uint32_t>(times[channel].size()));
+			}
+
+			const size_t keyCount = times[channel].size();
+			assert(keyCount < size_t(~std::uint32_t(0)));
+
+			header.KeyCounts[channel] = static_cast<std::uint32_t>(keyCount);
+
+			header.KeyStartOffsets[channel] = offset;
+			offset = AlignOffset(offset + keyStarts[channel].size() * sizeof(std::uint32_t));
+
+			header.TimeOffsets[channel] = offset;
+			offset = AlignOffset(offset + keyCount * sizeof(T));
+
+			for (size_t c = 0; c < componentCount; ++c)
+			{
+				header.ValueOffsets[channel][c] = offset;
+				offset = AlignOffset(offset + keyCount * sizeof(T));
+			}
+		}
+
+		header.Size = offset;
+
+		std::vector<std::uint8_t> data(offset, 0);
+
+		std::memcpy(data.data(), &header, sizeof(header_type));
+
+		for (size_t channel = 0; channel < 3; ++channel)
+		{
+			Write(data, header.KeyStartOffsets[channel], keyStarts[channel]);
+			Write(data, header.TimeOffsets[channel], times[channel]);
+
+			for (size_t c = 0; c < detail::ComponentCountOf(AnimationChannel(channel)); ++c)
+				Write(data, header.ValueOffsets[channel][c], values[channel][c]);
+		}
+
+		return data;
+	}
+
+private:
+	void AddKey(AnimationChannel channel, size_t joint, T time, std::array<T, 4> value)
+	{
+		assert(joint < m_JointCount);
+		assert(time >= T(0));
+
+		m_Tracks[size_t(channel)][joint].push_back({ time, value });
+	}
+
+	static std::array<T, 4> IdentityOf(AnimationChannel channel) noexcept
+	{
+		switch (channel)
+		{
+		case AnimationChannel::Rotation:	return { T(0), T(0), T(0), T(1) };
+		case AnimationChannel::Scale:		return { T(1), T(1), T(1), T(0) };
+		default:							return { T(0), T(0), T(0), T(0) };
+		}
+	}
+
+	static size_t AlignOffset(size_t offset) noexcept
+	{
+		constexpr size_t Alignment = detail::AnimationClipAlignment;
+
+		return (offset + Alignment - 1) & ~(Alignment - 1);
+	}
+
+	template<class U>
+	static void Write(std::vector<std::uint8_t>& data, std::uint64_t offset, const std::vector<U>& values) noexcept
+	{
+		if (!values.empty())
+			std::memcpy(data.data() + offset, values.data(), values.size() * sizeof(U));
+	}
+};
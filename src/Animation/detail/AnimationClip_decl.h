@@ -0,0 +1,31 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace Epic
+{
+	enum class AnimationChannel : std::uint32_t
+	{
+		Translation,
+		Rotation,
+		Scale
+	};
+
+	template<class T>
+	class AnimationClip;
+}
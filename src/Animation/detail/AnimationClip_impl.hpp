@@ -0,0 +1,368 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "AnimationClip_decl.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../AnimationPose.h"
+#include "../../Math/QuaternionBatch.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace Epic::detail
+{
+	// The layout of a serialized clip. Offsets are in bytes from the start of the header and every
+	// section is aligned to AnimationClipAlignment, so a clip can be sampled directly from a mapped file.
+	struct AnimationClipHeader
+	{
+		static constexpr std::uint32_t MagicValue = 0x43415045;	// "EPAC"
+		static constexpr std::uint32_t CurrentVersion = 1;
+
+		std::uint32_t Magic;
+		std::uint32_t Version;
+		std::uint32_t ValueSize;
+		std::uint32_t JointCount;
+		std::uint64_t Size;
+		double Duration;
+
+		// Per channel: the total number of keys, the first key of each joint (JointCount + 1 entries),
+		// the key times, and one array of values per component
+		std::uint32_t KeyCounts[3];
+		std::uint32_t Reserved;
+		std::uint64_t KeyStartOffsets[3];
+		std::uint64_t TimeOffsets[3];
+		std::uint64_t ValueOffsets[3][4];
+	};
+
+	constexpr size_t AnimationClipAlignment = 16;
+
+	constexpr size_t ComponentCountOf(AnimationChannel channel) noexcept
+	{
+		return (channel == AnimationChannel::Rotation) ? 4 : 3;
+	}
+
+	// Finds the last key of a track at or before time, starting from the key found by the previous search.
+	// Searching forward steps past a few keys before falling back to a binary search; searching backward
+	// only considers the keys before the cached one.
+	template<class Time, class T>
+	std::uint32_t SeekAnimationKey(const Time* pTimes, std::uint32_t count, std::uint32_t key, T time) noexcept
+	{
+		constexpr std::uint32_t MaxLinearSteps = 4;
+
+		const auto compare = [](T value, Time keyTime) { return value < T(keyTime); };
+
+		if (key >= count)
+			key = 0;
+
+		if (time < T(pTimes[key]))
+		{
+			const Time* pFound = std::upper_bound(pTimes, pTimes + key, time, compare);
+			return (pFound == pTimes) ? 0 : static_cast<std::uint32_t>(pFound - pTimes - 1);
+		}
+
+		for (std::uint32_t step = 0; step < MaxLinearSteps; ++step)
+		{
+			if (key + 1 >= count || T(pTimes[key + 1]) > time)
+				return key;
+
+			++key;
+		}
+
+		const Time* pFound = std::upper_bound(pTimes + key, pTimes + count, time, compare);
+		return static_cast<std::uint32_t>(pFound - pTimes - 1);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// AnimationClip
+//	A read-only view of a serialized clip (see AnimationClipBuilder).
+//	Each joint has a translation, rotation and scale track; the keys of every track are sorted by time and
+//	stored as one array per component. The view never copies or parses the data, which must outlive it.
+template<class T>
+class Epic::AnimationClip
+{
+	static_assert(std::is_floating_point_v<T>, "AnimationClip requires floating point keys.");
+
+public:
+	using type = Epic::AnimationClip<T>;
+	using value_type = T;
+	using pose_type = Epic::AnimationPose<T>;
+	using header_type = Epic::detail::AnimationClipHeader;
+
+public:
+	// Cursor - The playback state of one clip instance.
+	//	Remembers the key each track was last sampled at, so that sampling forward in time only has to
+	//	step past a key or two instead of searching the track. Also owns the scratch lanes used while sampling.
+	class Cursor
+	{
+		friend class Epic::AnimationClip<T>;
+
+	private:
+		std::vector<std::uint32_t> m_Keys;
+		std::array<std::vector<T>, 4> m_From;
+		std::array<std::vector<T>, 4> m_To;
+		std::vector<T> m_Alpha;
+
+	public:
+		// Forgets the cached keys, e.g. after jumping to an unrelated time
+		void Reset() noexcept
+		{
+			std::fill(std::begin(m_Keys), std::end(m_Keys), std::uint32_t(0));
+		}
+
+	private:
+		void Prepare(size_t jointCount)
+		{
+			if (m_Keys.size() == jointCount * 3)
+				return;
+
+			m_Keys.assign(jointCount * 3, 0);
+			m_Alpha.resize(jointCount);
+
+			for (size_t c = 0; c < 4; ++c)
+			{
+				m_From[c].resize(jointCount);
+				m_To[c].resize(jointCount);
+			}
+		}
+
+		template<size_t N>
+		std::array<const T*, N> From() const noexcept
+		{
+			std::array<const T*, N> result;
+
+			for (size_t c = 0; c < N; ++c)
+				result[c] = m_From[c].data();
+
+			return result;
+		}
+
+		template<size_t N>
+		std::array<const T*, N> To() const noexcept
+		{
+			std::array<const T*, N> result;
+
+			for (size_t c = 0; c < N; ++c)
+				result[c] = m_To[c].data();
+
+			return result;
+		}
+	};
+
+private:
+	const std::uint8_t* m_pData;
+	const header_type* m_pHeader;
+
+public:
+	AnimationClip() noexcept
+		: m_pData{ nullptr }, m_pHeader{ nullptr }
+	{ }
+
+	// Views serialized clip data. If the data is malformed or was built for a different value type,
+	// the clip is left invalid.
+	AnimationClip(const void* pData, size_t size) noexcept
+		: m_pData{ static_cast<const std::uint8_t*>(pData) }, m_pHeader{ nullptr }
+	{
+		if (IsValidData(m_pData, size))
+			m_pHeader = reinterpret_cast<const header_type*>(m_pData);
+	}
+
+	AnimationClip(const AnimationClip&) noexcept = default;
+	~AnimationClip() noexcept = default;
+
+	AnimationClip& operator = (const AnimationClip&) noexcept = default;
+
+public:
+	bool IsValid() const noexcept { return m_pHeader != nullptr; }
+
+	size_t JointCount() const noexcept { return IsValid() ? m_pHeader->JointCount : 0; }
+	T Duration() const noexcept { return IsValid() ? static_cast<T>(m_pHeader->Duration) : T(0); }
+	size_t Size() const noexcept { return IsValid() ? static_cast<size_t>(m_pHeader->Size) : 0; }
+
+	// The number of keys in one track
+	size_t KeyCount(AnimationChannel channel, size_t joint) const noexcept
+	{
+		assert(joint < JointCount());
+
+		const std::uint32_t* pKeyStart = KeyStarts(channel);
+		return pKeyStart[joint + 1] - pKeyStart[joint];
+	}
+
+	// The key times of one track
+	const T* KeyTimes(AnimationChannel channel, size_t joint) const noexcept
+	{
+		assert(joint < JointCount());
+		return Times(channel) + KeyStarts(channel)[joint];
+	}
+
+	// One component of the key values of one track
+	const T* KeyValues(AnimationChannel channel, size_t component, size_t joint) const noexcept
+	{
+		assert(joint < JointCount());
+		return Values(channel, component) + KeyStarts(channel)[joint];
+	}
+
+public:
+	// Samples every joint at time (clamped to [0, Duration]) into pose.
+	// Translation and scale are interpolated linearly and rotation with Quaternion::SlerpFast.
+	void Sample(T time, Cursor& cursor, pose_type& pose) const
+	{
+		assert(IsValid());
+		assert(pose.JointCount() == JointCount());
+
+		cursor.Prepare(JointCount());
+
+		time = std::clamp(time, T(0), Duration());
+
+		SampleChannel<AnimationChannel::Translation>(time, cursor, pose.Translations());
+		SampleChannel<AnimationChannel::Rotation>(time, cursor, pose.Rotations());
+		SampleChannel<AnimationChannel::Scale>(time, cursor, pose.Scales());
+	}
+
+private:
+	template<class U>
+	const U* At(std::uint64_t offset) const noexcept
+	{
+		return reinterpret_cast<const U*>(m_pData + offset);
+	}
+
+	const std::uint32_t* KeyStarts(AnimationChannel channel) const noexcept
+	{
+		return At<std::uint32_t>(m_pHeader->KeyStartOffsets[size_t(channel)]);
+	}
+
+	const T* Times(AnimationChannel channel) const noexcept
+	{
+		return At<T>(m_pHeader->TimeOffsets[size_t(channel)]);
+	}
+
+	const T* Values(AnimationChannel channel, size_t component) const noexcept
+	{
+		assert(component < detail::ComponentCountOf(channel));
+		return At<T>(m_pHeader->ValueOffsets[size_t(channel)][component]);
+	}
+
+	static bool IsValidData(const std::uint8_t* pData, size_t size) noexcept
+	{
+		if (!pData || size < sizeof(header_type))
+			return false;
+
+		if (reinterpret_cast<std::uintptr_t>(pData) % alignof(header_type) != 0)
+			return false;
+
+		const auto& header = *reinterpret_cast<const header_type*>(pData);
+
+		if (header.Magic != header_type::MagicValue ||
+			header.Version != header_type::CurrentVersion ||
+			header.ValueSize != sizeof(T) ||
+			header.Size > size)
+			return false;
+
+		const auto isValidSection = [&](std::uint64_t offset, std::uint64_t bytes)
+		{
+			return offset % detail::AnimationClipAlignment == 0 && offset <= header.Size && bytes <= header.Size - offset;
+		};
+
+		for (size_t channel = 0; channel < 3; ++channel)
+		{
+			const std::uint64_t keyCount = header.KeyCounts[channel];
+
+			if (!isValidSection(header.KeyStartOffsets[channel], (std::uint64_t(header.JointCount) + 1) * sizeof(std::uint32_t)) ||
+				!isValidSection(header.TimeOffsets[channel], keyCount * sizeof(T)))
+				return false;
+
+			for (size_t c = 0; c < detail::ComponentCountOf(AnimationChannel(channel)); ++c)
+			{
+				if (!isValidSection(header.ValueOffsets[channel][c], keyCount * sizeof(T)))
+					return false;
+			}
+
+			// Every track must hold at least one key, and the last track must end at the key count
+			const auto* pKeyStart = reinterpret_cast<const std::uint32_t*>(pData + header.KeyStartOffsets[channel]);
+
+			if (pKeyStart[0] != 0 || pKeyStart[header.JointCount] != keyCount)
+				return false;
+
+			for (size_t j = 0; j < header.JointCount; ++j)
+			{
+				if (pKeyStart[j + 1] <= pKeyStart[j])
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	template<AnimationChannel Channel, size_t N>
+	void SampleChannel(T time, Cursor& cursor, const std::array<T*, N>& result) const
+	{
+		const size_t jointCount = JointCount();
+		const std::uint32_t* pKeyStart = KeyStarts(Channel);
+		const T* pTimes = Times(Channel);
+
+		std::uint32_t* pKeys = &cursor.m_Keys[size_t(Channel) * jointCount];
+		T* pAlpha = cursor.m_Alpha.data();
+
+		std::array<const T*, N> values;
+		for (size_t c = 0; c < N; ++c)
+			values[c] = Values(Channel, c);
+
+		// Find the keys around time on every track and gather them into SoA lanes
+		for (size_t j = 0; j < jointCount; ++j)
+		{
+			const std::uint32_t first = pKeyStart[j];
+			const std::uint32_t count = pKeyStart[j + 1] - first;
+			const T* pTrackTimes = pTimes + first;
+
+			const std::uint32_t key = detail::SeekAnimationKey(pTrackTimes, count, pKeys[j], time);
+			const std::uint32_t next = std::min(key + 1, count - 1);
+			const T span = pTrackTimes[next] - pTrackTimes[key];
+
+			pKeys[j] = key;
+			pAlpha[j] = (span > T(0)) ? std::clamp((time - pTrackTimes[key]) / span, T(0), T(1)) : T(0);
+
+			for (size_t c = 0; c < N; ++c)
+			{
+				cursor.m_From[c][j] = values[c][first + key];
+				cursor.m_To[c][j] = values[c][first + next];
+			}
+		}
+
+		// Interpolate every joint at once
+		if constexpr (Channel == AnimationChannel::Rotation)
+		{
+			BatchSlerpFast(cursor.template From<4>(), cursor.template To<4>(), static_cast<const T*>(pAlpha), result, jointCount);
+		}
+		else
+		{
+			for (size_t c = 0; c < N; ++c)
+			{
+				const T* pFrom = cursor.m_From[c].data();
+				const T* pTo = cursor.m_To[c].data();
+				T* pResult = result[c];
+
+				for (size_t j = 0; j < jointCount; ++j)
+					pResult[j] = pFrom[j] + (pTo[j] - pFrom[j]) * pAlpha[j];
+			}
+		}
+	}
+};
@@ -0,0 +1,418 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "AnimationCompressor_decl.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "../AnimationClip.h"
+#include "../CompressedAnimationClip.h"
+#include "../../Math/Quaternion.h"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// AnimationCompressor
+//	Converts an AnimationClip into the layout viewed by CompressedAnimationClip.
+//	Every track is quantized to 16 bits (translation and scale against the range of the track, rotation with the
+//	smallest-three encoding) and then reduced by greedily dropping the keys that can be interpolated from their
+//	neighbours. Both steps are measured against the source keys, so no key ends up further than the tolerance
+//	of its channel from its source value unless quantization alone exceeds it.
+template<class T>
+class Epic::AnimationCompressor
+{
+	static_assert(std::is_floating_point_v<T>, "AnimationCompressor requires floating point keys.");
+
+public:
+	using type = Epic::AnimationCompressor<T>;
+	using value_type = T;
+	using clip_type = Epic::AnimationClip<T>;
+	using quaternion_type = Epic::Quaternion<T>;
+	using header_type = Epic::detail::CompressedAnimationClipHeader;
+
+public:
+	// Settings - The largest error allowed in each channel.
+	//	Translation and scale errors are distances; rotation errors are angles in radians.
+	struct Settings
+	{
+		T TranslationTolerance = T(0.001);
+		T RotationTolerance = T(0.002);
+		T ScaleTolerance = T(0.001);
+	};
+
+	// Statistics - A report of one compression
+	struct Statistics
+	{
+		size_t SourceSize = 0;
+		size_t CompressedSize = 0;
+		size_t SourceKeyCount = 0;
+		size_t CompressedKeyCount = 0;
+
+		T MaxTranslationError = T(0);
+		T MaxRotationError = T(0);
+		T MaxScaleError = T(0);
+
+		double Ratio() const noexcept
+		{
+			return (CompressedSize > 0) ? double(SourceSize) / double(CompressedSize) : 0.0;
+		}
+	};
+
+private:
+	// A track of the source clip and its quantized keys
+	struct Track
+	{
+		const T* pTimes = nullptr;
+		std::array<const T*, 4> pValues{};
+		std::uint32_t KeyCount = 0;
+
+		std::vector<std::uint16_t> Times;
+		std::array<std::vector<std::uint16_t>, 3> Words;
+		std::array<std::vector<T>, 4> Values;
+		std::array<float, 3> Min{};
+		std::array<float, 3> Scale{};
+	};
+
+private:
+	Settings m_Settings;
+
+public:
+	AnimationCompressor() noexcept = default;
+
+	explicit AnimationCompressor(const Settings& settings) noexcept
+		: m_Settings{ settings }
+	{ }
+
+	AnimationCompressor(const AnimationCompressor&) noexcept = default;
+	~AnimationCompressor() noexcept = default;
+
+	AnimationCompressor& operator = (const AnimationCompressor&) noexcept = default;
+
+public:
+	const Settings& GetSettings() const noexcept { return m_Settings; }
+	void SetSettings(const Settings& settings) noexcept { m_Settings = settings; }
+
+public:
+	// Compresses clip and optionally reports the result in pStatistics
+	std::vector<std::uint8_t> Compress(const clip_type& clip, Statistics* pStatistics = nullptr) const
+	{
+		assert(clip.IsValid());
+
+		const size_t jointCount = clip.JointCount();
+		const T duration = clip.Duration();
+
+		Statistics statistics;
+		statistics.SourceSize = clip.Size();
+
+		header_type header{};
+
+		header.Magic = header_type::MagicValue;
+		header.Version = header_type::CurrentVersion;
+		header.JointCount = static_cast<std::uint32_t>(jointCount);
+		header.Duration = static_cast<double>(duration);
+
+		std::array<std::vector<std::uint32_t>, 3> keyStarts;
+		std::array<std::vector<std::uint16_t>, 3> times;
+		std::array<std::array<std::vector<std::uint16_t>, 3>, 3> words;
+		std::array<std::array<std::vector<float>, 3>, 3> rangeMins;
+		std::array<std::array<std::vector<float>, 3>, 3> rangeScales;
+
+		Track track;
+		std::vector<std::uint32_t> kept;
+
+		for (size_t channel = 0; channel < 3; ++channel)
+		{
+			const auto channelId = AnimationChannel(channel);
+			const size_t componentCount = detail::ComponentCountOf(channelId);
+
+			keyStarts[channel].push_back(0);
+
+			for (size_t joint = 0; joint < jointCount; ++joint)
+			{
+				track.pTimes = clip.KeyTimes(channelId, joint);
+				track.KeyCount = static_cast<std::uint32_t>(clip.KeyCount(channelId, joint));
+
+				for (size_t c = 0; c < componentCount; ++c)
+					track.pValues[c] = clip.KeyValues(channelId, c, joint);
+
+				Quantize(channelId, duration, track);
+
+				const T error = Reduce(channelId, track, kept);
+
+				switch (channelId)
+				{
+				case AnimationChannel::Translation:	statistics.MaxTranslationError = std::max(statistics.MaxTranslationError, error); break;
+				case AnimationChannel::Rotation:	statistics.MaxRotationError = std::max(statistics.MaxRotationError, error); break;
+				default:							statistics.MaxScaleError = std::max(statistics.MaxScaleError, error); break;
+				}
+
+				for (const auto key : kept)
+				{
+					times[channel].push_back(track.Times[key]);
+
+					for (size_t c = 0; c < 3; ++c)
+						words[channel][c].push_back(track.Words[c][key]);
+				}
+
+				if (channelId != AnimationChannel::Rotation)
+				{
+					for (size_t c = 0; c < 3; ++c)
+					{
+						rangeMins[channel][c].push_back(track.Min[c]);
+						rangeScales[channel][c].push_back(track.Scale[c]);
+					}
+				}
+
+				keyStarts[channel].push_back(static_cast<std::uint32_t>(times[channel].size()));
+
+				statistics.SourceKeyCount += track.KeyCount;
+				statistics.CompressedKeyCount += kept.size();
+			}
+		}
+
+		// Lay out the sections in the order AnimationClipBuilder does
+		size_t offset = AlignOffset(sizeof(header_type));
+
+		for (size_t channel = 0; channel < 3; ++channel)
+		{
+			const size_t keyCount = times[channel].size();
+
+			header.KeyCounts[channel] = static_cast<std::uint32_t>(keyCount);
+
+			header.KeyStartOffsets[channel] = offset;
+			offset = AlignOffset(offset + keyStarts[channel].size() * sizeof(std::uint32_t));
+
+			header.TimeOffsets[channel] = offset;
+			offset = AlignOffset(offset + keyCount * sizeof(std::uint16_t));
+
+			for (size_t c = 0; c < 3; ++c)
+			{
+				header.ValueOffsets[channel][c] = offset;
+				offset = AlignOffset(offset + keyCount * sizeof(std::uint16_t));
+			}
+
+			if (AnimationChannel(channel) == AnimationChannel::Rotation)
+				continue;
+
+			for (size_t c = 0; c < 3; ++c)
+			{
+				header.RangeMinOffsets[channel][c] = offset;
+				offset = AlignOffset(offset + jointCount * sizeof(float));
+
+				header.RangeScaleOffsets[channel][c] = offset;
+				offset = AlignOffset(offset + jointCount * sizeof(float));
+			}
+		}
+
+		header.Size = offset;
+
+		std::vector<std::uint8_t> data(offset, 0);
+
+		std::memcpy(data.data(), &header, sizeof(header_type));
+
+		for (size_t channel = 0; channel < 3; ++channel)
+		{
+			Write(data, header.KeyStartOffsets[channel], keyStarts[channel]);
+			Write(data, header.TimeOffsets[channel], times[channel]);
+
+			for (size_t c = 0; c < 3; ++c)
+			{
+				Write(data, header.ValueOffsets[channel][c], words[channel][c]);
+
+				if (AnimationChannel(channel) != AnimationChannel::Rotation)
+				{
+					Write(data, header.RangeMinOffsets[channel][c], rangeMins[channel][c]);
+					Write(data, header.RangeScaleOffsets[channel][c], rangeScales[channel][c]);
+				}
+			}
+		}
+
+		statistics.CompressedSize = data.size();
+
+		if (pStatistics)
+			*pStatistics = statistics;
+
+		return data;
+	}
+
+private:
+	// Quantizes the keys of a track and decodes them again, exactly like CompressedAnimationClip will
+	static void Quantize(AnimationChannel channel, T duration, Track& track)
+	{
+		const std::uint32_t count = track.KeyCount;
+
+		track.Times.resize(count);
+
+		for (auto& words : track.Words)
+			words.resize(count);
+
+		for (auto& values : track.Values)
+			values.resize(count);
+
+		for (std::uint32_t k = 0; k < count; ++k)
+		{
+			const T unit = (duration > T(0)) ? std::clamp(track.pTimes[k] / duration, T(0), T(1)) : T(0);
+			track.Times[k] = static_cast<std::uint16_t>(std::lround(unit * T(detail::AnimationQuantizedMax)));
+		}
+
+		if (channel == AnimationChannel::Rotation)
+		{
+			for (std::uint32_t k = 0; k < count; ++k)
+			{
+				const auto encoded = detail::EncodeSmallestThree(track.pValues[0][k], track.pValues[1][k], track.pValues[2][k], track.pValues[3][k]);
+
+				for (size_t c = 0; c < 3; ++c)
+					track.Words[c][k] = encoded[c];
+
+				detail::DecodeSmallestThree(encoded[0], encoded[1], encoded[2],
+					track.Values[0][k], track.Values[1][k], track.Values[2][k], track.Values[3][k]);
+			}
+
+			return;
+		}
+
+		for (size_t c = 0; c < 3; ++c)
+		{
+			const T* pValues = track.pValues[c];
+			const auto [pLow, pHigh] = std::minmax_element(pValues, pValues + count);
+
+			// The range is stored as floats, so quantize against the rounded range
+			const float minimum = static_cast<float>(*pLow);
+			const float scale = static_cast<float>((*pHigh - *pLow) / T(detail::AnimationQuantizedMax));
+
+			track.Min[c] = minimum;
+			track.Scale[c] = scale;
+
+			for (std::uint32_t k = 0; k < count; ++k)
+			{
+				const T unit = (scale > 0.f) ? (pValues[k] - T(minimum)) / T(scale) : T(0);
+				const auto word = static_cast<std::uint16_t>(std::clamp<long>(std::lround(unit), 0, long(detail::AnimationQuantizedMax)));
+
+				track.Words[c][k] = word;
+				track.Values[c][k] = T(minimum) + T(word) * T(scale);
+			}
+		}
+	}
+
+	// Selects the keys of a track to keep and returns the largest error of the result
+	T Reduce(AnimationChannel channel, const Track& track, std::vector<std::uint32_t>& kept) const
+	{
+		const std::uint32_t count = track.KeyCount;
+		const T tolerance = ToleranceOf(channel);
+
+		kept.clear();
+		kept.push_back(0);
+
+		// A constant track collapses into its first key
+		T error = T(0);
+
+		for (std::uint32_t k = 0; k < count; ++k)
+			error = std::max(error, ErrorOf(channel, track, k, 0, 0));
+
+		if (error <= tolerance || count == 1)
+			return error;
+
+		// Extend each segment until one of the keys it skips no longer fits
+		std::uint32_t anchor = 0;
+
+		for (std::uint32_t k = 2; k < count; ++k)
+		{
+			if (SegmentError(channel, track, anchor, k) > tolerance)
+			{
+				kept.push_back(k - 1);
+				anchor = k - 1;
+			}
+		}
+
+		kept.push_back(count - 1);
+
+		error = T(0);
+
+		for (size_t i = 1; i < kept.size(); ++i)
+			error = std::max(error, SegmentError(channel, track, kept[i - 1], kept[i]));
+
+		return error;
+	}
+
+	// The largest error of the source keys in [from, to] when interpolated from the keys at from and to
+	static T SegmentError(AnimationChannel channel, const Track& track, std::uint32_t from, std::uint32_t to) noexcept
+	{
+		T result = T(0);
+
+		for (std::uint32_t k = from; k <= to; ++k)
+			result = std::max(result, ErrorOf(channel, track, k, from, to));
+
+		return result;
+	}
+
+	// The error of source key k when interpolated from the quantized keys at from and to
+	static T ErrorOf(AnimationChannel channel, const Track& track, std::uint32_t k, std::uint32_t from, std::uint32_t to) noexcept
+	{
+		const T span = T(track.Times[to]) - T(track.Times[from]);
+		const T alpha = (span > T(0)) ? std::clamp((T(track.Times[k]) - T(track.Times[from])) / span, T(0), T(1)) : T(0);
+
+		if (channel == AnimationChannel::Rotation)
+		{
+			const quaternion_type a{ { track.Values[0][from], track.Values[1][from], track.Values[2][from], track.Values[3][from] } };
+			const quaternion_type b{ { track.Values[0][to], track.Values[1][to], track.Values[2][to], track.Values[3][to] } };
+			const quaternion_type source{ { track.pValues[0][k], track.pValues[1][k], track.pValues[2][k], track.pValues[3][k] } };
+
+			const T dot = std::min(std::abs(quaternion_type::SlerpFast(a, b, alpha).Dot(source)), T(1));
+			return T(2) * std::acos(dot);
+		}
+
+		T distanceSq = T(0);
+
+		for (size_t c = 0; c < 3; ++c)
+		{
+			const T value = track.Values[c][from] + (track.Values[c][to] - track.Values[c][from]) * alpha;
+			const T delta = value - track.pValues[c][k];
+
+			distanceSq += delta * delta;
+		}
+
+		return std::sqrt(distanceSq);
+	}
+
+	T ToleranceOf(AnimationChannel channel) const noexcept
+	{
+		switch (channel)
+		{
+		case AnimationChannel::Translation:	return m_Settings.TranslationTolerance;
+		case AnimationChannel::Rotation:	return m_Settings.RotationTolerance;
+		default:							return m_Settings.ScaleTolerance;
+		}
+	}
+
+	static size_t AlignOffset(size_t offset) noexcept
+	{
+		constexpr size_t Alignment = detail::AnimationClipAlignment;
+
+		return (offset + Alignment - 1) & ~(Alignment - 1);
+	}
+
+	template<class U>
+	static void Write(std::vector<std::uint8_t>& data, std::uint64_t offset, const std::vector<U>& values) noexcept
+	{
+		if (!values.empty())
+			std::memcpy(data.data() + offset, values.data(), values.size() * sizeof(U));
+	}
+};
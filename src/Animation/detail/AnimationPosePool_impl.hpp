@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "AnimationPosePool_decl.h"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include "../AnimationPose.h"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// AnimationPosePool
+//	Recycles the intermediate poses of blending so that evaluating a blend tree does not allocate once warm.
+//	A pool is not thread safe; give every thread its own.
+template<class T>
+class Epic::AnimationPosePool
+{
+public:
+	using type = Epic::AnimationPosePool<T>;
+	using value_type = T;
+	using pose_type = Epic::AnimationPose<T>;
+
+private:
+	std::vector<std::unique_ptr<pose_type>> m_Poses;
+	std::vector<pose_type*> m_FreePoses;
+
+public:
+	AnimationPosePool() = default;
+	AnimationPosePool(AnimationPosePool&&) noexcept = default;
+	~AnimationPosePool() = default;
+
+	AnimationPosePool& operator = (AnimationPosePool&&) noexcept = default;
+
+	AnimationPosePool(const AnimationPosePool&) = delete;
+	AnimationPosePool& operator = (const AnimationPosePool&) = delete;
+
+public:
+	// The number of poses owned by the pool
+	size_t Size() const noexcept { return m_Poses.size(); }
+
+	// The number of poses that are currently acquired
+	size_t AcquiredCount() const noexcept { return m_Poses.size() - m_FreePoses.size(); }
+
+public:
+	// Takes a pose of jointCount joints out of the pool. Its contents are unspecified.
+	pose_type& Acquire(size_t jointCount)
+	{
+		pose_type* pPose = nullptr;
+
+		if (m_FreePoses.empty())
+		{
+			m_Poses.emplace_back(std::make_unique<pose_type>(jointCount));
+			pPose = m_Poses.back().get();
+		}
+		else
+		{
+			pPose = m_FreePoses.back();
+			m_FreePoses.pop_back();
+		}
+
+		if (pPose->JointCount() != jointCount)
+			pPose->Resize(jointCount);
+
+		return *pPose;
+	}
+
+	// Returns an acquired pose to the pool
+	void Release(pose_type& pose)
+	{
+		assert(std::any_of(std::begin(m_Poses), std::end(m_Poses), [&](const auto& p) { return p.get() == &pose; }));
+		assert(std::find(std::begin(m_FreePoses), std::end(m_FreePoses), &pose) == std::end(m_FreePoses));
+
+		m_FreePoses.push_back(&pose);
+	}
+
+	// Destroys every pose; no pose may be acquired
+	void Clear() noexcept
+	{
+		assert(AcquiredCount() == 0);
+
+		m_FreePoses.clear();
+		m_Poses.clear();
+	}
+};
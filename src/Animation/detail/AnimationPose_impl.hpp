@@ -0,0 +1,173 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "AnimationPose_decl.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <type_traits>
+#include <vector>
+
+#include "../../Math/Quaternion.h"
+#include "../../Math/Vector.h"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// AnimationPose
+//	The local translation, rotation and scale of every joint of a skeleton, stored as one array per component
+//	so that sampling and blending kernels stream through contiguous lanes.
+template<class T>
+class Epic::AnimationPose
+{
+	static_assert(std::is_floating_point_v<T>, "AnimationPose requires floating point components.");
+
+public:
+	using type = Epic::AnimationPose<T>;
+	using value_type = T;
+	using vector_type = Epic::Vector<T, 3>;
+	using quaternion_type = Epic::Quaternion<T>;
+
+private:
+	size_t m_JointCount;
+
+	std::array<std::vector<T>, 3> m_Translations;
+	std::array<std::vector<T>, 4> m_Rotations;
+	std::array<std::vector<T>, 3> m_Scales;
+
+public:
+	explicit AnimationPose(size_t jointCount = 0)
+		: m_JointCount{ 0 }
+	{
+		Resize(jointCount);
+	}
+
+	AnimationPose(const AnimationPose&) = default;
+	AnimationPose(AnimationPose&&) noexcept = default;
+	~AnimationPose() = default;
+
+	AnimationPose& operator = (const AnimationPose&) = default;
+	AnimationPose& operator = (AnimationPose&&) noexcept = default;
+
+public:
+	size_t JointCount() const noexcept { return m_JointCount; }
+
+	// Resizes the pose; every joint is reset to the identity transform
+	void Resize(size_t jointCount)
+	{
+		m_JointCount = jointCount;
+
+		for (auto& c : m_Translations)
+			c.resize(jointCount);
+
+		for (auto& c : m_Rotations)
+			c.resize(jointCount);
+
+		for (auto& c : m_Scales)
+			c.resize(jointCount);
+
+		SetIdentity();
+	}
+
+	void SetIdentity() noexcept
+	{
+		for (auto& c : m_Translations)
+			std::fill(std::begin(c), std::end(c), T(0));
+
+		for (size_t c = 0; c < 4; ++c)
+			std::fill(std::begin(m_Rotations[c]), std::end(m_Rotations[c]), (c == 3) ? T(1) : T(0));
+
+		for (auto& c : m_Scales)
+			std::fill(std::begin(c), std::end(c), T(1));
+	}
+
+public:
+	std::array<T*, 3> Translations() noexcept { return Pointers(m_Translations); }
+	std::array<const T*, 3> Translations() const noexcept { return Pointers(m_Translations); }
+
+	std::array<T*, 4> Rotations() noexcept { return Pointers(m_Rotations); }
+	std::array<const T*, 4> Rotations() const noexcept { return Pointers(m_Rotations); }
+
+	std::array<T*, 3> Scales() noexcept { return Pointers(m_Scales); }
+	std::array<const T*, 3> Scales() const noexcept { return Pointers(m_Scales); }
+
+public:
+	vector_type Translation(size_t joint) const noexcept
+	{
+		assert(joint < m_JointCount);
+		return vector_type{ m_Translations[0][joint], m_Translations[1][joint], m_Translations[2][joint] };
+	}
+
+	quaternion_type Rotation(size_t joint) const noexcept
+	{
+		assert(joint < m_JointCount);
+
+		const T values[4] = { m_Rotations[0][joint], m_Rotations[1][joint], m_Rotations[2][joint], m_Rotations[3][joint] };
+		return quaternion_type{ values };
+	}
+
+	vector_type Scale(size_t joint) const noexcept
+	{
+		assert(joint < m_JointCount);
+		return vector_type{ m_Scales[0][joint], m_Scales[1][joint], m_Scales[2][joint] };
+	}
+
+	void SetTranslation(size_t joint, const vector_type& translation) noexcept
+	{
+		assert(joint < m_JointCount);
+
+		for (size_t c = 0; c < 3; ++c)
+			m_Translations[c][joint] = translation[c];
+	}
+
+	void SetRotation(size_t joint, const quaternion_type& rotation) noexcept
+	{
+		assert(joint < m_JointCount);
+
+		for (size_t c = 0; c < 4; ++c)
+			m_Rotations[c][joint] = rotation.Values[c];
+	}
+
+	void SetScale(size_t joint, const vector_type& scale) noexcept
+	{
+		assert(joint < m_JointCount);
+
+		for (size_t c = 0; c < 3; ++c)
+			m_Scales[c][joint] = scale[c];
+	}
+
+private:
+	template<size_t N>
+	static std::array<T*, N> Pointers(std::array<std::vector<T>, N>& components) noexcept
+	{
+		std::array<T*, N> result;
+
+		for (size_t c = 0; c < N; ++c)
+			result[c] = components[c].data();
+
+		return result;
+	}
+
+	template<size_t N>
+	static std::array<const T*, N> Pointers(const std::array<std::vector<T>, N>& components) noexcept
+	{
+		std::array<const T*, N> result;
+
+		for (size_t c = 0; c < N; ++c)
+			result[c] = components[c].data();
+
+		return result;
+	}
+};
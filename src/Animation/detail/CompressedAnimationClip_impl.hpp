@@ -0,0 +1,395 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CompressedAnimationClip_decl.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../AnimationClip.h"
+#include "../AnimationPose.h"
+#include "../../Math/QuaternionBatch.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace Epic::detail
+{
+	// The layout of a compressed clip (see AnimationCompressor). Like AnimationClipHeader, offsets are in
+	// bytes from the start of the header and every section is aligned to AnimationClipAlignment.
+	//	Key times are stored as 16-bit fractions of the duration.
+	//	Translation and scale components are 16-bit fractions of a per-track [min, min + 65535 * scale] range.
+	//	Rotations are stored with the smallest-three encoding in three 16-bit words.
+	struct CompressedAnimationClipHeader
+	{
+		static constexpr std::uint32_t MagicValue = 0x43435045;	// "EPCC"
+		static constexpr std::uint32_t CurrentVersion = 1;
+
+		std::uint32_t Magic;
+		std::uint32_t Version;
+		std::uint32_t JointCount;
+		std::uint32_t Reserved;
+		std::uint64_t Size;
+		double Duration;
+
+		std::uint32_t KeyCounts[3];
+		std::uint32_t Reserved2;
+		std::uint64_t KeyStartOffsets[3];
+		std::uint64_t TimeOffsets[3];
+		std::uint64_t ValueOffsets[3][3];
+
+		// Per joint float ranges of the translation and scale channels (unused for rotation)
+		std::uint64_t RangeMinOffsets[3][3];
+		std::uint64_t RangeScaleOffsets[3][3];
+	};
+
+	constexpr std::uint32_t AnimationQuantizedMax = 0xFFFF;
+	constexpr std::uint32_t SmallestThreeMax = 0x7FFF;
+
+	// Encodes a unit quaternion as its three smallest components, each in [-1/sqrt(2), 1/sqrt(2)] and quantized
+	// to 15 bits. The dropped component is made positive and its index is kept in the top bits of the first two words.
+	template<class T>
+	std::array<std::uint16_t, 3> EncodeSmallestThree(T x, T y, T z, T w) noexcept
+	{
+		const T q[4] = { x, y, z, w };
+
+		size_t largest = 0;
+		for (size_t c = 1; c < 4; ++c)
+		{
+			if (std::abs(q[c]) > std::abs(q[largest]))
+				largest = c;
+		}
+
+		const T sign = (q[largest] < T(0)) ? T(-1) : T(1);
+		constexpr T Sqrt2 = T(1.4142135623730950488);
+
+		std::array<std::uint16_t, 3> result;
+
+		for (size_t c = 0, n = 0; c < 4; ++c)
+		{
+			if (c == largest)
+				continue;
+
+			const T unit = std::clamp((q[c] * sign * Sqrt2 + T(1)) * T(0.5), T(0), T(1));
+			result[n++] = static_cast<std::uint16_t>(std::lround(unit * T(SmallestThreeMax)));
+		}
+
+		result[0] |= static_cast<std::uint16_t>((largest & 1) << 15);
+		result[1] |= static_cast<std::uint16_t>((largest >> 1) << 15);
+
+		return result;
+	}
+
+	// Decodes a smallest-three rotation without branches, so that it can be applied to SoA lanes.
+	template<class T>
+	inline void DecodeSmallestThree(std::uint16_t w0, std::uint16_t w1, std::uint16_t w2, T& rx, T& ry, T& rz, T& rw) noexcept
+	{
+		constexpr T InvSqrt2 = T(0.70710678118654752440);
+		constexpr T Scale = T(2) * InvSqrt2 / T(SmallestThreeMax);
+
+		const std::uint32_t largest = std::uint32_t(w0 >> 15) | (std::uint32_t(w1 >> 15) << 1);
+
+		const T a = T(w0 & SmallestThreeMax) * Scale - InvSqrt2;
+		const T b = T(w1 & SmallestThreeMax) * Scale - InvSqrt2;
+		const T c = T(w2 & SmallestThreeMax) * Scale - InvSqrt2;
+		const T d = std::sqrt(std::max(T(1) - a * a - b * b - c * c, T(0)));
+
+		rx = (largest == 0) ? d : a;
+		ry = (largest == 0) ? a : ((largest == 1) ? d : b);
+		rz = (largest <= 1) ? b : ((largest == 2) ? d : c);
+		rw = (largest == 3) ? d : c;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// CompressedAnimationClip
+//	A read-only view of a clip produced by AnimationCompressor; the counterpart of AnimationClip.
+//	Sampling seeks the reduced keys of every track, gathers their quantized words into SoA lanes,
+//	decodes the lanes in batch and then interpolates them like AnimationClip.
+template<class T>
+class Epic::CompressedAnimationClip
+{
+	static_assert(std::is_floating_point_v<T>, "CompressedAnimationClip requires a floating point pose.");
+
+public:
+	using type = Epic::CompressedAnimationClip<T>;
+	using value_type = T;
+	using pose_type = Epic::AnimationPose<T>;
+	using header_type = Epic::detail::CompressedAnimationClipHeader;
+
+public:
+	// Cursor - The playback state of one clip instance (see AnimationClip::Cursor).
+	class Cursor
+	{
+		friend class Epic::CompressedAnimationClip<T>;
+
+	private:
+		std::vector<std::uint32_t> m_Keys;
+		std::array<std::vector<std::uint16_t>, 3> m_FromWords;
+		std::array<std::vector<std::uint16_t>, 3> m_ToWords;
+		std::array<std::vector<T>, 4> m_From;
+		std::array<std::vector<T>, 4> m_To;
+		std::vector<T> m_Alpha;
+
+	public:
+		void Reset() noexcept
+		{
+			std::fill(std::begin(m_Keys), std::end(m_Keys), std::uint32_t(0));
+		}
+
+	private:
+		void Prepare(size_t jointCount)
+		{
+			if (m_Keys.size() == jointCount * 3)
+				return;
+
+			m_Keys.assign(jointCount * 3, 0);
+			m_Alpha.resize(jointCount);
+
+			for (size_t c = 0; c < 3; ++c)
+			{
+				m_FromWords[c].resize(jointCount);
+				m_ToWords[c].resize(jointCount);
+			}
+
+			for (size_t c = 0; c < 4; ++c)
+			{
+				m_From[c].resize(jointCount);
+				m_To[c].resize(jointCount);
+			}
+		}
+
+		std::array<const T*, 4> From() const noexcept
+		{
+			return { m_From[0].data(), m_From[1].data(), m_From[2].data(), m_From[3].data() };
+		}
+
+		std::array<const T*, 4> To() const noexcept
+		{
+			return { m_To[0].data(), m_To[1].data(), m_To[2].data(), m_To[3].data() };
+		}
+	};
+
+private:
+	const std::uint8_t* m_pData;
+	const header_type* m_pHeader;
+
+public:
+	CompressedAnimationClip() noexcept
+		: m_pData{ nullptr }, m_pHeader{ nullptr }
+	{ }
+
+	// Views compressed clip data. If the data is malformed the clip is left invalid.
+	CompressedAnimationClip(const void* pData, size_t size) noexcept
+		: m_pData{ static_cast<const std::uint8_t*>(pData) }, m_pHeader{ nullptr }
+	{
+		if (IsValidData(m_pData, size))
+			m_pHeader = reinterpret_cast<const header_type*>(m_pData);
+	}
+
+	CompressedAnimationClip(const CompressedAnimationClip&) noexcept = default;
+	~CompressedAnimationClip() noexcept = default;
+
+	CompressedAnimationClip& operator = (const CompressedAnimationClip&) noexcept = default;
+
+public:
+	bool IsValid() const noexcept { return m_pHeader != nullptr; }
+
+	size_t JointCount() const noexcept { return IsValid() ? m_pHeader->JointCount : 0; }
+	T Duration() const noexcept { return IsValid() ? static_cast<T>(m_pHeader->Duration) : T(0); }
+	size_t Size() const noexcept { return IsValid() ? static_cast<size_t>(m_pHeader->Size) : 0; }
+
+	// The number of keys left in one track after reduction
+	size_t KeyCount(AnimationChannel channel, size_t joint) const noexcept
+	{
+		assert(joint < JointCount());
+
+		const std::uint32_t* pKeyStart = KeyStarts(channel);
+		return pKeyStart[joint + 1] - pKeyStart[joint];
+	}
+
+public:
+	// Samples every joint at time (clamped to [0, Duration]) into pose
+	void Sample(T time, Cursor& cursor, pose_type& pose) const
+	{
+		assert(IsValid());
+		assert(pose.JointCount() == JointCount());
+
+		cursor.Prepare(JointCount());
+
+		// Seek in the quantized time domain of the key times
+		const T duration = Duration();
+		const T quantizedTime = (duration > T(0))
+			? std::clamp(time / duration, T(0), T(1)) * T(detail::AnimationQuantizedMax)
+			: T(0);
+
+		SampleChannel<AnimationChannel::Translation>(quantizedTime, cursor, pose.Translations());
+		SampleChannel<AnimationChannel::Rotation>(quantizedTime, cursor, pose.Rotations());
+		SampleChannel<AnimationChannel::Scale>(quantizedTime, cursor, pose.Scales());
+	}
+
+private:
+	template<class U>
+	const U* At(std::uint64_t offset) const noexcept
+	{
+		return reinterpret_cast<const U*>(m_pData + offset);
+	}
+
+	const std::uint32_t* KeyStarts(AnimationChannel channel) const noexcept
+	{
+		return At<std::uint32_t>(m_pHeader->KeyStartOffsets[size_t(channel)]);
+	}
+
+	static bool IsValidData(const std::uint8_t* pData, size_t size) noexcept
+	{
+		if (!pData || size < sizeof(header_type))
+			return false;
+
+		if (reinterpret_cast<std::uintptr_t>(pData) % alignof(header_type) != 0)
+			return false;
+
+		const auto& header = *reinterpret_cast<const header_type*>(pData);
+
+		if (header.Magic != header_type::MagicValue ||
+			header.Version != header_type::CurrentVersion ||
+			header.Size > size)
+			return false;
+
+		const auto isValidSection = [&](std::uint64_t offset, std::uint64_t bytes)
+		{
+			return offset % detail::AnimationClipAlignment == 0 && offset <= header.Size && bytes <= header.Size - offset;
+		};
+
+		const std::uint64_t jointCount = header.JointCount;
+
+		for (size_t channel = 0; channel < 3; ++channel)
+		{
+			const std::uint64_t keyCount = header.KeyCounts[channel];
+
+			if (!isValidSection(header.KeyStartOffsets[channel], (jointCount + 1) * sizeof(std::uint32_t)) ||
+				!isValidSection(header.TimeOffsets[channel], keyCount * sizeof(std::uint16_t)))
+				return false;
+
+			for (size_t c = 0; c < 3; ++c)
+			{
+				if (!isValidSection(header.ValueOffsets[channel][c], keyCount * sizeof(std::uint16_t)))
+					return false;
+
+				if (AnimationChannel(channel) != AnimationChannel::Rotation &&
+					(!isValidSection(header.RangeMinOffsets[channel][c], jointCount * sizeof(float)) ||
+					 !isValidSection(header.RangeScaleOffsets[channel][c], jointCount * sizeof(float))))
+					return false;
+			}
+
+			const auto* pKeyStart = reinterpret_cast<const std::uint32_t*>(pData + header.KeyStartOffsets[channel]);
+
+			if (pKeyStart[0] != 0 || pKeyStart[jointCount] != keyCount)
+				return false;
+
+			for (size_t j = 0; j < jointCount; ++j)
+			{
+				if (pKeyStart[j + 1] <= pKeyStart[j])
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	template<AnimationChannel Channel, size_t N>
+	void SampleChannel(T quantizedTime, Cursor& cursor, const std::array<T*, N>& result) const
+	{
+		const size_t jointCount = JointCount();
+		const size_t channel = size_t(Channel);
+		const std::uint32_t* pKeyStart = KeyStarts(Channel);
+		const std::uint16_t* pTimes = At<std::uint16_t>(m_pHeader->TimeOffsets[channel]);
+
+		std::uint32_t* pKeys = &cursor.m_Keys[channel * jointCount];
+		T* pAlpha = cursor.m_Alpha.data();
+
+		std::array<const std::uint16_t*, 3> words;
+		for (size_t c = 0; c < 3; ++c)
+			words[c] = At<std::uint16_t>(m_pHeader->ValueOffsets[channel][c]);
+
+		// Find the keys around time on every track and gather their words into SoA lanes
+		for (size_t j = 0; j < jointCount; ++j)
+		{
+			const std::uint32_t first = pKeyStart[j];
+			const std::uint32_t count = pKeyStart[j + 1] - first;
+			const std::uint16_t* pTrackTimes = pTimes + first;
+
+			const std::uint32_t key = detail::SeekAnimationKey(pTrackTimes, count, pKeys[j], quantizedTime);
+			const std::uint32_t next = std::min(key + 1, count - 1);
+			const T span = T(pTrackTimes[next]) - T(pTrackTimes[key]);
+
+			pKeys[j] = key;
+			pAlpha[j] = (span > T(0)) ? std::clamp((quantizedTime - T(pTrackTimes[key])) / span, T(0), T(1)) : T(0);
+
+			for (size_t c = 0; c < 3; ++c)
+			{
+				cursor.m_FromWords[c][j] = words[c][first + key];
+				cursor.m_ToWords[c][j] = words[c][first + next];
+			}
+		}
+
+		// Decode and interpolate every joint at once
+		if constexpr (Channel == AnimationChannel::Rotation)
+		{
+			DecodeRotations(cursor.m_FromWords, cursor.m_From, jointCount);
+			DecodeRotations(cursor.m_ToWords, cursor.m_To, jointCount);
+
+			BatchSlerpFast(cursor.From(), cursor.To(), static_cast<const T*>(pAlpha), result, jointCount);
+		}
+		else
+		{
+			for (size_t c = 0; c < N; ++c)
+			{
+				const float* pMin = At<float>(m_pHeader->RangeMinOffsets[channel][c]);
+				const float* pScale = At<float>(m_pHeader->RangeScaleOffsets[channel][c]);
+				const std::uint16_t* pFrom = cursor.m_FromWords[c].data();
+				const std::uint16_t* pTo = cursor.m_ToWords[c].data();
+				T* pResult = result[c];
+
+				for (size_t j = 0; j < jointCount; ++j)
+				{
+					const T from = T(pMin[j]) + T(pFrom[j]) * T(pScale[j]);
+					const T to = T(pMin[j]) + T(pTo[j]) * T(pScale[j]);
+
+					pResult[j] = from + (to - from) * pAlpha[j];
+				}
+			}
+		}
+	}
+
+	static void DecodeRotations(const std::array<std::vector<std::uint16_t>, 3>& words, std::array<std::vector<T>, 4>& lanes, size_t count) noexcept
+	{
+		const std::uint16_t* pW0 = words[0].data();
+		const std::uint16_t* pW1 = words[1].data();
+		const std::uint16_t* pW2 = words[2].data();
+
+		T* pX = lanes[0].data();
+		T* pY = lanes[1].data();
+		T* pZ = lanes[2].data();
+		T* pW = lanes[3].data();
+
+		for (size_t j = 0; j < count; ++j)
+			detail::DecodeSmallestThree(pW0[j], pW1[j], pW2[j], pX[j], pY[j], pZ[j], pW[j]);
+	}
+};
@@ -0,0 +1,802 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "AABB.h"
+#include "ConvexShapes.hpp"
+#include "OBB.h"
+#include "../Math/Matrix.h"
+#include "../Math/MatrixDecomposition.hpp"
+#include "../Math/Vector.h"
+#include "../Parallel/ParallelFor.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// detail
+namespace Epic::detail
+{
+	// Points per chunk when fitting bounds in parallel; a chunk of Vector3f stays resident in L2
+	constexpr size_t BoundsMinGrainSize = 1 << 14;
+
+	// PointMoments - The count, mean and co-moments (xx, yy, zz, xy, xz, yz) about the mean of a point set.
+	template<class T>
+	struct PointMoments
+	{
+		size_t Count = 0;
+		T Mean[3] = { };
+		T M2[6] = { };
+	};
+
+	// MomentsOf - Two passes over a chunk; the second pass accumulates about the chunk mean to avoid cancellation.
+	template<class T>
+	inline PointMoments<T> MomentsOf(const Vector<T, 3>* pPoints, size_t count) noexcept
+	{
+		PointMoments<T> result;
+
+		if (count == 0)
+			return result;
+
+		T sx = T(0), sy = T(0), sz = T(0);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			sx += pPoints[i][0];
+			sy += pPoints[i][1];
+			sz += pPoints[i][2];
+		}
+
+		const T inv = T(1) / T(count);
+		const T mx = sx * inv, my = sy * inv, mz = sz * inv;
+
+		T xx = T(0), yy = T(0), zz = T(0), xy = T(0), xz = T(0), yz = T(0);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const T dx = pPoints[i][0] - mx;
+			const T dy = pPoints[i][1] - my;
+			const T dz = pPoints[i][2] - mz;
+
+			xx += dx * dx; yy += dy * dy; zz += dz * dz;
+			xy += dx * dy; xz += dx * dz; yz += dy * dz;
+		}
+
+		result.Count = count;
+		result.Mean[0] = mx; result.Mean[1] = my; result.Mean[2] = mz;
+		result.M2[0] = xx; result.M2[1] = yy; result.M2[2] = zz;
+		result.M2[3] = xy; result.M2[4] = xz; result.M2[5] = yz;
+
+		return result;
+	}
+
+	// MergeMoments - Pairwise combination of moments (Chan et al., 1979).
+	template<class T>
+	inline void MergeMoments(PointMoments<T>& a, const PointMoments<T>& b) noexcept
+	{
+		if (b.Count == 0)
+			return;
+
+		if (a.Count == 0)
+		{
+			a = b;
+			return;
+		}
+
+		const T n = T(a.Count + b.Count);
+		const T f = (T(a.Count) * T(b.Count)) / n;
+		const T d[3] = { b.Mean[0] - a.Mean[0], b.Mean[1] - a.Mean[1], b.Mean[2] - a.Mean[2] };
+
+		a.M2[0] += b.M2[0] + d[0] * d[0] * f;
+		a.M2[1] += b.M2[1] + d[1] * d[1] * f;
+		a.M2[2] += b.M2[2] + d[2] * d[2] * f;
+		a.M2[3] += b.M2[3] + d[0] * d[1] * f;
+		a.M2[4] += b.M2[4] + d[0] * d[2] * f;
+		a.M2[5] += b.M2[5] + d[1] * d[2] * f;
+
+		for (size_t k = 0; k < 3; ++k)
+			a.Mean[k] += d[k] * (T(b.Count) / n);
+
+		a.Count += b.Count;
+	}
+
+	// CovarianceOf - The population covariance of a point set.
+	template<class T>
+	inline Matrix<T, 3> CovarianceOf(const PointMoments<T>& moments) noexcept
+	{
+		const T inv = moments.Count > 0 ? T(1) / T(moments.Count) : T(0);
+		const T* m2 = moments.M2;
+
+		Matrix<T, 3> result;
+		result[0] = { m2[0] * inv, m2[3] * inv, m2[4] * inv };
+		result[1] = { m2[3] * inv, m2[1] * inv, m2[5] * inv };
+		result[2] = { m2[4] * inv, m2[5] * inv, m2[2] * inv };
+
+		return result;
+	}
+
+	template<class T>
+	inline Matrix<T, 3> PrincipalAxesOf(const PointMoments<T>& moments) noexcept
+	{
+		Vector<T, 3> eigenvalues;
+		Matrix<T, 3> result;
+
+		Epic::SymmetricEigen(CovarianceOf(moments), eigenvalues, result, 16);
+
+		return result;
+	}
+
+	// ExpandMinMax - Expands lo/hi by count points.
+	template<class T>
+	inline void ExpandMinMax(const Vector<T, 3>* pPoints, size_t count, T(&lo)[3], T(&hi)[3]) noexcept
+	{
+		T x0 = lo[0], y0 = lo[1], z0 = lo[2];
+		T x1 = hi[0], y1 = hi[1], z1 = hi[2];
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const T x = pPoints[i][0], y = pPoints[i][1], z = pPoints[i][2];
+
+			x0 = x < x0 ? x : x0; x1 = x > x1 ? x : x1;
+			y0 = y < y0 ? y : y0; y1 = y > y1 ? y : y1;
+			z0 = z < z0 ? z : z0; z1 = z > z1 ? z : z1;
+		}
+
+		lo[0] = x0; lo[1] = y0; lo[2] = z0;
+		hi[0] = x1; hi[1] = y1; hi[2] = z1;
+	}
+
+	// The points of a set with the smallest and largest coordinate along each axis (min x, max x, min y, ...)
+	template<class T>
+	struct ExtremePoints
+	{
+		Vector<T, 3> Points[6];
+		T Values[6] = {
+			std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest(),
+			std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest(),
+			std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest()
+		};
+
+		void Expand(const Vector<T, 3>& point) noexcept
+		{
+			for (size_t k = 0; k < 3; ++k)
+			{
+				if (point[k] < Values[k * 2])
+				{
+					Values[k * 2] = point[k];
+					Points[k * 2] = point;
+				}
+
+				if (point[k] > Values[k * 2 + 1])
+				{
+					Values[k * 2 + 1] = point[k];
+					Points[k * 2 + 1] = point;
+				}
+			}
+		}
+
+		void Merge(const ExtremePoints& other) noexcept
+		{
+			for (size_t k = 0; k < 3; ++k)
+			{
+				if (other.Values[k * 2] < Values[k * 2])
+				{
+					Values[k * 2] = other.Values[k * 2];
+					Points[k * 2] = other.Points[k * 2];
+				}
+
+				if (other.Values[k * 2 + 1] > Values[k * 2 + 1])
+				{
+					Values[k * 2 + 1] = other.Values[k * 2 + 1];
+					Points[k * 2 + 1] = other.Points[k * 2 + 1];
+				}
+			}
+		}
+	};
+
+	// An empty sphere has a negative radius
+	template<class T>
+	inline SphereShape<T> EmptySphere() noexcept
+	{
+		return { Vector<T, 3>{ Epic::Zero }, T(-1) };
+	}
+
+	// SphereOfPair - The sphere with a and b on opposite sides.
+	template<class T>
+	inline SphereShape<T> SphereOfPair(const Vector<T, 3>& a, const Vector<T, 3>& b) noexcept
+	{
+		return { (a + b) * T(0.5), (b - a).Magnitude() * T(0.5) };
+	}
+
+	// GrowSphere - Grows s just enough to contain point, keeping the far side of s fixed (Ritter, 1990).
+	template<class T>
+	inline void GrowSphere(SphereShape<T>& s, const Vector<T, 3>& point) noexcept
+	{
+		if (s.Radius < T(0))
+		{
+			s = { point, T(0) };
+			return;
+		}
+
+		const Vector<T, 3> d = point - s.Position;
+		const T distanceSq = d.MagnitudeSq();
+
+		if (distanceSq > s.Radius * s.Radius)
+		{
+			const T distance = std::sqrt(distanceSq);
+			const T radius = (s.Radius + distance) * T(0.5);
+
+			s.Position += d * ((radius - s.Radius) / distance);
+			s.Radius = radius;
+		}
+	}
+
+	// MergeSpheres - The smallest sphere enclosing both a and b.
+	template<class T>
+	inline SphereShape<T> MergeSpheres(const SphereShape<T>& a, const SphereShape<T>& b) noexcept
+	{
+		if (a.Radius < T(0)) return b;
+		if (b.Radius < T(0)) return a;
+
+		const Vector<T, 3> d = b.Position - a.Position;
+		const T distance = d.Magnitude();
+
+		if (distance + b.Radius <= a.Radius) return a;
+		if (distance + a.Radius <= b.Radius) return b;
+
+		const T radius = (distance + a.Radius + b.Radius) * T(0.5);
+
+		return { a.Position + d * ((radius - a.Radius) / distance), radius };
+	}
+
+	// RitterSeed - The sphere through the most separated pair of axis extreme points.
+	template<class T>
+	inline SphereShape<T> RitterSeed(const ExtremePoints<T>& extremes) noexcept
+	{
+		size_t axis = 0;
+		T best = T(-1);
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			const T separation = (extremes.Points[k * 2 + 1] - extremes.Points[k * 2]).MagnitudeSq();
+
+			if (separation > best)
+			{
+				best = separation;
+				axis = k;
+			}
+		}
+
+		return SphereOfPair(extremes.Points[axis * 2], extremes.Points[axis * 2 + 1]);
+	}
+
+	// SphereThrough - The smallest sphere with all of (up to 4) support points on its boundary.
+	//	Degenerate (collinear or coplanar) supports fall back to growing a sphere through fewer points.
+	template<class T>
+	inline SphereShape<T> SphereThrough(const Vector<T, 3>* pSupport, size_t count) noexcept
+	{
+		assert(count <= 4);
+
+		constexpr T Tolerance = std::numeric_limits<T>::epsilon() * T(16);
+
+		switch (count)
+		{
+		case 0:
+			return EmptySphere<T>();
+
+		case 1:
+			return { pSupport[0], T(0) };
+
+		case 2:
+			return SphereOfPair(pSupport[0], pSupport[1]);
+
+		case 3:
+		{
+			const Vector<T, 3> ab = pSupport[1] - pSupport[0];
+			const Vector<T, 3> ac = pSupport[2] - pSupport[0];
+			const Vector<T, 3> n = ab.Cross(ac);
+			const T denominator = T(2) * n.MagnitudeSq();
+
+			if (denominator <= Tolerance * ab.MagnitudeSq() * ac.MagnitudeSq())
+			{
+				auto s = SphereOfPair(pSupport[0], pSupport[1]);
+				GrowSphere(s, pSupport[2]);
+				return s;
+			}
+
+			const Vector<T, 3> offset = (n.Cross(ab) * ac.MagnitudeSq() + ac.Cross(n) * ab.MagnitudeSq()) / denominator;
+
+			return { pSupport[0] + offset, offset.Magnitude() };
+		}
+
+		default:
+		{
+			const Vector<T, 3> ab = pSupport[1] - pSupport[0];
+			const Vector<T, 3> ac = pSupport[2] - pSupport[0];
+			const Vector<T, 3> ad = pSupport[3] - pSupport[0];
+			const T denominator = T(2) * ab.Dot(ac.Cross(ad));
+			const T scale = ab.Magnitude() * ac.Magnitude() * ad.Magnitude();
+
+			if (std::abs(denominator) <= Tolerance * scale)
+			{
+				auto s = SphereThrough(pSupport, 3);
+				GrowSphere(s, pSupport[3]);
+				return s;
+			}
+
+			const Vector<T, 3> offset = (ab.Cross(ac) * ad.MagnitudeSq() + ad.Cross(ab) * ac.MagnitudeSq()
+				+ ac.Cross(ad) * ab.MagnitudeSq()) / denominator;
+
+			return { pSupport[0] + offset, offset.Magnitude() };
+		}
+		}
+	}
+
+	template<class T>
+	inline bool SphereContains(const SphereShape<T>& s, const Vector<T, 3>& point) noexcept
+	{
+		constexpr T Tolerance = std::numeric_limits<T>::epsilon() * T(64);
+
+		return (point - s.Position).MagnitudeSq() <= s.Radius * s.Radius * (T(1) + Tolerance) + Tolerance;
+	}
+
+	// MoveToFrontSphere - Welzl's algorithm with the move-to-front heuristic (Gartner, 1999).
+	//	Recursion only descends when a point joins the support set, so its depth is at most 4.
+	template<class T>
+	inline SphereShape<T> MoveToFrontSphere(std::vector<Vector<T, 3>>& points, size_t end,
+		Vector<T, 3>(&support)[4], size_t supportCount) noexcept
+	{
+		SphereShape<T> result = SphereThrough(support, supportCount);
+
+		if (supportCount == 4)
+			return result;
+
+		for (size_t i = 0; i < end; ++i)
+		{
+			if (result.Radius >= T(0) && SphereContains(result, points[i]))
+				continue;
+
+			support[supportCount] = points[i];
+			result = MoveToFrontSphere(points, i, support, supportCount + 1);
+
+			std::rotate(std::begin(points), std::begin(points) + i, std::begin(points) + i + 1);
+		}
+
+		return result;
+	}
+
+	template<class T>
+	inline ExtremePoints<T> ExtremePointsOf(const Vector<T, 3>* pPoints, size_t count)
+	{
+		const size_t grainSize = ParallelGrainSize(count, BoundsMinGrainSize);
+		std::vector<ExtremePoints<T>> chunks(ParallelChunkCount(count, grainSize));
+
+		ParallelForChunks(0, count, grainSize, [&](size_t chunk, size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+				chunks[chunk].Expand(pPoints[i]);
+		});
+
+		ExtremePoints<T> result;
+		for (const auto& chunk : chunks)
+			result.Merge(chunk);
+
+		return result;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// BoundsAccumulator
+namespace Epic
+{
+	// BoundsAccumulator - Fits bounds to a stream of point chunks in a single pass.
+	//	Each chunk is reduced in parallel into an axis aligned box, a Ritter sphere and the moments of its points;
+	//	accumulators fed on different threads can be combined with Merge. The covariance gives the principal axes
+	//	needed by an OrientedBoundsAccumulator, which completes a PCA box in a second pass.
+	template<class T>
+	class BoundsAccumulator
+	{
+	public:
+		using type = BoundsAccumulator<T>;
+		using value_type = T;
+		using vector_type = Vector<T, 3>;
+		using matrix_type = Matrix<T, 3>;
+		using sphere_type = SphereShape<T>;
+		using aabb_type = AABB<T>;
+
+	private:
+		detail::PointMoments<T> m_Moments;
+		aabb_type m_Box;
+		sphere_type m_Sphere = detail::EmptySphere<T>();
+
+	public:
+		BoundsAccumulator() noexcept = default;
+
+	public:
+		size_t Count() const noexcept { return m_Moments.Count; }
+
+		// The axis aligned bounds of every point added; empty until a point is added
+		const aabb_type& Box() const noexcept { return m_Box; }
+
+		// A Ritter bounding sphere; the radius is negative until a point is added
+		const sphere_type& Sphere() const noexcept { return m_Sphere; }
+
+		vector_type Mean() const noexcept
+		{
+			return { m_Moments.Mean[0], m_Moments.Mean[1], m_Moments.Mean[2] };
+		}
+
+		// The population covariance of every point added
+		matrix_type Covariance() const noexcept
+		{
+			return detail::CovarianceOf(m_Moments);
+		}
+
+		// The eigenvectors of the covariance as the columns of a rotation, by decreasing variance
+		matrix_type PrincipalAxes() const noexcept
+		{
+			return detail::PrincipalAxesOf(m_Moments);
+		}
+
+	public:
+		void Reset() noexcept
+		{
+			*this = BoundsAccumulator{ };
+		}
+
+		void Add(const vector_type* pPoints, size_t count)
+		{
+			struct Chunk
+			{
+				detail::PointMoments<T> Moments;
+				T Min[3], Max[3];
+				sphere_type Sphere;
+			};
+
+			const size_t grainSize = ParallelGrainSize(count, detail::BoundsMinGrainSize);
+			std::vector<Chunk> chunks(ParallelChunkCount(count, grainSize));
+
+			ParallelForChunks(0, count, grainSize, [&](size_t index, size_t begin, size_t end)
+			{
+				Chunk& chunk = chunks[index];
+
+				chunk.Moments = detail::MomentsOf(pPoints + begin, end - begin);
+
+				for (size_t k = 0; k < 3; ++k)
+				{
+					chunk.Min[k] = std::numeric_limits<T>::max();
+					chunk.Max[k] = std::numeric_limits<T>::lowest();
+				}
+
+				detail::ExpandMinMax(pPoints + begin, end - begin, chunk.Min, chunk.Max);
+
+				detail::ExtremePoints<T> extremes;
+				for (size_t i = begin; i < end; ++i)
+					extremes.Expand(pPoints[i]);
+
+				chunk.Sphere = detail::RitterSeed(extremes);
+				for (size_t i = begin; i < end; ++i)
+					detail::GrowSphere(chunk.Sphere, pPoints[i]);
+			});
+
+			// Chunks are combined in order so the result does not depend on scheduling
+			for (const auto& chunk : chunks)
+			{
+				detail::MergeMoments(m_Moments, chunk.Moments);
+				m_Box.Expand(aabb_type{ vector_type{ chunk.Min[0], chunk.Min[1], chunk.Min[2] },
+					vector_type{ chunk.Max[0], chunk.Max[1], chunk.Max[2] } });
+				m_Sphere = detail::MergeSpheres(m_Sphere, chunk.Sphere);
+			}
+		}
+
+		BoundsAccumulator& Merge(const BoundsAccumulator& other) noexcept
+		{
+			detail::MergeMoments(m_Moments, other.m_Moments);
+
+			if (!other.m_Box.IsEmpty())
+				m_Box.Expand(other.m_Box);
+
+			m_Sphere = detail::MergeSpheres(m_Sphere, other.m_Sphere);
+
+			return *this;
+		}
+	};
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// OrientedBoundsAccumulator
+namespace Epic
+{
+	// OrientedBoundsAccumulator - Fits a box with fixed axes to a stream of point chunks.
+	template<class T>
+	class OrientedBoundsAccumulator
+	{
+	public:
+		using type = OrientedBoundsAccumulator<T>;
+		using value_type = T;
+		using vector_type = Vector<T, 3>;
+		using matrix_type = Matrix<T, 3>;
+		using obb_type = OBB<T>;
+
+	private:
+		matrix_type m_Axes;
+		T m_Min[3];
+		T m_Max[3];
+
+	public:
+		// axes must be orthonormal columns
+		explicit OrientedBoundsAccumulator(const matrix_type& axes) noexcept
+			: m_Axes{ axes }
+		{
+			Reset();
+		}
+
+	public:
+		const matrix_type& Axes() const noexcept { return m_Axes; }
+
+		bool IsEmpty() const noexcept { return m_Min[0] > m_Max[0]; }
+
+		obb_type Box() const noexcept
+		{
+			if (IsEmpty())
+				return { vector_type{ Epic::Zero }, m_Axes, vector_type{ Epic::Zero } };
+
+			vector_type center{ Epic::Zero };
+			vector_type extents;
+
+			for (size_t k = 0; k < 3; ++k)
+			{
+				center += m_Axes[k] * ((m_Min[k] + m_Max[k]) * T(0.5));
+				extents[k] = (m_Max[k] - m_Min[k]) * T(0.5);
+			}
+
+			return { center, m_Axes, extents };
+		}
+
+	public:
+		void Reset() noexcept
+		{
+			for (size_t k = 0; k < 3; ++k)
+			{
+				m_Min[k] = std::numeric_limits<T>::max();
+				m_Max[k] = std::numeric_limits<T>::lowest();
+			}
+		}
+
+		void Add(const vector_type* pPoints, size_t count)
+		{
+			struct Chunk { T Min[3], Max[3]; };
+
+			const size_t grainSize = ParallelGrainSize(count, detail::BoundsMinGrainSize);
+			std::vector<Chunk> chunks(ParallelChunkCount(count, grainSize));
+
+			T axes[9];
+			for (size_t k = 0; k < 9; ++k)
+				axes[k] = m_Axes.Values[k];
+
+			ParallelForChunks(0, count, grainSize, [&](size_t index, size_t begin, size_t end)
+			{
+				T lo[3] = { std::numeric_limits<T>::max(), std::numeric_limits<T>::max(), std::numeric_limits<T>::max() };
+				T hi[3] = { std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest() };
+
+				for (size_t i = begin; i < end; ++i)
+				{
+					const T x = pPoints[i][0], y = pPoints[i][1], z = pPoints[i][2];
+
+					for (size_t k = 0; k < 3; ++k)
+					{
+						const T p = axes[k * 3] * x + axes[k * 3 + 1] * y + axes[k * 3 + 2] * z;
+
+						lo[k] = p < lo[k] ? p : lo[k];
+						hi[k] = p > hi[k] ? p : hi[k];
+					}
+				}
+
+				for (size_t k = 0; k < 3; ++k)
+				{
+					chunks[index].Min[k] = lo[k];
+					chunks[index].Max[k] = hi[k];
+				}
+			});
+
+			for (const auto& chunk : chunks)
+			{
+				for (size_t k = 0; k < 3; ++k)
+				{
+					m_Min[k] = std::min(m_Min[k], chunk.Min[k]);
+					m_Max[k] = std::max(m_Max[k], chunk.Max[k]);
+				}
+			}
+		}
+
+		OrientedBoundsAccumulator& Merge(const OrientedBoundsAccumulator& other) noexcept
+		{
+			for (size_t k = 0; k < 3; ++k)
+			{
+				m_Min[k] = std::min(m_Min[k], other.m_Min[k]);
+				m_Max[k] = std::max(m_Max[k], other.m_Max[k]);
+			}
+
+			return *this;
+		}
+	};
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Bounding volume fitting
+namespace Epic
+{
+	// BoundingBoxOf - The axis aligned bounds of count points, reduced in parallel.
+	template<class T>
+	AABB<T> BoundingBoxOf(const Vector<T, 3>* pPoints, size_t count)
+	{
+		struct Chunk { T Min[3], Max[3]; };
+
+		const size_t grainSize = ParallelGrainSize(count, detail::BoundsMinGrainSize);
+		std::vector<Chunk> chunks(ParallelChunkCount(count, grainSize));
+
+		ParallelForChunks(0, count, grainSize, [&](size_t index, size_t begin, size_t end)
+		{
+			Chunk& chunk = chunks[index];
+
+			for (size_t k = 0; k < 3; ++k)
+			{
+				chunk.Min[k] = std::numeric_limits<T>::max();
+				chunk.Max[k] = std::numeric_limits<T>::lowest();
+			}
+
+			detail::ExpandMinMax(pPoints + begin, end - begin, chunk.Min, chunk.Max);
+		});
+
+		AABB<T> result;
+		for (const auto& chunk : chunks)
+		{
+			result.Expand(AABB<T>{ Vector<T, 3>{ chunk.Min[0], chunk.Min[1], chunk.Min[2] },
+				Vector<T, 3>{ chunk.Max[0], chunk.Max[1], chunk.Max[2] } });
+		}
+
+		return result;
+	}
+
+	// RitterSphereOf - An approximate bounding sphere, usually 5-20% larger than the minimum (Ritter, 1990).
+	//	The seed comes from the extreme points of the whole set; each chunk grows its own copy in parallel
+	//	and the chunk spheres are merged. Returns a negative radius if count is 0.
+	template<class T>
+	SphereShape<T> RitterSphereOf(const Vector<T, 3>* pPoints, size_t count)
+	{
+		if (count == 0)
+			return detail::EmptySphere<T>();
+
+		const SphereShape<T> seed = detail::RitterSeed(detail::ExtremePointsOf(pPoints, count));
+
+		const size_t grainSize = ParallelGrainSize(count, detail::BoundsMinGrainSize);
+		std::vector<SphereShape<T>> chunks(ParallelChunkCount(count, grainSize), seed);
+
+		ParallelForChunks(0, count, grainSize, [&](size_t index, size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+				detail::GrowSphere(chunks[index], pPoints[i]);
+		});
+
+		SphereShape<T> result = detail::EmptySphere<T>();
+		for (const auto& chunk : chunks)
+			result = detail::MergeSpheres(result, chunk);
+
+		return result;
+	}
+
+	// MinimumSphereOf - The minimum bounding sphere of count points.
+	//	Welzl's algorithm runs on a small core set seeded with the extreme points. Each parallel pass adds the
+	//	furthest outlier of every chunk to the core set until no point lies outside; a few passes usually suffice.
+	//	The radius is finally widened to the furthest point, so every point is contained. Returns a negative
+	//	radius if count is 0.
+	template<class T>
+	SphereShape<T> MinimumSphereOf(const Vector<T, 3>* pPoints, size_t count, size_t maxPasses = 64)
+	{
+		if (count == 0)
+			return detail::EmptySphere<T>();
+
+		const auto extremes = detail::ExtremePointsOf(pPoints, count);
+		std::vector<Vector<T, 3>> core{ std::begin(extremes.Points), std::end(extremes.Points) };
+
+		struct Chunk
+		{
+			T DistanceSq;
+			size_t Index;
+		};
+
+		const size_t grainSize = ParallelGrainSize(count, detail::BoundsMinGrainSize);
+		std::vector<Chunk> chunks(ParallelChunkCount(count, grainSize));
+
+		SphereShape<T> result;
+
+		for (size_t pass = 0; pass < maxPasses; ++pass)
+		{
+			Vector<T, 3> support[4];
+			result = detail::MoveToFrontSphere(core, core.size(), support, 0);
+
+			const Vector<T, 3> center = result.Position;
+
+			ParallelForChunks(0, count, grainSize, [&](size_t index, size_t begin, size_t end)
+			{
+				T furthest = T(-1);
+				size_t furthestIndex = begin;
+
+				for (size_t i = begin; i < end; ++i)
+				{
+					const T distanceSq = (pPoints[i] - center).MagnitudeSq();
+
+					if (distanceSq > furthest)
+					{
+						furthest = distanceSq;
+						furthestIndex = i;
+					}
+				}
+
+				chunks[index] = { furthest, furthestIndex };
+			});
+
+			T furthest = T(0);
+			bool contained = true;
+
+			for (const auto& chunk : chunks)
+			{
+				furthest = std::max(furthest, chunk.DistanceSq);
+
+				if (!detail::SphereContains(result, pPoints[chunk.Index]))
+				{
+					core.push_back(pPoints[chunk.Index]);
+					contained = false;
+				}
+			}
+
+			result.Radius = std::max(result.Radius, std::sqrt(furthest));
+
+			if (contained)
+				break;
+		}
+
+		return result;
+	}
+
+	// OrientedBoxOf - Fits a box to count points along the principal axes of their covariance.
+	//	Two parallel passes: one for the moments and one to project onto the axes.
+	template<class T>
+	OBB<T> OrientedBoxOf(const Vector<T, 3>* pPoints, size_t count)
+	{
+		const size_t grainSize = ParallelGrainSize(count, detail::BoundsMinGrainSize);
+		std::vector<detail::PointMoments<T>> chunks(ParallelChunkCount(count, grainSize));
+
+		ParallelForChunks(0, count, grainSize, [&](size_t index, size_t begin, size_t end)
+		{
+			chunks[index] = detail::MomentsOf(pPoints + begin, end - begin);
+		});
+
+		detail::PointMoments<T> moments;
+		for (const auto& chunk : chunks)
+			detail::MergeMoments(moments, chunk);
+
+		OrientedBoundsAccumulator<T> box{ detail::PrincipalAxesOf(moments) };
+		box.Add(pPoints, count);
+
+		return box.Box();
+	}
+}
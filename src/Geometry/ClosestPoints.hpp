@@ -0,0 +1,514 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "OBB.h"
+#include "../Math/Vector.h"
+#include "../Parallel/BatchBlock.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Closest point types
+namespace Epic
+{
+	// ClosestPointsResult - The closest points of two features and the squared distance between them
+	template<class T>
+	struct ClosestPointsResult
+	{
+		Vector<T, 3> PointA{ Zero };
+		Vector<T, 3> PointB{ Zero };
+		T DistanceSq = T(0);
+	};
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Point queries
+namespace Epic
+{
+	// ClosestPointOnSegment - The point of segment ab closest to p; t receives its parameter along ab.
+	template<class T>
+	Vector<T, 3> ClosestPointOnSegment(const Vector<T, 3>& p, const Vector<T, 3>& a, const Vector<T, 3>& b, T& t) noexcept
+	{
+		const Vector<T, 3> ab = b - a;
+		const T lengthSq = ab.MagnitudeSq();
+
+		t = lengthSq > T(0) ? std::clamp((p - a).Dot(ab) / lengthSq, T(0), T(1)) : T(0);
+
+		return a + ab * t;
+	}
+
+	template<class T>
+	Vector<T, 3> ClosestPointOnSegment(const Vector<T, 3>& p, const Vector<T, 3>& a, const Vector<T, 3>& b) noexcept
+	{
+		T t;
+
+		return ClosestPointOnSegment(p, a, b, t);
+	}
+
+	// ClosestPointOnTriangle - The point of triangle abc closest to p, found by locating the Voronoi region of p
+	//	(Ericson, RTCD 5.1.5). Degenerate triangles fall back to the closest of their edges.
+	template<class T>
+	Vector<T, 3> ClosestPointOnTriangle(const Vector<T, 3>& p, const Vector<T, 3>& a, const Vector<T, 3>& b, const Vector<T, 3>& c) noexcept
+	{
+		const Vector<T, 3> ab = b - a;
+		const Vector<T, 3> ac = c - a;
+
+		const Vector<T, 3> ap = p - a;
+		const T d1 = ab.Dot(ap);
+		const T d2 = ac.Dot(ap);
+
+		if (d1 <= T(0) && d2 <= T(0))
+			return a;
+
+		const Vector<T, 3> bp = p - b;
+		const T d3 = ab.Dot(bp);
+		const T d4 = ac.Dot(bp);
+
+		if (d3 >= T(0) && d4 <= d3)
+			return b;
+
+		const T vc = d1 * d4 - d3 * d2;
+
+		if (vc <= T(0) && d1 >= T(0) && d3 <= T(0))
+			return a + ab * (d1 / (d1 - d3));
+
+		const Vector<T, 3> cp = p - c;
+		const T d5 = ab.Dot(cp);
+		const T d6 = ac.Dot(cp);
+
+		if (d6 >= T(0) && d5 <= d6)
+			return c;
+
+		const T vb = d5 * d2 - d1 * d6;
+
+		if (vb <= T(0) && d2 >= T(0) && d6 <= T(0))
+			return a + ac * (d2 / (d2 - d6));
+
+		const T va = d3 * d6 - d5 * d4;
+
+		if (va <= T(0) && (d4 - d3) >= T(0) && (d5 - d6) >= T(0))
+			return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+		const T sum = va + vb + vc;
+
+		if (sum <= T(0))
+		{
+			const Vector<T, 3> candidates[3] = {
+				ClosestPointOnSegment(p, a, b), ClosestPointOnSegment(p, b, c), ClosestPointOnSegment(p, c, a)
+			};
+
+			return *std::min_element(std::begin(candidates), std::end(candidates), [&](const auto& x, const auto& y)
+			{
+				return (x - p).MagnitudeSq() < (y - p).MagnitudeSq();
+			});
+		}
+
+		return a + ab * (vb / sum) + ac * (vc / sum);
+	}
+
+	template<class T>
+	Vector<T, 3> ClosestPointOnOBB(const Vector<T, 3>& p, const OBB<T>& box) noexcept
+	{
+		return box.ClosestPoint(p);
+	}
+
+	template<class T>
+	T DistanceSq(const Vector<T, 3>& p, const OBB<T>& box) noexcept
+	{
+		return (box.ClosestPoint(p) - p).MagnitudeSq();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Feature pair queries
+namespace Epic
+{
+	// ClosestPointsSegmentSegment - The closest points of segments p1q1 and p2q2 (Ericson, RTCD 5.1.9).
+	//	s and t receive the parameters of the points along each segment.
+	template<class T>
+	ClosestPointsResult<T> ClosestPointsSegmentSegment(const Vector<T, 3>& p1, const Vector<T, 3>& q1,
+		const Vector<T, 3>& p2, const Vector<T, 3>& q2, T& s, T& t) noexcept
+	{
+		constexpr T Epsilon = std::numeric_limits<T>::epsilon();
+
+		const Vector<T, 3> d1 = q1 - p1;
+		const Vector<T, 3> d2 = q2 - p2;
+		const Vector<T, 3> r = p1 - p2;
+
+		const T a = d1.MagnitudeSq();
+		const T e = d2.MagnitudeSq();
+		const T f = d2.Dot(r);
+
+		if (a <= Epsilon && e <= Epsilon)
+		{
+			s = t = T(0);
+		}
+		else if (a <= Epsilon)
+		{
+			s = T(0);
+			t = std::clamp(f / e, T(0), T(1));
+		}
+		else
+		{
+			const T c = d1.Dot(r);
+
+			if (e <= Epsilon)
+			{
+				t = T(0);
+				s = std::clamp(-c / a, T(0), T(1));
+			}
+			else
+			{
+				// Parallel segments have no unique pair; any s works, so start from p1
+				const T b = d1.Dot(d2);
+				const T denominator = a * e - b * b;
+
+				s = denominator > T(0) ? std::clamp((b * f - c * e) / denominator, T(0), T(1)) : T(0);
+				t = (b * s + f) / e;
+
+				if (t < T(0))
+				{
+					t = T(0);
+					s = std::clamp(-c / a, T(0), T(1));
+				}
+				else if (t > T(1))
+				{
+					t = T(1);
+					s = std::clamp((b - c) / a, T(0), T(1));
+				}
+			}
+		}
+
+		ClosestPointsResult<T> result;
+		result.PointA = p1 + d1 * s;
+		result.PointB = p2 + d2 * t;
+		result.DistanceSq = (result.PointB - result.PointA).MagnitudeSq();
+
+		return result;
+	}
+
+	template<class T>
+	ClosestPointsResult<T> ClosestPointsSegmentSegment(const Vector<T, 3>& p1, const Vector<T, 3>& q1,
+		const Vector<T, 3>& p2, const Vector<T, 3>& q2) noexcept
+	{
+		T s, t;
+
+		return ClosestPointsSegmentSegment(p1, q1, p2, q2, s, t);
+	}
+
+	// IntersectSegmentTriangle - Finds where segment pq crosses triangle abc from either side (Moller-Trumbore).
+	template<class T>
+	bool IntersectSegmentTriangle(const Vector<T, 3>& p, const Vector<T, 3>& q,
+		const Vector<T, 3>& a, const Vector<T, 3>& b, const Vector<T, 3>& c, Vector<T, 3>& point) noexcept
+	{
+		const Vector<T, 3> d = q - p;
+		const Vector<T, 3> ab = b - a;
+		const Vector<T, 3> ac = c - a;
+
+		const Vector<T, 3> h = d.Cross(ac);
+		const T det = ab.Dot(h);
+
+		if (std::abs(det) <= std::numeric_limits<T>::epsilon() * ab.Magnitude() * ac.Magnitude() * d.Magnitude())
+			return false;
+
+		const T inv = T(1) / det;
+		const Vector<T, 3> ap = p - a;
+
+		const T u = ap.Dot(h) * inv;
+		if (u < T(0) || u > T(1))
+			return false;
+
+		const Vector<T, 3> k = ap.Cross(ab);
+
+		const T v = d.Dot(k) * inv;
+		if (v < T(0) || u + v > T(1))
+			return false;
+
+		const T t = ac.Dot(k) * inv;
+		if (t < T(0) || t > T(1))
+			return false;
+
+		point = p + d * t;
+
+		return true;
+	}
+
+	// ClosestPointsSegmentTriangle - The closest points of segment pq and triangle abc.
+	//	A segment piercing the triangle reports the crossing point at distance zero.
+	template<class T>
+	ClosestPointsResult<T> ClosestPointsSegmentTriangle(const Vector<T, 3>& p, const Vector<T, 3>& q,
+		const Vector<T, 3>& a, const Vector<T, 3>& b, const Vector<T, 3>& c) noexcept
+	{
+		ClosestPointsResult<T> result;
+
+		if (IntersectSegmentTriangle(p, q, a, b, c, result.PointA))
+		{
+			result.PointB = result.PointA;
+			return result;
+		}
+
+		const Vector<T, 3> onP = ClosestPointOnTriangle(p, a, b, c);
+		const Vector<T, 3> onQ = ClosestPointOnTriangle(q, a, b, c);
+
+		result = { p, onP, (onP - p).MagnitudeSq() };
+
+		const T distanceQ = (onQ - q).MagnitudeSq();
+		if (distanceQ < result.DistanceSq)
+			result = { q, onQ, distanceQ };
+
+		const Vector<T, 3> vertices[3] = { a, b, c };
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			const auto edge = ClosestPointsSegmentSegment(p, q, vertices[i], vertices[(i + 1) % 3]);
+
+			if (edge.DistanceSq < result.DistanceSq)
+				result = edge;
+		}
+
+		return result;
+	}
+
+	// ClosestPointsTriangleTriangle - The closest points of triangles a and b.
+	//	Intersecting triangles report a point where an edge of one pierces the other, at distance zero.
+	//	Otherwise the closest pair is found among the 9 edge pairs and the 6 vertex-face pairs.
+	template<class T>
+	ClosestPointsResult<T> ClosestPointsTriangleTriangle(const Vector<T, 3>& a0, const Vector<T, 3>& a1, const Vector<T, 3>& a2,
+		const Vector<T, 3>& b0, const Vector<T, 3>& b1, const Vector<T, 3>& b2) noexcept
+	{
+		const Vector<T, 3> a[3] = { a0, a1, a2 };
+		const Vector<T, 3> b[3] = { b0, b1, b2 };
+
+		ClosestPointsResult<T> result;
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			Vector<T, 3> point;
+
+			if (IntersectSegmentTriangle(a[i], a[(i + 1) % 3], b0, b1, b2, point)
+				|| IntersectSegmentTriangle(b[i], b[(i + 1) % 3], a0, a1, a2, point))
+			{
+				result.PointA = result.PointB = point;
+				return result;
+			}
+		}
+
+		result.DistanceSq = std::numeric_limits<T>::max();
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			for (size_t j = 0; j < 3; ++j)
+			{
+				const auto edges = ClosestPointsSegmentSegment(a[i], a[(i + 1) % 3], b[j], b[(j + 1) % 3]);
+
+				if (edges.DistanceSq < result.DistanceSq)
+					result = edges;
+			}
+		}
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			const Vector<T, 3> onB = ClosestPointOnTriangle(a[i], b0, b1, b2);
+			const T distanceA = (onB - a[i]).MagnitudeSq();
+
+			if (distanceA < result.DistanceSq)
+				result = { a[i], onB, distanceA };
+
+			const Vector<T, 3> onA = ClosestPointOnTriangle(b[i], a0, a1, a2);
+			const T distanceB = (onA - b[i]).MagnitudeSq();
+
+			if (distanceB < result.DistanceSq)
+				result = { onA, b[i], distanceB };
+		}
+
+		return result;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Batch point-triangle queries
+namespace Epic::detail
+{
+	// ClosestPointOnTriangleLane - A branch-free form of ClosestPointOnTriangle for lane loops.
+	//	The projection onto the plane is kept when it falls inside the triangle; otherwise the closest of the three
+	//	clamped edge projections is taken. Every candidate is evaluated and chosen with selects.
+	template<class T>
+	inline T ClosestPointOnTriangleLane(const T(&p)[3], const T(&a)[3], const T(&b)[3], const T(&c)[3], T(&out)[3]) noexcept
+	{
+		T ab[3], ac[3], bc[3], ap[3], bp[3];
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			ab[k] = b[k] - a[k];
+			ac[k] = c[k] - a[k];
+			bc[k] = c[k] - b[k];
+			ap[k] = p[k] - a[k];
+			bp[k] = p[k] - b[k];
+		}
+
+		auto dot = [](const T(&x)[3], const T(&y)[3]) { return x[0] * y[0] + x[1] * y[1] + x[2] * y[2]; };
+
+		const T d00 = dot(ab, ab);
+		const T d01 = dot(ab, ac);
+		const T d11 = dot(ac, ac);
+		const T dbc = dot(bc, bc);
+		const T d20 = dot(ap, ab);
+		const T d21 = dot(ap, ac);
+
+		// Barycentric coordinates of the projection
+		const T denominator = d00 * d11 - d01 * d01;
+		const T inv = denominator > T(0) ? T(1) / denominator : T(0);
+		const T v = (d11 * d20 - d01 * d21) * inv;
+		const T w = (d00 * d21 - d01 * d20) * inv;
+		const bool inside = denominator > T(0) && v >= T(0) && w >= T(0) && v + w <= T(1);
+
+		// Clamped edge parameters
+		const T tab = d00 > T(0) ? std::min(std::max(d20 / d00, T(0)), T(1)) : T(0);
+		const T tac = d11 > T(0) ? std::min(std::max(d21 / d11, T(0)), T(1)) : T(0);
+		const T tbc = dbc > T(0) ? std::min(std::max(dot(bp, bc) / dbc, T(0)), T(1)) : T(0);
+
+		T eab[3], eac[3], ebc[3], face[3];
+		T sab = T(0), sac = T(0), sbc = T(0);
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			eab[k] = a[k] + ab[k] * tab;
+			eac[k] = a[k] + ac[k] * tac;
+			ebc[k] = b[k] + bc[k] * tbc;
+			face[k] = a[k] + ab[k] * v + ac[k] * w;
+
+			sab += (p[k] - eab[k]) * (p[k] - eab[k]);
+			sac += (p[k] - eac[k]) * (p[k] - eac[k]);
+			sbc += (p[k] - ebc[k]) * (p[k] - ebc[k]);
+		}
+
+		const bool pickAB = sab <= sac && sab <= sbc;
+		const bool pickAC = !pickAB && sac <= sbc;
+
+		T result = T(0);
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			const T edge = pickAB ? eab[k] : (pickAC ? eac[k] : ebc[k]);
+
+			out[k] = inside ? face[k] : edge;
+			result += (p[k] - out[k]) * (p[k] - out[k]);
+		}
+
+		return result;
+	}
+}
+
+namespace Epic
+{
+	// BatchClosestPointOnTriangles - The closest point of each of count triangles to p.
+	//	pTriangles holds 3 vertices per triangle. Either of pPoints or pDistancesSq may be null.
+	//	Triangles are staged into SoA lanes a block at a time and run through the branch-free kernel.
+	template<class T>
+	void BatchClosestPointOnTriangles(const Vector<T, 3>& p, const Vector<T, 3>* pTriangles, size_t count,
+		Vector<T, 3>* pPoints, T* pDistancesSq) noexcept
+	{
+		constexpr size_t BlockSize = detail::BatchBlockSize;
+
+		T v[9][BlockSize];
+		T out[3][BlockSize];
+		T distances[BlockSize];
+
+		const T point[3] = { p[0], p[1], p[2] };
+
+		for (size_t block = 0; block < count; block += BlockSize)
+		{
+			const size_t blockCount = std::min(BlockSize, count - block);
+
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				const Vector<T, 3>* pTriangle = pTriangles + (block + i) * 3;
+
+				for (size_t n = 0; n < 3; ++n)
+					for (size_t k = 0; k < 3; ++k)
+						v[n * 3 + k][i] = pTriangle[n][k];
+			}
+
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				T a[3], b[3], c[3], closest[3];
+
+				for (size_t k = 0; k < 3; ++k)
+				{
+					a[k] = v[k][i];
+					b[k] = v[3 + k][i];
+					c[k] = v[6 + k][i];
+				}
+
+				distances[i] = detail::ClosestPointOnTriangleLane(point, a, b, c, closest);
+
+				for (size_t k = 0; k < 3; ++k)
+					out[k][i] = closest[k];
+			}
+
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				if (pPoints)
+				{
+					for (size_t k = 0; k < 3; ++k)
+						pPoints[block + i][k] = out[k][i];
+				}
+
+				if (pDistancesSq)
+					pDistancesSq[block + i] = distances[i];
+			}
+		}
+	}
+
+	// ClosestTriangle - The index of the triangle closest to p, or count if there are none.
+	//	pTriangles holds 3 vertices per triangle; point and distanceSq receive the closest point and its distance.
+	template<class T>
+	size_t ClosestTriangle(const Vector<T, 3>& p, const Vector<T, 3>* pTriangles, size_t count,
+		Vector<T, 3>& point, T& distanceSq) noexcept
+	{
+		constexpr size_t BlockSize = detail::BatchBlockSize;
+
+		Vector<T, 3> points[BlockSize];
+		T distances[BlockSize];
+
+		size_t result = count;
+		distanceSq = std::numeric_limits<T>::max();
+
+		for (size_t block = 0; block < count; block += BlockSize)
+		{
+			const size_t blockCount = std::min(BlockSize, count - block);
+
+			BatchClosestPointOnTriangles(p, pTriangles + block * 3, blockCount, points, distances);
+
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				if (distances[i] < distanceSq)
+				{
+					distanceSq = distances[i];
+					point = points[i];
+					result = block + i;
+				}
+			}
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,155 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+#include "../Math/Quaternion.h"
+#include "../Math/Vector.h"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Convex shapes
+//	World space convex shapes for the narrowphase. Each shape provides Support(shape, direction), the point
+//	of the shape furthest along a (not necessarily normalized) direction, and Center(shape), a point near
+//	its middle that picks the first search direction. Other shapes can be used with GJK() and Penetration()
+//	by overloading both functions.
+namespace Epic
+{
+	template<class T>
+	struct SphereShape
+	{
+		Vector<T, 3> Position;
+		T Radius;
+	};
+
+	// A segment swept by a sphere
+	template<class T>
+	struct CapsuleShape
+	{
+		Vector<T, 3> PointA;
+		Vector<T, 3> PointB;
+		T Radius;
+	};
+
+	template<class T>
+	struct BoxShape
+	{
+		Vector<T, 3> Position;
+		Quaternion<T> Orientation;
+		Vector<T, 3> HalfExtents;
+	};
+
+	// The convex hull of Count points given in the shape's local frame. The points are not owned.
+	template<class T>
+	struct ConvexHullShape
+	{
+		Vector<T, 3> Position;
+		Quaternion<T> Orientation;
+		const Vector<T, 3>* pPoints;
+		size_t Count;
+	};
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Support functions
+namespace Epic
+{
+	namespace detail
+	{
+		// direction scaled to length, or 0 for a 0 direction
+		template<class T>
+		inline Vector<T, 3> ScaleToLength(const Vector<T, 3>& direction, T length) noexcept
+		{
+			const T magnitudeSq = direction.MagnitudeSq();
+
+			if (magnitudeSq <= T(0))
+				return Vector<T, 3>{ Zero };
+
+			return direction * (length / std::sqrt(magnitudeSq));
+		}
+	}
+
+	template<class T>
+	inline Vector<T, 3> Support(const SphereShape<T>& shape, const Vector<T, 3>& direction) noexcept
+	{
+		return shape.Position + detail::ScaleToLength(direction, shape.Radius);
+	}
+
+	template<class T>
+	inline Vector<T, 3> Support(const CapsuleShape<T>& shape, const Vector<T, 3>& direction) noexcept
+	{
+		const Vector<T, 3> axis = shape.PointB - shape.PointA;
+		const Vector<T, 3>& end = (axis.Dot(direction) >= T(0)) ? shape.PointB : shape.PointA;
+
+		return end + detail::ScaleToLength(direction, shape.Radius);
+	}
+
+	template<class T>
+	inline Vector<T, 3> Support(const BoxShape<T>& shape, const Vector<T, 3>& direction) noexcept
+	{
+		Vector<T, 3> local = direction;
+		Quaternion<T>::ConjugateOf(shape.Orientation).Transform(local);
+
+		for (size_t k = 0; k < 3; ++k)
+			local[k] = (local[k] >= T(0)) ? shape.HalfExtents[k] : -shape.HalfExtents[k];
+
+		shape.Orientation.Transform(local);
+
+		return shape.Position + local;
+	}
+
+	template<class T>
+	inline Vector<T, 3> Support(const ConvexHullShape<T>& shape, const Vector<T, 3>& direction) noexcept
+	{
+		assert(shape.pPoints && shape.Count > 0);
+
+		Vector<T, 3> local = direction;
+		Quaternion<T>::ConjugateOf(shape.Orientation).Transform(local);
+
+		size_t best = 0;
+		T bestDistance = shape.pPoints[0].Dot(local);
+
+		for (size_t i = 1; i < shape.Count; ++i)
+		{
+			const T distance = shape.pPoints[i].Dot(local);
+
+			if (distance > bestDistance)
+			{
+				best = i;
+				bestDistance = distance;
+			}
+		}
+
+		Vector<T, 3> result = shape.pPoints[best];
+		shape.Orientation.Transform(result);
+
+		return shape.Position + result;
+	}
+
+	template<class T>
+	inline Vector<T, 3> Center(const SphereShape<T>& shape) noexcept { return shape.Position; }
+
+	template<class T>
+	inline Vector<T, 3> Center(const CapsuleShape<T>& shape) noexcept { return (shape.PointA + shape.PointB) * T(0.5); }
+
+	template<class T>
+	inline Vector<T, 3> Center(const BoxShape<T>& shape) noexcept { return shape.Position; }
+
+	template<class T>
+	inline Vector<T, 3> Center(const ConvexHullShape<T>& shape) noexcept { return shape.Position; }
+}
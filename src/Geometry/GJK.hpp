@@ -0,0 +1,690 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ConvexShapes.hpp"
+#include "../Math/Vector.h"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// GJK types
+namespace Epic
+{
+	// GJKCache - The search directions of the final simplex of a GJK query.
+	//	Passing the same cache to the query of the same pair next frame seeds the simplex from those
+	//	directions, which usually leaves only one or two iterations to do.
+	template<class T>
+	struct GJKCache
+	{
+		Vector<T, 3> Directions[4];
+		size_t Count = 0;
+	};
+
+	// GJKResult - The distance between two shapes and their closest points
+	template<class T>
+	struct GJKResult
+	{
+		bool Intersecting = false;
+		T Distance = T(0);
+		Vector<T, 3> PointA{ Zero };
+		Vector<T, 3> PointB{ Zero };
+		size_t Iterations = 0;
+	};
+
+	// PenetrationResult - The smallest translation separating two intersecting shapes.
+	//	Moving shape B by Normal * Depth separates them; PointA and PointB are the deepest points of each.
+	template<class T>
+	struct PenetrationResult
+	{
+		bool Intersecting = false;
+		T Depth = T(0);
+		Vector<T, 3> Normal{ Zero };
+		Vector<T, 3> PointA{ Zero };
+		Vector<T, 3> PointB{ Zero };
+	};
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// GJK simplex
+namespace Epic::detail
+{
+	template<class Shape>
+	using ShapeScalar = typename std::decay_t<decltype(Center(std::declval<const Shape&>()))>::value_type;
+
+	// A vertex of the Minkowski difference A - B and the support points it came from
+	template<class T>
+	struct GJKVertex
+	{
+		Vector<T, 3> W;
+		Vector<T, 3> A;
+		Vector<T, 3> B;
+		Vector<T, 3> Direction;
+	};
+
+	template<class ShapeA, class ShapeB, class T>
+	inline GJKVertex<T> GJKSupport(const ShapeA& a, const ShapeB& b, const Vector<T, 3>& direction) noexcept
+	{
+		GJKVertex<T> result{ Vector<T, 3>{ Zero }, Support(a, direction), Support(b, -direction), direction };
+		result.W = result.A - result.B;
+
+		return result;
+	}
+
+	// GJKSimplex - Up to 4 vertices and the barycentric weights of the point closest to the origin.
+	//	Solve() reduces the simplex to the smallest feature containing that point (Catto, 2010).
+	template<class T>
+	struct GJKSimplex
+	{
+		GJKVertex<T> Vertices[4];
+		T Weights[4] = { };
+		size_t Count = 0;
+
+		Vector<T, 3> ClosestPoint() const noexcept
+		{
+			Vector<T, 3> result{ Zero };
+
+			for (size_t i = 0; i < Count; ++i)
+				result += Vertices[i].W * Weights[i];
+
+			return result;
+		}
+
+		void Witnesses(Vector<T, 3>& pointA, Vector<T, 3>& pointB) const noexcept
+		{
+			pointA = pointB = Vector<T, 3>{ Zero };
+
+			for (size_t i = 0; i < Count; ++i)
+			{
+				pointA += Vertices[i].A * Weights[i];
+				pointB += Vertices[i].B * Weights[i];
+			}
+		}
+
+		bool Contains(const Vector<T, 3>& w, T toleranceSq) const noexcept
+		{
+			for (size_t i = 0; i < Count; ++i)
+			{
+				if ((Vertices[i].W - w).MagnitudeSq() <= toleranceSq)
+					return true;
+			}
+
+			return false;
+		}
+
+		// Returns false if the origin lies inside a tetrahedron
+		bool Solve() noexcept
+		{
+			switch (Count)
+			{
+			case 1: Weights[0] = T(1); return true;
+			case 2: SolveSegment(); return true;
+			case 3: SolveTriangle(); return true;
+			default: return SolveTetrahedron();
+			}
+		}
+
+	private:
+		void Keep(size_t i) noexcept
+		{
+			Vertices[0] = Vertices[i];
+			Weights[0] = T(1);
+			Count = 1;
+		}
+
+		void Keep(size_t i, size_t j, T wi, T wj) noexcept
+		{
+			const GJKVertex<T> vi = Vertices[i];
+			const GJKVertex<T> vj = Vertices[j];
+
+			Vertices[0] = vi;
+			Vertices[1] = vj;
+			Weights[0] = wi;
+			Weights[1] = wj;
+			Count = 2;
+		}
+
+		void SolveSegment() noexcept
+		{
+			const Vector<T, 3>& w1 = Vertices[0].W;
+			const Vector<T, 3>& w2 = Vertices[1].W;
+			const Vector<T, 3> e12 = w2 - w1;
+
+			const T u = w2.Dot(e12);
+			const T v = -w1.Dot(e12);
+
+			if (v <= T(0))
+				Keep(0);
+			else if (u <= T(0))
+				Keep(1);
+			else
+				Keep(0, 1, u / (u + v), v / (u + v));
+		}
+
+		// The closest feature of the segment (i, j), written as weights into the full simplex
+		T SegmentDistanceSq(size_t i, size_t j, T(&weights)[4]) const noexcept
+		{
+			const Vector<T, 3>& wi = Vertices[i].W;
+			const Vector<T, 3>& wj = Vertices[j].W;
+			const Vector<T, 3> e = wj - wi;
+
+			const T u = wj.Dot(e);
+			const T v = -wi.Dot(e);
+
+			weights[0] = weights[1] = weights[2] = weights[3] = T(0);
+
+			if (v <= T(0))
+				weights[i] = T(1);
+			else if (u <= T(0))
+				weights[j] = T(1);
+			else
+			{
+				weights[i] = u / (u + v);
+				weights[j] = v / (u + v);
+			}
+
+			return (wi * weights[i] + wj * weights[j]).MagnitudeSq();
+		}
+
+		void KeepWeighted(const T(&weights)[4]) noexcept
+		{
+			size_t count = 0;
+
+			for (size_t i = 0; i < Count; ++i)
+			{
+				if (weights[i] > T(0))
+				{
+					Vertices[count] = Vertices[i];
+					Weights[count] = weights[i];
+					++count;
+				}
+			}
+
+			Count = count;
+		}
+
+		void SolveTriangle() noexcept
+		{
+			const Vector<T, 3>& w1 = Vertices[0].W;
+			const Vector<T, 3>& w2 = Vertices[1].W;
+			const Vector<T, 3>& w3 = Vertices[2].W;
+
+			const Vector<T, 3> e12 = w2 - w1;
+			const Vector<T, 3> e13 = w3 - w1;
+			const Vector<T, 3> e23 = w3 - w2;
+
+			const T u12 = w2.Dot(e12), v12 = -w1.Dot(e12);
+			const T u13 = w3.Dot(e13), v13 = -w1.Dot(e13);
+			const T u23 = w3.Dot(e23), v23 = -w2.Dot(e23);
+
+			const Vector<T, 3> n = e12.Cross(e13);
+
+			const T u123 = n.Dot(w2.Cross(w3));
+			const T v123 = n.Dot(w3.Cross(w1));
+			const T w123 = n.Dot(w1.Cross(w2));
+
+			if (v12 <= T(0) && v13 <= T(0))
+				Keep(0);
+			else if (u12 > T(0) && v12 > T(0) && w123 <= T(0))
+				Keep(0, 1, u12 / (u12 + v12), v12 / (u12 + v12));
+			else if (u13 > T(0) && v13 > T(0) && v123 <= T(0))
+				Keep(0, 2, u13 / (u13 + v13), v13 / (u13 + v13));
+			else if (u12 <= T(0) && v23 <= T(0))
+				Keep(1);
+			else if (u13 <= T(0) && u23 <= T(0))
+				Keep(2);
+			else if (u23 > T(0) && v23 > T(0) && u123 <= T(0))
+				Keep(1, 2, u23 / (u23 + v23), v23 / (u23 + v23));
+			else
+			{
+				const T sum = u123 + v123 + w123;
+
+				if (sum > T(0))
+				{
+					Weights[0] = u123 / sum;
+					Weights[1] = v123 / sum;
+					Weights[2] = w123 / sum;
+					return;
+				}
+
+				// Degenerate triangle: use the closest of its edges
+				T best[4], weights[4];
+				T bestDistanceSq = SegmentDistanceSq(0, 1, best);
+
+				const size_t edges[2][2] = { { 0, 2 }, { 1, 2 } };
+
+				for (const auto& edge : edges)
+				{
+					const T distanceSq = SegmentDistanceSq(edge[0], edge[1], weights);
+
+					if (distanceSq < bestDistanceSq)
+					{
+						bestDistanceSq = distanceSq;
+						std::copy(std::begin(weights), std::end(weights), std::begin(best));
+					}
+				}
+
+				KeepWeighted(best);
+			}
+		}
+
+		bool SolveTetrahedron() noexcept
+		{
+			constexpr size_t Faces[4][4] = { { 0, 1, 2, 3 }, { 0, 1, 3, 2 }, { 0, 2, 3, 1 }, { 1, 2, 3, 0 } };
+
+			const T volume = (Vertices[1].W - Vertices[0].W).Dot((Vertices[2].W - Vertices[0].W).Cross(Vertices[3].W - Vertices[0].W));
+			const bool isDegenerate = std::abs(volume) <= std::numeric_limits<T>::epsilon() * MaxMagnitudeSq() * std::sqrt(MaxMagnitudeSq());
+
+			GJKSimplex best;
+			T bestDistanceSq = std::numeric_limits<T>::max();
+			bool isOutside = false;
+
+			for (const auto& face : Faces)
+			{
+				const Vector<T, 3>& wi = Vertices[face[0]].W;
+				const Vector<T, 3> n = (Vertices[face[1]].W - wi).Cross(Vertices[face[2]].W - wi);
+
+				const T originSide = -n.Dot(wi);
+				const T vertexSide = n.Dot(Vertices[face[3]].W - wi);
+
+				if (!isDegenerate && originSide * vertexSide >= T(0))
+					continue;
+
+				isOutside = true;
+
+				GJKSimplex triangle;
+				triangle.Vertices[0] = Vertices[face[0]];
+				triangle.Vertices[1] = Vertices[face[1]];
+				triangle.Vertices[2] = Vertices[face[2]];
+				triangle.Count = 3;
+				triangle.SolveTriangle();
+
+				const T distanceSq = triangle.ClosestPoint().MagnitudeSq();
+
+				if (distanceSq < bestDistanceSq)
+				{
+					bestDistanceSq = distanceSq;
+					best = triangle;
+				}
+			}
+
+			if (!isOutside)
+			{
+				const T total = std::abs(volume);
+
+				// Barycentric weights of the origin from the sub-volumes
+				for (size_t i = 0; i < 4; ++i)
+				{
+					const auto& face = Faces[3 - i];
+					const Vector<T, 3>& wi = Vertices[face[0]].W;
+					const T subVolume = std::abs(wi.Dot(Vertices[face[1]].W.Cross(Vertices[face[2]].W)));
+
+					Weights[face[3]] = (total > T(0)) ? subVolume / total : T(0.25);
+				}
+
+				return false;
+			}
+
+			*this = best;
+			return true;
+		}
+
+		T MaxMagnitudeSq() const noexcept
+		{
+			T result = T(0);
+
+			for (size_t i = 0; i < Count; ++i)
+				result = std::max(result, Vertices[i].W.MagnitudeSq());
+
+			return result;
+		}
+	};
+
+	// Runs GJK on the pair, leaving the final simplex in simplex
+	template<class ShapeA, class ShapeB, class T>
+	GJKResult<T> RunGJK(const ShapeA& a, const ShapeB& b, GJKCache<T>* pCache, GJKSimplex<T>& simplex, size_t maxIterations) noexcept
+	{
+		const T relativeTolerance = std::sqrt(std::numeric_limits<T>::epsilon());
+		const T duplicateToleranceSq = std::numeric_limits<T>::epsilon();
+
+		simplex.Count = 0;
+
+		if (pCache)
+		{
+			for (size_t i = 0; i < pCache->Count; ++i)
+			{
+				const auto vertex = GJKSupport(a, b, pCache->Directions[i]);
+
+				if (!simplex.Contains(vertex.W, duplicateToleranceSq))
+					simplex.Vertices[simplex.Count++] = vertex;
+			}
+		}
+
+		if (simplex.Count == 0)
+		{
+			Vector<T, 3> direction = Center(b) - Center(a);
+
+			if (direction.MagnitudeSq() <= T(0))
+				direction = Vector<T, 3>{ T(1), T(0), T(0) };
+
+			simplex.Vertices[simplex.Count++] = GJKSupport(a, b, direction);
+		}
+
+		GJKResult<T> result;
+
+		for (result.Iterations = 0; result.Iterations < maxIterations; ++result.Iterations)
+		{
+			if (!simplex.Solve())
+			{
+				result.Intersecting = true;
+				break;
+			}
+
+			const Vector<T, 3> v = simplex.ClosestPoint();
+			const T distanceSq = v.MagnitudeSq();
+
+			T scaleSq = T(0);
+			for (size_t i = 0; i < simplex.Count; ++i)
+				scaleSq = std::max(scaleSq, simplex.Vertices[i].W.MagnitudeSq());
+
+			if (distanceSq <= std::numeric_limits<T>::epsilon() * scaleSq)
+			{
+				result.Intersecting = true;
+				break;
+			}
+
+			const auto vertex = GJKSupport(a, b, Vector<T, 3>{ -v });
+
+			// No further progress towards the origin
+			if (distanceSq - v.Dot(vertex.W) <= relativeTolerance * distanceSq || simplex.Contains(vertex.W, duplicateToleranceSq))
+				break;
+
+			simplex.Vertices[simplex.Count++] = vertex;
+		}
+
+		// Running out of iterations leaves the last support point without a weight
+		if (!result.Intersecting && result.Iterations == maxIterations && !simplex.Solve())
+			result.Intersecting = true;
+
+		if (!result.Intersecting)
+		{
+			simplex.Witnesses(result.PointA, result.PointB);
+			result.Distance = simplex.ClosestPoint().Magnitude();
+		}
+
+		if (pCache)
+		{
+			pCache->Count = simplex.Count;
+
+			for (size_t i = 0; i < simplex.Count; ++i)
+				pCache->Directions[i] = simplex.Vertices[i].Direction;
+		}
+
+		return result;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// EPA
+namespace Epic::detail
+{
+	template<class T>
+	struct EPAFace
+	{
+		size_t Indices[3];
+		Vector<T, 3> Normal;
+		T Distance;
+	};
+
+	template<class T>
+	inline EPAFace<T> MakeEPAFace(const std::vector<GJKVertex<T>>& vertices, size_t i, size_t j, size_t k) noexcept
+	{
+		EPAFace<T> face{ { i, j, k }, (vertices[j].W - vertices[i].W).Cross(vertices[k].W - vertices[i].W), std::numeric_limits<T>::max() };
+
+		const T lengthSq = face.Normal.MagnitudeSq();
+
+		if (lengthSq > T(0))
+		{
+			face.Normal *= T(1) / std::sqrt(lengthSq);
+			face.Distance = face.Normal.Dot(vertices[i].W);
+		}
+
+		return face;
+	}
+
+	// Grows a simplex that contains the origin into a tetrahedron. Returns false for flat shapes.
+	template<class ShapeA, class ShapeB, class T>
+	bool ExpandToTetrahedron(const ShapeA& a, const ShapeB& b, GJKSimplex<T>& simplex) noexcept
+	{
+		const T toleranceSq = std::numeric_limits<T>::epsilon();
+		const Vector<T, 3> axes[3] = { { T(1), T(0), T(0) }, { T(0), T(1), T(0) }, { T(0), T(0), T(1) } };
+
+		const auto tryAdd = [&](const Vector<T, 3>& direction, auto isAcceptable)
+		{
+			for (const T sign : { T(1), T(-1) })
+			{
+				const auto vertex = GJKSupport(a, b, Vector<T, 3>{ direction * sign });
+
+				if (isAcceptable(vertex.W))
+				{
+					simplex.Vertices[simplex.Count++] = vertex;
+					return true;
+				}
+			}
+
+			return false;
+		};
+
+		if (simplex.Count == 1)
+		{
+			for (const auto& axis : axes)
+			{
+				if (tryAdd(axis, [&](const Vector<T, 3>& w) { return (w - simplex.Vertices[0].W).MagnitudeSq() > toleranceSq; }))
+					break;
+			}
+		}
+
+		if (simplex.Count == 2)
+		{
+			const Vector<T, 3> e = simplex.Vertices[1].W - simplex.Vertices[0].W;
+
+			for (const auto& axis : axes)
+			{
+				const Vector<T, 3> perpendicular = e.Cross(axis);
+
+				if (perpendicular.MagnitudeSq() > T(0) && tryAdd(perpendicular, [&](const Vector<T, 3>& w)
+				{
+					return e.Cross(w - simplex.Vertices[0].W).MagnitudeSq() > toleranceSq * e.MagnitudeSq();
+				}))
+					break;
+			}
+		}
+
+		if (simplex.Count == 3)
+		{
+			const Vector<T, 3> n = (simplex.Vertices[1].W - simplex.Vertices[0].W).Cross(simplex.Vertices[2].W - simplex.Vertices[0].W);
+
+			tryAdd(n, [&](const Vector<T, 3>& w)
+			{
+				const T height = n.Dot(w - simplex.Vertices[0].W);
+				return height * height > toleranceSq * n.MagnitudeSq();
+			});
+		}
+
+		return simplex.Count == 4;
+	}
+
+	// Expanding polytope algorithm (van den Bergen, 2001) on a tetrahedron containing the origin
+	template<class ShapeA, class ShapeB, class T>
+	PenetrationResult<T> RunEPA(const ShapeA& a, const ShapeB& b, const GJKSimplex<T>& simplex, size_t maxIterations) noexcept
+	{
+		// Curved shapes only converge in the limit; their normal error goes as the square root of this
+		const T scale = std::sqrt(std::max({ simplex.Vertices[0].W.MagnitudeSq(), simplex.Vertices[1].W.MagnitudeSq(),
+			simplex.Vertices[2].W.MagnitudeSq(), simplex.Vertices[3].W.MagnitudeSq() }));
+		const T tolerance = T(64) * std::numeric_limits<T>::epsilon() * std::max(scale, T(1));
+
+		std::vector<GJKVertex<T>> vertices(simplex.Vertices, simplex.Vertices + 4);
+		std::vector<EPAFace<T>> faces;
+		std::vector<std::pair<size_t, size_t>> horizon;
+
+		// Wind every face so that its normal points away from the opposite vertex
+		constexpr size_t Faces[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+
+		for (const auto& f : Faces)
+		{
+			const Vector<T, 3> n = (vertices[f[1]].W - vertices[f[0]].W).Cross(vertices[f[2]].W - vertices[f[0]].W);
+
+			if (n.Dot(vertices[f[3]].W - vertices[f[0]].W) > T(0))
+				faces.push_back(MakeEPAFace(vertices, f[0], f[2], f[1]));
+			else
+				faces.push_back(MakeEPAFace(vertices, f[0], f[1], f[2]));
+		}
+
+		// The closest face never gets further from the origin as the polytope grows. Once rounding lets it
+		// fold inwards, the closest face of the last good polytope is kept.
+		EPAFace<T> face = faces[0];
+
+		for (size_t iteration = 0; iteration < maxIterations; ++iteration)
+		{
+			size_t closest = 0;
+
+			for (size_t f = 1; f < faces.size(); ++f)
+			{
+				if (faces[f].Distance < faces[closest].Distance)
+					closest = f;
+			}
+
+			if (iteration > 0 && faces[closest].Distance < face.Distance - tolerance)
+				break;
+
+			face = faces[closest];
+
+			const auto vertex = GJKSupport(a, b, face.Normal);
+
+			if (face.Normal.Dot(vertex.W) - face.Distance <= tolerance)
+				break;
+
+			// Remove the faces the new vertex can see and keep the edges of the hole they leave
+			horizon.clear();
+
+			for (size_t f = 0; f < faces.size();)
+			{
+				const auto& candidate = faces[f];
+
+				if (candidate.Normal.Dot(vertex.W - vertices[candidate.Indices[0]].W) <= tolerance)
+				{
+					++f;
+					continue;
+				}
+
+				for (size_t e = 0; e < 3; ++e)
+				{
+					const std::pair<size_t, size_t> edge{ candidate.Indices[e], candidate.Indices[(e + 1) % 3] };
+					const auto twin = std::find(std::begin(horizon), std::end(horizon), std::make_pair(edge.second, edge.first));
+
+					if (twin != std::end(horizon))
+						horizon.erase(twin);
+					else
+						horizon.push_back(edge);
+				}
+
+				faces[f] = faces.back();
+				faces.pop_back();
+			}
+
+			if (horizon.empty())
+				break;
+
+			vertices.push_back(vertex);
+
+			for (const auto& edge : horizon)
+				faces.push_back(MakeEPAFace(vertices, edge.first, edge.second, vertices.size() - 1));
+		}
+
+		// Barycentric weights of the origin's projection onto the closest face
+		const Vector<T, 3> p = face.Normal * face.Distance;
+		const Vector<T, 3>& w0 = vertices[face.Indices[0]].W;
+		const Vector<T, 3>& w1 = vertices[face.Indices[1]].W;
+		const Vector<T, 3>& w2 = vertices[face.Indices[2]].W;
+
+		const T area = face.Normal.Dot((w1 - w0).Cross(w2 - w0));
+		const T u = (area > T(0)) ? face.Normal.Dot((w1 - p).Cross(w2 - p)) / area : T(1);
+		const T v = (area > T(0)) ? face.Normal.Dot((w2 - p).Cross(w0 - p)) / area : T(0);
+		const T weights[3] = { u, v, T(1) - u - v };
+
+		PenetrationResult<T> result;
+		result.Intersecting = true;
+		result.Depth = std::max(face.Distance, T(0));
+		result.Normal = face.Normal;
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			result.PointA += vertices[face.Indices[k]].A * weights[k];
+			result.PointB += vertices[face.Indices[k]].B * weights[k];
+		}
+
+		return result;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// GJK
+namespace Epic
+{
+	// GJK - The distance and closest points between two convex shapes (Gilbert, Johnson and Keerthi, 1988).
+	//	Intersecting shapes report a distance of 0. pCache may carry the simplex between frames.
+	template<class ShapeA, class ShapeB, class T = detail::ShapeScalar<ShapeA>>
+	GJKResult<T> GJK(const ShapeA& a, const ShapeB& b, GJKCache<T>* pCache = nullptr, size_t maxIterations = 32) noexcept
+	{
+		detail::GJKSimplex<T> simplex;
+		return detail::RunGJK(a, b, pCache, simplex, maxIterations);
+	}
+
+	// Intersects - Whether two convex shapes overlap
+	template<class ShapeA, class ShapeB, class T = detail::ShapeScalar<ShapeA>>
+	bool Intersects(const ShapeA& a, const ShapeB& b, GJKCache<T>* pCache = nullptr) noexcept
+	{
+		return GJK(a, b, pCache).Intersecting;
+	}
+
+	// Penetration - The penetration depth and normal of two convex shapes, found with EPA when GJK reports
+	//	an intersection. Separated shapes report Intersecting = false.
+	template<class ShapeA, class ShapeB, class T = detail::ShapeScalar<ShapeA>>
+	PenetrationResult<T> Penetration(const ShapeA& a, const ShapeB& b, GJKCache<T>* pCache = nullptr, size_t maxIterations = 64)
+	{
+		detail::GJKSimplex<T> simplex;
+
+		if (!detail::RunGJK(a, b, pCache, simplex, 32).Intersecting)
+			return PenetrationResult<T>{};
+
+		if (!detail::ExpandToTetrahedron(a, b, simplex))
+		{
+			PenetrationResult<T> result;
+			result.Intersecting = true;
+			return result;
+		}
+
+		return detail::RunEPA(a, b, simplex, maxIterations);
+	}
+}
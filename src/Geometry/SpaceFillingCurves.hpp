@@ -0,0 +1,305 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+//////////////////////////////////////////////////////////////////////////////
+
+// CurveBits
+namespace Epic
+{
+	// CurveBits<Code, N> - The number of bits per axis that fit in a curve code of type Code.
+	//	uint32_t: 16 bits (2D) or 10 bits (3D, a 30-bit code)
+	//	uint64_t: 32 bits (2D) or 21 bits (3D, a 63-bit code)
+	template<class Code, size_t N>
+	inline constexpr size_t CurveBits = (sizeof(Code) * 8) / N;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace Epic::detail
+{
+	template<class U>
+	constexpr int CountLeadingZeroes(U value) noexcept
+	{
+		constexpr int Width = int(sizeof(U) * 8);
+
+		if (value == 0)
+			return Width;
+
+		int result = 0;
+
+		for (int shift = Width / 2; shift > 0; shift /= 2)
+		{
+			if ((value >> (Width - shift)) == 0)
+			{
+				result += shift;
+				value <<= shift;
+			}
+		}
+
+		return result;
+	}
+
+	// Spreads the low bits of value so that there are N - 1 zero bits between each of them.
+	template<class Code, size_t N>
+	constexpr Code SpreadBits(std::uint32_t value) noexcept
+	{
+		static_assert(std::is_same_v<Code, std::uint32_t> || std::is_same_v<Code, std::uint64_t>,
+			"Curve codes must be 32 or 64 bit unsigned integers.");
+
+		if constexpr (N == 2 && sizeof(Code) == 4)
+		{
+			Code x = value & 0x0000FFFFu;
+			x = (x | (x << 8)) & 0x00FF00FFu;
+			x = (x | (x << 4)) & 0x0F0F0F0Fu;
+			x = (x | (x << 2)) & 0x33333333u;
+			x = (x | (x << 1)) & 0x55555555u;
+			return x;
+		}
+		else if constexpr (N == 2)
+		{
+			Code x = value;
+			x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+			x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+			x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+			x = (x | (x << 2)) & 0x3333333333333333ull;
+			x = (x | (x << 1)) & 0x5555555555555555ull;
+			return x;
+		}
+		else if constexpr (N == 3 && sizeof(Code) == 4)
+		{
+			Code x = value & 0x000003FFu;
+			x = (x | (x << 16)) & 0x030000FFu;
+			x = (x | (x << 8)) & 0x0300F00Fu;
+			x = (x | (x << 4)) & 0x030C30C3u;
+			x = (x | (x << 2)) & 0x09249249u;
+			return x;
+		}
+		else
+		{
+			static_assert(N == 3, "Curve codes are only available for 2 or 3 dimensions.");
+
+			Code x = value & 0x001FFFFFu;
+			x = (x | (x << 32)) & 0x001F00000000FFFFull;
+			x = (x | (x << 16)) & 0x001F0000FF0000FFull;
+			x = (x | (x << 8)) & 0x100F00F00F00F00Full;
+			x = (x | (x << 4)) & 0x10C30C30C30C30C3ull;
+			x = (x | (x << 2)) & 0x1249249249249249ull;
+			return x;
+		}
+	}
+
+	// Gathers every Nth bit of code (the inverse of SpreadBits).
+	template<class Code, size_t N>
+	constexpr std::uint32_t CompactBits(Code code) noexcept
+	{
+		if constexpr (N == 2 && sizeof(Code) == 4)
+		{
+			Code x = code & 0x55555555u;
+			x = (x | (x >> 1)) & 0x33333333u;
+			x = (x | (x >> 2)) & 0x0F0F0F0Fu;
+			x = (x | (x >> 4)) & 0x00FF00FFu;
+			x = (x | (x >> 8)) & 0x0000FFFFu;
+			return static_cast<std::uint32_t>(x);
+		}
+		else if constexpr (N == 2)
+		{
+			Code x = code & 0x5555555555555555ull;
+			x = (x | (x >> 1)) & 0x3333333333333333ull;
+			x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+			x = (x | (x >> 4)) & 0x00FF00FF00FF00FFull;
+			x = (x | (x >> 8)) & 0x0000FFFF0000FFFFull;
+			x = (x | (x >> 16)) & 0x00000000FFFFFFFFull;
+			return static_cast<std::uint32_t>(x);
+		}
+		else if constexpr (N == 3 && sizeof(Code) == 4)
+		{
+			Code x = code & 0x09249249u;
+			x = (x | (x >> 2)) & 0x030C30C3u;
+			x = (x | (x >> 4)) & 0x0300F00Fu;
+			x = (x | (x >> 8)) & 0x030000FFu;
+			x = (x | (x >> 16)) & 0x000003FFu;
+			return static_cast<std::uint32_t>(x);
+		}
+		else
+		{
+			Code x = code & 0x1249249249249249ull;
+			x = (x | (x >> 2)) & 0x10C30C30C30C30C3ull;
+			x = (x | (x >> 4)) & 0x100F00F00F00F00Full;
+			x = (x | (x >> 8)) & 0x001F0000FF0000FFull;
+			x = (x | (x >> 16)) & 0x001F00000000FFFFull;
+			x = (x | (x >> 32)) & 0x00000000001FFFFFull;
+			return static_cast<std::uint32_t>(x);
+		}
+	}
+
+	// Converts axes into the transposed Hilbert index (Skilling, "Programming the Hilbert curve", 2004).
+	// Written without data-dependent branches so that batch loops can be vectorized.
+	template<size_t N>
+	constexpr void AxesToTranspose(std::array<std::uint32_t, N>& x, size_t bits) noexcept
+	{
+		// Inverse undo
+		for (size_t b = bits - 1; b > 0; --b)
+		{
+			const std::uint32_t p = (std::uint32_t(1) << b) - 1;
+
+			for (size_t i = 0; i < N; ++i)
+			{
+				const std::uint32_t set = std::uint32_t(0) - ((x[i] >> b) & 1u);
+				const std::uint32_t t = (x[0] ^ x[i]) & p & ~set;
+
+				x[0] ^= (p & set) ^ t;
+				x[i] ^= t;
+			}
+		}
+
+		// Gray encode
+		for (size_t i = 1; i < N; ++i)
+			x[i] ^= x[i - 1];
+
+		std::uint32_t t = 0;
+		for (size_t b = bits - 1; b > 0; --b)
+			t ^= ((std::uint32_t(1) << b) - 1) & (std::uint32_t(0) - ((x[N - 1] >> b) & 1u));
+
+		for (size_t i = 0; i < N; ++i)
+			x[i] ^= t;
+	}
+
+	// Converts a transposed Hilbert index back into axes (the inverse of AxesToTranspose).
+	template<size_t N>
+	constexpr void TransposeToAxes(std::array<std::uint32_t, N>& x, size_t bits) noexcept
+	{
+		// Gray decode
+		const std::uint32_t t = x[N - 1] >> 1;
+
+		for (size_t i = N - 1; i > 0; --i)
+			x[i] ^= x[i - 1];
+
+		x[0] ^= t;
+
+		// Undo excess work
+		for (size_t b = 1; b < bits; ++b)
+		{
+			const std::uint32_t p = (std::uint32_t(1) << b) - 1;
+
+			for (size_t j = N; j > 0; --j)
+			{
+				const size_t i = j - 1;
+				const std::uint32_t set = std::uint32_t(0) - ((x[i] >> b) & 1u);
+				const std::uint32_t u = (x[0] ^ x[i]) & p & ~set;
+
+				x[0] ^= (p & set) ^ u;
+				x[i] ^= u;
+			}
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Morton (Z-order) codes
+namespace Epic
+{
+	// Interleaves the bits of the axes, x occupying the least significant bit of each group.
+	template<class Code = std::uint32_t>
+	constexpr Code MortonEncode(std::uint32_t x, std::uint32_t y) noexcept
+	{
+		return detail::SpreadBits<Code, 2>(x) | (detail::SpreadBits<Code, 2>(y) << 1);
+	}
+
+	template<class Code = std::uint32_t>
+	constexpr Code MortonEncode(std::uint32_t x, std::uint32_t y, std::uint32_t z) noexcept
+	{
+		return detail::SpreadBits<Code, 3>(x) |
+			  (detail::SpreadBits<Code, 3>(y) << 1) |
+			  (detail::SpreadBits<Code, 3>(z) << 2);
+	}
+
+	template<class Code>
+	constexpr std::array<std::uint32_t, 2> MortonDecode2(Code code) noexcept
+	{
+		return { detail::CompactBits<Code, 2>(code), detail::CompactBits<Code, 2>(code >> 1) };
+	}
+
+	template<class Code>
+	constexpr std::array<std::uint32_t, 3> MortonDecode3(Code code) noexcept
+	{
+		return
+		{
+			detail::CompactBits<Code, 3>(code),
+			detail::CompactBits<Code, 3>(code >> 1),
+			detail::CompactBits<Code, 3>(code >> 2)
+		};
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Hilbert codes
+namespace Epic
+{
+	template<class Code = std::uint32_t>
+	constexpr Code HilbertEncode(std::uint32_t x, std::uint32_t y) noexcept
+	{
+		std::array<std::uint32_t, 2> axes{ x, y };
+		detail::AxesToTranspose(axes, CurveBits<Code, 2>);
+
+		// The transpose stores the most significant bit of each group in the first axis
+		return detail::SpreadBits<Code, 2>(axes[1]) | (detail::SpreadBits<Code, 2>(axes[0]) << 1);
+	}
+
+	template<class Code = std::uint32_t>
+	constexpr Code HilbertEncode(std::uint32_t x, std::uint32_t y, std::uint32_t z) noexcept
+	{
+		std::array<std::uint32_t, 3> axes{ x, y, z };
+		detail::AxesToTranspose(axes, CurveBits<Code, 3>);
+
+		return detail::SpreadBits<Code, 3>(axes[2]) |
+			  (detail::SpreadBits<Code, 3>(axes[1]) << 1) |
+			  (detail::SpreadBits<Code, 3>(axes[0]) << 2);
+	}
+
+	template<class Code>
+	constexpr std::array<std::uint32_t, 2> HilbertDecode2(Code code) noexcept
+	{
+		std::array<std::uint32_t, 2> axes
+		{
+			detail::CompactBits<Code, 2>(code >> 1),
+			detail::CompactBits<Code, 2>(code)
+		};
+
+		detail::TransposeToAxes(axes, CurveBits<Code, 2>);
+
+		return axes;
+	}
+
+	template<class Code>
+	constexpr std::array<std::uint32_t, 3> HilbertDecode3(Code code) noexcept
+	{
+		std::array<std::uint32_t, 3> axes
+		{
+			detail::CompactBits<Code, 3>(code >> 2),
+			detail::CompactBits<Code, 3>(code >> 1),
+			detail::CompactBits<Code, 3>(code)
+		};
+
+		detail::TransposeToAxes(axes, CurveBits<Code, 3>);
+
+		return axes;
+	}
+}
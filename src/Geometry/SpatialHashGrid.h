@@ -0,0 +1,38 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "detail/SpatialHashGrid_impl.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Externs
+namespace Epic
+{
+	extern template class SpatialHashGrid<float, 2>;
+	extern template class SpatialHashGrid<float, 3>;
+
+	extern template class SpatialHashGrid<double, 2>;
+	extern template class SpatialHashGrid<double, 3>;
+}
+
+// Aliases
+namespace Epic
+{
+	using SpatialHashGrid2f = SpatialHashGrid<float, 2>;
+	using SpatialHashGrid3f = SpatialHashGrid<float, 3>;
+
+	using SpatialHashGrid2d = SpatialHashGrid<double, 2>;
+	using SpatialHashGrid3d = SpatialHashGrid<double, 3>;
+}
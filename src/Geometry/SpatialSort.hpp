@@ -0,0 +1,398 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "SpaceFillingCurves.hpp"
+#include "../Math/Vector.h"
+#include "../Parallel/BatchBlock.hpp"
+#include "../Parallel/ParallelFor.hpp"
+#include "../Parallel/ParallelRadixSort.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// CurveQuantizer
+namespace Epic
+{
+	// CurveQuantizer - Maps positions within a bounding box onto the integer lattice of a curve code.
+	template<class T, size_t N, class Code = std::uint32_t>
+	class CurveQuantizer
+	{
+	public:
+		using vector_type = Epic::Vector<T, N>;
+		using cell_type = std::array<std::uint32_t, N>;
+
+		static constexpr size_t Bits = CurveBits<Code, N>;
+		static constexpr std::uint32_t MaxCell = std::uint32_t((std::uint64_t(1) << Bits) - 1);
+
+	private:
+		vector_type m_Min;
+		vector_type m_Scale;
+		vector_type m_InvScale;
+
+	public:
+		CurveQuantizer(const vector_type& boundsMin, const vector_type& boundsMax) noexcept
+			: m_Min{ boundsMin }
+		{
+			for (size_t n = 0; n < N; ++n)
+			{
+				const T extent = boundsMax[n] - boundsMin[n];
+
+				m_Scale[n] = (extent > T(0)) ? T(MaxCell) / extent : T(0);
+				m_InvScale[n] = (extent > T(0)) ? extent / T(MaxCell) : T(0);
+			}
+		}
+
+	public:
+		const vector_type& Min() const noexcept { return m_Min; }
+
+		std::uint32_t Quantize(T value, size_t axis) const noexcept
+		{
+			const T q = (value - m_Min[axis]) * m_Scale[axis];
+
+			// T(MaxCell) may round up past the uint32 range (e.g. float with 32-bit cells),
+			// so the upper clamp yields the integer MaxCell rather than casting T(MaxCell)
+			if (!(q > T(0)))
+				return 0;
+			if (q >= T(MaxCell))
+				return MaxCell;
+
+			return static_cast<std::uint32_t>(q);
+		}
+
+		cell_type Quantize(const vector_type& position) const noexcept
+		{
+			cell_type result;
+
+			for (size_t n = 0; n < N; ++n)
+				result[n] = Quantize(position[n], n);
+
+			return result;
+		}
+
+		T Dequantize(std::uint32_t cell, size_t axis) const noexcept
+		{
+			return m_Min[axis] + (T(cell) + T(0.5)) * m_InvScale[axis];
+		}
+
+		vector_type Dequantize(const cell_type& cell) const noexcept
+		{
+			vector_type result;
+
+			for (size_t n = 0; n < N; ++n)
+				result[n] = Dequantize(cell[n], n);
+
+			return result;
+		}
+	};
+
+	// Computes the bounding box of a set of positions
+	template<class T, size_t N>
+	std::pair<Vector<T, N>, Vector<T, N>> BoundsOf(const Vector<T, N>* pPositions, size_t count) noexcept
+	{
+		Vector<T, N> lo{ Zero };
+		Vector<T, N> hi{ Zero };
+
+		if (count == 0)
+			return { lo, hi };
+
+		lo = hi = pPositions[0];
+
+		for (size_t i = 1; i < count; ++i)
+		{
+			for (size_t n = 0; n < N; ++n)
+			{
+				lo[n] = std::min(lo[n], pPositions[i][n]);
+				hi[n] = std::max(hi[n], pPositions[i][n]);
+			}
+		}
+
+		return { lo, hi };
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Batch Encoders/Decoders
+namespace Epic
+{
+	namespace detail
+	{
+		constexpr size_t CurveBatchGrainSize = 16384;
+
+		template<bool Hilbert, class Code, size_t N>
+		constexpr Code EncodeCell(const std::array<std::uint32_t, N>& cell) noexcept
+		{
+			if constexpr (N == 2)
+				return Hilbert ? HilbertEncode<Code>(cell[0], cell[1]) : MortonEncode<Code>(cell[0], cell[1]);
+			else
+				return Hilbert ? HilbertEncode<Code>(cell[0], cell[1], cell[2]) : MortonEncode<Code>(cell[0], cell[1], cell[2]);
+		}
+
+		template<bool Hilbert, class Code, size_t N>
+		constexpr std::array<std::uint32_t, N> DecodeCell(Code code) noexcept
+		{
+			if constexpr (N == 2)
+				return Hilbert ? HilbertDecode2<Code>(code) : MortonDecode2<Code>(code);
+			else
+				return Hilbert ? HilbertDecode3<Code>(code) : MortonDecode3<Code>(code);
+		}
+
+		// The quantize and encode stages are split into separate loops over small blocks so that each stage
+		// is a straight-line loop over SoA lanes the compiler can vectorize.
+		template<bool Hilbert, class T, size_t N, class Code>
+		void EncodeBatch(const CurveQuantizer<T, N, Code>& quantizer, const T* const* pAxes, size_t count, Code* pCodes)
+		{
+			constexpr size_t BlockSize = BatchBlockSize;
+
+			ParallelFor(0, count, CurveBatchGrainSize, [&](size_t begin, size_t end)
+			{
+				std::uint32_t cells[N][BlockSize];
+
+				for (size_t block = begin; block < end; block += BlockSize)
+				{
+					const size_t blockCount = std::min(BlockSize, end - block);
+
+					for (size_t n = 0; n < N; ++n)
+					{
+						const T* pAxis = pAxes[n] + block;
+
+						for (size_t i = 0; i < blockCount; ++i)
+							cells[n][i] = quantizer.Quantize(pAxis[i], n);
+					}
+
+					for (size_t i = 0; i < blockCount; ++i)
+					{
+						std::array<std::uint32_t, N> cell;
+
+						for (size_t n = 0; n < N; ++n)
+							cell[n] = cells[n][i];
+
+						pCodes[block + i] = EncodeCell<Hilbert, Code, N>(cell);
+					}
+				}
+			});
+		}
+
+		template<bool Hilbert, class T, size_t N, class Code>
+		void EncodeBatch(const CurveQuantizer<T, N, Code>& quantizer, const Vector<T, N>* pPositions, size_t count, Code* pCodes)
+		{
+			ParallelFor(0, count, CurveBatchGrainSize, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+					pCodes[i] = EncodeCell<Hilbert, Code, N>(quantizer.Quantize(pPositions[i]));
+			});
+		}
+
+		template<bool Hilbert, class T, size_t N, class Code>
+		void DecodeBatch(const CurveQuantizer<T, N, Code>& quantizer, const Code* pCodes, size_t count, Vector<T, N>* pPositions)
+		{
+			ParallelFor(0, count, CurveBatchGrainSize, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+					pPositions[i] = quantizer.Dequantize(DecodeCell<Hilbert, Code, N>(pCodes[i]));
+			});
+		}
+	}
+
+	// MortonEncode - Encodes AoS positions into Morton codes.
+	template<class T, size_t N, class Code>
+	void MortonEncode(const CurveQuantizer<T, N, Code>& quantizer, const Vector<T, N>* pPositions, size_t count, Code* pCodes)
+	{
+		detail::EncodeBatch<false>(quantizer, pPositions, count, pCodes);
+	}
+
+	// MortonEncode - Encodes SoA positions (one array per axis) into Morton codes.
+	template<class T, size_t N, class Code>
+	void MortonEncode(const CurveQuantizer<T, N, Code>& quantizer, const std::array<const T*, N>& axes, size_t count, Code* pCodes)
+	{
+		detail::EncodeBatch<false>(quantizer, axes.data(), count, pCodes);
+	}
+
+	// MortonDecode - Decodes Morton codes into the centers of their lattice cells.
+	template<class T, size_t N, class Code>
+	void MortonDecode(const CurveQuantizer<T, N, Code>& quantizer, const Code* pCodes, size_t count, Vector<T, N>* pPositions)
+	{
+		detail::DecodeBatch<false>(quantizer, pCodes, count, pPositions);
+	}
+
+	// HilbertEncode - Encodes AoS positions into Hilbert codes.
+	template<class T, size_t N, class Code>
+	void HilbertEncode(const CurveQuantizer<T, N, Code>& quantizer, const Vector<T, N>* pPositions, size_t count, Code* pCodes)
+	{
+		detail::EncodeBatch<true>(quantizer, pPositions, count, pCodes);
+	}
+
+	// HilbertEncode - Encodes SoA positions (one array per axis) into Hilbert codes.
+	template<class T, size_t N, class Code>
+	void HilbertEncode(const CurveQuantizer<T, N, Code>& quantizer, const std::array<const T*, N>& axes, size_t count, Code* pCodes)
+	{
+		detail::EncodeBatch<true>(quantizer, axes.data(), count, pCodes);
+	}
+
+	// HilbertDecode - Decodes Hilbert codes into the centers of their lattice cells.
+	template<class T, size_t N, class Code>
+	void HilbertDecode(const CurveQuantizer<T, N, Code>& quantizer, const Code* pCodes, size_t count, Vector<T, N>* pPositions)
+	{
+		detail::DecodeBatch<true>(quantizer, pCodes, count, pPositions);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// SpatialSort
+namespace Epic
+{
+	// SpatialSort - Sorts curve codes in place and writes the permutation (sorted position -> source index).
+	// Reorder any number of SoA arrays with ParallelGather(pPermutation, ...).
+	template<class Code, class Index>
+	void SpatialSort(Code* pCodes, Index* pPermutation, size_t count)
+	{
+		ParallelRadixSortIndices(pCodes, pPermutation, count);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// RadixTree
+namespace Epic
+{
+	// RadixTreeNode - An internal node of a binary radix tree over sorted curve codes.
+	// Children with LeafFlag set index the sorted leaves; others index internal nodes.
+	struct RadixTreeNode
+	{
+		static constexpr std::uint32_t LeafFlag = 0x80000000u;
+		static constexpr std::uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+		std::uint32_t Left;
+		std::uint32_t Right;
+		std::uint32_t Parent;
+		std::uint32_t First;
+		std::uint32_t Last;
+	};
+
+	// BuildRadixTree - Builds the topology of a linear BVH from sorted codes (Karras, "Maximizing Parallelism
+	// in the Construction of BVHs, Octrees, and k-d Trees", 2012). Every internal node is built independently,
+	// so the build runs in parallel. Node 0 is the root; leafParents receives the parent of each leaf.
+	// Bounds are left to the caller, who can refit bottom-up by walking the parent links.
+	template<class Code>
+	void BuildRadixTree(const Code* pSortedCodes, size_t count,
+		std::vector<RadixTreeNode>& nodes, std::vector<std::uint32_t>& leafParents)
+	{
+		assert(count < RadixTreeNode::LeafFlag);
+
+		nodes.resize((count > 1) ? count - 1 : 0);
+		leafParents.assign(count, RadixTreeNode::InvalidIndex);
+
+		if (count < 2)
+			return;
+
+		const auto n = static_cast<std::int64_t>(count);
+
+		// Length of the common prefix of the codes at i and j; duplicate codes are distinguished by index
+		const auto delta = [&](std::int64_t i, std::int64_t j) -> int
+		{
+			if (j < 0 || j >= n)
+				return -1;
+
+			const Code a = pSortedCodes[i];
+			const Code b = pSortedCodes[j];
+
+			if (a != b)
+				return detail::CountLeadingZeroes(a ^ b);
+
+			return int(sizeof(Code) * 8) + detail::CountLeadingZeroes(std::uint64_t(i ^ j));
+		};
+
+		nodes[0].Parent = RadixTreeNode::InvalidIndex;
+
+		ParallelFor(0, count - 1, 4096, [&](size_t begin, size_t end)
+		{
+			for (size_t node = begin; node < end; ++node)
+			{
+				const auto i = static_cast<std::int64_t>(node);
+
+				// Direction of the node's range
+				const std::int64_t d = (delta(i, i + 1) - delta(i, i - 1)) >= 0 ? 1 : -1;
+
+				// Upper bound on the range length
+				const int deltaMin = delta(i, i - d);
+				std::int64_t lengthMax = 2;
+
+				while (delta(i, i + lengthMax * d) > deltaMin)
+					lengthMax *= 2;
+
+				// Exact range length
+				std::int64_t length = 0;
+
+				for (std::int64_t t = lengthMax / 2; t >= 1; t /= 2)
+				{
+					if (delta(i, i + (length + t) * d) > deltaMin)
+						length += t;
+				}
+
+				const std::int64_t j = i + length * d;
+
+				// Split position
+				const int deltaNode = delta(i, j);
+				std::int64_t split = 0;
+
+				for (std::int64_t divisor = 2, t = (length + 1) / 2; ; divisor *= 2, t = (length + divisor - 1) / divisor)
+				{
+					if (delta(i, i + (split + t) * d) > deltaNode)
+						split += t;
+
+					if (t <= 1)
+						break;
+				}
+
+				const std::int64_t gamma = i + split * d + std::min(d, std::int64_t(0));
+				const std::int64_t first = std::min(i, j);
+				const std::int64_t last = std::max(i, j);
+
+				RadixTreeNode& result = nodes[node];
+				result.First = static_cast<std::uint32_t>(first);
+				result.Last = static_cast<std::uint32_t>(last);
+
+				if (first == gamma)
+				{
+					result.Left = static_cast<std::uint32_t>(gamma) | RadixTreeNode::LeafFlag;
+					leafParents[gamma] = static_cast<std::uint32_t>(node);
+				}
+				else
+				{
+					result.Left = static_cast<std::uint32_t>(gamma);
+					nodes[gamma].Parent = static_cast<std::uint32_t>(node);
+				}
+
+				if (last == gamma + 1)
+				{
+					result.Right = static_cast<std::uint32_t>(gamma + 1) | RadixTreeNode::LeafFlag;
+					leafParents[gamma + 1] = static_cast<std::uint32_t>(node);
+				}
+				else
+				{
+					result.Right = static_cast<std::uint32_t>(gamma + 1);
+					nodes[gamma + 1].Parent = static_cast<std::uint32_t>(node);
+				}
+			}
+		});
+	}
+}
@@ -0,0 +1,520 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+
+#include "AABB.h"
+#include "ClosestPoints.hpp"
+#include "../Math/Vector.h"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Sweep types
+namespace Epic
+{
+	// SweepResult - The first contact of a shape moving along a motion vector.
+	//	Time is the fraction of the motion travelled before contact, and Normal points from the target toward
+	//	the moving shape. Shapes that already overlap hit at time zero. Batch sweeps also set Index to the
+	//	element that was hit.
+	template<class T>
+	struct SweepResult
+	{
+		bool Hit = false;
+		T Time = T(0);
+		Vector<T, 3> Normal{ Zero };
+		Vector<T, 3> Point{ Zero };
+		size_t Index = 0;
+	};
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// detail
+namespace Epic::detail
+{
+	// LowestRoot - The smallest root of a*t^2 + b*t + c in [0, maxRoot]
+	template<class T>
+	inline bool LowestRoot(T a, T b, T c, T maxRoot, T& root) noexcept
+	{
+		if (std::abs(a) <= std::numeric_limits<T>::epsilon())
+		{
+			if (std::abs(b) <= std::numeric_limits<T>::epsilon())
+				return false;
+
+			const T t = -c / b;
+
+			if (t < T(0) || t > maxRoot)
+				return false;
+
+			root = t;
+			return true;
+		}
+
+		const T discriminant = b * b - T(4) * a * c;
+
+		if (discriminant < T(0))
+			return false;
+
+		const T sqrtD = std::sqrt(discriminant);
+		T r1 = (-b - sqrtD) / (T(2) * a);
+		T r2 = (-b + sqrtD) / (T(2) * a);
+
+		if (r1 > r2)
+			std::swap(r1, r2);
+
+		if (r1 >= T(0) && r1 <= maxRoot)
+		{
+			root = r1;
+			return true;
+		}
+
+		if (r2 >= T(0) && r2 <= maxRoot)
+		{
+			root = r2;
+			return true;
+		}
+
+		return false;
+	}
+
+	// SweepSphereSegment - The first time in [0, maxTime] a moving sphere touches segment p1p2, found as a ray
+	//	against the capsule around the segment (Fauerby, 2003). Assumes the sphere does not start touching it.
+	template<class T>
+	inline bool SweepSphereSegment(const Vector<T, 3>& center, T radius, const Vector<T, 3>& motion,
+		const Vector<T, 3>& p1, const Vector<T, 3>& p2, T maxTime, T& time, Vector<T, 3>& contact) noexcept
+	{
+		const T radiusSq = radius * radius;
+		const T motionSq = motion.MagnitudeSq();
+		bool hit = false;
+
+		// The cylinder around the segment
+		const Vector<T, 3> edge = p2 - p1;
+		const Vector<T, 3> toStart = p1 - center;
+		const T edgeSq = edge.MagnitudeSq();
+		const T edgeDotMotion = edge.Dot(motion);
+		const T edgeDotStart = edge.Dot(toStart);
+
+		T t;
+
+		if (edgeSq > T(0))
+		{
+			const T a = edgeSq * -motionSq + edgeDotMotion * edgeDotMotion;
+			const T b = edgeSq * (T(2) * motion.Dot(toStart)) - T(2) * edgeDotMotion * edgeDotStart;
+			const T c = edgeSq * (radiusSq - toStart.MagnitudeSq()) + edgeDotStart * edgeDotStart;
+
+			if (LowestRoot(a, b, c, maxTime, t))
+			{
+				const T f = (edgeDotMotion * t - edgeDotStart) / edgeSq;
+
+				if (f >= T(0) && f <= T(1))
+				{
+					maxTime = time = t;
+					contact = p1 + edge * f;
+					hit = true;
+				}
+			}
+		}
+
+		// The spheres around its end points
+		for (const Vector<T, 3>* p : { &p1, &p2 })
+		{
+			const T b = T(2) * motion.Dot(center - *p);
+			const T c = (*p - center).MagnitudeSq() - radiusSq;
+
+			if (LowestRoot(motionSq, b, c, maxTime, t))
+			{
+				maxTime = time = t;
+				contact = *p;
+				hit = true;
+			}
+		}
+
+		return hit;
+	}
+
+	template<class T>
+	inline bool PointInTriangle(const Vector<T, 3>& p, const Vector<T, 3>& a, const Vector<T, 3>& b, const Vector<T, 3>& c,
+		const Vector<T, 3>& normal) noexcept
+	{
+		return normal.Dot((b - a).Cross(p - a)) >= T(0)
+			&& normal.Dot((c - b).Cross(p - b)) >= T(0)
+			&& normal.Dot((a - c).Cross(p - c)) >= T(0);
+	}
+
+	// Fills a time zero contact from the closest points of overlapping shapes
+	template<class T>
+	inline void OverlapResult(SweepResult<T>& result, const Vector<T, 3>& onMoving, const Vector<T, 3>& onTarget,
+		const Vector<T, 3>& fallbackNormal) noexcept
+	{
+		const Vector<T, 3> d = onMoving - onTarget;
+		const T distance = d.Magnitude();
+
+		result.Hit = true;
+		result.Time = T(0);
+		result.Normal = distance > std::numeric_limits<T>::epsilon() ? d / distance : fallbackNormal;
+		result.Point = onTarget;
+	}
+
+	template<class T>
+	inline const Vector<T, 3>* TriangleOf(const Vector<T, 3>* pTriangles, const std::uint32_t* pCandidates, size_t i) noexcept
+	{
+		return pTriangles + size_t(pCandidates ? pCandidates[i] : i) * 3;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Sphere sweeps
+namespace Epic
+{
+	// SweepSphereTriangle - Sweeps a sphere along motion against triangle abc.
+	//	The face is tested first; if the sphere meets its plane outside the triangle, the edges and vertices
+	//	are tested instead. Only contacts before maxTime are reported.
+	template<class T>
+	SweepResult<T> SweepSphereTriangle(const Vector<T, 3>& center, T radius, const Vector<T, 3>& motion,
+		const Vector<T, 3>& a, const Vector<T, 3>& b, const Vector<T, 3>& c, T maxTime = T(1)) noexcept
+	{
+		SweepResult<T> result;
+
+		Vector<T, 3> normal = (b - a).Cross(c - a);
+		const T length = normal.Magnitude();
+
+		if (length > T(0))
+			normal /= length;
+
+		const T startDistance = normal.Dot(center - a);
+		const T side = startDistance >= T(0) ? T(1) : T(-1);
+
+		// Already touching
+		const Vector<T, 3> closest = ClosestPointOnTriangle(center, a, b, c);
+
+		if ((closest - center).MagnitudeSq() <= radius * radius)
+		{
+			detail::OverlapResult(result, center, closest, normal * side);
+			return result;
+		}
+
+		// Against the face
+		const T approach = normal.Dot(motion) * side;
+
+		if (length > T(0) && std::abs(startDistance) > radius && approach < T(0))
+		{
+			const T t = (std::abs(startDistance) - radius) / -approach;
+
+			if (t > maxTime)
+				return result;
+
+			const Vector<T, 3> point = center + motion * t - normal * (radius * side);
+
+			if (detail::PointInTriangle(point, a, b, c, normal))
+			{
+				result.Hit = true;
+				result.Time = t;
+				result.Normal = normal * side;
+				result.Point = point;
+
+				return result;
+			}
+		}
+
+		// Against the edges and vertices
+		const Vector<T, 3> vertices[3] = { a, b, c };
+
+		T time = maxTime;
+		Vector<T, 3> contact;
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			if (detail::SweepSphereSegment(center, radius, motion, vertices[i], vertices[(i + 1) % 3], time, time, contact))
+			{
+				result.Hit = true;
+				result.Time = time;
+				result.Point = contact;
+			}
+		}
+
+		if (result.Hit)
+			result.Normal = ((center + motion * result.Time) - result.Point) / radius;
+
+		return result;
+	}
+
+	// SweepSphereTriangles - The first triangle hit by a sphere swept along motion.
+	//	pTriangles holds 3 vertices per triangle. pCandidates lists the count triangles to test, as produced by a
+	//	broadphase; if it is null the first count triangles are tested. Each hit shortens the sweep for the rest.
+	template<class T>
+	SweepResult<T> SweepSphereTriangles(const Vector<T, 3>& center, T radius, const Vector<T, 3>& motion,
+		const Vector<T, 3>* pTriangles, const std::uint32_t* pCandidates, size_t count, T maxTime = T(1)) noexcept
+	{
+		SweepResult<T> result;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Vector<T, 3>* pTriangle = detail::TriangleOf(pTriangles, pCandidates, i);
+			auto hit = SweepSphereTriangle(center, radius, motion, pTriangle[0], pTriangle[1], pTriangle[2], maxTime);
+
+			if (hit.Hit && (!result.Hit || hit.Time < result.Time))
+			{
+				hit.Index = pCandidates ? pCandidates[i] : i;
+				result = hit;
+				maxTime = hit.Time;
+			}
+		}
+
+		return result;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Box sweeps
+namespace Epic
+{
+	// SweepAABB - Sweeps box along motion against target.
+	//	The target is grown by the extents of box and the slabs are clipped against the path of its center.
+	//	Overlapping boxes hit at time zero with the normal of the axis of least penetration.
+	template<class T>
+	SweepResult<T> SweepAABB(const AABB<T>& box, const Vector<T, 3>& motion, const AABB<T>& target, T maxTime = T(1)) noexcept
+	{
+		SweepResult<T> result;
+
+		const Vector<T, 3> center = box.Center();
+		const Vector<T, 3> extents = box.Extents();
+
+		T enter = T(0);
+		T exit = maxTime;
+		size_t enterAxis = 3;
+
+		T leastPenetration = std::numeric_limits<T>::max();
+		size_t leastAxis = 0;
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			const T lo = target.Min[k] - extents[k];
+			const T hi = target.Max[k] + extents[k];
+
+			if (std::abs(motion[k]) <= std::numeric_limits<T>::epsilon())
+			{
+				if (center[k] < lo || center[k] > hi)
+					return result;
+			}
+			else
+			{
+				const T inv = T(1) / motion[k];
+				T t0 = (lo - center[k]) * inv;
+				T t1 = (hi - center[k]) * inv;
+
+				if (t0 > t1)
+					std::swap(t0, t1);
+
+				if (t0 > enter)
+				{
+					enter = t0;
+					enterAxis = k;
+				}
+
+				exit = std::min(exit, t1);
+
+				if (enter > exit)
+					return result;
+			}
+
+			const T penetration = std::min(center[k] - lo, hi - center[k]);
+			if (penetration < leastPenetration)
+			{
+				leastPenetration = penetration;
+				leastAxis = k;
+			}
+		}
+
+		result.Hit = true;
+		result.Time = enter;
+
+		if (enterAxis < 3)
+		{
+			result.Normal[enterAxis] = motion[enterAxis] > T(0) ? T(-1) : T(1);
+		}
+		else
+		{
+			const T lo = target.Min[leastAxis] - extents[leastAxis];
+			const T hi = target.Max[leastAxis] + extents[leastAxis];
+
+			result.Normal[leastAxis] = (center[leastAxis] - lo) < (hi - center[leastAxis]) ? T(-1) : T(1);
+		}
+
+		// The middle of the touching faces
+		const Vector<T, 3> moved = center + motion * result.Time;
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			result.Point[k] = result.Normal[k] != T(0)
+				? (result.Normal[k] > T(0) ? target.Max[k] : target.Min[k])
+				: (std::max(moved[k] - extents[k], target.Min[k]) + std::min(moved[k] + extents[k], target.Max[k])) * T(0.5);
+		}
+
+		return result;
+	}
+
+	// SweepAABBs - The first of a candidate list of boxes hit by box swept along motion (see SweepSphereTriangles).
+	template<class T>
+	SweepResult<T> SweepAABBs(const AABB<T>& box, const Vector<T, 3>& motion, const AABB<T>* pTargets,
+		const std::uint32_t* pCandidates, size_t count, T maxTime = T(1)) noexcept
+	{
+		SweepResult<T> result;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const size_t index = pCandidates ? pCandidates[i] : i;
+			auto hit = SweepAABB(box, motion, pTargets[index], maxTime);
+
+			if (hit.Hit && (!result.Hit || hit.Time < result.Time))
+			{
+				hit.Index = index;
+				result = hit;
+				maxTime = hit.Time;
+			}
+		}
+
+		return result;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Capsule casts
+namespace Epic
+{
+	// CapsuleCastSphere - Sweeps the capsule around segment pointA pointB against a sphere.
+	//	Solved in the frame of the capsule, as the sphere's center cast backwards against a capsule of both radii.
+	template<class T>
+	SweepResult<T> CapsuleCastSphere(const Vector<T, 3>& pointA, const Vector<T, 3>& pointB, T radius, const Vector<T, 3>& motion,
+		const Vector<T, 3>& center, T sphereRadius, T maxTime = T(1)) noexcept
+	{
+		SweepResult<T> result;
+
+		const T combined = radius + sphereRadius;
+		const Vector<T, 3> onSegment = ClosestPointOnSegment(center, pointA, pointB);
+		const Vector<T, 3> offset = onSegment - center;
+
+		if (offset.MagnitudeSq() <= combined * combined)
+		{
+			detail::OverlapResult(result, onSegment, center, Vector<T, 3>{ T(0), T(1), T(0) });
+			result.Point = center + result.Normal * sphereRadius;
+			return result;
+		}
+
+		T time;
+		Vector<T, 3> contact;
+
+		if (!detail::SweepSphereSegment(center, combined, -motion, pointA, pointB, maxTime, time, contact))
+			return result;
+
+		// contact is the point of the segment at the time of impact, before moving it
+		const Vector<T, 3> onMoving = contact + motion * time;
+
+		result.Hit = true;
+		result.Time = time;
+		result.Normal = (onMoving - center) / combined;
+		result.Point = center + result.Normal * sphereRadius;
+
+		return result;
+	}
+
+	// CapsuleCastTriangle - Sweeps the capsule around segment pointA pointB against triangle abc.
+	//	The distance between a translating segment and a triangle is convex in time, so Newton steps from t = 0
+	//	approach the first contact from below without overshooting it. Contact is reported once the gap falls
+	//	within a small fraction of the radius, or at the last step if the iterations run out while the gap is
+	//	still closing (grazing sweeps converge slowly, and would otherwise tunnel).
+	template<class T>
+	SweepResult<T> CapsuleCastTriangle(const Vector<T, 3>& pointA, const Vector<T, 3>& pointB, T radius, const Vector<T, 3>& motion,
+		const Vector<T, 3>& a, const Vector<T, 3>& b, const Vector<T, 3>& c, T maxTime = T(1), size_t maxIterations = 32) noexcept
+	{
+		SweepResult<T> result;
+
+		const T tolerance = std::max(radius, motion.Magnitude()) * T(1e-4);
+
+		Vector<T, 3> normal = (b - a).Cross(c - a);
+		const T length = normal.Magnitude();
+
+		if (length > T(0))
+			normal /= length;
+
+		if (normal.Dot((pointA + pointB) * T(0.5) - a) < T(0))
+			normal = -normal;
+
+		T t = T(0);
+
+		for (size_t iteration = 0; iteration < maxIterations; ++iteration)
+		{
+			const Vector<T, 3> shift = motion * t;
+			const auto closest = ClosestPointsSegmentTriangle(pointA + shift, pointB + shift, a, b, c);
+			const T distance = std::sqrt(closest.DistanceSq);
+
+			if (distance - radius <= tolerance)
+			{
+				detail::OverlapResult(result, closest.PointA, closest.PointB, normal);
+				result.Time = t;
+
+				return result;
+			}
+
+			// The rate the gap closes at; a gap that is not closing never will, by convexity
+			const T closing = -(closest.PointA - closest.PointB).Dot(motion) / distance;
+
+			if (closing <= std::numeric_limits<T>::epsilon())
+				return result;
+
+			t += (distance - radius) / closing;
+
+			if (t > maxTime)
+				return result;
+		}
+
+		const Vector<T, 3> shift = motion * t;
+		const auto closest = ClosestPointsSegmentTriangle(pointA + shift, pointB + shift, a, b, c);
+
+		detail::OverlapResult(result, closest.PointA, closest.PointB, normal);
+		result.Time = t;
+
+		return result;
+	}
+
+	// CapsuleCastTriangles - The first of a candidate list of triangles hit by a capsule (see SweepSphereTriangles).
+	template<class T>
+	SweepResult<T> CapsuleCastTriangles(const Vector<T, 3>& pointA, const Vector<T, 3>& pointB, T radius, const Vector<T, 3>& motion,
+		const Vector<T, 3>* pTriangles, const std::uint32_t* pCandidates, size_t count, T maxTime = T(1)) noexcept
+	{
+		SweepResult<T> result;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Vector<T, 3>* pTriangle = detail::TriangleOf(pTriangles, pCandidates, i);
+			auto hit = CapsuleCastTriangle(pointA, pointB, radius, motion, pTriangle[0], pTriangle[1], pTriangle[2], maxTime);
+
+			if (hit.Hit && (!result.Hit || hit.Time < result.Time))
+			{
+				hit.Index = pCandidates ? pCandidates[i] : i;
+				result = hit;
+				maxTime = hit.Time;
+			}
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,142 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "AABB_decl.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <type_traits>
+
+#include "../../Math/Vector.h"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// AABB
+//	An axis aligned bounding box. A default constructed box is empty: its Min is greater than its Max,
+//	so that expanding it by the first point gives that point.
+template<class T>
+class Epic::AABB
+{
+	static_assert(std::is_floating_point_v<T>, "AABB requires floating point bounds.");
+
+public:
+	using type = Epic::AABB<T>;
+	using value_type = T;
+	using vector_type = Epic::Vector<T, 3>;
+
+public:
+	vector_type Min;
+	vector_type Max;
+
+public:
+	AABB() noexcept
+		: Min{ std::numeric_limits<T>::max(), std::numeric_limits<T>::max(), std::numeric_limits<T>::max() },
+		  Max{ std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest() }
+	{ }
+
+	AABB(const vector_type& min, const vector_type& max) noexcept
+		: Min{ min }, Max{ max }
+	{ }
+
+	AABB(const AABB&) noexcept = default;
+	~AABB() noexcept = default;
+
+	AABB& operator = (const AABB&) noexcept = default;
+
+public:
+	bool IsEmpty() const noexcept
+	{
+		return Min[0] > Max[0] || Min[1] > Max[1] || Min[2] > Max[2];
+	}
+
+	vector_type Center() const noexcept { return (Min + Max) * T(0.5); }
+	vector_type Size() const noexcept { return Max - Min; }
+
+	// Half the size of the box along each axis
+	vector_type Extents() const noexcept { return (Max - Min) * T(0.5); }
+
+	bool Contains(const vector_type& point) const noexcept
+	{
+		for (size_t k = 0; k < 3; ++k)
+		{
+			if (point[k] < Min[k] || point[k] > Max[k])
+				return false;
+		}
+
+		return true;
+	}
+
+	bool Intersects(const AABB& box) const noexcept
+	{
+		for (size_t k = 0; k < 3; ++k)
+		{
+			if (box.Max[k] < Min[k] || box.Min[k] > Max[k])
+				return false;
+		}
+
+		return true;
+	}
+
+	vector_type ClosestPoint(const vector_type& point) const noexcept
+	{
+		vector_type result;
+
+		for (size_t k = 0; k < 3; ++k)
+			result[k] = std::clamp(point[k], Min[k], Max[k]);
+
+		return result;
+	}
+
+public:
+	AABB& Reset() noexcept
+	{
+		return *this = AABB{};
+	}
+
+	AABB& Expand(const vector_type& point) noexcept
+	{
+		for (size_t k = 0; k < 3; ++k)
+		{
+			Min[k] = std::min(Min[k], point[k]);
+			Max[k] = std::max(Max[k], point[k]);
+		}
+
+		return *this;
+	}
+
+	AABB& Expand(const AABB& box) noexcept
+	{
+		for (size_t k = 0; k < 3; ++k)
+		{
+			Min[k] = std::min(Min[k], box.Min[k]);
+			Max[k] = std::max(Max[k], box.Max[k]);
+		}
+
+		return *this;
+	}
+
+public:
+	// The smallest box containing count points
+	static AABB FitOf(const vector_type* pPoints, size_t count) noexcept
+	{
+		AABB result;
+
+		for (size_t i = 0; i < count; ++i)
+			result.Expand(pPoints[i]);
+
+		return result;
+	}
+};
@@ -0,0 +1,880 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ConvexHull_decl.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../../Math/Vector.h"
+#include "../../Parallel/ParallelFor.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// ConvexHull
+//	Builds the convex hull of a point cloud with quickhull (Barber et al., 1996).
+//	Triangles are kept in an arena while building: face slot f owns half-edges 3f..3f+2, and deleted slots are
+//	recycled along with their outside lists. Once no point remains outside, adjacent triangles within the merge
+//	tolerance of a common plane are merged into convex polygons and compacted into a half-edge mesh.
+template<class T>
+class Epic::ConvexHull
+{
+	static_assert(std::is_floating_point_v<T>, "ConvexHull requires floating point positions.");
+
+public:
+	using type = Epic::ConvexHull<T>;
+	using value_type = T;
+	using vector_type = Epic::Vector<T, 3>;
+	using index_type = std::uint32_t;
+
+	static constexpr index_type InvalidIndex = ~index_type(0);
+
+	// Settings - Tolerances and limits
+	//	A point must lie further than Tolerance above a face to be outside it; zero derives the tolerance from the
+	//	magnitude of the input. Faces are merged while their vertices lie within MergeTolerance (or Tolerance,
+	//	if greater) of a common plane. A nonzero MaxVertices stops the build after that many vertices, after
+	//	which the hull no longer contains every point. ParallelPartition splits the initial scans across threads.
+	struct Settings
+	{
+		T Tolerance = T(0);
+		T MergeTolerance = T(0);
+		size_t MaxVertices = 0;
+		bool ParallelPartition = true;
+	};
+
+	// A convex polygon whose edges are FirstEdge..FirstEdge + EdgeCount, counter-clockwise about Normal
+	struct Face
+	{
+		vector_type Normal;
+		T Offset;
+		index_type FirstEdge;
+		index_type EdgeCount;
+	};
+
+	struct HalfEdge
+	{
+		index_type Origin;
+		index_type Twin;
+		index_type Next;
+		index_type Face;
+	};
+
+private:
+	static constexpr size_t MinGrainSize = 16384;
+
+	enum class FaceState : std::uint8_t
+	{
+		Free,
+		Alive,
+		Visible
+	};
+
+	struct BuildFace
+	{
+		vector_type Normal;
+		T Offset;
+		T Area;
+		T FurthestDistance;
+		index_type Furthest;
+		index_type Serial;
+		FaceState State;
+		std::vector<index_type> Outside;
+	};
+
+	struct HorizonFrame
+	{
+		index_type Face;
+		index_type First;
+		index_type Visited;
+	};
+
+	struct HorizonEdge
+	{
+		index_type Origin;
+		index_type End;
+		index_type Twin;
+	};
+
+	struct Candidate
+	{
+		T Distance;
+		index_type Face;
+		index_type Serial;
+
+		bool operator < (const Candidate& other) const noexcept { return Distance < other.Distance; }
+	};
+
+private:
+	Settings m_Settings;
+	T m_Tolerance = T(0);
+
+	std::vector<vector_type> m_Vertices;
+	std::vector<index_type> m_SourceIndices;
+	std::vector<Face> m_Faces;
+	std::vector<HalfEdge> m_Edges;
+
+	// Build arena
+	const vector_type* m_pPoints = nullptr;
+	size_t m_PointCount = 0;
+	std::vector<BuildFace> m_BuildFaces;
+	std::vector<index_type> m_EdgeOrigins;
+	std::vector<index_type> m_EdgeTwins;
+	std::vector<index_type> m_FreeFaces;
+	std::vector<Candidate> m_Candidates;
+	index_type m_NextSerial = 0;
+
+	// Build scratch
+	std::vector<index_type> m_Assignments;
+	std::vector<HorizonFrame> m_HorizonStack;
+	std::vector<HorizonEdge> m_Horizon;
+	std::vector<index_type> m_VisibleFaces;
+	std::vector<index_type> m_NewFaces;
+	std::vector<index_type> m_Orphans;
+
+public:
+	ConvexHull() noexcept = default;
+
+	explicit ConvexHull(const Settings& settings) noexcept
+		: m_Settings{ settings }
+	{ }
+
+	ConvexHull(const ConvexHull&) = default;
+	ConvexHull(ConvexHull&&) noexcept = default;
+	~ConvexHull() = default;
+
+	ConvexHull& operator = (const ConvexHull&) = default;
+	ConvexHull& operator = (ConvexHull&&) noexcept = default;
+
+public:
+	const Settings& GetSettings() const noexcept { return m_Settings; }
+	void SetSettings(const Settings& settings) noexcept { m_Settings = settings; }
+
+	// The tolerance used by the last Build()
+	T Tolerance() const noexcept { return m_Tolerance; }
+
+	bool Empty() const noexcept { return m_Faces.empty(); }
+
+	const std::vector<vector_type>& Vertices() const noexcept { return m_Vertices; }
+	const std::vector<Face>& Faces() const noexcept { return m_Faces; }
+	const std::vector<HalfEdge>& Edges() const noexcept { return m_Edges; }
+
+	// The index of each vertex in the points given to Build()
+	const std::vector<index_type>& SourceIndices() const noexcept { return m_SourceIndices; }
+
+	void Clear() noexcept
+	{
+		m_Vertices.clear();
+		m_SourceIndices.clear();
+		m_Faces.clear();
+		m_Edges.clear();
+	}
+
+public:
+	// Builds the hull of count points. Returns false, leaving the hull empty, if the points are coplanar.
+	bool Build(const vector_type* pPoints, size_t count)
+	{
+		assert(count < size_t(InvalidIndex));
+
+		Clear();
+		ResetArena();
+
+		if (count < 4)
+			return false;
+
+		m_pPoints = pPoints;
+		m_PointCount = count;
+
+		index_type simplex[4];
+		const bool solid = FindSimplex(simplex);
+
+		if (solid)
+		{
+			CreateSimplex(simplex);
+			PartitionSimplex(simplex);
+
+			const size_t maxVertices = m_Settings.MaxVertices > 0 ? std::max(m_Settings.MaxVertices, size_t(4)) : ~size_t(0);
+			size_t vertexCount = 4;
+
+			// Always expand toward the furthest outside point, so that a vertex limit keeps the most significant ones
+			while (!m_Candidates.empty() && vertexCount < maxVertices)
+			{
+				std::pop_heap(std::begin(m_Candidates), std::end(m_Candidates));
+				const Candidate candidate = m_Candidates.back();
+				m_Candidates.pop_back();
+
+				const BuildFace& face = m_BuildFaces[candidate.Face];
+
+				if (face.State != FaceState::Alive || face.Serial != candidate.Serial || face.Outside.empty())
+					continue;
+
+				AddPoint(candidate.Face);
+				++vertexCount;
+			}
+
+			Compact();
+		}
+
+		m_pPoints = nullptr;
+		m_PointCount = 0;
+
+		return solid;
+	}
+
+	bool Build(const std::vector<vector_type>& points)
+	{
+		return Build(points.data(), points.size());
+	}
+
+public:
+	bool Contains(const vector_type& point, T tolerance = T(0)) const noexcept
+	{
+		for (const auto& face : m_Faces)
+		{
+			if (face.Normal.Dot(point) - face.Offset > tolerance)
+				return false;
+		}
+
+		return !m_Faces.empty();
+	}
+
+	// Appends a triangle fan of every face to indices. Returns the number of triangles appended.
+	size_t Triangulate(std::vector<index_type>& indices) const
+	{
+		size_t result = 0;
+
+		for (const auto& face : m_Faces)
+		{
+			const index_type first = m_Edges[face.FirstEdge].Origin;
+
+			for (index_type e = 1; e + 1 < face.EdgeCount; ++e)
+			{
+				indices.push_back(first);
+				indices.push_back(m_Edges[face.FirstEdge + e].Origin);
+				indices.push_back(m_Edges[face.FirstEdge + e + 1].Origin);
+				++result;
+			}
+		}
+
+		return result;
+	}
+
+private:
+	size_t GrainSize() const noexcept
+	{
+		return m_Settings.ParallelPartition ? ParallelGrainSize(m_PointCount, MinGrainSize) : std::max(m_PointCount, size_t(1));
+	}
+
+	T Distance(index_type face, const vector_type& point) const noexcept
+	{
+		return m_BuildFaces[face].Normal.Dot(point) - m_BuildFaces[face].Offset;
+	}
+
+	void ResetArena() noexcept
+	{
+		m_BuildFaces.clear();
+		m_EdgeOrigins.clear();
+		m_EdgeTwins.clear();
+		m_FreeFaces.clear();
+		m_Candidates.clear();
+		m_NextSerial = 0;
+	}
+
+	// Returns the index of the point with the highest score (the first one on ties)
+	template<class Score>
+	index_type ArgMax(Score score, T& best) const
+	{
+		const size_t grainSize = GrainSize();
+		std::vector<std::pair<T, index_type>> chunks(ParallelChunkCount(m_PointCount, grainSize));
+
+		ParallelForChunks(0, m_PointCount, grainSize, [&](size_t chunk, size_t begin, size_t end)
+		{
+			std::pair<T, index_type> result{ std::numeric_limits<T>::lowest(), index_type(begin) };
+
+			for (size_t i = begin; i < end; ++i)
+			{
+				const T value = score(m_pPoints[i]);
+
+				if (value > result.first)
+					result = { value, index_type(i) };
+			}
+
+			chunks[chunk] = result;
+		});
+
+		std::pair<T, index_type> result = chunks.front();
+		for (const auto& chunk : chunks)
+		{
+			if (chunk.first > result.first)
+				result = chunk;
+		}
+
+		best = result.first;
+
+		return result.second;
+	}
+
+	bool FindSimplex(index_type(&simplex)[4])
+	{
+		struct Extremes
+		{
+			index_type Min[3];
+			index_type Max[3];
+		};
+
+		const size_t grainSize = GrainSize();
+		std::vector<Extremes> chunks(ParallelChunkCount(m_PointCount, grainSize));
+
+		ParallelForChunks(0, m_PointCount, grainSize, [&](size_t chunk, size_t begin, size_t end)
+		{
+			Extremes& result = chunks[chunk];
+
+			for (size_t k = 0; k < 3; ++k)
+				result.Min[k] = result.Max[k] = index_type(begin);
+
+			for (size_t i = begin + 1; i < end; ++i)
+			{
+				for (size_t k = 0; k < 3; ++k)
+				{
+					if (m_pPoints[i][k] < m_pPoints[result.Min[k]][k]) result.Min[k] = index_type(i);
+					if (m_pPoints[i][k] > m_pPoints[result.Max[k]][k]) result.Max[k] = index_type(i);
+				}
+			}
+		});
+
+		Extremes extremes = chunks.front();
+		for (const auto& chunk : chunks)
+		{
+			for (size_t k = 0; k < 3; ++k)
+			{
+				if (m_pPoints[chunk.Min[k]][k] < m_pPoints[extremes.Min[k]][k]) extremes.Min[k] = chunk.Min[k];
+				if (m_pPoints[chunk.Max[k]][k] > m_pPoints[extremes.Max[k]][k]) extremes.Max[k] = chunk.Max[k];
+			}
+		}
+
+		// Scale the tolerance with the magnitude of the coordinates (Lloyd, 2004)
+		if (m_Settings.Tolerance > T(0))
+		{
+			m_Tolerance = m_Settings.Tolerance;
+		}
+		else
+		{
+			T magnitude = T(0);
+			for (size_t k = 0; k < 3; ++k)
+				magnitude += std::max(std::abs(m_pPoints[extremes.Min[k]][k]), std::abs(m_pPoints[extremes.Max[k]][k]));
+
+			m_Tolerance = T(3) * std::numeric_limits<T>::epsilon() * magnitude;
+		}
+
+		// The pair of extreme points furthest apart along an axis
+		size_t axis = 0;
+		for (size_t k = 1; k < 3; ++k)
+		{
+			if (m_pPoints[extremes.Max[k]][k] - m_pPoints[extremes.Min[k]][k] > m_pPoints[extremes.Max[axis]][axis] - m_pPoints[extremes.Min[axis]][axis])
+				axis = k;
+		}
+
+		simplex[0] = extremes.Min[axis];
+		simplex[1] = extremes.Max[axis];
+
+		const vector_type a = m_pPoints[simplex[0]];
+		const vector_type ab = m_pPoints[simplex[1]] - a;
+
+		if (ab.Magnitude() <= m_Tolerance)
+			return false;
+
+		// The point furthest from their line
+		const vector_type direction = vector_type{ ab }.Normalize();
+		T best;
+
+		simplex[2] = ArgMax([&](const vector_type& p)
+		{
+			const vector_type d = p - a;
+			const T along = d.Dot(direction);
+
+			return d.MagnitudeSq() - along * along;
+		}, best);
+
+		if (best <= m_Tolerance * m_Tolerance)
+			return false;
+
+		// The point furthest from their plane
+		const vector_type normal = ab.Cross(m_pPoints[simplex[2]] - a).Normalize();
+
+		simplex[3] = ArgMax([&](const vector_type& p)
+		{
+			return std::abs(normal.Dot(p - a));
+		}, best);
+
+		return best > m_Tolerance;
+	}
+
+	index_type AllocateFace(index_type a, index_type b, index_type c)
+	{
+		index_type face;
+
+		if (!m_FreeFaces.empty())
+		{
+			face = m_FreeFaces.back();
+			m_FreeFaces.pop_back();
+		}
+		else
+		{
+			face = index_type(m_BuildFaces.size());
+			m_BuildFaces.emplace_back();
+			m_EdgeOrigins.resize(m_EdgeOrigins.size() + 3);
+			m_EdgeTwins.resize(m_EdgeTwins.size() + 3);
+		}
+
+		m_EdgeOrigins[face * 3 + 0] = a;
+		m_EdgeOrigins[face * 3 + 1] = b;
+		m_EdgeOrigins[face * 3 + 2] = c;
+
+		m_EdgeTwins[face * 3 + 0] = InvalidIndex;
+		m_EdgeTwins[face * 3 + 1] = InvalidIndex;
+		m_EdgeTwins[face * 3 + 2] = InvalidIndex;
+
+		const vector_type& pa = m_pPoints[a];
+		const vector_type& pb = m_pPoints[b];
+		const vector_type& pc = m_pPoints[c];
+
+		BuildFace& result = m_BuildFaces[face];
+
+		result.Normal = (pb - pa).Cross(pc - pa);
+
+		const T length = result.Normal.Magnitude();
+		if (length > T(0))
+			result.Normal /= length;
+
+		result.Area = length * T(0.5);
+		result.Offset = result.Normal.Dot((pa + pb + pc) / T(3));
+		result.FurthestDistance = T(0);
+		result.Furthest = InvalidIndex;
+		result.Serial = m_NextSerial++;
+		result.State = FaceState::Alive;
+		result.Outside.clear();
+
+		return face;
+	}
+
+	void Link(index_type edge, index_type twin) noexcept
+	{
+		m_EdgeTwins[edge] = twin;
+		m_EdgeTwins[twin] = edge;
+	}
+
+	void AssignOutside(index_type face, index_type point, T distance)
+	{
+		BuildFace& f = m_BuildFaces[face];
+
+		f.Outside.push_back(point);
+
+		if (distance > f.FurthestDistance)
+		{
+			f.FurthestDistance = distance;
+			f.Furthest = point;
+		}
+	}
+
+	void PushCandidate(index_type face)
+	{
+		const BuildFace& f = m_BuildFaces[face];
+
+		if (f.Outside.empty())
+			return;
+
+		m_Candidates.push_back({ f.FurthestDistance, face, f.Serial });
+		std::push_heap(std::begin(m_Candidates), std::end(m_Candidates));
+	}
+
+	void CreateSimplex(index_type(&simplex)[4])
+	{
+		// Wind the base so that the apex lies below it
+		const vector_type& a = m_pPoints[simplex[0]];
+		const vector_type normal = (m_pPoints[simplex[1]] - a).Cross(m_pPoints[simplex[2]] - a);
+
+		if (normal.Dot(m_pPoints[simplex[3]] - a) > T(0))
+			std::swap(simplex[1], simplex[2]);
+
+		AllocateFace(simplex[0], simplex[1], simplex[2]);
+		AllocateFace(simplex[0], simplex[3], simplex[1]);
+		AllocateFace(simplex[1], simplex[3], simplex[2]);
+		AllocateFace(simplex[2], simplex[3], simplex[0]);
+
+		for (index_type e = 0; e < 12; ++e)
+		{
+			const index_type origin = m_EdgeOrigins[e];
+			const index_type end = m_EdgeOrigins[(e / 3) * 3 + (e + 1) % 3];
+
+			for (index_type t = 0; t < 12; ++t)
+			{
+				if (m_EdgeOrigins[t] == end && m_EdgeOrigins[(t / 3) * 3 + (t + 1) % 3] == origin)
+					m_EdgeTwins[e] = t;
+			}
+		}
+	}
+
+	// Assigns every point to the simplex face it lies furthest outside of. Distances are computed in parallel
+	// chunks; the outside lists are then filled in point order so the result does not depend on scheduling.
+	void PartitionSimplex(const index_type(&simplex)[4])
+	{
+		m_Assignments.resize(m_PointCount);
+
+		ParallelFor(0, m_PointCount, GrainSize(), [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				index_type best = InvalidIndex;
+				T bestDistance = m_Tolerance;
+
+				for (index_type face = 0; face < 4; ++face)
+				{
+					const T distance = Distance(face, m_pPoints[i]);
+
+					if (distance > bestDistance)
+					{
+						best = face;
+						bestDistance = distance;
+					}
+				}
+
+				m_Assignments[i] = best;
+			}
+		});
+
+		for (const index_type s : simplex)
+			m_Assignments[s] = InvalidIndex;
+
+		for (size_t i = 0; i < m_PointCount; ++i)
+		{
+			const index_type face = m_Assignments[i];
+
+			if (face != InvalidIndex)
+				AssignOutside(face, index_type(i), Distance(face, m_pPoints[i]));
+		}
+
+		for (index_type face = 0; face < 4; ++face)
+			PushCandidate(face);
+	}
+
+	// Marks the faces visible from point, starting with face, and collects the horizon in counter-clockwise order
+	void ComputeHorizon(const vector_type& point, index_type face)
+	{
+		m_VisibleFaces.clear();
+		m_Horizon.clear();
+		m_HorizonStack.clear();
+
+		m_BuildFaces[face].State = FaceState::Visible;
+		m_VisibleFaces.push_back(face);
+		m_HorizonStack.push_back({ face, 0, 0 });
+
+		while (!m_HorizonStack.empty())
+		{
+			HorizonFrame& frame = m_HorizonStack.back();
+
+			if (frame.Visited == 3)
+			{
+				m_HorizonStack.pop_back();
+				continue;
+			}
+
+			const index_type edge = frame.Face * 3 + (frame.First + frame.Visited) % 3;
+			++frame.Visited;
+
+			const index_type twin = m_EdgeTwins[edge];
+			const index_type neighbour = twin / 3;
+
+			if (m_BuildFaces[neighbour].State == FaceState::Visible)
+				continue;
+
+			if (Distance(neighbour, point) > m_Tolerance)
+			{
+				// Continue around the neighbour from the edge after the one just crossed
+				m_BuildFaces[neighbour].State = FaceState::Visible;
+				m_VisibleFaces.push_back(neighbour);
+				m_HorizonStack.push_back({ neighbour, (twin % 3 + 1) % 3, 0 });
+			}
+			else
+			{
+				m_Horizon.push_back({ m_EdgeOrigins[edge], m_EdgeOrigins[frame.Face * 3 + (edge + 1) % 3], twin });
+			}
+		}
+	}
+
+	void AddPoint(index_type face)
+	{
+		const index_type eye = m_BuildFaces[face].Furthest;
+		const vector_type& point = m_pPoints[eye];
+
+		ComputeHorizon(point, face);
+
+		// Recycle the visible faces, keeping their outside points for reassignment
+		m_Orphans.clear();
+
+		for (const index_type visible : m_VisibleFaces)
+		{
+			BuildFace& f = m_BuildFaces[visible];
+
+			for (const index_type p : f.Outside)
+			{
+				if (p != eye)
+					m_Orphans.push_back(p);
+			}
+
+			f.Outside.clear();
+			f.State = FaceState::Free;
+			m_FreeFaces.push_back(visible);
+		}
+
+		// Fan new faces from the eye to the horizon
+		m_NewFaces.clear();
+
+		for (const auto& edge : m_Horizon)
+		{
+			const index_type created = AllocateFace(edge.Origin, edge.End, eye);
+
+			Link(created * 3, edge.Twin);
+			m_NewFaces.push_back(created);
+		}
+
+		const size_t count = m_NewFaces.size();
+		for (size_t i = 0; i < count; ++i)
+			Link(m_NewFaces[i] * 3 + 1, m_NewFaces[(i + 1) % count] * 3 + 2);
+
+		for (const index_type p : m_Orphans)
+		{
+			for (const index_type created : m_NewFaces)
+			{
+				const T distance = Distance(created, m_pPoints[p]);
+
+				if (distance > m_Tolerance)
+				{
+					AssignOutside(created, p, distance);
+					break;
+				}
+			}
+		}
+
+		for (const index_type created : m_NewFaces)
+			PushCandidate(created);
+	}
+
+	// Merges coplanar triangles into polygons and writes the compacted half-edge mesh
+	void Compact()
+	{
+		const T mergeTolerance = std::max(m_Settings.MergeTolerance, m_Tolerance);
+		const index_type faceCount = index_type(m_BuildFaces.size());
+
+		std::vector<index_type> order;
+
+		for (index_type f = 0; f < faceCount; ++f)
+		{
+			if (m_BuildFaces[f].State == FaceState::Alive)
+				order.push_back(f);
+		}
+
+		std::stable_sort(std::begin(order), std::end(order), [&](index_type a, index_type b)
+		{
+			return m_BuildFaces[a].Area > m_BuildFaces[b].Area;
+		});
+
+		// Grow each group from its largest triangle while the neighbours stay on the seed's plane.
+		//	Groups are kept simply connected, so each has a single boundary loop: a triangle whose opposite vertex
+		//	already belongs to the group is only added if it also borders the group across a second edge, since
+		//	it would otherwise pinch the group at that vertex or close it around another group.
+		std::vector<index_type> groups(faceCount, InvalidIndex);
+		std::vector<index_type> vertexGroups(m_PointCount, InvalidIndex);
+		std::vector<index_type> stack;
+		index_type groupCount = 0;
+
+		for (const index_type seed : order)
+		{
+			if (groups[seed] != InvalidIndex)
+				continue;
+
+			const index_type group = groupCount++;
+			const vector_type& normal = m_BuildFaces[seed].Normal;
+			const T offset = m_BuildFaces[seed].Offset;
+
+			groups[seed] = group;
+			stack.push_back(seed);
+
+			for (index_type k = 0; k < 3; ++k)
+				vertexGroups[m_EdgeOrigins[seed * 3 + k]] = group;
+
+			while (!stack.empty())
+			{
+				const index_type f = stack.back();
+				stack.pop_back();
+
+				for (index_type k = 0; k < 3; ++k)
+				{
+					const index_type twin = m_EdgeTwins[f * 3 + k];
+					const index_type neighbour = twin / 3;
+
+					if (groups[neighbour] != InvalidIndex || m_BuildFaces[neighbour].Normal.Dot(normal) <= T(0))
+						continue;
+
+					// The shared edge already passed, so only the vertex opposite it needs testing
+					const index_type opposite = m_EdgeOrigins[neighbour * 3 + (twin + 2) % 3];
+
+					if (std::abs(normal.Dot(m_pPoints[opposite]) - offset) > mergeTolerance)
+						continue;
+
+					if (vertexGroups[opposite] == group &&
+						groups[m_EdgeTwins[neighbour * 3 + (twin + 1) % 3] / 3] != group &&
+						groups[m_EdgeTwins[neighbour * 3 + (twin + 2) % 3] / 3] != group)
+						continue;
+
+					groups[neighbour] = group;
+					stack.push_back(neighbour);
+					vertexGroups[opposite] = group;
+				}
+			}
+		}
+
+		auto groupOf = [&](index_type edge) { return groups[edge / 3]; };
+		auto next = [](index_type edge) { return (edge / 3) * 3 + (edge + 1) % 3; };
+
+		// The boundary edge of a group following edge, found by turning about its end vertex
+		auto nextBoundary = [&](index_type edge)
+		{
+			const index_type group = groupOf(edge);
+			index_type candidate = next(edge);
+
+			while (groupOf(m_EdgeTwins[candidate]) == group)
+				candidate = next(m_EdgeTwins[candidate]);
+
+			return candidate;
+		};
+
+		std::vector<index_type> remap(m_PointCount, InvalidIndex);
+		std::vector<bool> emitted(groupCount, false);
+		std::vector<index_type> loop;
+
+		// The output edge starting at each boundary triangle edge, and the last triangle edge of each output edge
+		std::vector<index_type> edgeOf(m_EdgeOrigins.size(), InvalidIndex);
+		std::vector<index_type> lastOf;
+
+		// Emit in arena order; neighbouring slots were usually created together, which keeps the walk cache friendly
+		for (index_type f = 0; f < faceCount; ++f)
+		{
+			if (m_BuildFaces[f].State != FaceState::Alive)
+				continue;
+
+			for (index_type k = 0; k < 3; ++k)
+			{
+				const index_type start = f * 3 + k;
+				const index_type group = groups[f];
+
+				if (emitted[group] || groupOf(m_EdgeTwins[start]) == group)
+					continue;
+
+				emitted[group] = true;
+
+				loop.clear();
+				index_type edge = start;
+
+				do
+				{
+					loop.push_back(edge);
+					edge = nextBoundary(edge);
+				} while (edge != start && loop.size() <= m_EdgeOrigins.size());
+
+				// Start the loop where the neighbouring group changes, then drop the vertices between edges
+				// bordering the same neighbour; they only join two faces
+				const size_t loopSize = loop.size();
+				size_t first = 0;
+
+				for (size_t i = 0; i < loopSize; ++i)
+				{
+					if (groupOf(m_EdgeTwins[loop[i]]) != groupOf(m_EdgeTwins[loop[(i + loopSize - 1) % loopSize]]))
+					{
+						first = i;
+						break;
+					}
+				}
+
+				Face polygon;
+				polygon.FirstEdge = index_type(m_Edges.size());
+
+				for (size_t i = 0; i < loopSize; ++i)
+				{
+					const index_type e = loop[(first + i) % loopSize];
+					const index_type previous = loop[(first + i + loopSize - 1) % loopSize];
+
+					if (i > 0 && groupOf(m_EdgeTwins[e]) == groupOf(m_EdgeTwins[previous]))
+					{
+						lastOf.back() = e;
+						continue;
+					}
+
+					const index_type source = m_EdgeOrigins[e];
+
+					if (remap[source] == InvalidIndex)
+					{
+						remap[source] = index_type(m_Vertices.size());
+						m_Vertices.push_back(m_pPoints[source]);
+						m_SourceIndices.push_back(source);
+					}
+
+					edgeOf[e] = index_type(m_Edges.size());
+					lastOf.push_back(e);
+					m_Edges.push_back({ remap[source], InvalidIndex, InvalidIndex, index_type(m_Faces.size()) });
+				}
+
+				polygon.EdgeCount = index_type(m_Edges.size()) - polygon.FirstEdge;
+
+				// Newell's normal; the offset passes through the outermost vertex so the plane supports the hull
+				vector_type normal{ Epic::Zero };
+
+				for (index_type i = 0; i < polygon.EdgeCount; ++i)
+				{
+					HalfEdge& he = m_Edges[polygon.FirstEdge + i];
+					he.Next = polygon.FirstEdge + (i + 1) % polygon.EdgeCount;
+
+					const vector_type& p = m_Vertices[he.Origin];
+					const vector_type& q = m_Vertices[m_Edges[he.Next].Origin];
+
+					normal[0] += (p[1] - q[1]) * (p[2] + q[2]);
+					normal[1] += (p[2] - q[2]) * (p[0] + q[0]);
+					normal[2] += (p[0] - q[0]) * (p[1] + q[1]);
+				}
+
+				const T length = normal.Magnitude();
+				polygon.Normal = length > T(0) ? normal / length : m_BuildFaces[f].Normal;
+				polygon.Offset = std::numeric_limits<T>::lowest();
+
+				for (index_type i = 0; i < polygon.EdgeCount; ++i)
+					polygon.Offset = std::max(polygon.Offset, polygon.Normal.Dot(m_Vertices[m_Edges[polygon.FirstEdge + i].Origin]));
+
+				m_Faces.push_back(polygon);
+			}
+		}
+
+		// The neighbour's run along a shared edge is reversed, so it starts at the twin of this run's last edge
+		for (size_t e = 0; e < m_Edges.size(); ++e)
+		{
+			m_Edges[e].Twin = edgeOf[m_EdgeTwins[lastOf[e]]];
+
+			assert(m_Edges[e].Twin != InvalidIndex);
+		}
+	}
+};
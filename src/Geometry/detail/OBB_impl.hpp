@@ -0,0 +1,373 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "OBB_decl.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "../AABB.h"
+#include "../../Math/Matrix.h"
+#include "../../Math/MatrixDecomposition.hpp"
+#include "../../Math/Quaternion.h"
+#include "../../Math/Vector.h"
+#include "../../Parallel/BatchBlock.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// detail
+namespace Epic::detail
+{
+	// SATSeparated - Tests the 15 candidate separating axes of two boxes (Ericson, RTCD 4.4.1).
+	//	r holds the rotation of box b in the frame of box a (r[i][j] = dot(a_i, b_j)), t is the offset of b's
+	//	center in the frame of a, and ea/eb are the half extents. Returns true when a separating axis exists.
+	//	The tests are combined without branching so that lane loops can vectorize them.
+	template<class T>
+	inline bool SATSeparated(const T(&r)[3][3], const T(&t)[3], const T(&ea)[3], const T(&eb)[3]) noexcept
+	{
+		// Padding the absolute rotation keeps the cross product axes robust when edges are near parallel
+		constexpr T Epsilon = T(1e-6);
+
+		T ar[3][3];
+		for (size_t i = 0; i < 3; ++i)
+			for (size_t j = 0; j < 3; ++j)
+				ar[i][j] = std::abs(r[i][j]) + Epsilon;
+
+		bool separated = false;
+
+		// Face axes of a
+		for (size_t i = 0; i < 3; ++i)
+			separated |= std::abs(t[i]) > ea[i] + eb[0] * ar[i][0] + eb[1] * ar[i][1] + eb[2] * ar[i][2];
+
+		// Face axes of b
+		for (size_t j = 0; j < 3; ++j)
+		{
+			const T d = t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j];
+			separated |= std::abs(d) > ea[0] * ar[0][j] + ea[1] * ar[1][j] + ea[2] * ar[2][j] + eb[j];
+		}
+
+		// Edge cross products a_i x b_j
+		for (size_t i = 0; i < 3; ++i)
+		{
+			const size_t i1 = (i + 1) % 3;
+			const size_t i2 = (i + 2) % 3;
+
+			for (size_t j = 0; j < 3; ++j)
+			{
+				const size_t j1 = (j + 1) % 3;
+				const size_t j2 = (j + 2) % 3;
+
+				const T d = t[i2] * r[i1][j] - t[i1] * r[i2][j];
+				const T ra = ea[i1] * ar[i2][j] + ea[i2] * ar[i1][j];
+				const T rb = eb[j1] * ar[i][j2] + eb[j2] * ar[i][j1];
+
+				separated |= std::abs(d) > ra + rb;
+			}
+		}
+
+		return separated;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// OBB
+//	An oriented bounding box. The columns of Orientation are the unit axes of the box and
+//	Extents holds the half size of the box along each of them.
+template<class T>
+class Epic::OBB
+{
+	static_assert(std::is_floating_point_v<T>, "OBB requires floating point bounds.");
+
+public:
+	using type = Epic::OBB<T>;
+	using value_type = T;
+	using vector_type = Epic::Vector<T, 3>;
+	using matrix_type = Epic::Matrix<T, 3>;
+	using quaternion_type = Epic::Quaternion<T>;
+	using aabb_type = Epic::AABB<T>;
+
+public:
+	vector_type Center;
+	matrix_type Orientation;
+	vector_type Extents;
+
+public:
+	OBB() noexcept
+		: Center{ Epic::Zero }, Orientation{ Epic::Identity }, Extents{ Epic::Zero }
+	{ }
+
+	OBB(const vector_type& center, const matrix_type& orientation, const vector_type& extents) noexcept
+		: Center{ center }, Orientation{ orientation }, Extents{ extents }
+	{ }
+
+	OBB(const vector_type& center, const quaternion_type& orientation, const vector_type& extents) noexcept
+		: Center{ center }, Orientation{ orientation }, Extents{ extents }
+	{ }
+
+	explicit OBB(const aabb_type& box) noexcept
+		: Center{ box.Center() }, Orientation{ Epic::Identity }, Extents{ box.Extents() }
+	{ }
+
+	OBB(const OBB&) noexcept = default;
+	~OBB() noexcept = default;
+
+	OBB& operator = (const OBB&) noexcept = default;
+
+public:
+	const vector_type& Axis(size_t index) const noexcept
+	{
+		assert(index < 3);
+
+		return Orientation[index];
+	}
+
+	// Expresses a world space point in the frame of the box
+	vector_type ToLocal(const vector_type& point) const noexcept
+	{
+		const vector_type d = point - Center;
+
+		return { Orientation[0].Dot(d), Orientation[1].Dot(d), Orientation[2].Dot(d) };
+	}
+
+	vector_type ClosestPoint(const vector_type& point) const noexcept
+	{
+		const vector_type local = ToLocal(point);
+		vector_type result = Center;
+
+		for (size_t k = 0; k < 3; ++k)
+			result += Orientation[k] * std::clamp(local[k], -Extents[k], Extents[k]);
+
+		return result;
+	}
+
+	bool Contains(const vector_type& point) const noexcept
+	{
+		const vector_type local = ToLocal(point);
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			if (std::abs(local[k]) > Extents[k])
+				return false;
+		}
+
+		return true;
+	}
+
+	// The world space axis aligned box enclosing this box
+	aabb_type Bounds() const noexcept
+	{
+		vector_type extents;
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			extents[k] = std::abs(Orientation[0][k]) * Extents[0]
+				+ std::abs(Orientation[1][k]) * Extents[1]
+				+ std::abs(Orientation[2][k]) * Extents[2];
+		}
+
+		return { Center - extents, Center + extents };
+	}
+
+public:
+	bool Intersects(const OBB& box) const noexcept
+	{
+		T r[3][3], t[3], ea[3], eb[3];
+
+		LoadRelative(box, r, t, ea, eb);
+
+		return !detail::SATSeparated(r, t, ea, eb);
+	}
+
+	bool Intersects(const aabb_type& box) const noexcept
+	{
+		return Intersects(OBB{ box });
+	}
+
+	// Sphere overlap
+	bool Intersects(const vector_type& center, T radius) const noexcept
+	{
+		return (ClosestPoint(center) - center).MagnitudeSq() <= radius * radius;
+	}
+
+	// Raycast - Slab test in the frame of the box.
+	//	Writes the distance along direction to the first hit, which is zero when origin lies inside the box.
+	//	Direction need not be normalized; distance is measured in multiples of it.
+	bool Raycast(const vector_type& origin, const vector_type& direction, T& distance,
+		T maxDistance = std::numeric_limits<T>::max()) const noexcept
+	{
+		const vector_type o = ToLocal(origin);
+
+		T tmin = T(0);
+		T tmax = maxDistance;
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			const T d = Orientation[k].Dot(direction);
+
+			if (std::abs(d) < std::numeric_limits<T>::epsilon())
+			{
+				// Parallel to the slab; misses unless the origin lies between its planes
+				if (std::abs(o[k]) > Extents[k])
+					return false;
+
+				continue;
+			}
+
+			const T inv = T(1) / d;
+			T t0 = (-Extents[k] - o[k]) * inv;
+			T t1 = (Extents[k] - o[k]) * inv;
+
+			if (t0 > t1)
+				std::swap(t0, t1);
+
+			tmin = std::max(tmin, t0);
+			tmax = std::min(tmax, t1);
+
+			if (tmin > tmax)
+				return false;
+		}
+
+		distance = tmin;
+
+		return true;
+	}
+
+public:
+	// FitOf - Fits a box to count points using the principal axes of their covariance.
+	//	The box is tight along those axes but is not the minimum volume box.
+	static OBB FitOf(const vector_type* pPoints, size_t count) noexcept
+	{
+		if (count == 0)
+			return OBB{};
+
+		vector_type mean{ Epic::Zero };
+		for (size_t i = 0; i < count; ++i)
+			mean += pPoints[i];
+		mean /= T(count);
+
+		T c[6] = { };	// xx, yy, zz, xy, xz, yz
+		for (size_t i = 0; i < count; ++i)
+		{
+			const vector_type d = pPoints[i] - mean;
+
+			c[0] += d[0] * d[0];
+			c[1] += d[1] * d[1];
+			c[2] += d[2] * d[2];
+			c[3] += d[0] * d[1];
+			c[4] += d[0] * d[2];
+			c[5] += d[1] * d[2];
+		}
+
+		matrix_type covariance;
+		covariance[0] = { c[0], c[3], c[4] };
+		covariance[1] = { c[3], c[1], c[5] };
+		covariance[2] = { c[4], c[5], c[2] };
+
+		vector_type eigenvalues;
+		matrix_type axes;
+		Epic::SymmetricEigen(covariance, eigenvalues, axes, 16);
+
+		vector_type lo{ std::numeric_limits<T>::max(), std::numeric_limits<T>::max(), std::numeric_limits<T>::max() };
+		vector_type hi{ std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest() };
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const vector_type d = pPoints[i] - mean;
+
+			for (size_t k = 0; k < 3; ++k)
+			{
+				const T p = axes[k].Dot(d);
+				lo[k] = std::min(lo[k], p);
+				hi[k] = std::max(hi[k], p);
+			}
+		}
+
+		vector_type center = mean;
+		vector_type extents;
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			center += axes[k] * ((lo[k] + hi[k]) * T(0.5));
+			extents[k] = (hi[k] - lo[k]) * T(0.5);
+		}
+
+		return { center, axes, extents };
+	}
+
+	// BatchIntersects - Tests box against count others, writing 1 to pResults for each overlap and 0 otherwise.
+	//	The relative frames are staged in blocks of lanes and run through the branch-free SAT kernel.
+	static void BatchIntersects(const OBB& box, const OBB* pOthers, size_t count, std::uint8_t* pResults) noexcept
+	{
+		constexpr size_t BlockSize = detail::BatchBlockSize;
+
+		T r[9][BlockSize];
+		T t[3][BlockSize];
+		T eb[3][BlockSize];
+
+		const T ea[3] = { box.Extents[0], box.Extents[1], box.Extents[2] };
+
+		for (size_t block = 0; block < count; block += BlockSize)
+		{
+			const size_t blockCount = std::min(BlockSize, count - block);
+
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				const OBB& other = pOthers[block + i];
+				const vector_type d = other.Center - box.Center;
+
+				for (size_t a = 0; a < 3; ++a)
+				{
+					for (size_t b = 0; b < 3; ++b)
+						r[a * 3 + b][i] = box.Orientation[a].Dot(other.Orientation[b]);
+
+					t[a][i] = box.Orientation[a].Dot(d);
+					eb[a][i] = other.Extents[a];
+				}
+			}
+
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				T rLane[3][3], tLane[3], ebLane[3];
+
+				for (size_t k = 0; k < 9; ++k) rLane[k / 3][k % 3] = r[k][i];
+				for (size_t k = 0; k < 3; ++k) tLane[k] = t[k][i];
+				for (size_t k = 0; k < 3; ++k) ebLane[k] = eb[k][i];
+
+				pResults[block + i] = detail::SATSeparated(rLane, tLane, ea, ebLane) ? 0 : 1;
+			}
+		}
+	}
+
+private:
+	void LoadRelative(const OBB& box, T(&r)[3][3], T(&t)[3], T(&ea)[3], T(&eb)[3]) const noexcept
+	{
+		const vector_type d = box.Center - Center;
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			for (size_t j = 0; j < 3; ++j)
+				r[i][j] = Orientation[i].Dot(box.Orientation[j]);
+
+			t[i] = Orientation[i].Dot(d);
+			ea[i] = Extents[i];
+			eb[i] = box.Extents[i];
+		}
+	}
+};
@@ -0,0 +1,508 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "SpatialHashGrid_decl.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../../Math/Constants.h"
+#include "../../Math/Vector.h"
+#include "../../Parallel/ParallelFor.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// SpatialHashGrid
+//	A uniform grid of cells hashed into a fixed number of buckets.
+//	Points are counting-sorted by bucket on every Build() and stored in SoA form,
+//	so neighbor queries stream through contiguous memory instead of chasing nodes.
+template<class T, size_t N>
+class Epic::SpatialHashGrid
+{
+	static_assert(N == 2 || N == 3, "SpatialHashGrid is only available for 2D or 3D positions.");
+	static_assert(std::is_floating_point_v<T>, "SpatialHashGrid requires floating point positions.");
+
+public:
+	using type = Epic::SpatialHashGrid<T, N>;
+	using value_type = T;
+	using vector_type = Epic::Vector<T, N>;
+	using index_type = std::uint32_t;
+	using key_type = std::uint64_t;
+	using cell_type = std::array<std::int32_t, N>;
+	using pair_type = std::pair<index_type, index_type>;
+
+	static constexpr size_t Dimensions = N;
+
+private:
+	static constexpr size_t MinBucketCount = 64;
+	static constexpr size_t MinGrainSize = 16384;
+
+private:
+	T m_CellSize;
+	T m_InvCellSize;
+	size_t m_RequestedBucketCount;
+	size_t m_BucketCount;
+	size_t m_BucketShift;
+
+	std::vector<index_type> m_BucketStart;
+	std::vector<index_type> m_Indices;
+	std::vector<key_type> m_Keys;
+	std::array<std::vector<T>, N> m_Positions;
+
+	std::vector<key_type> m_SourceKeys;
+	std::vector<index_type> m_ChunkCounts;
+
+public:
+	explicit SpatialHashGrid(T cellSize, size_t bucketCount = 0) noexcept
+		: m_CellSize{ T(1) }, m_InvCellSize{ T(1) },
+		  m_RequestedBucketCount{ bucketCount },
+		  m_BucketCount{ 0 }, m_BucketShift{ 0 }
+	{
+		SetCellSize(cellSize);
+	}
+
+	SpatialHashGrid(const SpatialHashGrid&) = default;
+	SpatialHashGrid(SpatialHashGrid&&) noexcept = default;
+	~SpatialHashGrid() = default;
+
+	SpatialHashGrid& operator = (const SpatialHashGrid&) = default;
+	SpatialHashGrid& operator = (SpatialHashGrid&&) noexcept = default;
+
+public:
+	T CellSize() const noexcept { return m_CellSize; }
+	size_t BucketCount() const noexcept { return m_BucketCount; }
+	size_t Size() const noexcept { return m_Indices.size(); }
+	bool Empty() const noexcept { return m_Indices.empty(); }
+
+	// The source index of each point, in grid order
+	const std::vector<index_type>& Indices() const noexcept { return m_Indices; }
+
+	// The positions along one axis, in grid order
+	const std::vector<T>& Positions(size_t axis) const noexcept { return m_Positions[axis]; }
+
+	// Changing the cell size invalidates the grid until the next Build()
+	void SetCellSize(T cellSize) noexcept
+	{
+		assert(cellSize > T(0));
+
+		m_CellSize = cellSize;
+		m_InvCellSize = T(1) / cellSize;
+	}
+
+	void Clear() noexcept
+	{
+		m_BucketStart.clear();
+		m_Indices.clear();
+		m_Keys.clear();
+
+		for (auto& axis : m_Positions)
+			axis.clear();
+	}
+
+public:
+	cell_type CellOf(const vector_type& position) const noexcept
+	{
+		cell_type cell;
+
+		for (size_t n = 0; n < N; ++n)
+			cell[n] = static_cast<std::int32_t>(std::floor(position[n] * m_InvCellSize));
+
+		return cell;
+	}
+
+	// Rebuilds the grid from an array of positions.
+	// Keys are computed, histogrammed and scattered in parallel chunks; the resulting order is stable.
+	void Build(const vector_type* pPositions, size_t count)
+	{
+		assert(count < size_t(~index_type(0)));
+
+		ResizeBuckets(count);
+
+		m_Indices.resize(count);
+		m_Keys.resize(count);
+		m_SourceKeys.resize(count);
+
+		for (auto& axis : m_Positions)
+			axis.resize(count);
+
+		const size_t threads = std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+		const size_t grainSize = std::max((count + threads - 1) / threads, MinGrainSize);
+		const size_t chunkCount = std::max(ParallelChunkCount(count, grainSize), size_t(1));
+
+		m_ChunkCounts.assign(chunkCount * m_BucketCount, index_type(0));
+
+		// Compute the cell key of every point and histogram the buckets of each chunk
+		ParallelForChunks(0, count, grainSize, [&](size_t chunk, size_t begin, size_t end)
+		{
+			index_type* pCounts = &m_ChunkCounts[chunk * m_BucketCount];
+
+			for (size_t i = begin; i < end; ++i)
+			{
+				const key_type key = KeyOf(CellOf(pPositions[i]));
+
+				m_SourceKeys[i] = key;
+				++pCounts[BucketOf(key)];
+			}
+		});
+
+		// Convert the histograms into scatter offsets (bucket-major, chunk-minor keeps the sort stable)
+		m_BucketStart.resize(m_BucketCount + 1);
+
+		index_type offset = 0;
+		for (size_t b = 0; b < m_BucketCount; ++b)
+		{
+			m_BucketStart[b] = offset;
+
+			for (size_t c = 0; c < chunkCount; ++c)
+			{
+				index_type& slot = m_ChunkCounts[c * m_BucketCount + b];
+				const index_type bucketCount = slot;
+
+				slot = offset;
+				offset += bucketCount;
+			}
+		}
+
+		m_BucketStart[m_BucketCount] = offset;
+
+		// Scatter the points into their buckets
+		ParallelForChunks(0, count, grainSize, [&](size_t chunk, size_t begin, size_t end)
+		{
+			index_type* pOffsets = &m_ChunkCounts[chunk * m_BucketCount];
+
+			for (size_t i = begin; i < end; ++i)
+			{
+				const key_type key = m_SourceKeys[i];
+				const index_type dest = pOffsets[BucketOf(key)]++;
+
+				m_Indices[dest] = static_cast<index_type>(i);
+				m_Keys[dest] = key;
+
+				for (size_t n = 0; n < N; ++n)
+					m_Positions[n][dest] = pPositions[i][n];
+			}
+		});
+	}
+
+	void Build(const std::vector<vector_type>& positions)
+	{
+		Build(positions.data(), positions.size());
+	}
+
+public:
+	// Invokes fn(index, distanceSq) for every point within radius of center
+	template<class Function>
+	void QueryRadius(const vector_type& center, T radius, Function fn) const
+	{
+		if (Empty())
+			return;
+
+		const T radiusSq = radius * radius;
+		const cell_type lo = CellOf(center - radius);
+		const cell_type hi = CellOf(center + radius);
+
+		ForEachCell(lo, hi, [&](const cell_type& cell)
+		{
+			VisitCell(cell, [&](size_t s)
+			{
+				const T distSq = DistanceSq(s, center);
+
+				if (distSq <= radiusSq)
+					fn(m_Indices[s], distSq);
+			});
+		});
+	}
+
+	// Appends the index of every point within radius of center to results. Returns the number appended.
+	size_t QueryRadius(const vector_type& center, T radius, std::vector<index_type>& results) const
+	{
+		const size_t first = results.size();
+
+		QueryRadius(center, radius, [&](index_type index, T) { results.push_back(index); });
+
+		return results.size() - first;
+	}
+
+	// Finds up to k points nearest to center (no farther than maxRadius), ordered by increasing distance.
+	// Cells are visited in rings of increasing size until no unvisited cell can contain a closer point.
+	size_t QueryNearest(const vector_type& center, size_t k, T maxRadius, std::vector<index_type>& results) const
+	{
+		using candidate_type = std::pair<T, index_type>;
+
+		if (Empty() || k == 0)
+			return 0;
+
+		std::vector<candidate_type> heap;
+		heap.reserve(k + 1);
+
+		const T maxRadiusSq = maxRadius * maxRadius;
+		const cell_type origin = CellOf(center);
+		const auto maxRing = static_cast<std::int32_t>(std::ceil(maxRadius * m_InvCellSize)) + 1;
+
+		for (std::int32_t ring = 0; ring <= maxRing; ++ring)
+		{
+			if (ring > 0)
+			{
+				// Every unvisited point lies outside the box of visited cells
+				T nearestUnvisited = MaxReal<T>;
+
+				for (size_t n = 0; n < N; ++n)
+				{
+					const T lower = T(origin[n] - (ring - 1)) * m_CellSize;
+					const T upper = T(origin[n] + ring) * m_CellSize;
+
+					nearestUnvisited = std::min(nearestUnvisited, std::min(center[n] - lower, upper - center[n]));
+				}
+
+				if (nearestUnvisited > maxRadius)
+					break;
+
+				if (heap.size() == k && nearestUnvisited * nearestUnvisited >= heap.front().first)
+					break;
+			}
+
+			ForEachRingCell(origin, ring, [&](const cell_type& cell)
+			{
+				VisitCell(cell, [&](size_t s)
+				{
+					const T distSq = DistanceSq(s, center);
+
+					if (distSq > maxRadiusSq)
+						return;
+
+					if (heap.size() < k)
+					{
+						heap.emplace_back(distSq, m_Indices[s]);
+						std::push_heap(std::begin(heap), std::end(heap));
+					}
+					else if (distSq < heap.front().first)
+					{
+						std::pop_heap(std::begin(heap), std::end(heap));
+						heap.back() = { distSq, m_Indices[s] };
+						std::push_heap(std::begin(heap), std::end(heap));
+					}
+				});
+			});
+		}
+
+		std::sort_heap(std::begin(heap), std::end(heap));
+
+		for (const auto& candidate : heap)
+			results.push_back(candidate.second);
+
+		return heap.size();
+	}
+
+public:
+	// Invokes fn(indexA, indexB, distanceSq) once for every pair of points within radius of each other.
+	// Points are processed in parallel chunks, so fn must be safe to call concurrently.
+	template<class Function>
+	void ForEachPair(T radius, Function fn) const
+	{
+		const size_t count = Size();
+		const size_t grainSize = ParallelGrainSize(count, 1024);
+
+		ParallelForChunks(0, count, grainSize, [&](size_t, size_t begin, size_t end)
+		{
+			ForEachPairInRange(radius, begin, end, fn);
+		});
+	}
+
+	// Collects every pair of points within radius of each other. Returns the number of pairs appended.
+	size_t FindPairs(T radius, std::vector<pair_type>& results) const
+	{
+		const size_t count = Size();
+		const size_t grainSize = ParallelGrainSize(count, 1024);
+		const size_t chunkCount = ParallelChunkCount(count, grainSize);
+		const size_t first = results.size();
+
+		std::vector<std::vector<pair_type>> chunkResults(chunkCount);
+
+		ParallelForChunks(0, count, grainSize, [&](size_t chunk, size_t begin, size_t end)
+		{
+			auto& pairs = chunkResults[chunk];
+
+			ForEachPairInRange(radius, begin, end, [&](index_type a, index_type b, T)
+			{
+				pairs.emplace_back(a, b);
+			});
+		});
+
+		size_t total = 0;
+		for (const auto& pairs : chunkResults)
+			total += pairs.size();
+
+		results.reserve(first + total);
+
+		for (const auto& pairs : chunkResults)
+			results.insert(std::end(results), std::begin(pairs), std::end(pairs));
+
+		return total;
+	}
+
+private:
+	void ResizeBuckets(size_t count) noexcept
+	{
+		size_t target = m_RequestedBucketCount;
+
+		if (target == 0)
+			target = count / 2;
+
+		size_t bucketCount = MinBucketCount;
+		size_t bits = 6;
+
+		while (bucketCount < target)
+		{
+			bucketCount <<= 1;
+			++bits;
+		}
+
+		m_BucketCount = bucketCount;
+		m_BucketShift = 64 - bits;
+	}
+
+	static key_type KeyOf(const cell_type& cell) noexcept
+	{
+		if constexpr (N == 2)
+		{
+			return (key_type(std::uint32_t(cell[0])) << 32) | key_type(std::uint32_t(cell[1]));
+		}
+		else
+		{
+			constexpr key_type Mask = (key_type(1) << 21) - 1;
+
+			return ((key_type(std::uint32_t(cell[0])) & Mask) << 42) |
+				   ((key_type(std::uint32_t(cell[1])) & Mask) << 21) |
+				    (key_type(std::uint32_t(cell[2])) & Mask);
+		}
+	}
+
+	size_t BucketOf(key_type key) const noexcept
+	{
+		// Fibonacci hashing
+		return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> m_BucketShift);
+	}
+
+	T DistanceSq(size_t sorted, const vector_type& point) const noexcept
+	{
+		T result = T(0);
+
+		for (size_t n = 0; n < N; ++n)
+		{
+			const T d = m_Positions[n][sorted] - point[n];
+			result += d * d;
+		}
+
+		return result;
+	}
+
+	template<class Function>
+	void VisitCell(const cell_type& cell, Function fn) const
+	{
+		const key_type key = KeyOf(cell);
+		const size_t bucket = BucketOf(key);
+		const size_t end = m_BucketStart[bucket + 1];
+
+		for (size_t s = m_BucketStart[bucket]; s < end; ++s)
+		{
+			// Buckets are shared by colliding cells
+			if (m_Keys[s] == key)
+				fn(s);
+		}
+	}
+
+	template<class Function>
+	static void ForEachCell(const cell_type& lo, const cell_type& hi, Function fn)
+	{
+		cell_type cell;
+
+		if constexpr (N == 2)
+		{
+			for (cell[0] = lo[0]; cell[0] <= hi[0]; ++cell[0])
+				for (cell[1] = lo[1]; cell[1] <= hi[1]; ++cell[1])
+					fn(cell);
+		}
+		else
+		{
+			for (cell[0] = lo[0]; cell[0] <= hi[0]; ++cell[0])
+				for (cell[1] = lo[1]; cell[1] <= hi[1]; ++cell[1])
+					for (cell[2] = lo[2]; cell[2] <= hi[2]; ++cell[2])
+						fn(cell);
+		}
+	}
+
+	template<class Function>
+	static void ForEachRingCell(const cell_type& origin, std::int32_t ring, Function fn)
+	{
+		cell_type lo, hi;
+
+		for (size_t n = 0; n < N; ++n)
+		{
+			lo[n] = origin[n] - ring;
+			hi[n] = origin[n] + ring;
+		}
+
+		ForEachCell(lo, hi, [&](const cell_type& cell)
+		{
+			for (size_t n = 0; n < N; ++n)
+			{
+				if (cell[n] == lo[n] || cell[n] == hi[n])
+				{
+					fn(cell);
+					return;
+				}
+			}
+		});
+	}
+
+	template<class Function>
+	void ForEachPairInRange(T radius, size_t begin, size_t end, Function fn) const
+	{
+		const T radiusSq = radius * radius;
+
+		for (size_t s = begin; s < end; ++s)
+		{
+			vector_type point;
+
+			for (size_t n = 0; n < N; ++n)
+				point[n] = m_Positions[n][s];
+
+			const cell_type lo = CellOf(point - radius);
+			const cell_type hi = CellOf(point + radius);
+
+			ForEachCell(lo, hi, [&](const cell_type& cell)
+			{
+				VisitCell(cell, [&](size_t t)
+				{
+					// Each pair is reported once, from its lower grid position
+					if (t <= s)
+						return;
+
+					const T distSq = DistanceSq(t, point);
+
+					if (distSq <= radiusSq)
+						fn(m_Indices[s], m_Indices[t], distSq);
+				});
+			});
+		}
+	}
+};
@@ -0,0 +1,812 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "Matrix.h"
+#include "Quaternion.h"
+#include "../Parallel/BatchBlock.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Decomposition kernels
+//	Branch-free scalar kernels on the 9 column-major values of a 3x3 matrix. The batch functions below
+//	stage blocks of matrices into SoA lanes and apply a kernel step to every lane, so that they vectorize.
+namespace Epic::detail
+{
+	// Writes the cofactor matrix of m, det(m) * inverse(m)^T, and returns det(m).
+	// The columns of the cofactor matrix are the cross products of the columns of m.
+	template<class T>
+	inline T Cofactor3(const T(&m)[9], T(&c)[9]) noexcept
+	{
+		c[0] = m[4] * m[8] - m[5] * m[7];
+		c[1] = m[5] * m[6] - m[3] * m[8];
+		c[2] = m[3] * m[7] - m[4] * m[6];
+		c[3] = m[7] * m[2] - m[8] * m[1];
+		c[4] = m[8] * m[0] - m[6] * m[2];
+		c[5] = m[6] * m[1] - m[7] * m[0];
+		c[6] = m[1] * m[5] - m[2] * m[4];
+		c[7] = m[2] * m[3] - m[0] * m[5];
+		c[8] = m[0] * m[4] - m[1] * m[3];
+
+		return m[0] * c[0] + m[1] * c[1] + m[2] * c[2];
+	}
+
+	// One step of the scaled Newton iteration for the orthogonal polar factor (Higham, 1986):
+	//	R = (g * R + inverse(g * R)^T) / 2, with the Frobenius norm scaling g = sqrt(|inverse(R)| / |R|).
+	// Returns the squared Frobenius norm of the change.
+	template<class T>
+	inline T PolarStep(T(&r)[9]) noexcept
+	{
+		constexpr T Tiny = T(1e-30);
+
+		T c[9];
+		const T det = Cofactor3(r, c);
+		const T safeDet = (det < T(0)) ? std::min(det, -Tiny) : std::max(det, Tiny);
+
+		T normR = T(0);
+		T normC = T(0);
+
+		for (size_t k = 0; k < 9; ++k)
+		{
+			normR += r[k] * r[k];
+			normC += c[k] * c[k];
+		}
+
+		const T gamma = std::sqrt(std::sqrt(normC / std::max(normR, Tiny)) / std::abs(safeDet));
+		const T a = T(0.5) * gamma;
+		const T b = T(0.5) / (gamma * safeDet);
+
+		T change = T(0);
+
+		for (size_t k = 0; k < 9; ++k)
+		{
+			const T next = a * r[k] + b * c[k];
+			change += (next - r[k]) * (next - r[k]);
+			r[k] = next;
+		}
+
+		return change;
+	}
+
+	// Makes an orthogonal r a proper rotation and writes the symmetric stretch s = transpose(r) * m
+	template<class T>
+	inline void PolarFinish(const T(&m)[9], T(&r)[9], T(&s)[9]) noexcept
+	{
+		const T det =
+			r[0] * (r[4] * r[8] - r[5] * r[7]) +
+			r[1] * (r[5] * r[6] - r[3] * r[8]) +
+			r[2] * (r[3] * r[7] - r[4] * r[6]);
+
+		const T sign = (det < T(0)) ? T(-1) : T(1);
+
+		for (size_t k = 0; k < 9; ++k)
+			r[k] *= sign;
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			for (size_t j = 0; j < 3; ++j)
+				s[j * 3 + i] = r[i * 3] * m[j * 3] + r[i * 3 + 1] * m[j * 3 + 1] + r[i * 3 + 2] * m[j * 3 + 2];
+		}
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			for (size_t j = i + 1; j < 3; ++j)
+			{
+				const T average = T(0.5) * (s[j * 3 + i] + s[i * 3 + j]);
+				s[j * 3 + i] = average;
+				s[i * 3 + j] = average;
+			}
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Polar decomposition
+namespace Epic
+{
+	// PolarDecompose - Factors mat into rotation * stretch, where rotation is the nearest rotation to mat and
+	//	stretch is symmetric (scale and shear). If mat reflects, the reflection is left in stretch.
+	//	Iterates until the rotation changes by less than tolerance; returns the number of iterations.
+	template<class T>
+	size_t PolarDecompose(const Matrix<T, 3>& mat, Matrix<T, 3>& rotation, Matrix<T, 3>& stretch,
+		size_t maxIterations = 16, T tolerance = T(1e-6)) noexcept
+	{
+		T m[9], r[9], s[9];
+
+		for (size_t k = 0; k < 9; ++k)
+			m[k] = r[k] = mat.Values[k];
+
+		size_t iterations = 0;
+
+		while (iterations < maxIterations)
+		{
+			++iterations;
+
+			if (detail::PolarStep(r) <= tolerance * tolerance)
+				break;
+		}
+
+		detail::PolarFinish(m, r, s);
+
+		for (size_t k = 0; k < 9; ++k)
+		{
+			rotation.Values[k] = r[k];
+			stretch.Values[k] = s[k];
+		}
+
+		return iterations;
+	}
+
+	// BatchPolarDecompose - Decomposes count matrices with a fixed number of iterations.
+	//	Six iterations reach float precision for matrices with up to ~100:1 scale ratios.
+	//	pStretches may be null; rotations may be written over the source matrices.
+	template<class T>
+	void BatchPolarDecompose(const Matrix<T, 3>* pMatrices, Matrix<T, 3>* pRotations, Matrix<T, 3>* pStretches,
+		size_t count, size_t iterations = 6) noexcept
+	{
+		constexpr size_t BlockSize = detail::BatchBlockSize;
+
+		T m[9][BlockSize];
+		T r[9][BlockSize];
+
+		for (size_t block = 0; block < count; block += BlockSize)
+		{
+			const size_t blockCount = std::min(BlockSize, count - block);
+
+			for (size_t i = 0; i < blockCount; ++i)
+				for (size_t k = 0; k < 9; ++k)
+					m[k][i] = r[k][i] = pMatrices[block + i].Values[k];
+
+			for (size_t iteration = 0; iteration < iterations; ++iteration)
+			{
+				for (size_t i = 0; i < blockCount; ++i)
+				{
+					T lane[9];
+
+					for (size_t k = 0; k < 9; ++k)
+						lane[k] = r[k][i];
+
+					detail::PolarStep(lane);
+
+					for (size_t k = 0; k < 9; ++k)
+						r[k][i] = lane[k];
+				}
+			}
+
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				T mLane[9], rLane[9], sLane[9];
+
+				for (size_t k = 0; k < 9; ++k)
+				{
+					mLane[k] = m[k][i];
+					rLane[k] = r[k][i];
+				}
+
+				detail::PolarFinish(mLane, rLane, sLane);
+
+				for (size_t k = 0; k < 9; ++k)
+				{
+					pRotations[block + i].Values[k] = rLane[k];
+
+					if (pStretches)
+						pStretches[block + i].Values[k] = sLane[k];
+				}
+			}
+		}
+	}
+
+	// BatchOrthonormalize - Orthonormalizes count matrices in place (see Matrix::Orthonormalize)
+	//	The rotation columns of each block are staged into SoA lanes and every Gram-Schmidt step is applied
+	//	to all lanes at once; the results match Matrix::Orthonormalize.
+	template<class T, size_t N>
+	void BatchOrthonormalize(Matrix<T, N>* pMatrices, size_t count) noexcept
+	{
+		constexpr size_t BlockSize = detail::BatchBlockSize;
+		constexpr size_t K = (N == 4) ? 3 : N;
+
+		T c[K][K][BlockSize];
+		T s[BlockSize];
+
+		for (size_t block = 0; block < count; block += BlockSize)
+		{
+			const size_t blockCount = std::min(BlockSize, count - block);
+
+			for (size_t i = 0; i < blockCount; ++i)
+				for (size_t j = 0; j < K; ++j)
+					for (size_t k = 0; k < K; ++k)
+						c[j][k][i] = pMatrices[block + i].Values[j * N + k];
+
+			for (size_t j = 0; j < K; ++j)
+			{
+				for (size_t b = 0; b < j; ++b)
+				{
+					for (size_t i = 0; i < blockCount; ++i)
+						s[i] = T(0);
+
+					for (size_t k = 0; k < K; ++k)
+						for (size_t i = 0; i < blockCount; ++i)
+							s[i] += c[j][k][i] * c[b][k][i];
+
+					for (size_t k = 0; k < K; ++k)
+						for (size_t i = 0; i < blockCount; ++i)
+							c[j][k][i] -= s[i] * c[b][k][i];
+				}
+
+				for (size_t i = 0; i < blockCount; ++i)
+					s[i] = T(0);
+
+				for (size_t k = 0; k < K; ++k)
+					for (size_t i = 0; i < blockCount; ++i)
+						s[i] += c[j][k][i] * c[j][k][i];
+
+				// A degenerate column is left at zero, as in the scalar version
+				for (size_t i = 0; i < blockCount; ++i)
+					s[i] = (s[i] > T(0)) ? T(1) / std::sqrt(s[i]) : T(1);
+
+				for (size_t k = 0; k < K; ++k)
+					for (size_t i = 0; i < blockCount; ++i)
+						c[j][k][i] *= s[i];
+			}
+
+			for (size_t i = 0; i < blockCount; ++i)
+				for (size_t j = 0; j < K; ++j)
+					for (size_t k = 0; k < K; ++k)
+						pMatrices[block + i].Values[j * N + k] = c[j][k][i];
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Jacobi kernels
+//	Symmetric matrices are held as their 6 unique values { a00, a11, a22, a01, a02, a12 } and eigenvectors
+//	as the 9 column-major values of a rotation. Every rotation is computed without branches; a pair whose
+//	off-diagonal value is already 0 is rotated by the identity.
+namespace Epic::detail
+{
+	constexpr size_t SymmetricIndex(size_t i, size_t j) noexcept
+	{
+		return (i == j) ? i : (i + j + 2);
+	}
+
+	template<class T>
+	inline void LoadSymmetric(const T(&m)[9], T(&a)[6]) noexcept
+	{
+		a[0] = m[0]; a[1] = m[4]; a[2] = m[8];
+		a[3] = T(0.5) * (m[1] + m[3]);
+		a[4] = T(0.5) * (m[2] + m[6]);
+		a[5] = T(0.5) * (m[5] + m[7]);
+	}
+
+	// Annihilates a[P][Q] with a Jacobi rotation and accumulates it into the eigenvectors v
+	template<size_t P, size_t Q, class T>
+	inline void JacobiRotate(T(&a)[6], T(&v)[9]) noexcept
+	{
+		constexpr size_t R = 3 - P - Q;
+		constexpr size_t PP = SymmetricIndex(P, P);
+		constexpr size_t QQ = SymmetricIndex(Q, Q);
+		constexpr size_t PQ = SymmetricIndex(P, Q);
+		constexpr size_t RP = SymmetricIndex(R, P);
+		constexpr size_t RQ = SymmetricIndex(R, Q);
+		constexpr T Tiny = T(1e-30);
+
+		// t = tan(theta), the smaller root of t^2 + 2t * cot(2 theta) - 1 = 0
+		const T apq = a[PQ];
+		const T tau = a[QQ] - a[PP];
+		const T sign = (tau < T(0)) ? T(-1) : T(1);
+		const T t = (T(2) * apq * sign) / (std::abs(tau) + std::sqrt(tau * tau + T(4) * apq * apq) + Tiny);
+		const T c = T(1) / std::sqrt(T(1) + t * t);
+		const T s = t * c;
+
+		a[PP] -= t * apq;
+		a[QQ] += t * apq;
+		a[PQ] = T(0);
+
+		const T arp = a[RP];
+		const T arq = a[RQ];
+
+		a[RP] = c * arp - s * arq;
+		a[RQ] = s * arp + c * arq;
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			const T vp = v[P * 3 + k];
+			const T vq = v[Q * 3 + k];
+
+			v[P * 3 + k] = c * vp - s * vq;
+			v[Q * 3 + k] = s * vp + c * vq;
+		}
+	}
+
+	template<class T>
+	inline void JacobiSweep(T(&a)[6], T(&v)[9]) noexcept
+	{
+		JacobiRotate<0, 1>(a, v);
+		JacobiRotate<0, 2>(a, v);
+		JacobiRotate<1, 2>(a, v);
+	}
+
+	template<class T>
+	inline void SwapColumnsIf(bool condition, T(&e)[3], T(&v)[9], size_t i, size_t j) noexcept
+	{
+		const T ei = e[i];
+		const T ej = e[j];
+
+		e[i] = condition ? ej : ei;
+		e[j] = condition ? ei : ej;
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			const T vi = v[i * 3 + k];
+			const T vj = v[j * 3 + k];
+
+			v[i * 3 + k] = condition ? vj : vi;
+			v[j * 3 + k] = condition ? vi : vj;
+		}
+	}
+
+	// Sorts the eigenvalues in decreasing order along with their eigenvectors and keeps v a proper rotation
+	template<class T>
+	inline void SortEigen(T(&e)[3], T(&v)[9]) noexcept
+	{
+		SwapColumnsIf(e[0] < e[1], e, v, 0, 1);
+		SwapColumnsIf(e[1] < e[2], e, v, 1, 2);
+		SwapColumnsIf(e[0] < e[1], e, v, 0, 1);
+
+		const T det =
+			v[0] * (v[4] * v[8] - v[5] * v[7]) +
+			v[1] * (v[5] * v[6] - v[3] * v[8]) +
+			v[2] * (v[3] * v[7] - v[4] * v[6]);
+
+		const T sign = (det < T(0)) ? T(-1) : T(1);
+
+		for (size_t k = 6; k < 9; ++k)
+			v[k] *= sign;
+	}
+
+	// Zeroes b[Col][J] against b[Col][I] with a Givens rotation of rows I and J, accumulating it into u
+	template<size_t I, size_t J, size_t Col, class T>
+	inline void GivensRotate(T(&b)[9], T(&u)[9]) noexcept
+	{
+		constexpr T Tiny = T(1e-30);
+
+		const T a1 = b[Col * 3 + I];
+		const T a2 = b[Col * 3 + J];
+		const T rho = std::sqrt(a1 * a1 + a2 * a2);
+		const bool isValid = rho > Tiny;
+		const T c = isValid ? a1 / rho : T(1);
+		const T s = isValid ? a2 / rho : T(0);
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			const T bi = b[k * 3 + I];
+			const T bj = b[k * 3 + J];
+
+			b[k * 3 + I] = c * bi + s * bj;
+			b[k * 3 + J] = c * bj - s * bi;
+
+			const T ui = u[I * 3 + k];
+			const T uj = u[J * 3 + k];
+
+			u[I * 3 + k] = c * ui + s * uj;
+			u[J * 3 + k] = c * uj - s * ui;
+		}
+	}
+
+	// Completes an SVD from the sorted eigenvectors v of transpose(m) * m:
+	//	b = m * v is factored by Givens QR into u * r; the diagonal of r holds the singular values.
+	template<class T>
+	inline void SingularValueFinish(const T(&m)[9], const T(&v)[9], T(&u)[9], T(&sigma)[3]) noexcept
+	{
+		T b[9];
+
+		for (size_t j = 0; j < 3; ++j)
+		{
+			for (size_t k = 0; k < 3; ++k)
+				b[j * 3 + k] = m[k] * v[j * 3] + m[3 + k] * v[j * 3 + 1] + m[6 + k] * v[j * 3 + 2];
+		}
+
+		for (size_t k = 0; k < 9; ++k)
+			u[k] = (k % 4 == 0) ? T(1) : T(0);
+
+		GivensRotate<0, 1, 0>(b, u);
+		GivensRotate<0, 2, 0>(b, u);
+		GivensRotate<1, 2, 1>(b, u);
+
+		sigma[0] = b[0];
+		sigma[1] = b[4];
+		sigma[2] = b[8];
+	}
+
+	template<class T>
+	inline void LoadIdentity3(T(&v)[9]) noexcept
+	{
+		for (size_t k = 0; k < 9; ++k)
+			v[k] = (k % 4 == 0) ? T(1) : T(0);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Eigen decomposition and SVD
+namespace Epic
+{
+	// SymmetricEigen - Diagonalizes a symmetric matrix with cyclic Jacobi sweeps:
+	//	mat = eigenvectors * diag(eigenvalues) * transpose(eigenvectors)
+	//	Eigenvalues are sorted in decreasing order and eigenvectors is a rotation whose columns match them.
+	//	Sweeps until the off-diagonal norm falls below tolerance relative to the diagonal; returns the number of sweeps.
+	template<class T>
+	size_t SymmetricEigen(const Matrix<T, 3>& mat, Vector<T, 3>& eigenvalues, Matrix<T, 3>& eigenvectors,
+		size_t maxSweeps = 8, T tolerance = T(1e-7)) noexcept
+	{
+		T m[9], a[6], v[9];
+
+		for (size_t k = 0; k < 9; ++k)
+			m[k] = mat.Values[k];
+
+		detail::LoadSymmetric(m, a);
+		detail::LoadIdentity3(v);
+
+		size_t sweeps = 0;
+
+		while (sweeps < maxSweeps)
+		{
+			const T offDiagonal = a[3] * a[3] + a[4] * a[4] + a[5] * a[5];
+			const T diagonal = a[0] * a[0] + a[1] * a[1] + a[2] * a[2];
+
+			if (offDiagonal <= tolerance * tolerance * diagonal)
+				break;
+
+			detail::JacobiSweep(a, v);
+			++sweeps;
+		}
+
+		T e[3] = { a[0], a[1], a[2] };
+		detail::SortEigen(e, v);
+
+		for (size_t k = 0; k < 3; ++k)
+			eigenvalues[k] = e[k];
+
+		for (size_t k = 0; k < 9; ++k)
+			eigenvectors.Values[k] = v[k];
+
+		return sweeps;
+	}
+
+	// SingularValueDecompose - Factors mat = u * diag(sigma) * transpose(v) (McAdams et al., 2011).
+	//	u and v are rotations and sigma is sorted by decreasing magnitude; if mat reflects, the last singular
+	//	value is negative. v diagonalizes transpose(mat) * mat and u comes from a Givens QR of mat * v.
+	template<class T>
+	void SingularValueDecompose(const Matrix<T, 3>& mat, Matrix<T, 3>& u, Vector<T, 3>& sigma, Matrix<T, 3>& v,
+		size_t maxSweeps = 8) noexcept
+	{
+		Matrix<T, 3> normal = Matrix<T, 3>::TransposeOf(mat);
+		normal.Compose(mat);
+
+		Vector<T, 3> eigenvalues;
+		SymmetricEigen(normal, eigenvalues, v, maxSweeps);
+
+		T m[9], vs[9], us[9], s[3];
+
+		for (size_t k = 0; k < 9; ++k)
+		{
+			m[k] = mat.Values[k];
+			vs[k] = v.Values[k];
+		}
+
+		detail::SingularValueFinish(m, vs, us, s);
+
+		for (size_t k = 0; k < 9; ++k)
+			u.Values[k] = us[k];
+
+		for (size_t k = 0; k < 3; ++k)
+			sigma[k] = s[k];
+	}
+
+	// BatchSymmetricEigen - Diagonalizes count symmetric matrices with a fixed number of sweeps.
+	//	Four sweeps reach float precision for typical inertia and covariance matrices.
+	template<class T>
+	void BatchSymmetricEigen(const Matrix<T, 3>* pMatrices, Vector<T, 3>* pEigenvalues, Matrix<T, 3>* pEigenvectors,
+		size_t count, size_t sweeps = 4) noexcept
+	{
+		constexpr size_t BlockSize = detail::BatchBlockSize;
+
+		T a[6][BlockSize];
+		T v[9][BlockSize];
+
+		for (size_t block = 0; block < count; block += BlockSize)
+		{
+			const size_t blockCount = std::min(BlockSize, count - block);
+
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				T mLane[9], aLane[6];
+
+				for (size_t k = 0; k < 9; ++k)
+				{
+					mLane[k] = pMatrices[block + i].Values[k];
+					v[k][i] = (k % 4 == 0) ? T(1) : T(0);
+				}
+
+				detail::LoadSymmetric(mLane, aLane);
+
+				for (size_t k = 0; k < 6; ++k)
+					a[k][i] = aLane[k];
+			}
+
+			for (size_t sweep = 0; sweep < sweeps; ++sweep)
+			{
+				for (size_t i = 0; i < blockCount; ++i)
+				{
+					T aLane[6], vLane[9];
+
+					for (size_t k = 0; k < 6; ++k) aLane[k] = a[k][i];
+					for (size_t k = 0; k < 9; ++k) vLane[k] = v[k][i];
+
+					detail::JacobiSweep(aLane, vLane);
+
+					for (size_t k = 0; k < 6; ++k) a[k][i] = aLane[k];
+					for (size_t k = 0; k < 9; ++k) v[k][i] = vLane[k];
+				}
+			}
+
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				T e[3] = { a[0][i], a[1][i], a[2][i] };
+				T vLane[9];
+
+				for (size_t k = 0; k < 9; ++k)
+					vLane[k] = v[k][i];
+
+				detail::SortEigen(e, vLane);
+
+				for (size_t k = 0; k < 3; ++k)
+					pEigenvalues[block + i][k] = e[k];
+
+				for (size_t k = 0; k < 9; ++k)
+					pEigenvectors[block + i].Values[k] = vLane[k];
+			}
+		}
+	}
+
+	// BatchSingularValueDecompose - Decomposes count matrices with a fixed number of Jacobi sweeps
+	//	(see SingularValueDecompose). pU and pV may be null.
+	template<class T>
+	void BatchSingularValueDecompose(const Matrix<T, 3>* pMatrices, Matrix<T, 3>* pU, Vector<T, 3>* pSigma, Matrix<T, 3>* pV,
+		size_t count, size_t sweeps = 4) noexcept
+	{
+		constexpr size_t BlockSize = detail::BatchBlockSize;
+
+		T a[6][BlockSize];
+		T v[9][BlockSize];
+
+		for (size_t block = 0; block < count; block += BlockSize)
+		{
+			const size_t blockCount = std::min(BlockSize, count - block);
+
+			// Stage transpose(m) * m
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				const auto& m = pMatrices[block + i].Values;
+
+				for (size_t p = 0; p < 3; ++p)
+				{
+					for (size_t q = p; q < 3; ++q)
+						a[detail::SymmetricIndex(p, q)][i] = m[p * 3] * m[q * 3] + m[p * 3 + 1] * m[q * 3 + 1] + m[p * 3 + 2] * m[q * 3 + 2];
+				}
+
+				for (size_t k = 0; k < 9; ++k)
+					v[k][i] = (k % 4 == 0) ? T(1) : T(0);
+			}
+
+			for (size_t sweep = 0; sweep < sweeps; ++sweep)
+			{
+				for (size_t i = 0; i < blockCount; ++i)
+				{
+					T aLane[6], vLane[9];
+
+					for (size_t k = 0; k < 6; ++k) aLane[k] = a[k][i];
+					for (size_t k = 0; k < 9; ++k) vLane[k] = v[k][i];
+
+					detail::JacobiSweep(aLane, vLane);
+
+					for (size_t k = 0; k < 6; ++k) a[k][i] = aLane[k];
+					for (size_t k = 0; k < 9; ++k) v[k][i] = vLane[k];
+				}
+			}
+
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				T e[3] = { a[0][i], a[1][i], a[2][i] };
+				T mLane[9], vLane[9], uLane[9], s[3];
+
+				for (size_t k = 0; k < 9; ++k)
+				{
+					mLane[k] = pMatrices[block + i].Values[k];
+					vLane[k] = v[k][i];
+				}
+
+				detail::SortEigen(e, vLane);
+				detail::SingularValueFinish(mLane, vLane, uLane, s);
+
+				for (size_t k = 0; k < 3; ++k)
+					pSigma[block + i][k] = s[k];
+
+				for (size_t k = 0; k < 9; ++k)
+				{
+					if (pU) pU[block + i].Values[k] = uLane[k];
+					if (pV) pV[block + i].Values[k] = vLane[k];
+				}
+			}
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// TRS kernels
+namespace Epic::detail
+{
+	// Splits the upper 3x4 of a column-major affine matrix into translation, rotation (x, y, z, w) and scale.
+	// A mirroring matrix (negative determinant) is given a negative x scale. The quaternion is built from
+	// the largest diagonal combination using selects rather than branches, then renormalized to absorb
+	// rounding and small amounts of shear.
+	template<class T>
+	inline void DecomposeTRS(const T(&m)[12], T(&t)[3], T(&q)[4], T(&s)[3]) noexcept
+	{
+		constexpr T Tiny = T(1e-30);
+
+		t[0] = m[9];
+		t[1] = m[10];
+		t[2] = m[11];
+
+		const T sx = std::sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+		s[1] = std::sqrt(m[3] * m[3] + m[4] * m[4] + m[5] * m[5]);
+		s[2] = std::sqrt(m[6] * m[6] + m[7] * m[7] + m[8] * m[8]);
+
+		const T det = m[0] * (m[4] * m[8] - m[5] * m[7])
+			+ m[1] * (m[5] * m[6] - m[3] * m[8])
+			+ m[2] * (m[3] * m[7] - m[4] * m[6]);
+		s[0] = (det < T(0)) ? -sx : sx;
+
+		const T ix = T(1) / ((det < T(0)) ? std::min(s[0], -Tiny) : std::max(s[0], Tiny));
+		const T iy = T(1) / std::max(s[1], Tiny);
+		const T iz = T(1) / std::max(s[2], Tiny);
+
+		const T r00 = m[0] * ix, r10 = m[1] * ix, r20 = m[2] * ix;
+		const T r01 = m[3] * iy, r11 = m[4] * iy, r21 = m[5] * iy;
+		const T r02 = m[6] * iz, r12 = m[7] * iz, r22 = m[8] * iz;
+
+		// The largest of |x|, |y|, |z|, |w| comes from the diagonal; the others come from the off-diagonal
+		// sums and differences divided by it, which keeps them accurate when they are small.
+		const T xx = T(1) + r00 - r11 - r22;
+		const T yy = T(1) - r00 + r11 - r22;
+		const T zz = T(1) - r00 - r11 + r22;
+		const T ww = T(1) + r00 + r11 + r22;
+
+		const bool wMax = ww >= std::max(xx, std::max(yy, zz));
+		const bool xMax = !wMax && xx >= std::max(yy, zz);
+		const bool yMax = !wMax && !xMax && yy >= zz;
+
+		const T largest = T(0.5) * std::sqrt(std::max(std::max(std::max(xx, yy), std::max(zz, ww)), Tiny));
+		const T inv = T(0.25) / largest;
+
+		const T xw = (r21 - r12) * inv, yw = (r02 - r20) * inv, zw = (r10 - r01) * inv;
+		const T xy = (r10 + r01) * inv, xz = (r02 + r20) * inv, yz = (r21 + r12) * inv;
+
+		q[0] = wMax ? xw : xMax ? largest : yMax ? xy : xz;
+		q[1] = wMax ? yw : xMax ? xy : yMax ? largest : yz;
+		q[2] = wMax ? zw : xMax ? xz : yMax ? yz : largest;
+		q[3] = wMax ? largest : xMax ? xw : yMax ? yw : zw;
+
+		// Prefer w >= 0 so that equal rotations decompose to equal quaternions
+		const T flip = std::copysign(T(1), q[3]);
+
+		const T invLength = flip / std::sqrt(std::max(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3], Tiny));
+
+		for (size_t k = 0; k < 4; ++k)
+			q[k] *= invLength;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// TRS decomposition
+namespace Epic
+{
+	// Decompose - Splits an affine matrix into the translation, rotation and scale that Matrix::MakeTRS
+	//	composes back into it. Mirroring is expressed as a negative x scale. Shear and the projective
+	//	row are ignored; use PolarDecompose on the upper 3x3 if the matrix may be sheared.
+	template<class T>
+	void Decompose(const Matrix<T, 4>& mat, Vector<T, 3>& translation, Quaternion<T>& rotation, Vector<T, 3>& scale) noexcept
+	{
+		T m[12], t[3], q[4], s[3];
+
+		for (size_t c = 0; c < 4; ++c)
+			for (size_t r = 0; r < 3; ++r)
+				m[c * 3 + r] = mat.Values[c * 4 + r];
+
+		detail::DecomposeTRS(m, t, q, s);
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			translation[k] = t[k];
+			scale[k] = s[k];
+		}
+
+		for (size_t k = 0; k < 4; ++k)
+			rotation.Values[k] = q[k];
+	}
+
+	// BatchDecompose - Decomposes count matrices (see Decompose).
+	//	Any of pTranslations, pRotations or pScales may be null.
+	template<class T>
+	void BatchDecompose(const Matrix<T, 4>* pMatrices, Vector<T, 3>* pTranslations, Quaternion<T>* pRotations, Vector<T, 3>* pScales,
+		size_t count) noexcept
+	{
+		constexpr size_t BlockSize = detail::BatchBlockSize;
+
+		T m[12][BlockSize];
+		T t[3][BlockSize];
+		T q[4][BlockSize];
+		T s[3][BlockSize];
+
+		for (size_t block = 0; block < count; block += BlockSize)
+		{
+			const size_t blockCount = std::min(BlockSize, count - block);
+
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				const auto& values = pMatrices[block + i].Values;
+
+				for (size_t c = 0; c < 4; ++c)
+					for (size_t r = 0; r < 3; ++r)
+						m[c * 3 + r][i] = values[c * 4 + r];
+			}
+
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				T mLane[12], tLane[3], qLane[4], sLane[3];
+
+				for (size_t k = 0; k < 12; ++k) mLane[k] = m[k][i];
+
+				detail::DecomposeTRS(mLane, tLane, qLane, sLane);
+
+				for (size_t k = 0; k < 3; ++k) t[k][i] = tLane[k];
+				for (size_t k = 0; k < 4; ++k) q[k][i] = qLane[k];
+				for (size_t k = 0; k < 3; ++k) s[k][i] = sLane[k];
+			}
+
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				for (size_t k = 0; k < 3; ++k)
+				{
+					if (pTranslations) pTranslations[block + i][k] = t[k][i];
+					if (pScales) pScales[block + i][k] = s[k][i];
+				}
+
+				if (pRotations)
+				{
+					for (size_t k = 0; k < 4; ++k)
+						pRotations[block + i].Values[k] = q[k][i];
+				}
+			}
+		}
+	}
+}
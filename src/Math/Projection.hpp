@@ -0,0 +1,238 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cassert>
+#include <cmath>
+
+#include "Angle.h"
+#include "Matrix.h"
+#include "Vector.h"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Projection builders
+//	Projections for a camera looking down -z. The standard variants follow the OpenGL convention and map
+//	depth to [-1, 1] in NDC. The reversed-Z variants map the near plane to 1 and the far plane to 0, for use
+//	with a [0, 1] clip depth range (D3D, or glClipControl) and a greater-than depth test; storing depth this way
+//	spreads floating point precision evenly over distance. Infinite variants place the far plane at infinity.
+namespace Epic
+{
+	namespace detail
+	{
+		// PerspectiveOf - A perspective projection with clip z = a * z + b
+		template<class T>
+		inline Matrix<T, 4> PerspectiveOf(Radian<T> fovy, T aspectRatio, T a, T b) noexcept
+		{
+			assert(aspectRatio != T(0));
+
+			const T f = T(1) / (fovy / T(2)).Tan();
+
+			Matrix<T, 4> result = Zero;
+
+			result.Values[0] = f / aspectRatio;
+			result.Values[5] = f;
+			result.Values[10] = a;
+			result.Values[11] = T(-1);
+			result.Values[14] = b;
+
+			return result;
+		}
+
+		// OrthographicOf - An orthographic projection with clip z = a * z + b
+		template<class T>
+		inline Matrix<T, 4> OrthographicOf(T left, T right, T top, T bottom, T a, T b) noexcept
+		{
+			assert(right != left);
+			assert(top != bottom);
+
+			Matrix<T, 4> result = Identity;
+
+			result.Values[0] = T(2) / (right - left);
+			result.Values[5] = T(2) / (top - bottom);
+			result.Values[10] = a;
+			result.Values[12] = -(right + left) / (right - left);
+			result.Values[13] = -(top + bottom) / (top - bottom);
+			result.Values[14] = b;
+
+			return result;
+		}
+	}
+
+	// The standard variants are those of CreatePerspectiveMatrix and CreateOrthoMatrix
+	template<class T>
+	inline Matrix<T, 4> MakePerspective(Radian<T> fovy, T aspectRatio, T znear, T zfar) noexcept
+	{
+		assert(znear > T(0) && zfar > znear);
+
+		return CreatePerspectiveMatrix(fovy, aspectRatio, znear, zfar);
+	}
+
+	template<class T>
+	inline Matrix<T, 4> MakePerspectiveInfinite(Radian<T> fovy, T aspectRatio, T znear) noexcept
+	{
+		assert(znear > T(0));
+
+		return detail::PerspectiveOf(fovy, aspectRatio, T(-1), T(-2) * znear);
+	}
+
+	template<class T>
+	inline Matrix<T, 4> MakePerspectiveReversedZ(Radian<T> fovy, T aspectRatio, T znear, T zfar) noexcept
+	{
+		assert(znear > T(0) && zfar > znear);
+
+		return detail::PerspectiveOf(fovy, aspectRatio, znear / (zfar - znear), (zfar * znear) / (zfar - znear));
+	}
+
+	template<class T>
+	inline Matrix<T, 4> MakePerspectiveInfiniteReversedZ(Radian<T> fovy, T aspectRatio, T znear) noexcept
+	{
+		assert(znear > T(0));
+
+		return detail::PerspectiveOf(fovy, aspectRatio, T(0), znear);
+	}
+
+	template<class T>
+	inline Matrix<T, 4> MakeOrthographic(T left, T right, T top, T bottom, T znear, T zfar) noexcept
+	{
+		return CreateOrthoMatrix(left, right, top, bottom, znear, zfar);
+	}
+
+	template<class T>
+	inline Matrix<T, 4> MakeOrthographicReversedZ(T left, T right, T top, T bottom, T znear, T zfar) noexcept
+	{
+		assert(zfar != znear);
+
+		return detail::OrthographicOf(left, right, top, bottom, T(1) / (zfar - znear), zfar / (zfar - znear));
+	}
+
+	template<class T>
+	inline Matrix<T, 4> MakePerspective(Degree<T> fovy, T aspectRatio, T znear, T zfar) noexcept
+	{
+		return MakePerspective(Radian<T>(fovy), aspectRatio, znear, zfar);
+	}
+
+	template<class T>
+	inline Matrix<T, 4> MakePerspectiveInfinite(Degree<T> fovy, T aspectRatio, T znear) noexcept
+	{
+		return MakePerspectiveInfinite(Radian<T>(fovy), aspectRatio, znear);
+	}
+
+	template<class T>
+	inline Matrix<T, 4> MakePerspectiveReversedZ(Degree<T> fovy, T aspectRatio, T znear, T zfar) noexcept
+	{
+		return MakePerspectiveReversedZ(Radian<T>(fovy), aspectRatio, znear, zfar);
+	}
+
+	template<class T>
+	inline Matrix<T, 4> MakePerspectiveInfiniteReversedZ(Degree<T> fovy, T aspectRatio, T znear) noexcept
+	{
+		return MakePerspectiveInfiniteReversedZ(Radian<T>(fovy), aspectRatio, znear);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Projection inverses
+//	Closed-form inverses that rely on the sparsity of projection matrices instead of a general inversion.
+namespace Epic
+{
+	// PerspectiveInverseOf - Inverts any perspective projection of the form built above, including
+	//	off-center frusta, reversed-Z and infinite far planes (clip x = X x + cx z, y = Y y + cy z, z = A z + B, w = -z).
+	template<class T>
+	inline Matrix<T, 4> PerspectiveInverseOf(const Matrix<T, 4>& projection) noexcept
+	{
+		const auto& m = projection.Values;
+
+		assert(m[0] != T(0) && m[5] != T(0) && m[14] != T(0));
+		assert(m[11] == T(-1));
+
+		Matrix<T, 4> result = Zero;
+
+		result.Values[0] = T(1) / m[0];
+		result.Values[5] = T(1) / m[5];
+		result.Values[11] = T(1) / m[14];
+		result.Values[12] = m[8] / m[0];
+		result.Values[13] = m[9] / m[5];
+		result.Values[14] = T(-1);
+		result.Values[15] = m[10] / m[14];
+
+		return result;
+	}
+
+	// OrthographicInverseOf - Inverts any axis-aligned orthographic projection
+	template<class T>
+	inline Matrix<T, 4> OrthographicInverseOf(const Matrix<T, 4>& projection) noexcept
+	{
+		const auto& m = projection.Values;
+
+		assert(m[0] != T(0) && m[5] != T(0) && m[10] != T(0));
+		assert(m[15] == T(1));
+
+		Matrix<T, 4> result = Identity;
+
+		result.Values[0] = T(1) / m[0];
+		result.Values[5] = T(1) / m[5];
+		result.Values[10] = T(1) / m[10];
+		result.Values[12] = -m[12] / m[0];
+		result.Values[13] = -m[13] / m[5];
+		result.Values[14] = -m[14] / m[10];
+
+		return result;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Cube map views
+namespace Epic
+{
+	// MakeCubeFaceViewProjections - Writes the view-projections of the six faces of a cube map centered on
+	//	position, in +X, -X, +Y, -Y, +Z, -Z order with the OpenGL face orientations. projection should have a
+	//	90 degree field of view and an aspect ratio of 1. The face views are signed axis permutations,
+	//	so each view-projection is composed by permuting the projection's columns rather than a matrix product.
+	template<class T>
+	inline void MakeCubeFaceViewProjections(const Vector<T, 3>& position, const Matrix<T, 4>& projection, Matrix<T, 4>* pResults) noexcept
+	{
+		// For each face, the world axis and sign behind the view's x, y and z axes (right, up, backward)
+		constexpr size_t Axes[6][3] = { { 2, 1, 0 }, { 2, 1, 0 }, { 0, 2, 1 }, { 0, 2, 1 }, { 0, 1, 2 }, { 0, 1, 2 } };
+		constexpr int Signs[6][3] = { { -1, -1, -1 }, { 1, -1, 1 }, { 1, 1, -1 }, { 1, -1, 1 }, { 1, -1, -1 }, { -1, -1, 1 } };
+
+		const auto& p = projection.Values;
+
+		for (size_t face = 0; face < 6; ++face)
+		{
+			Matrix<T, 4>& result = pResults[face];
+			result = Zero;
+
+			// view = [R | -R position], so projection * view = [P3 R | P3 (-R position) + p3], with P3 the first three
+			//	columns of the projection and p3 its last. Column j of P3 R is sign * P3 column k for R(k, j) = sign.
+			for (size_t k = 0; k < 3; ++k)
+			{
+				const size_t axis = Axes[face][k];
+				const T sign = T(Signs[face][k]);
+				const T offset = -sign * position[axis];
+
+				for (size_t r = 0; r < 4; ++r)
+				{
+					result.Values[axis * 4 + r] = sign * p[k * 4 + r];
+					result.Values[12 + r] += offset * p[k * 4 + r];
+				}
+			}
+
+			for (size_t r = 0; r < 4; ++r)
+				result.Values[12 + r] += p[12 + r];
+		}
+	}
+}
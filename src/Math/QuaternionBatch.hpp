@@ -0,0 +1,333 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "Constants.h"
+#include "../Parallel/BatchBlock.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Batch kernels
+//	Branch-free scalar kernels, inlined into the batch loops below so that they can be auto-vectorized.
+//	The polynomial approximations are accurate to float precision.
+namespace Epic::detail
+{
+	// acos(x) for x in [-1, 1] (Abramowitz & Stegun 4.4.46); absolute error <= 2e-8
+	template<class T>
+	inline T BatchAcos(T x) noexcept
+	{
+		const T ax = std::abs(x);
+
+		T p = T(-0.0012624911);
+		p = p * ax + T(0.0066700901);
+		p = p * ax - T(0.0170881256);
+		p = p * ax + T(0.0308918810);
+		p = p * ax - T(0.0501743046);
+		p = p * ax + T(0.0889789874);
+		p = p * ax - T(0.2145988016);
+		p = p * ax + T(1.5707963050);
+
+		const T r = std::sqrt(std::max(T(1) - ax, T(0))) * p;
+
+		return (x < T(0)) ? Pi<T> - r : r;
+	}
+
+	// sin(x) for x in [0, Pi]; folded onto [0, Pi/2] and evaluated to the x^11 term, absolute error <= 6e-8
+	template<class T>
+	inline T BatchSin(T x) noexcept
+	{
+		x = std::min(x, Pi<T> - x);
+
+		const T x2 = x * x;
+
+		T p = T(-1.0 / 39916800.0);
+		p = p * x2 + T(1.0 / 362880.0);
+		p = p * x2 - T(1.0 / 5040.0);
+		p = p * x2 + T(1.0 / 120.0);
+		p = p * x2 - T(1.0 / 6.0);
+		p = p * x2 + T(1);
+
+		return x * p;
+	}
+
+	template<class T>
+	inline void BatchNormalize(T& x, T& y, T& z, T& w) noexcept
+	{
+		const T invLength = T(1) / std::sqrt(x * x + y * y + z * z + w * w);
+
+		x *= invLength;
+		y *= invLength;
+		z *= invLength;
+		w *= invLength;
+	}
+
+	template<class T>
+	inline void NlerpKernel(
+		T ax, T ay, T az, T aw,
+		T bx, T by, T bz, T bw,
+		T t, T& rx, T& ry, T& rz, T& rw) noexcept
+	{
+		const T s = T(1) - t;
+
+		T x = ax * s + bx * t;
+		T y = ay * s + by * t;
+		T z = az * s + bz * t;
+		T w = aw * s + bw * t;
+
+		BatchNormalize(x, y, z, w);
+
+		rx = x; ry = y; rz = z; rw = w;
+	}
+
+	template<class T>
+	inline void SlerpKernel(
+		T ax, T ay, T az, T aw,
+		T bx, T by, T bz, T bw,
+		T t, T& rx, T& ry, T& rz, T& rw) noexcept
+	{
+		// Below this angle (~0.25 degrees) slerp and nlerp are indistinguishable at float precision
+		constexpr T NlerpThreshold = T(1) - T(1e-5);
+
+		const T dot = std::clamp(ax * bx + ay * by + az * bz + aw * bw, T(-1), T(1));
+		const T theta = BatchAcos(dot);
+		const T invSinTheta = T(1) / std::max(BatchSin(theta), T(Epsilon<T>));
+		const bool isNear = dot > NlerpThreshold;
+
+		// Both weights are always evaluated so that the choice compiles to a select
+		const T sa = BatchSin((T(1) - t) * theta) * invSinTheta;
+		const T sb = BatchSin(t * theta) * invSinTheta;
+
+		const T wa = isNear ? T(1) - t : sa;
+		const T wb = isNear ? t : sb;
+
+		T x = ax * wa + bx * wb;
+		T y = ay * wa + by * wb;
+		T z = az * wa + bz * wb;
+		T w = aw * wa + bw * wb;
+
+		BatchNormalize(x, y, z, w);
+
+		rx = x; ry = y; rz = z; rw = w;
+	}
+
+	// Approximates slerp along the shorter arc with a normalized lerp whose t is remapped by a fitted cubic
+	// (Kapoulkine, "Approximating slerp", 2015). The rotation error is at most 8e-4 radians (0.045 degrees)
+	// for any pair of unit quaternions, compared with 0.14 radians for an uncorrected nlerp.
+	template<class T>
+	inline void SlerpFastKernel(
+		T ax, T ay, T az, T aw,
+		T bx, T by, T bz, T bw,
+		T t, T& rx, T& ry, T& rz, T& rw) noexcept
+	{
+		const T dot = ax * bx + ay * by + az * bz + aw * bw;
+		const T d = std::abs(dot);
+
+		const T A = T(1.0904) + d * (T(-3.2452) + d * (T(3.55645) - d * T(1.43519)));
+		const T B = T(0.848013) + d * (T(-1.06021) + d * T(0.215638));
+
+		const T u = t - T(0.5);
+		const T k = A * u * u + B;
+		const T ot = t + t * u * (t - T(1)) * k;
+
+		const T wa = T(1) - ot;
+		const T wb = (dot < T(0)) ? -ot : ot;
+
+		T x = ax * wa + bx * wb;
+		T y = ay * wa + by * wb;
+		T z = az * wa + bz * wb;
+		T w = aw * wa + bw * wb;
+
+		BatchNormalize(x, y, z, w);
+
+		rx = x; ry = y; rz = z; rw = w;
+	}
+
+	template<class T>
+	inline void SquadKernel(
+		T ax, T ay, T az, T aw,
+		T bx, T by, T bz, T bw,
+		T cx, T cy, T cz, T cw,
+		T dx, T dy, T dz, T dw,
+		T t, T& rx, T& ry, T& rz, T& rw) noexcept
+	{
+		T px, py, pz, pw;
+		T qx, qy, qz, qw;
+
+		SlerpKernel(ax, ay, az, aw, bx, by, bz, bw, t, px, py, pz, pw);
+		SlerpKernel(cx, cy, cz, cw, dx, dy, dz, dw, t, qx, qy, qz, qw);
+		SlerpKernel(px, py, pz, pw, qx, qy, qz, qw, T(2) * t * (T(1) - t), rx, ry, rz, rw);
+	}
+
+	// Stages blocks of the K input arrays and t into local SoA buffers, invokes kernel(inputs, t, outputs, i)
+	// for each lane and copies the results out. Working on local buffers keeps the lane loop free of
+	// aliasing checks (so it vectorizes) and lets results overwrite the inputs.
+	template<size_t K, class T, class Kernel>
+	void QuaternionBatch(const std::array<const T*, 4>(&inputs)[K], T t, const T* pT,
+		const std::array<T*, 4>& result, size_t count, Kernel kernel) noexcept
+	{
+		constexpr size_t BlockSize = BatchBlockSize;
+
+		T in[K][4][BlockSize];
+		T ts[BlockSize];
+		T out[4][BlockSize];
+
+		for (size_t block = 0; block < count; block += BlockSize)
+		{
+			const size_t blockCount = std::min(BlockSize, count - block);
+
+			for (size_t k = 0; k < K; ++k)
+				for (size_t c = 0; c < 4; ++c)
+					std::copy_n(inputs[k][c] + block, blockCount, in[k][c]);
+
+			if (pT)
+				std::copy_n(pT + block, blockCount, ts);
+			else
+				std::fill_n(ts, blockCount, t);
+
+			for (size_t i = 0; i < blockCount; ++i)
+				kernel(in, ts[i], out, i);
+
+			for (size_t c = 0; c < 4; ++c)
+				std::copy_n(out[c], blockCount, result[c] + block);
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Batch interpolation
+//	Quaternions are passed as SoA arrays of { x, y, z, w } components and are expected to be unit length.
+//	Results may be written over any of the inputs. Each function takes either one t shared by every element
+//	or an array of per-element t, which must lie in [0, 1].
+namespace Epic
+{
+	// BatchNlerp - Normalized linear interpolation; matches Quaternion::Lerp.
+	template<class T>
+	void BatchNlerp(const std::array<const T*, 4>& from, const std::array<const T*, 4>& to, T t,
+		const std::array<T*, 4>& result, size_t count) noexcept
+	{
+		detail::QuaternionBatch<2, T>({ from, to }, t, nullptr, result, count, [](const auto& q, T laneT, auto& r, size_t i)
+		{
+			detail::NlerpKernel(
+				q[0][0][i], q[0][1][i], q[0][2][i], q[0][3][i],
+				q[1][0][i], q[1][1][i], q[1][2][i], q[1][3][i],
+				laneT, r[0][i], r[1][i], r[2][i], r[3][i]);
+		});
+	}
+
+	template<class T>
+	void BatchNlerp(const std::array<const T*, 4>& from, const std::array<const T*, 4>& to, const T* pT,
+		const std::array<T*, 4>& result, size_t count) noexcept
+	{
+		detail::QuaternionBatch<2, T>({ from, to }, T(0), pT, result, count, [](const auto& q, T laneT, auto& r, size_t i)
+		{
+			detail::NlerpKernel(
+				q[0][0][i], q[0][1][i], q[0][2][i], q[0][3][i],
+				q[1][0][i], q[1][1][i], q[1][2][i], q[1][3][i],
+				laneT, r[0][i], r[1][i], r[2][i], r[3][i]);
+		});
+	}
+
+	// BatchSlerp - Spherical linear interpolation; matches Quaternion::Slerp to within 1e-5.
+	//	acos and sin are replaced by polynomials so that the loop carries no library calls.
+	template<class T>
+	void BatchSlerp(const std::array<const T*, 4>& from, const std::array<const T*, 4>& to, T t,
+		const std::array<T*, 4>& result, size_t count) noexcept
+	{
+		detail::QuaternionBatch<2, T>({ from, to }, t, nullptr, result, count, [](const auto& q, T laneT, auto& r, size_t i)
+		{
+			detail::SlerpKernel(
+				q[0][0][i], q[0][1][i], q[0][2][i], q[0][3][i],
+				q[1][0][i], q[1][1][i], q[1][2][i], q[1][3][i],
+				laneT, r[0][i], r[1][i], r[2][i], r[3][i]);
+		});
+	}
+
+	template<class T>
+	void BatchSlerp(const std::array<const T*, 4>& from, const std::array<const T*, 4>& to, const T* pT,
+		const std::array<T*, 4>& result, size_t count) noexcept
+	{
+		detail::QuaternionBatch<2, T>({ from, to }, T(0), pT, result, count, [](const auto& q, T laneT, auto& r, size_t i)
+		{
+			detail::SlerpKernel(
+				q[0][0][i], q[0][1][i], q[0][2][i], q[0][3][i],
+				q[1][0][i], q[1][1][i], q[1][2][i], q[1][3][i],
+				laneT, r[0][i], r[1][i], r[2][i], r[3][i]);
+		});
+	}
+
+	// BatchSlerpFast - Approximate spherical linear interpolation along the shorter arc; matches Quaternion::SlerpFast.
+	template<class T>
+	void BatchSlerpFast(const std::array<const T*, 4>& from, const std::array<const T*, 4>& to, T t,
+		const std::array<T*, 4>& result, size_t count) noexcept
+	{
+		detail::QuaternionBatch<2, T>({ from, to }, t, nullptr, result, count, [](const auto& q, T laneT, auto& r, size_t i)
+		{
+			detail::SlerpFastKernel(
+				q[0][0][i], q[0][1][i], q[0][2][i], q[0][3][i],
+				q[1][0][i], q[1][1][i], q[1][2][i], q[1][3][i],
+				laneT, r[0][i], r[1][i], r[2][i], r[3][i]);
+		});
+	}
+
+	template<class T>
+	void BatchSlerpFast(const std::array<const T*, 4>& from, const std::array<const T*, 4>& to, const T* pT,
+		const std::array<T*, 4>& result, size_t count) noexcept
+	{
+		detail::QuaternionBatch<2, T>({ from, to }, T(0), pT, result, count, [](const auto& q, T laneT, auto& r, size_t i)
+		{
+			detail::SlerpFastKernel(
+				q[0][0][i], q[0][1][i], q[0][2][i], q[0][3][i],
+				q[1][0][i], q[1][1][i], q[1][2][i], q[1][3][i],
+				laneT, r[0][i], r[1][i], r[2][i], r[3][i]);
+		});
+	}
+
+	// BatchSquad - Spherical quadrangle interpolation; matches Quaternion::Squad.
+	template<class T>
+	void BatchSquad(const std::array<const T*, 4>& from, const std::array<const T*, 4>& to,
+		const std::array<const T*, 4>& a, const std::array<const T*, 4>& b, T t,
+		const std::array<T*, 4>& result, size_t count) noexcept
+	{
+		detail::QuaternionBatch<4, T>({ from, to, a, b }, t, nullptr, result, count, [](const auto& q, T laneT, auto& r, size_t i)
+		{
+			detail::SquadKernel(
+				q[0][0][i], q[0][1][i], q[0][2][i], q[0][3][i],
+				q[1][0][i], q[1][1][i], q[1][2][i], q[1][3][i],
+				q[2][0][i], q[2][1][i], q[2][2][i], q[2][3][i],
+				q[3][0][i], q[3][1][i], q[3][2][i], q[3][3][i],
+				laneT, r[0][i], r[1][i], r[2][i], r[3][i]);
+		});
+	}
+
+	template<class T>
+	void BatchSquad(const std::array<const T*, 4>& from, const std::array<const T*, 4>& to,
+		const std::array<const T*, 4>& a, const std::array<const T*, 4>& b, const T* pT,
+		const std::array<T*, 4>& result, size_t count) noexcept
+	{
+		detail::QuaternionBatch<4, T>({ from, to, a, b }, T(0), pT, result, count, [](const auto& q, T laneT, auto& r, size_t i)
+		{
+			detail::SquadKernel(
+				q[0][0][i], q[0][1][i], q[0][2][i], q[0][3][i],
+				q[1][0][i], q[1][1][i], q[1][2][i], q[1][3][i],
+				q[2][0][i], q[2][1][i], q[2][2][i], q[2][3][i],
+				q[3][0][i], q[3][1][i], q[3][2][i], q[3][3][i],
+				laneT, r[0][i], r[1][i], r[2][i], r[3][i]);
+		});
+	}
+}
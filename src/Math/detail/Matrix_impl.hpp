@@ -56,13 +56,13 @@ public:
 	Matrix(const ZeroesTag&) noexcept
 	{ 
 		for (size_t n = 0; n < ElementCount; ++n)
-			at(n) = T(0);
+			Values[n] = T(0);
 	}
 
 	Matrix(const OnesTag&) noexcept
 	{
 		for (size_t n = 0; n < ElementCount; ++n)
-			at(n) = T(1);
+			Values[n] = T(1);
 	}
 
 	Matrix(const IdentityTag&) noexcept
@@ -262,7 +262,7 @@ public:
 	constexpr Matrix& Fill(T value) noexcept
 	{
 		for (size_t n = 0; n < ElementCount; ++n)
-			at(n) = value;
+			Values[n] = value;
 
 		return *this;
 	}
@@ -270,10 +270,10 @@ public:
 	constexpr Matrix& MakeIdentity() noexcept
 	{
 		for (size_t n = 0; n < ElementCount; ++n)
-			at(n) = T(0);
+			Values[n] = T(0);
 
 		for (size_t n = 0; n < ColumnCount; ++n)
-			at(ColumnCount * n + n) = T(1);
+			Values[column_type::Size * n + n] = T(1);
 
 		return *this;
 	}
@@ -292,7 +292,7 @@ public:
 	}
 
 	template<typename EnabledFor4x4 = std::enable_if_t<(N == 4)>>
-	Matrix& MakeTRS(Vector<T, 2> translation, Quaternion<T> rotation, Vector<T, 3> scale) noexcept
+	Matrix& MakeTRS(Vector<T, 3> translation, Quaternion<T> rotation, Vector<T, 3> scale) noexcept
 	{
 		MakeRotation(std::move(rotation));
 
@@ -300,7 +300,9 @@ public:
 		Columns[1] *= scale.y;
 		Columns[2] *= scale.z;
 
-		Columns[3] = std::move(translation);
+		Columns[3].x = translation.x;
+		Columns[3].y = translation.y;
+		Columns[3].z = translation.z;
 
 		return *this;
 	}
@@ -506,56 +508,60 @@ public:
 	template<typename EnabledFor3x3OrGreater = std::enable_if_t<(N >= 3)>>
 	Quaternion<T> ToQuaternion() const noexcept
 	{
-		const auto trace = Trace();
+		Quaternion<T> result;
+
+		const auto trace = T(1) + Columns[0][0] + Columns[1][1] + Columns[2][2];
 
 		if (trace > T(0.000001))
 		{
 			const auto sqt = std::sqrt(trace) * T(2);
 
-			return
-			{
+			result.Reset
+			(
 				(Columns[1][2] - Columns[2][1]) / sqt,
 				(Columns[2][0] - Columns[0][2]) / sqt,
 				(Columns[0][1] - Columns[1][0]) / sqt,
 				sqt / T(4)
-			};
+			);
 		}
 		else if (Columns[0][0] > Columns[1][1] && Columns[0][0] > Columns[2][2])
 		{
 			const auto sqt = std::sqrt(T(1) + Columns[0][0] - Columns[1][1] - Columns[2][2]) * T(2);
 
-			return
-			{
+			result.Reset
+			(
 				sqt / T(4),
 				(Columns[0][1] + Columns[1][0]) / sqt,
 				(Columns[2][0] + Columns[0][2]) / sqt,
-				(Columns[1][2] + Columns[2][1]) / sqt
-			};
+				(Columns[1][2] - Columns[2][1]) / sqt
+			);
 		}
 		else if (Columns[1][1] > Columns[2][2])
 		{
 			const auto sqt = std::sqrt(T(1) + Columns[1][1] - Columns[0][0] - Columns[2][2]) * T(2);
 
-			return
-			{
+			result.Reset
+			(
 				(Columns[0][1] + Columns[1][0]) / sqt,
 				sqt / T(4),
 				(Columns[1][2] + Columns[2][1]) / sqt,
-				(Columns[2][0] + Columns[0][2]) / sqt
-			};
+				(Columns[2][0] - Columns[0][2]) / sqt
+			);
 		}
 		else
 		{
 			const auto sqt = std::sqrt(T(1) + Columns[2][2] - Columns[0][0] - Columns[1][1]) * T(2);
 
-			return
-			{
+			result.Reset
+			(
 				(Columns[2][0] + Columns[0][2]) / sqt,
 				(Columns[1][2] + Columns[2][1]) / sqt,
 				sqt / T(4),
-				(Columns[0][1] + Columns[1][0]) / sqt
-			};
+				(Columns[0][1] - Columns[1][0]) / sqt
+			);
 		}
+
+		return result;
 	}
 
 public:
@@ -604,6 +610,44 @@ public:
 		return *this;
 	}
 
+	// Gram-Schmidt orthonormalization of the rotation columns (the upper 3x3 of a 4x4 matrix).
+	// Removes scale and shear; the first column keeps its direction.
+	Matrix& Orthonormalize() noexcept
+	{
+		constexpr size_t K = (ColumnCount == 4) ? 3 : ColumnCount;
+
+		for (size_t i = 0; i < K; ++i)
+		{
+			T* pColumn = &Values[i * column_type::Size];
+
+			for (size_t j = 0; j < i; ++j)
+			{
+				const T* pBasis = &Values[j * column_type::Size];
+
+				T dot = T(0);
+				for (size_t k = 0; k < K; ++k)
+					dot += pColumn[k] * pBasis[k];
+
+				for (size_t k = 0; k < K; ++k)
+					pColumn[k] -= dot * pBasis[k];
+			}
+
+			T lengthSq = T(0);
+			for (size_t k = 0; k < K; ++k)
+				lengthSq += pColumn[k] * pColumn[k];
+
+			if (lengthSq > T(0))
+			{
+				const T scale = T(1) / std::sqrt(lengthSq);
+
+				for (size_t k = 0; k < K; ++k)
+					pColumn[k] *= scale;
+			}
+		}
+
+		return *this;
+	}
+
 	Matrix& InvertRigid() noexcept
 	{
 		return TransposeInvertRigid().Transpose();
@@ -796,6 +840,11 @@ public:
 		return Matrix(mat).Transpose();
 	}
 
+	static Matrix OrthonormalOf(const Matrix& mat) noexcept
+	{
+		return Matrix(mat).Orthonormalize();
+	}
+
 	static Matrix RigidInverseOf(const Matrix& mat) noexcept
 	{
 		return Matrix(mat).InvertRigid();
@@ -25,6 +25,7 @@
 
 #include "../Angle.h"
 #include "../Constants.h"
+#include "../QuaternionBatch.hpp"
 #include "../Tags.h"
 #include "../Vector.h"
 
@@ -456,6 +457,21 @@ public:
 		return ((std::move(from) * thetaFrom.Sin()) + (std::move(to) * thetaTo.Sin())) / theta.Sin();
 	}
 
+	// SlerpFast - Approximates Slerp along the shorter arc without acos or sin.
+	// t is remapped by a fitted cubic before a normalized lerp; the result is within 8e-4 radians
+	// (0.045 degrees) of the exact rotation for any pair of unit quaternions and any t in [0, 1].
+	static auto SlerpFast(Quaternion from, Quaternion to, T t) noexcept
+	{
+		Quaternion result;
+
+		detail::SlerpFastKernel(
+			from.x, from.y, from.z, from.w,
+			to.x, to.y, to.z, to.w,
+			t, result.x, result.y, result.z, result.w);
+
+		return result;
+	}
+
 	static auto Squad(Quaternion from, Quaternion to, Quaternion a, Quaternion b, T t) noexcept
 	{
 		return Slerp(Slerp(std::move(from), std::move(to), t), Slerp(std::move(a), std::move(b), t), T(2) * t * (T(1) - t));
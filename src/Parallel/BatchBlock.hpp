@@ -0,0 +1,26 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+//////////////////////////////////////////////////////////////////////////////
+
+// BatchBlockSize
+namespace Epic::detail
+{
+	// The number of lanes the batch kernels stage into local SoA buffers at a time.
+	//	Small enough for the buffers to stay in L1 and on the stack, large enough to amortize the staging loops.
+	constexpr size_t BatchBlockSize = 64;
+}
@@ -0,0 +1,86 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////////////
+
+// ParallelChunkCount
+namespace Epic
+{
+	// ParallelChunkCount - Calculates the number of chunks [0..count) will be split into for a given grain size.
+	inline size_t ParallelChunkCount(size_t count, size_t grainSize) noexcept
+	{
+		grainSize = std::max(grainSize, size_t(1));
+
+		return (count + grainSize - 1) / grainSize;
+	}
+
+	// ParallelGrainSize - Calculates a grain size that splits [0..count) into a few chunks per hardware thread.
+	inline size_t ParallelGrainSize(size_t count, size_t minGrainSize = 1024) noexcept
+	{
+		const size_t threads = std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+		const size_t target = (count + (threads * 4) - 1) / (threads * 4);
+
+		return std::max(target, std::max(minGrainSize, size_t(1)));
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// ParallelFor
+namespace Epic
+{
+	// ParallelForChunks - Invokes fn(chunk, begin, end) for each grain-sized chunk of [first..last).
+	// Chunks may run concurrently; a single chunk is always invoked on the calling thread.
+	template<class Function>
+	inline void ParallelForChunks(size_t first, size_t last, size_t grainSize, Function fn)
+	{
+		if (last <= first)
+			return;
+
+		grainSize = std::max(grainSize, size_t(1));
+
+		const size_t chunkCount = ParallelChunkCount(last - first, grainSize);
+
+		if (chunkCount == 1)
+		{
+			fn(size_t(0), first, last);
+			return;
+		}
+
+		std::vector<size_t> chunks(chunkCount);
+		std::iota(std::begin(chunks), std::end(chunks), size_t(0));
+
+		std::for_each(std::execution::par, std::begin(chunks), std::end(chunks), [&](size_t chunk)
+		{
+			const size_t begin = first + (chunk * grainSize);
+			const size_t end = std::min(begin + grainSize, last);
+
+			fn(chunk, begin, end);
+		});
+	}
+
+	// ParallelFor - Invokes fn(begin, end) for each grain-sized chunk of [first..last).
+	template<class Function>
+	inline void ParallelFor(size_t first, size_t last, size_t grainSize, Function fn)
+	{
+		ParallelForChunks(first, last, grainSize, [&](size_t, size_t begin, size_t end) { fn(begin, end); });
+	}
+}
@@ -0,0 +1,160 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "ParallelFor.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// ParallelRadixSort
+namespace Epic
+{
+	// ParallelRadixSort - Stable LSD radix sort of unsigned integer keys, 8 bits per pass.
+	// Values are permuted alongside their keys. Each pass histograms and scatters in parallel chunks;
+	// passes in which every key shares the same digit are skipped.
+	template<class Key, class Value>
+	void ParallelRadixSort(Key* pKeys, Value* pValues, size_t count)
+	{
+		static_assert(std::is_unsigned_v<Key>, "ParallelRadixSort requires unsigned integer keys.");
+
+		constexpr size_t RadixBits = 8;
+		constexpr size_t RadixSize = size_t(1) << RadixBits;
+		constexpr size_t PassCount = (sizeof(Key) * 8) / RadixBits;
+
+		if (count < 2)
+			return;
+
+		const size_t threads = std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+		const size_t grainSize = std::max((count + threads - 1) / threads, size_t(16384));
+		const size_t chunkCount = ParallelChunkCount(count, grainSize);
+
+		std::vector<Key> keyBuffer(count);
+		std::vector<Value> valueBuffer(count);
+		std::vector<size_t> counts(chunkCount * RadixSize);
+
+		Key* pSrcKeys = pKeys;
+		Key* pDestKeys = keyBuffer.data();
+		Value* pSrcValues = pValues;
+		Value* pDestValues = valueBuffer.data();
+
+		for (size_t pass = 0; pass < PassCount; ++pass)
+		{
+			const size_t shift = pass * RadixBits;
+
+			std::fill(std::begin(counts), std::end(counts), size_t(0));
+
+			ParallelForChunks(0, count, grainSize, [&](size_t chunk, size_t begin, size_t end)
+			{
+				size_t* pCounts = &counts[chunk * RadixSize];
+
+				for (size_t i = begin; i < end; ++i)
+					++pCounts[(pSrcKeys[i] >> shift) & (RadixSize - 1)];
+			});
+
+			// Convert the histograms into scatter offsets (digit-major, chunk-minor keeps the sort stable)
+			bool isTrivialPass = false;
+			size_t offset = 0;
+
+			for (size_t digit = 0; digit < RadixSize; ++digit)
+			{
+				const size_t digitStart = offset;
+
+				for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+				{
+					size_t& slot = counts[chunk * RadixSize + digit];
+					const size_t chunkDigitCount = slot;
+
+					slot = offset;
+					offset += chunkDigitCount;
+				}
+
+				if (offset - digitStart == count)
+					isTrivialPass = true;
+			}
+
+			if (isTrivialPass)
+				continue;
+
+			ParallelForChunks(0, count, grainSize, [&](size_t chunk, size_t begin, size_t end)
+			{
+				size_t* pOffsets = &counts[chunk * RadixSize];
+
+				for (size_t i = begin; i < end; ++i)
+				{
+					const size_t dest = pOffsets[(pSrcKeys[i] >> shift) & (RadixSize - 1)]++;
+
+					pDestKeys[dest] = pSrcKeys[i];
+					pDestValues[dest] = pSrcValues[i];
+				}
+			});
+
+			std::swap(pSrcKeys, pDestKeys);
+			std::swap(pSrcValues, pDestValues);
+		}
+
+		if (pSrcKeys != pKeys)
+		{
+			std::copy(pSrcKeys, pSrcKeys + count, pKeys);
+			std::copy(pSrcValues, pSrcValues + count, pValues);
+		}
+	}
+
+	// ParallelRadixSortIndices - Sorts keys and writes the sorting permutation (sorted position -> source index).
+	template<class Key, class Index>
+	void ParallelRadixSortIndices(Key* pKeys, Index* pIndices, size_t count)
+	{
+		static_assert(std::is_unsigned_v<Index>, "ParallelRadixSortIndices requires unsigned integer indices.");
+
+		ParallelFor(0, count, ParallelGrainSize(count, 65536), [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+				pIndices[i] = static_cast<Index>(i);
+		});
+
+		ParallelRadixSort(pKeys, pIndices, count);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// ParallelGather
+namespace Epic
+{
+	// ParallelGather - Writes pDest[i] = pSrc[pIndices[i]]; used to reorder SoA arrays by a sort permutation.
+	template<class T, class Index>
+	void ParallelGather(const Index* pIndices, size_t count, const T* pSrc, T* pDest)
+	{
+		ParallelFor(0, count, ParallelGrainSize(count, 16384), [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+				pDest[i] = pSrc[pIndices[i]];
+		});
+	}
+
+	// ParallelGather - Reorders a vector in place by a sort permutation.
+	template<class T, class Index>
+	void ParallelGather(const Index* pIndices, std::vector<T>& values)
+	{
+		std::vector<T> result(values.size());
+
+		ParallelGather(pIndices, values.size(), values.data(), result.data());
+
+		values.swap(result);
+	}
+}
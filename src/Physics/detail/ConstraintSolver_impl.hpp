@@ -0,0 +1,867 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ConstraintSolver_decl.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "../../Math/Matrix.h"
+#include "../../Math/Quaternion.h"
+#include "../../Math/Vector.h"
+#include "../../Parallel/ParallelFor.hpp"
+#include "../RigidBodySet.h"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Constraint rows and batches
+namespace Epic::detail
+{
+	// ConstraintRow - One scalar velocity constraint between two bodies:
+	//	Cdot = Linear . (vB - vA) + AngularB . wB - AngularA . wA
+	//	The accumulated impulse is clamped to [Lower - Friction * r, Upper + Friction * r], where r is the
+	//	impulse of the Reference row; friction rows reference the normal row of their contact.
+	template<class T>
+	struct ConstraintRow
+	{
+		std::uint32_t BodyA;
+		std::uint32_t BodyB;
+		std::uint32_t Reference;
+
+		T Linear[3];
+		T AngularA[3];
+		T AngularB[3];
+
+		// inverse(I) * Angular in world space
+		T InertiaA[3];
+		T InertiaB[3];
+
+		// The inverse of the effective mass J * inverse(M) * transpose(J)
+		T Mass;
+		T Bias;
+		T Lower;
+		T Upper;
+		T Friction;
+		T Impulse;
+	};
+
+	// ConstraintBatch - Up to W rows that share no dynamic body, stored lane by lane.
+	//	Body indices are local to the island being solved; unused lanes refer to a padding body.
+	//	References index the impulses of the whole island.
+	template<class T, size_t W>
+	struct ConstraintBatch
+	{
+		std::uint32_t BodyA[W];
+		std::uint32_t BodyB[W];
+		std::uint32_t Reference[W];
+
+		T Linear[3][W];
+		T AngularA[3][W];
+		T AngularB[3][W];
+		T InertiaA[3][W];
+		T InertiaB[3][W];
+
+		T Mass[W];
+		T Bias[W];
+		T Lower[W];
+		T Upper[W];
+		T Friction[W];
+	};
+
+	// ConstraintBodies - The velocities of the bodies in one island, indexed locally
+	template<class T>
+	struct ConstraintBodies
+	{
+		std::array<std::vector<T>, 3> LinearVelocities;
+		std::array<std::vector<T>, 3> AngularVelocities;
+		std::vector<T> InverseMasses;
+
+		void Resize(size_t count)
+		{
+			for (size_t k = 0; k < 3; ++k)
+			{
+				LinearVelocities[k].assign(count, T(0));
+				AngularVelocities[k].assign(count, T(0));
+			}
+
+			InverseMasses.assign(count, T(0));
+		}
+	};
+
+	// Applies the impulse change of every lane to its bodies
+	template<class T, size_t W>
+	inline void ApplyConstraintImpulses(const ConstraintBatch<T, W>& batch, const T(&delta)[W], ConstraintBodies<T>& bodies) noexcept
+	{
+		T* v[3] = { bodies.LinearVelocities[0].data(), bodies.LinearVelocities[1].data(), bodies.LinearVelocities[2].data() };
+		T* w[3] = { bodies.AngularVelocities[0].data(), bodies.AngularVelocities[1].data(), bodies.AngularVelocities[2].data() };
+		const T* invMasses = bodies.InverseMasses.data();
+
+		for (size_t lane = 0; lane < W; ++lane)
+		{
+			const std::uint32_t a = batch.BodyA[lane];
+			const std::uint32_t b = batch.BodyB[lane];
+			const T ma = invMasses[a] * delta[lane];
+			const T mb = invMasses[b] * delta[lane];
+
+			for (size_t k = 0; k < 3; ++k)
+			{
+				v[k][a] -= batch.Linear[k][lane] * ma;
+				w[k][a] -= batch.InertiaA[k][lane] * delta[lane];
+				v[k][b] += batch.Linear[k][lane] * mb;
+				w[k][b] += batch.InertiaB[k][lane] * delta[lane];
+			}
+		}
+	}
+
+	// One projected Gauss-Seidel step over the batch whose impulses start at pImpulses[base].
+	// The lanes are independent, so the loops run W rows at once.
+	template<class T, size_t W>
+	inline void SolveConstraintBatch(const ConstraintBatch<T, W>& batch, T* pImpulses, size_t base, ConstraintBodies<T>& bodies) noexcept
+	{
+		const T* v[3] = { bodies.LinearVelocities[0].data(), bodies.LinearVelocities[1].data(), bodies.LinearVelocities[2].data() };
+		const T* w[3] = { bodies.AngularVelocities[0].data(), bodies.AngularVelocities[1].data(), bodies.AngularVelocities[2].data() };
+
+		T delta[W];
+
+		for (size_t lane = 0; lane < W; ++lane)
+		{
+			const std::uint32_t a = batch.BodyA[lane];
+			const std::uint32_t b = batch.BodyB[lane];
+
+			T cdot = T(0);
+
+			for (size_t k = 0; k < 3; ++k)
+			{
+				cdot += batch.Linear[k][lane] * (v[k][b] - v[k][a]);
+				cdot += batch.AngularB[k][lane] * w[k][b] - batch.AngularA[k][lane] * w[k][a];
+			}
+
+			const T reference = pImpulses[batch.Reference[lane]];
+			const T lower = batch.Lower[lane] - batch.Friction[lane] * reference;
+			const T upper = batch.Upper[lane] + batch.Friction[lane] * reference;
+			const T previous = pImpulses[base + lane];
+			const T next = std::clamp(previous - batch.Mass[lane] * (cdot + batch.Bias[lane]), lower, upper);
+
+			pImpulses[base + lane] = next;
+			delta[lane] = next - previous;
+		}
+
+		ApplyConstraintImpulses(batch, delta, bodies);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// ConstraintSolver
+//	A sequential impulse solver for contacts (with friction), ball-socket joints and hinge joints.
+//	Every constraint is reduced to scalar rows. Solve() splits the rows into islands of connected dynamic
+//	bodies and solves the islands in parallel. Within an island the rows are graph colored so that rows
+//	of one color share no dynamic body, then packed BatchWidth at a time into lane-wise batches that are
+//	solved as one unit. Contact impulses are cached by key and joint impulses kept on the joint, so that
+//	each Solve() can warm start from the previous one.
+template<class T>
+class Epic::ConstraintSolver
+{
+	static_assert(std::is_floating_point_v<T>, "ConstraintSolver requires floating point state.");
+
+public:
+	using type = Epic::ConstraintSolver<T>;
+	using value_type = T;
+	using body_set_type = Epic::RigidBodySet<T>;
+	using body_type = typename body_set_type::body_type;
+	using joint_type = std::uint32_t;
+	using key_type = std::uint64_t;
+	using vector_type = Epic::Vector<T, 3>;
+	using quaternion_type = Epic::Quaternion<T>;
+	using matrix_type = Epic::Matrix<T, 3>;
+
+	static constexpr size_t BatchWidth = 8;
+
+	// Settings - Solver iterations and position error correction
+	//	Baumgarte is the fraction of the position error fed back into the velocities per step.
+	//	Contacts penetrating by less than Slop are not pushed apart.
+	struct Settings
+	{
+		size_t Iterations = 8;
+		T Baumgarte = T(0.2);
+		T Slop = T(0.005);
+		bool WarmStart = true;
+	};
+
+private:
+	using row_type = detail::ConstraintRow<T>;
+	using batch_type = detail::ConstraintBatch<T, BatchWidth>;
+	using bodies_type = detail::ConstraintBodies<T>;
+
+	static constexpr std::uint32_t InvalidIndex = ~std::uint32_t(0);
+	static constexpr size_t ColorCount = 64;
+
+	enum class JointType : std::uint8_t
+	{
+		BallSocket,
+		Hinge
+	};
+
+	struct Contact
+	{
+		body_type BodyA;
+		body_type BodyB;
+		vector_type Point;
+		vector_type Normal;
+		T Depth;
+		T Friction;
+		key_type Key;
+	};
+
+	struct Joint
+	{
+		JointType Type;
+		body_type BodyA;
+		body_type BodyB;
+		vector_type LocalAnchorA;
+		vector_type LocalAnchorB;
+		vector_type LocalAxisA;
+		vector_type LocalAxisB;
+		std::array<T, 5> Impulses;
+	};
+
+	// The mass properties of one body while its rows are built
+	struct BodyFrame
+	{
+		vector_type Position;
+		quaternion_type Orientation;
+		matrix_type InverseInertia;
+		T InverseMass;
+	};
+
+	// Per-thread scratch for solving islands
+	struct IslandScratch
+	{
+		bodies_type Bodies;
+		std::vector<body_type> Globals;
+		std::vector<std::uint32_t> Locals;
+		std::vector<std::uint64_t> Masks;
+		std::vector<std::uint32_t> Colors;
+		std::vector<std::uint32_t> Ordered;
+		std::vector<size_t> ColorStart;
+		std::vector<batch_type> Batches;
+		std::vector<T> Impulses;
+	};
+
+private:
+	Settings m_Settings;
+
+	std::vector<Contact> m_Contacts;
+	std::vector<Joint> m_Joints;
+	std::unordered_map<key_type, std::array<T, 3>> m_ContactCache;
+
+	// Scratch of the last Solve()
+	std::vector<row_type> m_Rows;
+	std::vector<std::uint32_t> m_ContactRows;
+	std::vector<std::uint32_t> m_JointRows;
+	std::vector<std::uint32_t> m_RowSlots;
+	std::vector<std::uint32_t> m_LocalBodies;
+	std::vector<std::uint32_t> m_IslandOf;
+	std::vector<std::uint32_t> m_IslandRows;
+	std::vector<size_t> m_IslandStart;
+	std::vector<size_t> m_IslandBatchCounts;
+
+public:
+	ConstraintSolver() noexcept = default;
+
+	explicit ConstraintSolver(const Settings& settings) noexcept
+		: m_Settings{ settings }
+	{ }
+
+	ConstraintSolver(const ConstraintSolver&) = default;
+	ConstraintSolver(ConstraintSolver&&) noexcept = default;
+	~ConstraintSolver() = default;
+
+	ConstraintSolver& operator = (const ConstraintSolver&) = default;
+	ConstraintSolver& operator = (ConstraintSolver&&) noexcept = default;
+
+public:
+	const Settings& GetSettings() const noexcept { return m_Settings; }
+	void SetSettings(const Settings& settings) noexcept { m_Settings = settings; }
+
+	size_t ContactCount() const noexcept { return m_Contacts.size(); }
+	size_t JointCount() const noexcept { return m_Joints.size(); }
+
+	// The number of islands solved by the last Solve()
+	size_t IslandCount() const noexcept { return m_IslandStart.empty() ? 0 : m_IslandStart.size() - 1; }
+
+	// The number of batches solved per iteration by the last Solve()
+	size_t BatchCount() const noexcept
+	{
+		size_t result = 0;
+
+		for (const size_t count : m_IslandBatchCounts)
+			result += count;
+
+		return result;
+	}
+
+	// Removes every constraint and forgets the cached contact impulses
+	void Clear() noexcept
+	{
+		m_Contacts.clear();
+		m_Joints.clear();
+		m_ContactCache.clear();
+	}
+
+public:
+	// Adds a contact for the next Solve(). normal points from bodyA to bodyB and depth is the penetration.
+	// Contacts with the same non-zero key in consecutive Solve() calls are warm started from each other.
+	void AddContact(body_type bodyA, body_type bodyB, const vector_type& point, const vector_type& normal,
+		T depth, T friction, key_type key = 0)
+	{
+		assert(bodyA != bodyB);
+		assert(friction >= T(0));
+
+		m_Contacts.push_back(Contact{ bodyA, bodyB, point, normal, depth, friction, key });
+	}
+
+	// Removes the contacts added since the last Solve(); Solve() does this itself
+	void ClearContacts() noexcept
+	{
+		m_Contacts.clear();
+	}
+
+	// Joins two bodies at a world space anchor, letting them rotate freely about it
+	joint_type AddBallSocket(const body_set_type& bodies, body_type bodyA, body_type bodyB, const vector_type& anchor)
+	{
+		return AddJoint(bodies, JointType::BallSocket, bodyA, bodyB, anchor, vector_type{ T(1), T(0), T(0) });
+	}
+
+	// Joins two bodies at a world space anchor, letting them rotate only about a world space axis
+	joint_type AddHinge(const body_set_type& bodies, body_type bodyA, body_type bodyB, const vector_type& anchor, const vector_type& axis)
+	{
+		return AddJoint(bodies, JointType::Hinge, bodyA, bodyB, anchor, axis);
+	}
+
+	void ClearJoints() noexcept
+	{
+		m_Joints.clear();
+	}
+
+public:
+	// Solves every constraint for the velocities of bodies, then clears the contacts.
+	// Call between RigidBodySet::IntegrateVelocities() and RigidBodySet::IntegratePositions().
+	void Solve(body_set_type& bodies, T dt)
+	{
+		assert(dt > T(0));
+
+		BuildRows(bodies, dt);
+		BuildIslands(bodies);
+
+		const size_t islandCount = IslandCount();
+
+		m_IslandBatchCounts.assign(islandCount, 0);
+		m_RowSlots.resize(m_Rows.size());
+		m_LocalBodies.resize(bodies.Size());
+
+		ParallelFor(0, islandCount, 1, [&](size_t begin, size_t end)
+		{
+			IslandScratch scratch;
+
+			for (size_t island = begin; island < end; ++island)
+				SolveIsland(bodies, island, scratch);
+		});
+
+		StoreImpulses();
+
+		m_Contacts.clear();
+	}
+
+private:
+	joint_type AddJoint(const body_set_type& bodies, JointType jointType, body_type bodyA, body_type bodyB,
+		const vector_type& anchor, const vector_type& axis)
+	{
+		assert(bodyA != bodyB);
+
+		const auto inverseA = quaternion_type::ConjugateOf(bodies.Orientation(bodyA));
+		const auto inverseB = quaternion_type::ConjugateOf(bodies.Orientation(bodyB));
+
+		Joint joint{ jointType, bodyA, bodyB, anchor - bodies.Position(bodyA), anchor - bodies.Position(bodyB), axis, axis, {} };
+
+		inverseA.Transform(joint.LocalAnchorA);
+		inverseB.Transform(joint.LocalAnchorB);
+		inverseA.Transform(joint.LocalAxisA);
+		inverseB.Transform(joint.LocalAxisB);
+
+		joint.LocalAxisA.Normalize();
+		joint.LocalAxisB.Normalize();
+
+		m_Joints.push_back(joint);
+
+		return static_cast<joint_type>(m_Joints.size() - 1);
+	}
+
+	static BodyFrame FrameOf(const body_set_type& bodies, body_type body) noexcept
+	{
+		return BodyFrame{ bodies.Position(body), bodies.Orientation(body), bodies.WorldInverseInertia(body), bodies.InverseMass(body) };
+	}
+
+	static vector_type Rotate(const quaternion_type& rotation, vector_type vec) noexcept
+	{
+		rotation.Transform(vec);
+		return vec;
+	}
+
+	// A unit vector perpendicular to the unit vector n
+	static vector_type PerpendicularOf(const vector_type& n) noexcept
+	{
+		vector_type result = (std::abs(n[0]) > T(0.57)) ? vector_type{ n[1], -n[0], T(0) } : vector_type{ T(0), n[2], -n[1] };
+		return result.Normalize();
+	}
+
+	void AddRow(body_type bodyA, body_type bodyB, const BodyFrame& a, const BodyFrame& b,
+		const vector_type& linear, const vector_type& angularA, const vector_type& angularB,
+		T bias, T lower, T upper, T friction, std::uint32_t reference, T impulse)
+	{
+		const vector_type inertiaA = a.InverseInertia * angularA;
+		const vector_type inertiaB = b.InverseInertia * angularB;
+
+		row_type row;
+
+		row.BodyA = bodyA;
+		row.BodyB = bodyB;
+		row.Reference = (reference == InvalidIndex) ? static_cast<std::uint32_t>(m_Rows.size()) : reference;
+
+		T k = (a.InverseMass + b.InverseMass) * linear.Dot(linear);
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			row.Linear[i] = linear[i];
+			row.AngularA[i] = angularA[i];
+			row.AngularB[i] = angularB[i];
+			row.InertiaA[i] = inertiaA[i];
+			row.InertiaB[i] = inertiaB[i];
+
+			k += angularA[i] * inertiaA[i] + angularB[i] * inertiaB[i];
+		}
+
+		row.Mass = (k > T(0)) ? T(1) / k : T(0);
+		row.Bias = bias;
+		row.Lower = lower;
+		row.Upper = upper;
+		row.Friction = friction;
+		row.Impulse = m_Settings.WarmStart ? impulse : T(0);
+
+		m_Rows.push_back(row);
+	}
+
+	void BuildRows(const body_set_type& bodies, T dt)
+	{
+		constexpr T Unbounded = std::numeric_limits<T>::max();
+
+		const T feedback = m_Settings.Baumgarte / dt;
+
+		m_Rows.clear();
+		m_ContactRows.assign(m_Contacts.size(), InvalidIndex);
+		m_JointRows.assign(m_Joints.size(), InvalidIndex);
+
+		for (size_t c = 0; c < m_Contacts.size(); ++c)
+		{
+			const Contact& contact = m_Contacts[c];
+			const BodyFrame a = FrameOf(bodies, contact.BodyA);
+			const BodyFrame b = FrameOf(bodies, contact.BodyB);
+
+			if (a.InverseMass == T(0) && b.InverseMass == T(0))
+				continue;
+
+			m_ContactRows[c] = static_cast<std::uint32_t>(m_Rows.size());
+
+			std::array<T, 3> impulses{};
+
+			if (contact.Key != 0)
+			{
+				const auto it = m_ContactCache.find(contact.Key);
+
+				if (it != std::end(m_ContactCache))
+					impulses = it->second;
+			}
+
+			const vector_type rA = contact.Point - a.Position;
+			const vector_type rB = contact.Point - b.Position;
+			const vector_type& n = contact.Normal;
+			const vector_type t1 = PerpendicularOf(n);
+			const vector_type t2 = n.Cross(t1);
+
+			const auto normalRow = static_cast<std::uint32_t>(m_Rows.size());
+			const T bias = -feedback * std::max(contact.Depth - m_Settings.Slop, T(0));
+
+			AddRow(contact.BodyA, contact.BodyB, a, b, n, rA.Cross(n), rB.Cross(n), bias, T(0), Unbounded, T(0), InvalidIndex, impulses[0]);
+			AddRow(contact.BodyA, contact.BodyB, a, b, t1, rA.Cross(t1), rB.Cross(t1), T(0), T(0), T(0), contact.Friction, normalRow, impulses[1]);
+			AddRow(contact.BodyA, contact.BodyB, a, b, t2, rA.Cross(t2), rB.Cross(t2), T(0), T(0), T(0), contact.Friction, normalRow, impulses[2]);
+		}
+
+		for (size_t j = 0; j < m_Joints.size(); ++j)
+		{
+			const Joint& joint = m_Joints[j];
+			const BodyFrame a = FrameOf(bodies, joint.BodyA);
+			const BodyFrame b = FrameOf(bodies, joint.BodyB);
+
+			if (a.InverseMass == T(0) && b.InverseMass == T(0))
+				continue;
+
+			m_JointRows[j] = static_cast<std::uint32_t>(m_Rows.size());
+
+			const vector_type rA = Rotate(a.Orientation, joint.LocalAnchorA);
+			const vector_type rB = Rotate(b.Orientation, joint.LocalAnchorB);
+			const vector_type error = (b.Position + rB) - (a.Position + rA);
+
+			for (size_t k = 0; k < 3; ++k)
+			{
+				vector_type axis{ Zero };
+				axis[k] = T(1);
+
+				AddRow(joint.BodyA, joint.BodyB, a, b, axis, rA.Cross(axis), rB.Cross(axis),
+					feedback * error[k], -Unbounded, Unbounded, T(0), InvalidIndex, joint.Impulses[k]);
+			}
+
+			if (joint.Type == JointType::Hinge)
+			{
+				// Keep axisB perpendicular to the two axes perpendicular to axisA
+				const vector_type axisA = Rotate(a.Orientation, joint.LocalAxisA);
+				const vector_type axisB = Rotate(b.Orientation, joint.LocalAxisB);
+				const vector_type perpendiculars[2] = { PerpendicularOf(axisA), axisA.Cross(PerpendicularOf(axisA)) };
+
+				for (size_t k = 0; k < 2; ++k)
+				{
+					const vector_type angular = axisB.Cross(perpendiculars[k]);
+
+					AddRow(joint.BodyA, joint.BodyB, a, b, vector_type{ Zero }, angular, angular,
+						feedback * perpendiculars[k].Dot(axisB), -Unbounded, Unbounded, T(0), InvalidIndex, joint.Impulses[3 + k]);
+				}
+			}
+		}
+	}
+
+	// Groups the rows into islands of dynamic bodies connected by constraints (union-find)
+	void BuildIslands(const body_set_type& bodies)
+	{
+		const size_t bodyCount = bodies.Size();
+
+		std::vector<std::uint32_t> parents(bodyCount);
+
+		for (size_t i = 0; i < bodyCount; ++i)
+			parents[i] = static_cast<std::uint32_t>(i);
+
+		const auto find = [&](std::uint32_t body)
+		{
+			while (parents[body] != body)
+			{
+				parents[body] = parents[parents[body]];
+				body = parents[body];
+			}
+
+			return body;
+		};
+
+		const auto dynamicOf = [&](const row_type& row)
+		{
+			return bodies.IsStatic(row.BodyA) ? row.BodyB : row.BodyA;
+		};
+
+		for (const auto& row : m_Rows)
+		{
+			if (!bodies.IsStatic(row.BodyA) && !bodies.IsStatic(row.BodyB))
+				parents[find(row.BodyA)] = find(row.BodyB);
+		}
+
+		// Number the islands and counting sort the rows by island
+		m_IslandOf.assign(bodyCount, InvalidIndex);
+		m_IslandStart.assign(1, 0);
+
+		std::vector<std::uint32_t> rowIslands(m_Rows.size());
+
+		for (size_t r = 0; r < m_Rows.size(); ++r)
+		{
+			const std::uint32_t root = find(dynamicOf(m_Rows[r]));
+
+			if (m_IslandOf[root] == InvalidIndex)
+			{
+				m_IslandOf[root] = static_cast<std::uint32_t>(m_IslandStart.size() - 1);
+				m_IslandStart.push_back(0);
+			}
+
+			rowIslands[r] = m_IslandOf[root];
+			++m_IslandStart[rowIslands[r] + 1];
+		}
+
+		for (size_t i = 1; i < m_IslandStart.size(); ++i)
+			m_IslandStart[i] += m_IslandStart[i - 1];
+
+		std::vector<size_t> cursors(std::begin(m_IslandStart), std::end(m_IslandStart) - 1);
+
+		m_IslandRows.resize(m_Rows.size());
+
+		for (size_t r = 0; r < m_Rows.size(); ++r)
+			m_IslandRows[cursors[rowIslands[r]]++] = static_cast<std::uint32_t>(r);
+	}
+
+	void SolveIsland(body_set_type& bodies, size_t island, IslandScratch& scratch)
+	{
+		const std::uint32_t* pRows = m_IslandRows.data() + m_IslandStart[island];
+		const size_t rowCount = m_IslandStart[island + 1] - m_IslandStart[island];
+
+		// Local bodies: one per dynamic body, one per static reference, then the padding body.
+		// Dynamic bodies belong to a single island, so their entries of m_LocalBodies are written by one thread.
+		auto& globals = scratch.Globals;
+		globals.clear();
+
+		auto& locals = scratch.Locals;
+		locals.resize(rowCount * 2);
+
+		for (size_t r = 0; r < rowCount; ++r)
+		{
+			const row_type& row = m_Rows[pRows[r]];
+			const body_type ends[2] = { row.BodyA, row.BodyB };
+
+			for (size_t e = 0; e < 2; ++e)
+			{
+				const body_type body = ends[e];
+				std::uint32_t local;
+
+				if (bodies.IsStatic(body))
+				{
+					local = static_cast<std::uint32_t>(globals.size());
+					globals.push_back(body);
+				}
+				else if (m_LocalBodies[body] < globals.size() && globals[m_LocalBodies[body]] == body)
+				{
+					local = m_LocalBodies[body];
+				}
+				else
+				{
+					local = static_cast<std::uint32_t>(globals.size());
+					m_LocalBodies[body] = local;
+					globals.push_back(body);
+				}
+
+				locals[r * 2 + e] = local;
+			}
+		}
+
+		const auto padding = static_cast<std::uint32_t>(globals.size());
+
+		auto& local = scratch.Bodies;
+		local.Resize(globals.size() + 1);
+
+		for (size_t i = 0; i < globals.size(); ++i)
+		{
+			const vector_type v = bodies.LinearVelocity(globals[i]);
+			const vector_type w = bodies.AngularVelocity(globals[i]);
+
+			for (size_t k = 0; k < 3; ++k)
+			{
+				local.LinearVelocities[k][i] = v[k];
+				local.AngularVelocities[k][i] = w[k];
+			}
+
+			local.InverseMasses[i] = bodies.InverseMass(globals[i]);
+		}
+
+		ColorRows(rowCount, locals, globals.size(), scratch);
+		BuildBatches(pRows, locals, padding, scratch);
+
+		auto& batches = scratch.Batches;
+		auto& impulses = scratch.Impulses;
+
+		m_IslandBatchCounts[island] = batches.size();
+
+		// Warm start
+		for (size_t b = 0; b < batches.size(); ++b)
+		{
+			T delta[BatchWidth];
+
+			for (size_t lane = 0; lane < BatchWidth; ++lane)
+				delta[lane] = impulses[b * BatchWidth + lane];
+
+			detail::ApplyConstraintImpulses(batches[b], delta, local);
+		}
+
+		for (size_t iteration = 0; iteration < m_Settings.Iterations; ++iteration)
+		{
+			for (size_t b = 0; b < batches.size(); ++b)
+				detail::SolveConstraintBatch(batches[b], impulses.data(), b * BatchWidth, local);
+		}
+
+		for (size_t r = 0; r < rowCount; ++r)
+			m_Rows[pRows[r]].Impulse = impulses[m_RowSlots[pRows[r]]];
+
+		for (size_t i = 0; i < globals.size(); ++i)
+		{
+			if (bodies.IsStatic(globals[i]))
+				continue;
+
+			bodies.SetLinearVelocity(globals[i], vector_type{ local.LinearVelocities[0][i], local.LinearVelocities[1][i], local.LinearVelocities[2][i] });
+			bodies.SetAngularVelocity(globals[i], vector_type{ local.AngularVelocities[0][i], local.AngularVelocities[1][i], local.AngularVelocities[2][i] });
+		}
+	}
+
+	// Greedily gives each row the lowest color that neither of its bodies has used yet.
+	// Rows that find no free color get ColorCount and are solved one per batch.
+	static void ColorRows(size_t rowCount, const std::vector<std::uint32_t>& locals, size_t bodyCount, IslandScratch& scratch)
+	{
+		auto& masks = scratch.Masks;
+		auto& colors = scratch.Colors;
+		auto& ordered = scratch.Ordered;
+		auto& colorStart = scratch.ColorStart;
+
+		masks.assign(bodyCount, 0);
+		colors.resize(rowCount);
+		colorStart.assign(ColorCount + 2, 0);
+
+		for (size_t r = 0; r < rowCount; ++r)
+		{
+			const std::uint32_t a = locals[r * 2];
+			const std::uint32_t b = locals[r * 2 + 1];
+			const std::uint64_t used = masks[a] | masks[b];
+
+			std::uint32_t color = 0;
+			while (color < ColorCount && (used & (std::uint64_t(1) << color)))
+				++color;
+
+			if (color < ColorCount)
+			{
+				masks[a] |= std::uint64_t(1) << color;
+				masks[b] |= std::uint64_t(1) << color;
+			}
+
+			colors[r] = color;
+			++colorStart[color + 1];
+		}
+
+		for (size_t c = 1; c < colorStart.size(); ++c)
+			colorStart[c] += colorStart[c - 1];
+
+		std::vector<size_t> cursors(std::begin(colorStart), std::end(colorStart) - 1);
+
+		ordered.resize(rowCount);
+
+		for (size_t r = 0; r < rowCount; ++r)
+			ordered[cursors[colors[r]]++] = static_cast<std::uint32_t>(r);
+	}
+
+	// Packs the colored rows into batches, padding each color's last batch with rows on the padding body
+	void BuildBatches(const std::uint32_t* pRows, const std::vector<std::uint32_t>& locals, std::uint32_t padding, IslandScratch& scratch)
+	{
+		auto& batches = scratch.Batches;
+		auto& impulses = scratch.Impulses;
+		const auto& ordered = scratch.Ordered;
+		const auto& colorStart = scratch.ColorStart;
+
+		batches.clear();
+		impulses.clear();
+
+		for (size_t color = 0; color <= ColorCount; ++color)
+		{
+			const size_t width = (color < ColorCount) ? BatchWidth : 1;
+
+			for (size_t first = colorStart[color]; first < colorStart[color + 1]; first += width)
+			{
+				const size_t count = std::min(width, colorStart[color + 1] - first);
+				const size_t base = batches.size() * BatchWidth;
+
+				batch_type batch{};
+				impulses.resize(base + BatchWidth, T(0));
+
+				for (size_t lane = 0; lane < BatchWidth; ++lane)
+				{
+					batch.BodyA[lane] = batch.BodyB[lane] = padding;
+					batch.Reference[lane] = static_cast<std::uint32_t>(base + lane);
+				}
+
+				for (size_t lane = 0; lane < count; ++lane)
+				{
+					const std::uint32_t r = ordered[first + lane];
+					const std::uint32_t index = pRows[r];
+					const row_type& row = m_Rows[index];
+
+					batch.BodyA[lane] = locals[r * 2];
+					batch.BodyB[lane] = locals[r * 2 + 1];
+
+					for (size_t k = 0; k < 3; ++k)
+					{
+						batch.Linear[k][lane] = row.Linear[k];
+						batch.AngularA[k][lane] = row.AngularA[k];
+						batch.AngularB[k][lane] = row.AngularB[k];
+						batch.InertiaA[k][lane] = row.InertiaA[k];
+						batch.InertiaB[k][lane] = row.InertiaB[k];
+					}
+
+					batch.Mass[lane] = row.Mass;
+					batch.Bias[lane] = row.Bias;
+					batch.Lower[lane] = row.Lower;
+					batch.Upper[lane] = row.Upper;
+					batch.Friction[lane] = row.Friction;
+
+					m_RowSlots[index] = static_cast<std::uint32_t>(base + lane);
+					impulses[base + lane] = row.Impulse;
+				}
+
+				batches.push_back(batch);
+			}
+		}
+
+		// References are resolved once every row of the island has a slot
+		for (size_t r = 0; r < ordered.size(); ++r)
+		{
+			const std::uint32_t index = pRows[r];
+			const std::uint32_t slot = m_RowSlots[index];
+			const size_t b = slot / BatchWidth;
+
+			batches[b].Reference[slot % BatchWidth] = m_RowSlots[m_Rows[index].Reference];
+		}
+	}
+
+	// Writes the accumulated impulses back to the contact cache and the joints
+	void StoreImpulses()
+	{
+		std::unordered_map<key_type, std::array<T, 3>> cache;
+
+		for (size_t c = 0; c < m_Contacts.size(); ++c)
+		{
+			const std::uint32_t r = m_ContactRows[c];
+
+			if (r != InvalidIndex && m_Contacts[c].Key != 0)
+				cache[m_Contacts[c].Key] = { m_Rows[r].Impulse, m_Rows[r + 1].Impulse, m_Rows[r + 2].Impulse };
+		}
+
+		for (size_t j = 0; j < m_Joints.size(); ++j)
+		{
+			const std::uint32_t r = m_JointRows[j];
+
+			if (r == InvalidIndex)
+				continue;
+
+			const size_t count = (m_Joints[j].Type == JointType::Hinge) ? 5 : 3;
+
+			for (size_t k = 0; k < count; ++k)
+				m_Joints[j].Impulses[k] = m_Rows[r + k].Impulse;
+		}
+
+		m_ContactCache = std::move(cache);
+	}
+};
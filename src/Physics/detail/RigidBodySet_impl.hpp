@@ -0,0 +1,461 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RigidBodySet_decl.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../../Math/Matrix.h"
+#include "../../Math/Quaternion.h"
+#include "../../Math/Vector.h"
+#include "../../Parallel/ParallelFor.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// RigidBodySet
+//	Stores rigid body state as one array per component, so that Integrate() runs each step of the update
+//	across many bodies at once. Bodies are referenced by index; destroying a body moves the last body into
+//	its index. A body with zero inverse mass is static and ignores gravity.
+//	Inertia is given as the diagonal of the inertia tensor in the body's principal frame. The world space
+//	inverse inertia tensor, R * inverse(I) * transpose(R), is cached as its 6 unique values and refreshed
+//	whenever the orientation changes.
+template<class T>
+class Epic::RigidBodySet
+{
+	static_assert(std::is_floating_point_v<T>, "RigidBodySet requires floating point state.");
+
+public:
+	using type = Epic::RigidBodySet<T>;
+	using value_type = T;
+	using body_type = std::uint32_t;
+	using vector_type = Epic::Vector<T, 3>;
+	using quaternion_type = Epic::Quaternion<T>;
+	using matrix_type = Epic::Matrix<T, 3>;
+
+	static constexpr body_type InvalidBody = ~body_type(0);
+
+private:
+	static constexpr size_t MinGrainSize = 1024;
+
+	using lanes3_type = std::array<std::vector<T>, 3>;
+	using lanes4_type = std::array<std::vector<T>, 4>;
+	using lanes6_type = std::array<std::vector<T>, 6>;
+
+private:
+	lanes3_type m_Positions;
+	lanes4_type m_Orientations;
+	lanes3_type m_LinearVelocities;
+	lanes3_type m_AngularVelocities;
+	lanes3_type m_Forces;
+	lanes3_type m_Torques;
+	std::vector<T> m_InverseMasses;
+	lanes3_type m_InverseInertias;
+
+	// { xx, yy, zz, xy, xz, yz }
+	lanes6_type m_WorldInverseInertias;
+
+	std::vector<T> m_LinearDampings;
+	std::vector<T> m_AngularDampings;
+
+public:
+	RigidBodySet() noexcept = default;
+	RigidBodySet(const RigidBodySet&) = default;
+	RigidBodySet(RigidBodySet&&) noexcept = default;
+	~RigidBodySet() = default;
+
+	RigidBodySet& operator = (const RigidBodySet&) = default;
+	RigidBodySet& operator = (RigidBodySet&&) noexcept = default;
+
+public:
+	size_t Size() const noexcept { return m_InverseMasses.size(); }
+	bool Empty() const noexcept { return m_InverseMasses.empty(); }
+
+	bool IsValid(body_type body) const noexcept { return body < Size(); }
+
+	void Reserve(size_t count)
+	{
+		ForEachLane([&](std::vector<T>& lane) { lane.reserve(count); });
+	}
+
+	void Clear() noexcept
+	{
+		ForEachLane([](std::vector<T>& lane) { lane.clear(); });
+	}
+
+public:
+	// Creates a static body
+	body_type Create(const vector_type& position, const quaternion_type& orientation)
+	{
+		return Create(position, orientation, T(0), vector_type{ Zero });
+	}
+
+	// Creates a body with the given mass and principal moments of inertia.
+	// A mass of 0 creates a static body; a moment of 0 locks rotation about that axis.
+	body_type Create(const vector_type& position, const quaternion_type& orientation, T mass, const vector_type& inertia)
+	{
+		const auto body = static_cast<body_type>(Size());
+
+		ForEachLane([](std::vector<T>& lane) { lane.push_back(T(0)); });
+
+		for (size_t k = 0; k < 3; ++k)
+			m_Positions[k][body] = position[k];
+
+		for (size_t k = 0; k < 4; ++k)
+			m_Orientations[k][body] = orientation.Values[k];
+
+		SetMass(body, mass, inertia);
+
+		return body;
+	}
+
+	// Destroys a body. The last body is moved into its index.
+	void Destroy(body_type body) noexcept
+	{
+		assert(IsValid(body));
+
+		const size_t last = Size() - 1;
+
+		ForEachLane([&](std::vector<T>& lane)
+		{
+			lane[body] = lane[last];
+			lane.pop_back();
+		});
+	}
+
+public:
+	vector_type Position(body_type body) const noexcept { return Load(m_Positions, body); }
+	vector_type LinearVelocity(body_type body) const noexcept { return Load(m_LinearVelocities, body); }
+	vector_type AngularVelocity(body_type body) const noexcept { return Load(m_AngularVelocities, body); }
+	vector_type InverseInertia(body_type body) const noexcept { return Load(m_InverseInertias, body); }
+
+	quaternion_type Orientation(body_type body) const noexcept
+	{
+		assert(IsValid(body));
+
+		quaternion_type result;
+
+		for (size_t k = 0; k < 4; ++k)
+			result.Values[k] = m_Orientations[k][body];
+
+		return result;
+	}
+
+	T InverseMass(body_type body) const noexcept
+	{
+		assert(IsValid(body));
+		return m_InverseMasses[body];
+	}
+
+	bool IsStatic(body_type body) const noexcept { return InverseMass(body) == T(0); }
+
+	T LinearDamping(body_type body) const noexcept
+	{
+		assert(IsValid(body));
+		return m_LinearDampings[body];
+	}
+
+	T AngularDamping(body_type body) const noexcept
+	{
+		assert(IsValid(body));
+		return m_AngularDampings[body];
+	}
+
+	// The world space inverse inertia tensor as of the last orientation change
+	matrix_type WorldInverseInertia(body_type body) const noexcept
+	{
+		assert(IsValid(body));
+
+		const auto& w = m_WorldInverseInertias;
+
+		matrix_type result;
+		result.Values =
+		{
+			w[0][body], w[3][body], w[4][body],
+			w[3][body], w[1][body], w[5][body],
+			w[4][body], w[5][body], w[2][body]
+		};
+
+		return result;
+	}
+
+	// Component arrays, for batch consumers
+	std::array<const T*, 3> Positions() const noexcept { return Lanes(m_Positions); }
+	std::array<const T*, 4> Orientations() const noexcept { return Lanes(m_Orientations); }
+	std::array<const T*, 3> LinearVelocities() const noexcept { return Lanes(m_LinearVelocities); }
+	std::array<const T*, 3> AngularVelocities() const noexcept { return Lanes(m_AngularVelocities); }
+
+public:
+	void SetPosition(body_type body, const vector_type& position) noexcept { Store(m_Positions, body, position); }
+	void SetLinearVelocity(body_type body, const vector_type& velocity) noexcept { Store(m_LinearVelocities, body, velocity); }
+	void SetAngularVelocity(body_type body, const vector_type& velocity) noexcept { Store(m_AngularVelocities, body, velocity); }
+
+	void SetOrientation(body_type body, const quaternion_type& orientation) noexcept
+	{
+		assert(IsValid(body));
+
+		for (size_t k = 0; k < 4; ++k)
+			m_Orientations[k][body] = orientation.Values[k];
+
+		UpdateWorldInertia(body, body + 1);
+	}
+
+	// Sets the mass and principal moments of inertia. A value of 0 is treated as infinite.
+	void SetMass(body_type body, T mass, const vector_type& inertia) noexcept
+	{
+		assert(IsValid(body));
+		assert(mass >= T(0));
+
+		m_InverseMasses[body] = (mass > T(0)) ? T(1) / mass : T(0);
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			assert(inertia[k] >= T(0));
+			m_InverseInertias[k][body] = (mass > T(0) && inertia[k] > T(0)) ? T(1) / inertia[k] : T(0);
+		}
+
+		UpdateWorldInertia(body, body + 1);
+	}
+
+	// Sets the fraction of velocity removed per second, applied as v / (1 + dt * damping)
+	void SetDamping(body_type body, T linear, T angular) noexcept
+	{
+		assert(IsValid(body));
+		assert(linear >= T(0) && angular >= T(0));
+
+		m_LinearDampings[body] = linear;
+		m_AngularDampings[body] = angular;
+	}
+
+public:
+	// Accumulates a force through the center of mass until the next Integrate()
+	void ApplyForce(body_type body, const vector_type& force) noexcept
+	{
+		Accumulate(m_Forces, body, force);
+	}
+
+	// Accumulates a force applied at a world space point until the next Integrate()
+	void ApplyForce(body_type body, const vector_type& force, const vector_type& point) noexcept
+	{
+		const vector_type arm = point - Position(body);
+
+		Accumulate(m_Forces, body, force);
+		Accumulate(m_Torques, body, arm.Cross(force));
+	}
+
+	// Accumulates a world space torque until the next Integrate()
+	void ApplyTorque(body_type body, const vector_type& torque) noexcept
+	{
+		Accumulate(m_Torques, body, torque);
+	}
+
+	// Changes the velocity of a body by an impulse applied at a world space point
+	void ApplyImpulse(body_type body, const vector_type& impulse, const vector_type& point) noexcept
+	{
+		const vector_type arm = point - Position(body);
+
+		Accumulate(m_LinearVelocities, body, impulse * InverseMass(body));
+		Accumulate(m_AngularVelocities, body, WorldInverseInertia(body) * arm.Cross(impulse));
+	}
+
+public:
+	// Advances every body by dt with semi-implicit Euler: velocities are updated from the accumulated
+	// forces and gravity first, then positions and orientations from the new velocities. Orientations
+	// are renormalized, world inertia tensors refreshed and accumulated forces cleared.
+	// The gyroscopic term w x (I * w) is omitted; it is the usual source of instability at large dt.
+	void Integrate(T dt, const vector_type& gravity)
+	{
+		const size_t count = Size();
+
+		ParallelFor(0, count, ParallelGrainSize(count, MinGrainSize), [&](size_t begin, size_t end)
+		{
+			IntegrateVelocityRange(begin, end, dt, gravity);
+			IntegratePositionRange(begin, end, dt);
+			UpdateWorldInertia(begin, end);
+		});
+	}
+
+	// The first half of Integrate(): applies the accumulated forces, gravity and damping to the
+	// velocities and clears the accumulated forces. Constraints are solved between the two halves.
+	void IntegrateVelocities(T dt, const vector_type& gravity)
+	{
+		const size_t count = Size();
+
+		ParallelFor(0, count, ParallelGrainSize(count, MinGrainSize), [&](size_t begin, size_t end)
+		{
+			IntegrateVelocityRange(begin, end, dt, gravity);
+		});
+	}
+
+	// The second half of Integrate(): advances positions and orientations by the current velocities.
+	void IntegratePositions(T dt)
+	{
+		const size_t count = Size();
+
+		ParallelFor(0, count, ParallelGrainSize(count, MinGrainSize), [&](size_t begin, size_t end)
+		{
+			IntegratePositionRange(begin, end, dt);
+			UpdateWorldInertia(begin, end);
+		});
+	}
+
+private:
+	template<class Function>
+	void ForEachLane(Function fn)
+	{
+		for (auto& lane : m_Positions) fn(lane);
+		for (auto& lane : m_Orientations) fn(lane);
+		for (auto& lane : m_LinearVelocities) fn(lane);
+		for (auto& lane : m_AngularVelocities) fn(lane);
+		for (auto& lane : m_Forces) fn(lane);
+		for (auto& lane : m_Torques) fn(lane);
+		fn(m_InverseMasses);
+		for (auto& lane : m_InverseInertias) fn(lane);
+		for (auto& lane : m_WorldInverseInertias) fn(lane);
+		fn(m_LinearDampings);
+		fn(m_AngularDampings);
+	}
+
+	template<size_t N>
+	static std::array<const T*, N> Lanes(const std::array<std::vector<T>, N>& lanes) noexcept
+	{
+		std::array<const T*, N> result;
+
+		for (size_t k = 0; k < N; ++k)
+			result[k] = lanes[k].data();
+
+		return result;
+	}
+
+	vector_type Load(const lanes3_type& lanes, body_type body) const noexcept
+	{
+		assert(IsValid(body));
+		return vector_type{ lanes[0][body], lanes[1][body], lanes[2][body] };
+	}
+
+	void Store(lanes3_type& lanes, body_type body, const vector_type& value) noexcept
+	{
+		assert(IsValid(body));
+
+		for (size_t k = 0; k < 3; ++k)
+			lanes[k][body] = value[k];
+	}
+
+	void Accumulate(lanes3_type& lanes, body_type body, const vector_type& value) noexcept
+	{
+		assert(IsValid(body));
+
+		for (size_t k = 0; k < 3; ++k)
+			lanes[k][body] += value[k];
+	}
+
+	void IntegrateVelocityRange(size_t begin, size_t end, T dt, const vector_type& gravity) noexcept
+	{
+		T* vx = m_LinearVelocities[0].data(); T* vy = m_LinearVelocities[1].data(); T* vz = m_LinearVelocities[2].data();
+		T* wx = m_AngularVelocities[0].data(); T* wy = m_AngularVelocities[1].data(); T* wz = m_AngularVelocities[2].data();
+		T* fx = m_Forces[0].data(); T* fy = m_Forces[1].data(); T* fz = m_Forces[2].data();
+		T* tx = m_Torques[0].data(); T* ty = m_Torques[1].data(); T* tz = m_Torques[2].data();
+		const T* iw[6] = { m_WorldInverseInertias[0].data(), m_WorldInverseInertias[1].data(), m_WorldInverseInertias[2].data(),
+			m_WorldInverseInertias[3].data(), m_WorldInverseInertias[4].data(), m_WorldInverseInertias[5].data() };
+		const T* invMasses = m_InverseMasses.data();
+		const T* linearDampings = m_LinearDampings.data();
+		const T* angularDampings = m_AngularDampings.data();
+
+		const T gx = gravity[0], gy = gravity[1], gz = gravity[2];
+
+		for (size_t i = begin; i < end; ++i)
+		{
+			const T invMass = invMasses[i];
+			const T gravityScale = (invMass > T(0)) ? T(1) : T(0);
+			const T linearScale = T(1) / (T(1) + dt * linearDampings[i]);
+			const T angularScale = T(1) / (T(1) + dt * angularDampings[i]);
+
+			const T ax = iw[0][i] * tx[i] + iw[3][i] * ty[i] + iw[4][i] * tz[i];
+			const T ay = iw[3][i] * tx[i] + iw[1][i] * ty[i] + iw[5][i] * tz[i];
+			const T az = iw[4][i] * tx[i] + iw[5][i] * ty[i] + iw[2][i] * tz[i];
+
+			vx[i] = (vx[i] + (fx[i] * invMass + gx * gravityScale) * dt) * linearScale;
+			vy[i] = (vy[i] + (fy[i] * invMass + gy * gravityScale) * dt) * linearScale;
+			vz[i] = (vz[i] + (fz[i] * invMass + gz * gravityScale) * dt) * linearScale;
+
+			wx[i] = (wx[i] + ax * dt) * angularScale;
+			wy[i] = (wy[i] + ay * dt) * angularScale;
+			wz[i] = (wz[i] + az * dt) * angularScale;
+
+			fx[i] = fy[i] = fz[i] = T(0);
+			tx[i] = ty[i] = tz[i] = T(0);
+		}
+	}
+
+	void IntegratePositionRange(size_t begin, size_t end, T dt) noexcept
+	{
+		T* px = m_Positions[0].data(); T* py = m_Positions[1].data(); T* pz = m_Positions[2].data();
+		T* qx = m_Orientations[0].data(); T* qy = m_Orientations[1].data(); T* qz = m_Orientations[2].data(); T* qw = m_Orientations[3].data();
+		const T* vx = m_LinearVelocities[0].data(); const T* vy = m_LinearVelocities[1].data(); const T* vz = m_LinearVelocities[2].data();
+		const T* wx = m_AngularVelocities[0].data(); const T* wy = m_AngularVelocities[1].data(); const T* wz = m_AngularVelocities[2].data();
+
+		const T halfDt = T(0.5) * dt;
+
+		for (size_t i = begin; i < end; ++i)
+		{
+			px[i] += vx[i] * dt;
+			py[i] += vy[i] * dt;
+			pz[i] += vz[i] * dt;
+
+			// q += (dt / 2) * (w, 0) * q
+			const T x = qx[i], y = qy[i], z = qz[i], w = qw[i];
+
+			const T nx = x + halfDt * (wx[i] * w + wy[i] * z - wz[i] * y);
+			const T ny = y + halfDt * (wy[i] * w + wz[i] * x - wx[i] * z);
+			const T nz = z + halfDt * (wz[i] * w + wx[i] * y - wy[i] * x);
+			const T nw = w - halfDt * (wx[i] * x + wy[i] * y + wz[i] * z);
+
+			const T invLength = T(1) / std::sqrt(nx * nx + ny * ny + nz * nz + nw * nw);
+
+			qx[i] = nx * invLength;
+			qy[i] = ny * invLength;
+			qz[i] = nz * invLength;
+			qw[i] = nw * invLength;
+		}
+	}
+
+	// Recomputes R * diag(inverse inertia) * transpose(R) from the orientations of [begin..end)
+	void UpdateWorldInertia(size_t begin, size_t end) noexcept
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			const T x = m_Orientations[0][i], y = m_Orientations[1][i], z = m_Orientations[2][i], w = m_Orientations[3][i];
+
+			// Rows of R
+			const T r00 = T(1) - T(2) * (y * y + z * z), r01 = T(2) * (x * y - w * z), r02 = T(2) * (x * z + w * y);
+			const T r10 = T(2) * (x * y + w * z), r11 = T(1) - T(2) * (x * x + z * z), r12 = T(2) * (y * z - w * x);
+			const T r20 = T(2) * (x * z - w * y), r21 = T(2) * (y * z + w * x), r22 = T(1) - T(2) * (x * x + y * y);
+
+			const T dx = m_InverseInertias[0][i], dy = m_InverseInertias[1][i], dz = m_InverseInertias[2][i];
+
+			m_WorldInverseInertias[0][i] = r00 * r00 * dx + r01 * r01 * dy + r02 * r02 * dz;
+			m_WorldInverseInertias[1][i] = r10 * r10 * dx + r11 * r11 * dy + r12 * r12 * dz;
+			m_WorldInverseInertias[2][i] = r20 * r20 * dx + r21 * r21 * dy + r22 * r22 * dz;
+			m_WorldInverseInertias[3][i] = r00 * r10 * dx + r01 * r11 * dy + r02 * r12 * dz;
+			m_WorldInverseInertias[4][i] = r00 * r20 * dx + r01 * r21 * dy + r02 * r22 * dz;
+			m_WorldInverseInertias[5][i] = r10 * r20 * dx + r11 * r21 * dy + r12 * r22 * dz;
+		}
+	}
+};
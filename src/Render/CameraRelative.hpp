@@ -0,0 +1,230 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "../Math/Matrix.h"
+#include "../Math/Vector.h"
+#include "../Parallel/BatchBlock.hpp"
+#include "../Parallel/ParallelFor.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Camera-relative rendering
+//	Worlds larger than float precision keep their transforms in double and render relative to the camera.
+//	Subtracting the camera position in double before narrowing to float keeps the full float precision near the
+//	camera, where it matters, instead of spending it on the distance to the world origin. The batch forms stage
+//	blocks of matrices into SoA lanes so that the subtraction and the narrowing vectorize.
+namespace Epic
+{
+	namespace detail
+	{
+		constexpr size_t CameraRelativeMinGrainSize = 4096;
+
+		// CameraRelativeLanes - Computes translate(-origin) * m for count lanes of column-major values
+		inline void CameraRelativeLanes(const double(&m)[16][BatchBlockSize], const double(&origin)[3],
+			float(&out)[16][BatchBlockSize], size_t count) noexcept
+		{
+			for (size_t c = 0; c < 4; ++c)
+			{
+				for (size_t r = 0; r < 3; ++r)
+				{
+					for (size_t i = 0; i < count; ++i)
+						out[c * 4 + r][i] = static_cast<float>(m[c * 4 + r][i] - origin[r] * m[c * 4 + 3][i]);
+				}
+
+				for (size_t i = 0; i < count; ++i)
+					out[c * 4 + 3][i] = static_cast<float>(m[c * 4 + 3][i]);
+			}
+		}
+	}
+
+	// CameraRelativeOf - The transform world relative to origin (usually the camera position), narrowed to float
+	inline Matrix<float, 4> CameraRelativeOf(const Matrix<double, 4>& world, const Vector<double, 3>& origin) noexcept
+	{
+		Matrix<float, 4> result;
+
+		for (size_t c = 0; c < 4; ++c)
+		{
+			for (size_t r = 0; r < 3; ++r)
+				result.Values[c * 4 + r] = static_cast<float>(world.Values[c * 4 + r] - origin[r] * world.Values[c * 4 + 3]);
+
+			result.Values[c * 4 + 3] = static_cast<float>(world.Values[c * 4 + 3]);
+		}
+
+		return result;
+	}
+
+	// CameraRelativeOf - A position relative to origin, narrowed to float
+	inline Vector<float, 3> CameraRelativeOf(const Vector<double, 3>& position, const Vector<double, 3>& origin) noexcept
+	{
+		return Vector<float, 3>
+		{
+			static_cast<float>(position[0] - origin[0]),
+			static_cast<float>(position[1] - origin[1]),
+			static_cast<float>(position[2] - origin[2])
+		};
+	}
+
+	// CameraRelativeViewOf - The view matrix to use with transforms made relative to origin, view * translate(origin).
+	//	When origin is the camera position the result is the view rotation alone.
+	inline Matrix<float, 4> CameraRelativeViewOf(const Matrix<double, 4>& view, const Vector<double, 3>& origin) noexcept
+	{
+		Matrix<float, 4> result;
+
+		for (size_t n = 0; n < 12; ++n)
+			result.Values[n] = static_cast<float>(view.Values[n]);
+
+		for (size_t r = 0; r < 4; ++r)
+		{
+			const double translation = view.Values[12 + r] + view.Values[r] * origin[0] + view.Values[4 + r] * origin[1] + view.Values[8 + r] * origin[2];
+
+			result.Values[12 + r] = static_cast<float>(translation);
+		}
+
+		return result;
+	}
+
+	// CameraPositionOf - The world position of the camera of a rigid view matrix
+	inline Vector<double, 3> CameraPositionOf(const Matrix<double, 4>& view) noexcept
+	{
+		const auto& m = view.Values;
+
+		return Vector<double, 3>
+		{
+			-(m[0] * m[12] + m[1] * m[13] + m[2] * m[14]),
+			-(m[4] * m[12] + m[5] * m[13] + m[6] * m[14]),
+			-(m[8] * m[12] + m[9] * m[13] + m[10] * m[14])
+		};
+	}
+
+	// BatchCameraRelative - Writes count world transforms relative to origin, narrowed to float.
+	//	Large batches are split across threads.
+	inline void BatchCameraRelative(const Matrix<double, 4>* pWorlds, size_t count, const Vector<double, 3>& origin, Matrix<float, 4>* pResults)
+	{
+		constexpr size_t BlockSize = detail::BatchBlockSize;
+
+		const double o[3] = { origin[0], origin[1], origin[2] };
+
+		ParallelFor(0, count, ParallelGrainSize(count, detail::CameraRelativeMinGrainSize), [&](size_t begin, size_t end)
+		{
+			double m[16][BlockSize];
+			float out[16][BlockSize];
+
+			for (size_t block = begin; block < end; block += BlockSize)
+			{
+				const size_t blockCount = std::min(BlockSize, end - block);
+
+				for (size_t i = 0; i < blockCount; ++i)
+				{
+					for (size_t k = 0; k < 16; ++k)
+						m[k][i] = pWorlds[block + i].Values[k];
+				}
+
+				detail::CameraRelativeLanes(m, o, out, blockCount);
+
+				for (size_t i = 0; i < blockCount; ++i)
+				{
+					for (size_t k = 0; k < 16; ++k)
+						pResults[block + i].Values[k] = out[k][i];
+				}
+			}
+		});
+	}
+
+	// BatchCameraRelative - Writes count positions relative to origin, narrowed to float
+	inline void BatchCameraRelative(const Vector<double, 3>* pPositions, size_t count, const Vector<double, 3>& origin, Vector<float, 3>* pResults)
+	{
+		ParallelFor(0, count, ParallelGrainSize(count, detail::CameraRelativeMinGrainSize), [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				for (size_t k = 0; k < 3; ++k)
+					pResults[i][k] = static_cast<float>(pPositions[i][k] - origin[k]);
+			}
+		});
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Origin rebasing
+//	Data that lives in float relative to a floating origin is shifted whenever the camera strays too far from it.
+namespace Epic
+{
+	// RebaseOrigin - Moves origin when the camera is further than threshold from it along any axis.
+	//	The new origin is the camera position snapped to a grid of cellSize (or threshold if zero), so that repeated
+	//	rebasing lands on the same values. Writes the change of origin to shift and returns true if it moved.
+	inline bool RebaseOrigin(Vector<double, 3>& origin, const Vector<double, 3>& cameraPosition, double threshold,
+		Vector<double, 3>& shift, double cellSize = 0.0) noexcept
+	{
+		assert(threshold > 0.0);
+
+		shift = Vector<double, 3>{ 0.0, 0.0, 0.0 };
+
+		const double distance = std::max({
+			std::abs(cameraPosition[0] - origin[0]),
+			std::abs(cameraPosition[1] - origin[1]),
+			std::abs(cameraPosition[2] - origin[2]) });
+
+		if (distance <= threshold)
+			return false;
+
+		const double cell = (cellSize > 0.0) ? cellSize : threshold;
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			const double snapped = std::round(cameraPosition[k] / cell) * cell;
+
+			shift[k] = snapped - origin[k];
+			origin[k] = snapped;
+		}
+
+		return true;
+	}
+
+	// BatchRebase - Re-expresses count float positions relative to an origin moved by shift
+	inline void BatchRebase(Vector<float, 3>* pPositions, size_t count, const Vector<double, 3>& shift)
+	{
+		ParallelFor(0, count, ParallelGrainSize(count, detail::CameraRelativeMinGrainSize), [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				for (size_t k = 0; k < 3; ++k)
+					pPositions[i][k] = static_cast<float>(double(pPositions[i][k]) - shift[k]);
+			}
+		});
+	}
+
+	// BatchRebase - Re-expresses count float transforms relative to an origin moved by shift
+	inline void BatchRebase(Matrix<float, 4>* pMatrices, size_t count, const Vector<double, 3>& shift)
+	{
+		ParallelFor(0, count, ParallelGrainSize(count, detail::CameraRelativeMinGrainSize), [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				auto& m = pMatrices[i].Values;
+
+				for (size_t c = 0; c < 4; ++c)
+				{
+					for (size_t r = 0; r < 3; ++r)
+						m[c * 4 + r] = static_cast<float>(double(m[c * 4 + r]) - shift[r] * double(m[c * 4 + 3]));
+				}
+			}
+		});
+	}
+}
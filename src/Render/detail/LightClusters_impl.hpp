@@ -0,0 +1,579 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "LightClusters_decl.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "../../Geometry/AABB.h"
+#include "../../Math/Matrix.h"
+#include "../../Math/Vector.h"
+#include "../../Parallel/BatchBlock.hpp"
+#include "../../Parallel/ParallelFor.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// detail
+namespace Epic::detail
+{
+	// SphereIntersectsBox - Tests a sphere against a box by the distance to its closest point
+	template<class T>
+	inline bool SphereIntersectsBox(const Vector<T, 3>& center, T radius, const AABB<T>& box) noexcept
+	{
+		T distanceSq = T(0);
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			const T d = std::max(std::max(box.Min[k] - center[k], center[k] - box.Max[k]), T(0));
+			distanceSq += d * d;
+		}
+
+		return distanceSq <= radius * radius;
+	}
+
+	// ConeIntersectsSphere - Tests a spot light cone (unit direction, half angle given by its cosine and sine)
+	//	against a sphere. The test is exact for the infinite cone and culls the sphere beyond the cone's range.
+	template<class T>
+	inline bool ConeIntersectsSphere(const Vector<T, 3>& position, const Vector<T, 3>& direction, T range, T cosAngle, T sinAngle,
+		const Vector<T, 3>& center, T radius) noexcept
+	{
+		const Vector<T, 3> v = center - position;
+		const T lengthSq = v.MagnitudeSq();
+		const T along = v.Dot(direction);
+		const T closest = cosAngle * std::sqrt(std::max(lengthSq - along * along, T(0))) - along * sinAngle;
+
+		return !(closest > radius) && !(along > radius + range) && !(along < -radius);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// LightClusters
+//	Assigns point and spot lights to the view-space clusters of a froxel grid for clustered shading.
+//	The frustum is split into screen tiles and exponentially spaced depth slices; cluster bounds are computed
+//	once per projection. Lights are transformed to view space in blocks of lanes, then each depth slice is culled
+//	in parallel: lights are filtered against the slice, then against each row of clusters, then against the clusters.
+//	The result is a compact index list per cluster holding its point lights followed by its spot lights.
+template<class T>
+class Epic::LightClusters
+{
+	static_assert(std::is_floating_point_v<T>, "LightClusters requires floating point positions.");
+
+public:
+	using type = Epic::LightClusters<T>;
+	using value_type = T;
+	using vector_type = Epic::Vector<T, 3>;
+	using matrix_type = Epic::Matrix<T, 4>;
+	using box_type = Epic::AABB<T>;
+	using index_type = std::uint32_t;
+
+	// Settings - Grid dimensions
+	//	A nonzero MaxDistance limits the depth range of the grid, which is required for infinite projections.
+	struct Settings
+	{
+		size_t TilesX = 16;
+		size_t TilesY = 9;
+		size_t Slices = 24;
+		T MaxDistance = T(0);
+	};
+
+	struct PointLight
+	{
+		vector_type Position;
+		T Radius;
+	};
+
+	// A cone of half angle Angle (radians) along the unit Direction, lit up to Range from Position
+	struct SpotLight
+	{
+		vector_type Position;
+		vector_type Direction;
+		T Range;
+		T Angle;
+	};
+
+	// LightIndices()[Offset..Offset + PointCount) are point lights, and the following SpotCount entries are spot lights
+	struct Cluster
+	{
+		index_type Offset;
+		index_type PointCount;
+		index_type SpotCount;
+	};
+
+private:
+	struct ViewPoint
+	{
+		vector_type Center;
+		T Radius;
+	};
+
+	struct ViewSpot
+	{
+		vector_type Position;
+		vector_type Direction;
+		T Range;
+		T Cos;
+		T Sin;
+		vector_type BoundCenter;
+		T BoundRadius;
+	};
+
+	struct SliceScratch
+	{
+		std::vector<index_type> Points;
+		std::vector<index_type> Spots;
+		std::vector<index_type> RowPoints;
+		std::vector<index_type> RowSpots;
+		std::vector<index_type> Indices;
+	};
+
+private:
+	Settings m_Settings;
+	matrix_type m_Projection;
+	T m_Near = T(0);
+	T m_Far = T(0);
+	T m_SliceScale = T(0);
+	bool m_Exponential = false;
+
+	std::vector<T> m_SliceDepths;
+	std::vector<box_type> m_Bounds;
+	std::vector<box_type> m_RowBounds;
+	std::vector<vector_type> m_SphereCenters;
+	std::vector<T> m_SphereRadii;
+
+	std::vector<ViewPoint> m_Points;
+	std::vector<ViewSpot> m_Spots;
+	std::vector<SliceScratch> m_Scratch;
+
+	std::vector<Cluster> m_Clusters;
+	std::vector<index_type> m_LightIndices;
+
+public:
+	LightClusters() noexcept
+		: m_Projection{ Epic::Identity }
+	{ }
+
+	explicit LightClusters(const Settings& settings) noexcept
+		: m_Settings{ settings }, m_Projection{ Epic::Identity }
+	{ }
+
+	LightClusters(const LightClusters&) = default;
+	LightClusters(LightClusters&&) noexcept = default;
+	~LightClusters() = default;
+
+	LightClusters& operator = (const LightClusters&) = default;
+	LightClusters& operator = (LightClusters&&) noexcept = default;
+
+public:
+	const Settings& GetSettings() const noexcept { return m_Settings; }
+
+	// Changing the settings invalidates the grid until the next SetProjection()
+	void SetSettings(const Settings& settings) noexcept
+	{
+		m_Settings = settings;
+		m_Bounds.clear();
+		m_Clusters.clear();
+		m_LightIndices.clear();
+	}
+
+public:
+	size_t ClusterCount() const noexcept { return m_Settings.TilesX * m_Settings.TilesY * m_Settings.Slices; }
+	size_t ClusterIndex(size_t x, size_t y, size_t slice) const noexcept { return (slice * m_Settings.TilesY + y) * m_Settings.TilesX + x; }
+
+	T Near() const noexcept { return m_Near; }
+	T Far() const noexcept { return m_Far; }
+
+	// The view distance at which a slice begins; SliceDepth(Slices) is the far end of the grid
+	T SliceDepth(size_t slice) const noexcept { assert(slice < m_SliceDepths.size()); return m_SliceDepths[slice]; }
+
+	// The view-space bounds of a cluster
+	const box_type& Bounds(size_t cluster) const noexcept { assert(cluster < m_Bounds.size()); return m_Bounds[cluster]; }
+
+	const std::vector<Cluster>& Clusters() const noexcept { return m_Clusters; }
+	const std::vector<index_type>& LightIndices() const noexcept { return m_LightIndices; }
+
+	const Cluster& GetCluster(size_t cluster) const noexcept { assert(cluster < m_Clusters.size()); return m_Clusters[cluster]; }
+
+	// The slice containing a view distance, clamped to the grid
+	size_t SliceOf(T depth) const noexcept
+	{
+		const T slice = m_Exponential
+			? std::log(std::max(depth, m_Near) / m_Near) * m_SliceScale
+			: (depth - m_Near) * m_SliceScale;
+
+		return static_cast<size_t>(std::clamp(slice, T(0), T(m_Settings.Slices - 1)));
+	}
+
+	// The cluster containing a view-space position, clamped to the grid
+	size_t ClusterOf(const vector_type& viewPosition) const noexcept
+	{
+		Vector<T, 4> clip{ viewPosition[0], viewPosition[1], viewPosition[2], T(1) };
+		clip = m_Projection * clip;
+
+		const T x = (clip[0] / clip[3] * T(0.5) + T(0.5)) * T(m_Settings.TilesX);
+		const T y = (clip[1] / clip[3] * T(0.5) + T(0.5)) * T(m_Settings.TilesY);
+
+		return ClusterIndex(
+			static_cast<size_t>(std::clamp(x, T(0), T(m_Settings.TilesX - 1))),
+			static_cast<size_t>(std::clamp(y, T(0), T(m_Settings.TilesY - 1))),
+			SliceOf(-viewPosition[2]));
+	}
+
+public:
+	// Computes the view-space bounds of every cluster for a projection looking down -z
+	void SetProjection(const matrix_type& projection)
+	{
+		assert(m_Settings.TilesX > 0 && m_Settings.TilesY > 0 && m_Settings.Slices > 0);
+
+		const size_t tilesX = m_Settings.TilesX;
+		const size_t tilesY = m_Settings.TilesY;
+		const size_t slices = m_Settings.Slices;
+
+		m_Projection = projection;
+
+		const matrix_type inverse = matrix_type::InverseOf(projection);
+
+		const auto unproject = [&](T x, T y, T z)
+		{
+			return inverse * Vector<T, 4>{ x, y, z, T(1) };
+		};
+
+		// An infinite far plane unprojects to a point at infinity (w = 0)
+		const auto nearPoint = unproject(T(0), T(0), T(-1));
+		const auto farPoint = unproject(T(0), T(0), T(1));
+
+		m_Near = -nearPoint[2] / nearPoint[3];
+		m_Far = (std::abs(farPoint[3]) > std::numeric_limits<T>::epsilon() * std::abs(farPoint[2])) ? -farPoint[2] / farPoint[3] : std::numeric_limits<T>::infinity();
+
+		if (m_Settings.MaxDistance > T(0))
+			m_Far = std::min(m_Far, m_Settings.MaxDistance);
+
+		assert(std::isfinite(m_Far) && m_Far > m_Near);
+
+		m_Exponential = m_Near > T(0);
+		m_SliceScale = m_Exponential ? T(slices) / std::log(m_Far / m_Near) : T(slices) / (m_Far - m_Near);
+
+		m_SliceDepths.resize(slices + 1);
+
+		for (size_t k = 0; k <= slices; ++k)
+		{
+			const T t = T(k) / T(slices);
+
+			m_SliceDepths[k] = m_Exponential ? m_Near * std::pow(m_Far / m_Near, t) : m_Near + (m_Far - m_Near) * t;
+		}
+
+		m_SliceDepths[slices] = m_Far;
+
+		// Each tile corner is a line through the near plane and the NDC z = 0 plane (finite even with an infinite far plane)
+		std::vector<vector_type> origins((tilesX + 1) * (tilesY + 1));
+		std::vector<vector_type> directions(origins.size());
+
+		for (size_t y = 0; y <= tilesY; ++y)
+		{
+			for (size_t x = 0; x <= tilesX; ++x)
+			{
+				const T ndcX = T(2) * T(x) / T(tilesX) - T(1);
+				const T ndcY = T(2) * T(y) / T(tilesY) - T(1);
+
+				const auto a = unproject(ndcX, ndcY, T(-1));
+				const auto b = unproject(ndcX, ndcY, T(0));
+
+				const vector_type pa{ a[0] / a[3], a[1] / a[3], a[2] / a[3] };
+				const vector_type pb{ b[0] / b[3], b[1] / b[3], b[2] / b[3] };
+
+				// Scale the direction to advance one unit of view distance (-z)
+				origins[y * (tilesX + 1) + x] = pa;
+				directions[y * (tilesX + 1) + x] = (pb - pa) / (pa[2] - pb[2]);
+			}
+		}
+
+		m_Bounds.resize(ClusterCount());
+		m_RowBounds.resize(slices * tilesY);
+		m_SphereCenters.resize(ClusterCount());
+		m_SphereRadii.resize(ClusterCount());
+
+		ParallelFor(0, slices, 1, [&](size_t begin, size_t end)
+		{
+			for (size_t k = begin; k < end; ++k)
+			{
+				for (size_t y = 0; y < tilesY; ++y)
+				{
+					box_type& row = m_RowBounds[k * tilesY + y];
+					row.Reset();
+
+					for (size_t x = 0; x < tilesX; ++x)
+					{
+						const size_t cluster = ClusterIndex(x, y, k);
+						box_type& box = m_Bounds[cluster];
+
+						box.Reset();
+
+						for (size_t corner = 0; corner < 4; ++corner)
+						{
+							const size_t c = (y + (corner >> 1)) * (tilesX + 1) + x + (corner & 1);
+							const T nearOffset = m_SliceDepths[k] + origins[c][2];
+							const T farOffset = m_SliceDepths[k + 1] + origins[c][2];
+
+							box.Expand(origins[c] + directions[c] * nearOffset);
+							box.Expand(origins[c] + directions[c] * farOffset);
+						}
+
+						row.Expand(box);
+
+						m_SphereCenters[cluster] = box.Center();
+						m_SphereRadii[cluster] = box.Extents().Magnitude();
+					}
+				}
+			}
+		});
+
+		m_Clusters.assign(ClusterCount(), Cluster{ 0, 0, 0 });
+		m_LightIndices.clear();
+	}
+
+	// Transforms the lights to view space and rebuilds the light lists of every cluster
+	void Build(const matrix_type& view, const PointLight* pPoints, size_t pointCount, const SpotLight* pSpots, size_t spotCount)
+	{
+		assert(!m_Bounds.empty());
+		assert(pointCount < size_t(~index_type(0)) && spotCount < size_t(~index_type(0)));
+
+		TransformLights(view, pPoints, pointCount, pSpots, spotCount);
+
+		const size_t slices = m_Settings.Slices;
+
+		m_Scratch.resize(slices);
+		m_Clusters.resize(ClusterCount());
+
+		ParallelFor(0, slices, 1, [&](size_t begin, size_t end)
+		{
+			for (size_t k = begin; k < end; ++k)
+				CullSlice(k);
+		});
+
+		// Concatenate the slice lists, offsetting each slice's clusters by the lights before it
+		const size_t clustersPerSlice = m_Settings.TilesX * m_Settings.TilesY;
+
+		index_type offset = 0;
+		for (size_t k = 0; k < slices; ++k)
+		{
+			for (size_t c = k * clustersPerSlice; c < (k + 1) * clustersPerSlice; ++c)
+				m_Clusters[c].Offset += offset;
+
+			offset += static_cast<index_type>(m_Scratch[k].Indices.size());
+		}
+
+		m_LightIndices.resize(offset);
+
+		ParallelFor(0, slices, 1, [&](size_t begin, size_t end)
+		{
+			for (size_t k = begin; k < end; ++k)
+			{
+				const auto& indices = m_Scratch[k].Indices;
+
+				if (!indices.empty())
+					std::copy(std::begin(indices), std::end(indices), &m_LightIndices[m_Clusters[k * clustersPerSlice].Offset]);
+			}
+		});
+	}
+
+private:
+	// Transforms light positions and directions in blocks of lanes, then derives the view-space culling volumes
+	void TransformLights(const matrix_type& view, const PointLight* pPoints, size_t pointCount, const SpotLight* pSpots, size_t spotCount)
+	{
+		constexpr size_t BlockSize = detail::BatchBlockSize;
+
+		T m[16];
+
+		for (size_t n = 0; n < 16; ++n)
+			m[n] = view.Values[n];
+
+		m_Points.resize(pointCount);
+		m_Spots.resize(spotCount);
+
+		ParallelFor(0, pointCount, ParallelGrainSize(pointCount), [&](size_t begin, size_t end)
+		{
+			T p[3][BlockSize];
+			T out[3][BlockSize];
+
+			for (size_t block = begin; block < end; block += BlockSize)
+			{
+				const size_t blockCount = std::min(BlockSize, end - block);
+
+				for (size_t i = 0; i < blockCount; ++i)
+				{
+					for (size_t k = 0; k < 3; ++k)
+						p[k][i] = pPoints[block + i].Position[k];
+				}
+
+				for (size_t r = 0; r < 3; ++r)
+				{
+					for (size_t i = 0; i < blockCount; ++i)
+						out[r][i] = m[r] * p[0][i] + m[4 + r] * p[1][i] + m[8 + r] * p[2][i] + m[12 + r];
+				}
+
+				for (size_t i = 0; i < blockCount; ++i)
+					m_Points[block + i] = ViewPoint{ vector_type{ out[0][i], out[1][i], out[2][i] }, pPoints[block + i].Radius };
+			}
+		});
+
+		ParallelFor(0, spotCount, ParallelGrainSize(spotCount), [&](size_t begin, size_t end)
+		{
+			T p[3][BlockSize];
+			T d[3][BlockSize];
+			T outP[3][BlockSize];
+			T outD[3][BlockSize];
+
+			for (size_t block = begin; block < end; block += BlockSize)
+			{
+				const size_t blockCount = std::min(BlockSize, end - block);
+
+				for (size_t i = 0; i < blockCount; ++i)
+				{
+					for (size_t k = 0; k < 3; ++k)
+					{
+						p[k][i] = pSpots[block + i].Position[k];
+						d[k][i] = pSpots[block + i].Direction[k];
+					}
+				}
+
+				for (size_t r = 0; r < 3; ++r)
+				{
+					for (size_t i = 0; i < blockCount; ++i)
+					{
+						outP[r][i] = m[r] * p[0][i] + m[4 + r] * p[1][i] + m[8 + r] * p[2][i] + m[12 + r];
+						outD[r][i] = m[r] * d[0][i] + m[4 + r] * d[1][i] + m[8 + r] * d[2][i];
+					}
+				}
+
+				for (size_t i = 0; i < blockCount; ++i)
+				{
+					const SpotLight& light = pSpots[block + i];
+					ViewSpot& spot = m_Spots[block + i];
+
+					spot.Position = vector_type{ outP[0][i], outP[1][i], outP[2][i] };
+					spot.Direction = vector_type{ outD[0][i], outD[1][i], outD[2][i] };
+					spot.Direction.Normalize();
+					spot.Range = light.Range;
+					spot.Cos = std::cos(light.Angle);
+					spot.Sin = std::sin(light.Angle);
+
+					// The bounding sphere of the cone: wide cones are bounded by their cap, narrow ones by their tip and rim
+					if (spot.Cos < T(0.70710678118654752))
+					{
+						spot.BoundCenter = spot.Position + spot.Direction * (spot.Cos * spot.Range);
+						spot.BoundRadius = spot.Sin * spot.Range;
+					}
+					else
+					{
+						const T half = spot.Range / (T(2) * spot.Cos);
+
+						spot.BoundCenter = spot.Position + spot.Direction * half;
+						spot.BoundRadius = half;
+					}
+				}
+			}
+		});
+	}
+
+	// Culls every light against the clusters of one depth slice, writing slice-local offsets
+	void CullSlice(size_t k)
+	{
+		SliceScratch& scratch = m_Scratch[k];
+
+		scratch.Points.clear();
+		scratch.Spots.clear();
+		scratch.Indices.clear();
+
+		// View space looks down -z, so the slice spans z in [-far, -near]
+		const T zNear = -m_SliceDepths[k];
+		const T zFar = -m_SliceDepths[k + 1];
+
+		for (size_t i = 0; i < m_Points.size(); ++i)
+		{
+			const ViewPoint& light = m_Points[i];
+
+			if (light.Center[2] - light.Radius <= zNear && light.Center[2] + light.Radius >= zFar)
+				scratch.Points.push_back(static_cast<index_type>(i));
+		}
+
+		for (size_t i = 0; i < m_Spots.size(); ++i)
+		{
+			const ViewSpot& light = m_Spots[i];
+
+			if (light.BoundCenter[2] - light.BoundRadius <= zNear && light.BoundCenter[2] + light.BoundRadius >= zFar)
+				scratch.Spots.push_back(static_cast<index_type>(i));
+		}
+
+		for (size_t y = 0; y < m_Settings.TilesY; ++y)
+		{
+			const box_type& row = m_RowBounds[k * m_Settings.TilesY + y];
+
+			scratch.RowPoints.clear();
+			scratch.RowSpots.clear();
+
+			for (index_type i : scratch.Points)
+			{
+				if (detail::SphereIntersectsBox(m_Points[i].Center, m_Points[i].Radius, row))
+					scratch.RowPoints.push_back(i);
+			}
+
+			for (index_type i : scratch.Spots)
+			{
+				if (detail::SphereIntersectsBox(m_Spots[i].BoundCenter, m_Spots[i].BoundRadius, row))
+					scratch.RowSpots.push_back(i);
+			}
+
+			for (size_t x = 0; x < m_Settings.TilesX; ++x)
+			{
+				const size_t cluster = ClusterIndex(x, y, k);
+				const box_type& box = m_Bounds[cluster];
+				const size_t first = scratch.Indices.size();
+
+				for (index_type i : scratch.RowPoints)
+				{
+					if (detail::SphereIntersectsBox(m_Points[i].Center, m_Points[i].Radius, box))
+						scratch.Indices.push_back(i);
+				}
+
+				const size_t firstSpot = scratch.Indices.size();
+
+				for (index_type i : scratch.RowSpots)
+				{
+					const ViewSpot& light = m_Spots[i];
+
+					if (detail::SphereIntersectsBox(light.BoundCenter, light.BoundRadius, box) &&
+						detail::ConeIntersectsSphere(light.Position, light.Direction, light.Range, light.Cos, light.Sin,
+							m_SphereCenters[cluster], m_SphereRadii[cluster]))
+					{
+						scratch.Indices.push_back(i);
+					}
+				}
+
+				m_Clusters[cluster] = Cluster
+				{
+					static_cast<index_type>(first),
+					static_cast<index_type>(firstSpot - first),
+					static_cast<index_type>(scratch.Indices.size() - firstSpot)
+				};
+			}
+		}
+	}
+};
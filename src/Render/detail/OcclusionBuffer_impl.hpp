@@ -0,0 +1,779 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "OcclusionBuffer_decl.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "../../Geometry/AABB.h"
+#include "../../Math/Matrix.h"
+#include "../../Math/Vector.h"
+#include "../../Parallel/BatchBlock.hpp"
+#include "../../Parallel/ParallelFor.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// detail
+namespace Epic::detail
+{
+	// ProjectBoxLane - Projects the corners of a box through the column-major view-projection m.
+	//	Writes the screen-space bounds in pixels (min x, min y, max x, max y) and the nearest window depth to rect.
+	//	Returns true when the box straddles the near plane, in which case rect is meaningless. A box entirely behind
+	//	the near plane is reported as lying beyond the far plane instead.
+	template<class T>
+	inline bool ProjectBoxLane(const T* m, const T* lo, const T* hi, T width, T height, T* rect) noexcept
+	{
+		T minX = std::numeric_limits<T>::max(), minY = minX, minZ = minX;
+		T maxX = std::numeric_limits<T>::lowest(), maxY = maxX;
+		bool anyBehind = false;
+		bool allBehind = true;
+
+		for (size_t corner = 0; corner < 8; ++corner)
+		{
+			const T x = (corner & 1) ? hi[0] : lo[0];
+			const T y = (corner & 2) ? hi[1] : lo[1];
+			const T z = (corner & 4) ? hi[2] : lo[2];
+
+			const T cx = m[0] * x + m[4] * y + m[8] * z + m[12];
+			const T cy = m[1] * x + m[5] * y + m[9] * z + m[13];
+			const T cz = m[2] * x + m[6] * y + m[10] * z + m[14];
+			const T cw = m[3] * x + m[7] * y + m[11] * z + m[15];
+
+			const bool behind = ((cz + cw) <= T(0)) | (cw <= T(0));
+
+			anyBehind |= behind;
+			allBehind &= behind;
+
+			const T invW = T(1) / std::max(cw, std::numeric_limits<T>::min());
+
+			minX = std::min(minX, cx * invW);
+			maxX = std::max(maxX, cx * invW);
+			minY = std::min(minY, cy * invW);
+			maxY = std::max(maxY, cy * invW);
+			minZ = std::min(minZ, cz * invW);
+		}
+
+		rect[0] = (minX * T(0.5) + T(0.5)) * width;
+		rect[1] = (minY * T(0.5) + T(0.5)) * height;
+		rect[2] = (maxX * T(0.5) + T(0.5)) * width;
+		rect[3] = (maxY * T(0.5) + T(0.5)) * height;
+		rect[4] = allBehind ? T(2) : minZ * T(0.5) + T(0.5);
+
+		return anyBehind & !allBehind;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// OcclusionBuffer
+//	A depth-only software rasterizer for occlusion culling.
+//	Occluder vertices are transformed in blocks, their triangles clipped against the near plane and set up as
+//	edge and depth plane equations, then binned into screen tiles. Tiles rasterize independently on worker
+//	threads and each reduces its own pixels into the lower levels of a max-depth hierarchy, so that occludee
+//	boxes can be tested against a handful of texels regardless of their size on screen.
+//	Depth is stored as window depth in [0, 1] (OpenGL clip conventions) and the buffer is cleared to the far plane.
+template<class T>
+class Epic::OcclusionBuffer
+{
+	static_assert(std::is_floating_point_v<T>, "OcclusionBuffer requires floating point depth.");
+
+public:
+	using type = Epic::OcclusionBuffer<T>;
+	using value_type = T;
+	using vector_type = Epic::Vector<T, 3>;
+	using matrix_type = Epic::Matrix<T, 4>;
+	using box_type = Epic::AABB<T>;
+	using index_type = std::uint32_t;
+
+	// Settings - Buffer dimensions
+	//	Width and Height are rounded up to a multiple of TileSize, which must be a power of two.
+	//	When CullBackFaces is set, occluder triangles that wind clockwise on screen are skipped.
+	struct Settings
+	{
+		size_t Width = 512;
+		size_t Height = 256;
+		size_t TileSize = 32;
+		bool CullBackFaces = true;
+	};
+
+	// One level of the depth hierarchy; each texel holds the farthest depth of the pixels beneath it
+	struct Level
+	{
+		size_t Width;
+		size_t Height;
+		std::vector<T> Depth;
+	};
+
+private:
+	static constexpr size_t MinGrainSize = 4096;
+	static constexpr size_t MinBoxGrainSize = 1024;
+
+	// The edge functions (A x + B y + C >= 0 inside), depth plane and clamped pixel bounds of a screen triangle
+	struct Triangle
+	{
+		T EdgeA[3];
+		T InvEdgeA[3];
+		T EdgeB[3];
+		T EdgeC[3];
+		T DepthA;
+		T DepthB;
+		T DepthC;
+		std::int32_t MinX;
+		std::int32_t MinY;
+		std::int32_t MaxX;
+		std::int32_t MaxY;
+	};
+
+private:
+	Settings m_Settings;
+	matrix_type m_ViewProjection;
+	size_t m_TilesX = 0;
+	size_t m_TilesY = 0;
+	size_t m_TileShift = 0;
+
+	std::vector<Level> m_Levels;
+	std::array<std::vector<T>, 4> m_Clip;
+
+	// Triangle slots; setup gives each source triangle two slots (a near-clipped triangle can split into two),
+	//	so chunks write their triangles in place. Unused slots are marked empty. The storage only ever grows.
+	std::vector<Triangle> m_Triangles;
+	size_t m_SlotCount = 0;
+	size_t m_TriangleCount = 0;
+
+	std::vector<index_type> m_BinStart;
+	std::vector<index_type> m_Bins;
+	std::vector<index_type> m_ChunkCounts;
+
+public:
+	OcclusionBuffer() noexcept
+		: OcclusionBuffer(Settings{ })
+	{ }
+
+	explicit OcclusionBuffer(const Settings& settings) noexcept
+		: m_ViewProjection{ Epic::Identity }
+	{
+		SetSettings(settings);
+	}
+
+	OcclusionBuffer(const OcclusionBuffer&) = default;
+	OcclusionBuffer(OcclusionBuffer&&) noexcept = default;
+	~OcclusionBuffer() = default;
+
+	OcclusionBuffer& operator = (const OcclusionBuffer&) = default;
+	OcclusionBuffer& operator = (OcclusionBuffer&&) noexcept = default;
+
+public:
+	const Settings& GetSettings() const noexcept { return m_Settings; }
+
+	// Changing the settings reallocates the buffer and discards any queued occluders
+	void SetSettings(const Settings& settings) noexcept
+	{
+		assert(settings.TileSize > 0 && (settings.TileSize & (settings.TileSize - 1)) == 0);
+
+		m_Settings = settings;
+		m_TileShift = 0;
+
+		while ((size_t(1) << m_TileShift) < m_Settings.TileSize)
+			++m_TileShift;
+
+		m_TilesX = std::max((m_Settings.Width + m_Settings.TileSize - 1) >> m_TileShift, size_t(1));
+		m_TilesY = std::max((m_Settings.Height + m_Settings.TileSize - 1) >> m_TileShift, size_t(1));
+		m_Settings.Width = m_TilesX << m_TileShift;
+		m_Settings.Height = m_TilesY << m_TileShift;
+
+		m_Levels.clear();
+
+		size_t width = m_Settings.Width;
+		size_t height = m_Settings.Height;
+
+		for (;;)
+		{
+			m_Levels.push_back(Level{ width, height, std::vector<T>(width * height, T(1)) });
+
+			if (width == 1 && height == 1)
+				break;
+
+			width = (width + 1) / 2;
+			height = (height + 1) / 2;
+		}
+
+		m_SlotCount = 0;
+		m_TriangleCount = 0;
+	}
+
+public:
+	size_t Width() const noexcept { return m_Settings.Width; }
+	size_t Height() const noexcept { return m_Settings.Height; }
+	size_t TileCount() const noexcept { return m_TilesX * m_TilesY; }
+	size_t TriangleCount() const noexcept { return m_TriangleCount; }
+	size_t LevelCount() const noexcept { return m_Levels.size(); }
+
+	const matrix_type& ViewProjection() const noexcept { return m_ViewProjection; }
+	const Level& GetLevel(size_t level) const noexcept { assert(level < m_Levels.size()); return m_Levels[level]; }
+
+	// The rasterized depth of pixel (x, y), with row 0 at the bottom of the screen
+	T Depth(size_t x, size_t y) const noexcept
+	{
+		assert(x < m_Settings.Width && y < m_Settings.Height);
+
+		return m_Levels[0].Depth[y * m_Settings.Width + x];
+	}
+
+public:
+	// Begins a frame, discarding the occluders queued for the previous one
+	void Begin(const matrix_type& viewProjection) noexcept
+	{
+		m_ViewProjection = viewProjection;
+		m_SlotCount = 0;
+		m_TriangleCount = 0;
+	}
+
+	// Queues an indexed triangle list of world-space occluders
+	void AddOccluders(const vector_type* pVertices, size_t vertexCount, const index_type* pIndices, size_t indexCount)
+	{
+		AddTriangles(m_ViewProjection, pVertices, vertexCount, pIndices, indexCount);
+	}
+
+	// Queues an indexed triangle list of occluders in the space of model
+	void AddOccluders(const matrix_type& model, const vector_type* pVertices, size_t vertexCount, const index_type* pIndices, size_t indexCount)
+	{
+		AddTriangles(m_ViewProjection * model, pVertices, vertexCount, pIndices, indexCount);
+	}
+
+	// Bins the queued occluders into tiles, rasterizes the tiles in parallel and rebuilds the depth hierarchy
+	void Rasterize()
+	{
+		const size_t tileCount = TileCount();
+		const size_t slotCount = m_SlotCount;
+		const size_t grainSize = ParallelGrainSize(slotCount, MinGrainSize);
+		const size_t chunkCount = std::max(ParallelChunkCount(slotCount, grainSize), size_t(1));
+
+		m_ChunkCounts.assign(chunkCount * tileCount, index_type(0));
+
+		// Count the tiles overlapped by each chunk of triangles
+		ParallelForChunks(0, slotCount, grainSize, [&](size_t chunk, size_t begin, size_t end)
+		{
+			index_type* pCounts = &m_ChunkCounts[chunk * tileCount];
+
+			for (size_t i = begin; i < end; ++i)
+				ForEachTile(m_Triangles[i], [&](size_t tile) { ++pCounts[tile]; });
+		});
+
+		// Convert the counts into scatter offsets (tile-major, chunk-minor keeps submission order within a tile)
+		m_BinStart.resize(tileCount + 1);
+
+		index_type offset = 0;
+		for (size_t tile = 0; tile < tileCount; ++tile)
+		{
+			m_BinStart[tile] = offset;
+
+			for (size_t c = 0; c < chunkCount; ++c)
+			{
+				index_type& slot = m_ChunkCounts[c * tileCount + tile];
+				const index_type binCount = slot;
+
+				slot = offset;
+				offset += binCount;
+			}
+		}
+
+		m_BinStart[tileCount] = offset;
+		m_Bins.resize(offset);
+
+		ParallelForChunks(0, slotCount, grainSize, [&](size_t chunk, size_t begin, size_t end)
+		{
+			index_type* pOffsets = &m_ChunkCounts[chunk * tileCount];
+
+			for (size_t i = begin; i < end; ++i)
+				ForEachTile(m_Triangles[i], [&](size_t tile) { m_Bins[pOffsets[tile]++] = static_cast<index_type>(i); });
+		});
+
+		ParallelFor(0, tileCount, 1, [&](size_t begin, size_t end)
+		{
+			for (size_t tile = begin; tile < end; ++tile)
+				RasterizeTile(tile);
+		});
+
+		// The levels above the tile size reduce a level at a time, in parallel rows once a level is large enough
+		for (size_t level = m_TileShift + 1; level < m_Levels.size(); ++level)
+		{
+			const Level& src = m_Levels[level - 1];
+			Level& dst = m_Levels[level];
+
+			const size_t rowGrainSize = std::max(MinGrainSize / dst.Width, size_t(1));
+
+			ParallelFor(0, dst.Height, rowGrainSize, [&](size_t begin, size_t end)
+			{
+				for (size_t y = begin; y < end; ++y)
+				{
+					const size_t y0 = 2 * y;
+					const size_t y1 = std::min(y0 + 1, src.Height - 1);
+
+					for (size_t x = 0; x < dst.Width; ++x)
+					{
+						const size_t x0 = 2 * x;
+						const size_t x1 = std::min(x0 + 1, src.Width - 1);
+
+						dst.Depth[y * dst.Width + x] = std::max(
+							std::max(src.Depth[y0 * src.Width + x0], src.Depth[y0 * src.Width + x1]),
+							std::max(src.Depth[y1 * src.Width + x0], src.Depth[y1 * src.Width + x1]));
+					}
+				}
+			});
+		}
+	}
+
+public:
+	// Tests whether any part of box may be visible past the rasterized occluders.
+	//	Boxes crossing the near plane are always visible; boxes outside the viewport or beyond the far plane never are.
+	bool IsVisible(const box_type& box) const noexcept
+	{
+		T m[16];
+		T rect[5];
+
+		for (size_t n = 0; n < 16; ++n)
+			m[n] = m_ViewProjection.Values[n];
+
+		const T lo[3] = { box.Min[0], box.Min[1], box.Min[2] };
+		const T hi[3] = { box.Max[0], box.Max[1], box.Max[2] };
+
+		const bool straddles = detail::ProjectBoxLane(m, lo, hi, T(m_Settings.Width), T(m_Settings.Height), rect);
+
+		return TestRect(rect, straddles);
+	}
+
+	// BatchIsVisible - Tests count boxes, writing 1 to pResults for each one that may be visible and 0 otherwise.
+	//	Boxes are projected in blocks of lanes through the branch-free corner kernel, then tested against the hierarchy.
+	void BatchIsVisible(const box_type* pBoxes, size_t count, std::uint8_t* pResults) const noexcept
+	{
+		constexpr size_t BlockSize = detail::BatchBlockSize;
+
+		T m[16];
+
+		for (size_t n = 0; n < 16; ++n)
+			m[n] = m_ViewProjection.Values[n];
+
+		const T width = T(m_Settings.Width);
+		const T height = T(m_Settings.Height);
+
+		ParallelFor(0, count, ParallelGrainSize(count, MinBoxGrainSize), [&](size_t begin, size_t end)
+		{
+			T lo[3][BlockSize];
+			T hi[3][BlockSize];
+			T rect[5][BlockSize];
+			bool straddles[BlockSize];
+
+			for (size_t block = begin; block < end; block += BlockSize)
+			{
+				const size_t blockCount = std::min(BlockSize, end - block);
+
+				for (size_t i = 0; i < blockCount; ++i)
+				{
+					for (size_t k = 0; k < 3; ++k)
+					{
+						lo[k][i] = pBoxes[block + i].Min[k];
+						hi[k][i] = pBoxes[block + i].Max[k];
+					}
+				}
+
+				for (size_t i = 0; i < blockCount; ++i)
+				{
+					const T loLane[3] = { lo[0][i], lo[1][i], lo[2][i] };
+					const T hiLane[3] = { hi[0][i], hi[1][i], hi[2][i] };
+					T rectLane[5];
+
+					straddles[i] = detail::ProjectBoxLane(m, loLane, hiLane, width, height, rectLane);
+
+					for (size_t k = 0; k < 5; ++k)
+						rect[k][i] = rectLane[k];
+				}
+
+				for (size_t i = 0; i < blockCount; ++i)
+				{
+					const T rectLane[5] = { rect[0][i], rect[1][i], rect[2][i], rect[3][i], rect[4][i] };
+
+					pResults[block + i] = TestRect(rectLane, straddles[i]) ? 1 : 0;
+				}
+			}
+		});
+	}
+
+private:
+	void AddTriangles(const matrix_type& mvp, const vector_type* pVertices, size_t vertexCount, const index_type* pIndices, size_t indexCount)
+	{
+		assert(indexCount % 3 == 0);
+
+		TransformVertices(mvp, pVertices, vertexCount);
+
+		const size_t triangleCount = indexCount / 3;
+		const size_t grainSize = ParallelGrainSize(triangleCount, MinGrainSize);
+		const size_t slotBase = m_SlotCount;
+
+		// Growing is the only serial step, and only happens while the storage warms up
+		if (m_Triangles.size() < slotBase + 2 * triangleCount)
+			m_Triangles.resize(std::max(slotBase + 2 * triangleCount, m_Triangles.size() * 2));
+
+		std::atomic<size_t> emitted{ 0 };
+
+		ParallelForChunks(0, triangleCount, grainSize, [&](size_t, size_t begin, size_t end)
+		{
+			Triangle* const pFirst = m_Triangles.data() + slotBase + 2 * begin;
+			Triangle* const pLast = m_Triangles.data() + slotBase + 2 * end;
+			Triangle* pOut = pFirst;
+
+			for (size_t t = begin; t < end; ++t)
+			{
+				assert(pIndices[3 * t + 0] < vertexCount);
+				assert(pIndices[3 * t + 1] < vertexCount);
+				assert(pIndices[3 * t + 2] < vertexCount);
+
+				SetupTriangle(pIndices[3 * t + 0], pIndices[3 * t + 1], pIndices[3 * t + 2], pOut);
+			}
+
+			emitted.fetch_add(size_t(pOut - pFirst), std::memory_order_relaxed);
+
+			for (; pOut < pLast; ++pOut)
+			{
+				pOut->MinX = 0;
+				pOut->MaxX = -1;
+			}
+		});
+
+		m_SlotCount = slotBase + 2 * triangleCount;
+		m_TriangleCount += emitted.load(std::memory_order_relaxed);
+	}
+
+	// Transforms the vertices to clip space in blocks of lanes, one clip component at a time
+	void TransformVertices(const matrix_type& mvp, const vector_type* pVertices, size_t count)
+	{
+		constexpr size_t BlockSize = detail::BatchBlockSize;
+
+		// Only grow, so that a smaller mesh does not cost a serial clear of the next larger one
+		for (auto& component : m_Clip)
+		{
+			if (component.size() < count)
+				component.resize(count);
+		}
+
+		T m[16];
+
+		for (size_t n = 0; n < 16; ++n)
+			m[n] = mvp.Values[n];
+
+		ParallelFor(0, count, ParallelGrainSize(count, MinGrainSize), [&](size_t begin, size_t end)
+		{
+			T x[BlockSize];
+			T y[BlockSize];
+			T z[BlockSize];
+
+			for (size_t block = begin; block < end; block += BlockSize)
+			{
+				const size_t blockCount = std::min(BlockSize, end - block);
+
+				for (size_t i = 0; i < blockCount; ++i)
+				{
+					x[i] = pVertices[block + i][0];
+					y[i] = pVertices[block + i][1];
+					z[i] = pVertices[block + i][2];
+				}
+
+				for (size_t r = 0; r < 4; ++r)
+				{
+					T* pOut = m_Clip[r].data() + block;
+					const T mx = m[r], my = m[4 + r], mz = m[8 + r], mw = m[12 + r];
+
+					for (size_t i = 0; i < blockCount; ++i)
+						pOut[i] = mx * x[i] + my * y[i] + mz * z[i] + mw;
+				}
+			}
+		});
+	}
+
+	// Rejects triangles outside the frustum and clips the rest against the near plane (z = -w)
+	void SetupTriangle(index_type i0, index_type i1, index_type i2, Triangle*& pOut) const
+	{
+		T v[3][4];
+		const index_type indices[3] = { i0, i1, i2 };
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			for (size_t c = 0; c < 4; ++c)
+				v[k][c] = m_Clip[c][indices[k]];
+		}
+
+		const auto allOutside = [&](size_t axis, T sign)
+		{
+			return (sign * v[0][axis] > v[0][3]) && (sign * v[1][axis] > v[1][3]) && (sign * v[2][axis] > v[2][3]);
+		};
+
+		if (allOutside(0, T(-1)) || allOutside(0, T(1)) || allOutside(1, T(-1)) || allOutside(1, T(1)) || allOutside(2, T(1)))
+			return;
+
+		const T d[3] = { v[0][2] + v[0][3], v[1][2] + v[1][3], v[2][2] + v[2][3] };
+
+		if (d[0] >= T(0) && d[1] >= T(0) && d[2] >= T(0))
+		{
+			EmitTriangle(v[0], v[1], v[2], pOut);
+			return;
+		}
+
+		// Sutherland-Hodgman against the near plane leaves a triangle or a quad
+		T polygon[4][4];
+		size_t count = 0;
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			const size_t j = (k + 1) % 3;
+
+			if (d[k] >= T(0))
+			{
+				std::copy(v[k], v[k] + 4, polygon[count++]);
+			}
+
+			if ((d[k] >= T(0)) != (d[j] >= T(0)))
+			{
+				const T t = d[k] / (d[k] - d[j]);
+
+				for (size_t c = 0; c < 4; ++c)
+					polygon[count][c] = v[k][c] + (v[j][c] - v[k][c]) * t;
+
+				++count;
+			}
+		}
+
+		for (size_t k = 2; k < count; ++k)
+			EmitTriangle(polygon[0], polygon[k - 1], polygon[k], pOut);
+	}
+
+	void EmitTriangle(const T* a, const T* b, const T* c, Triangle*& pOut) const
+	{
+		const T* clip[3] = { a, b, c };
+		const T width = T(m_Settings.Width);
+		const T height = T(m_Settings.Height);
+
+		T sx[3], sy[3], sz[3];
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			if (clip[k][3] <= T(0))
+				return;
+
+			const T invW = T(1) / clip[k][3];
+
+			sx[k] = (clip[k][0] * invW * T(0.5) + T(0.5)) * width;
+			sy[k] = (clip[k][1] * invW * T(0.5) + T(0.5)) * height;
+			sz[k] = clip[k][2] * invW * T(0.5) + T(0.5);
+		}
+
+		T area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sx[2] - sx[0]) * (sy[1] - sy[0]);
+
+		if (!(std::abs(area) > T(0)))
+			return;
+
+		// Wind every triangle counter-clockwise so that the inside is where all edge functions are positive
+		if (area < T(0))
+		{
+			if (m_Settings.CullBackFaces)
+				return;
+
+			std::swap(sx[1], sx[2]);
+			std::swap(sy[1], sy[2]);
+			std::swap(sz[1], sz[2]);
+			area = -area;
+		}
+
+		// Only pixels whose centers lie within the bounds can be covered
+		const auto pixelRange = [](T lo, T hi, T size, std::int32_t& first, std::int32_t& last)
+		{
+			first = static_cast<std::int32_t>(std::ceil(std::clamp(lo - T(0.5), T(0), size)));
+			last = static_cast<std::int32_t>(std::floor(std::clamp(hi - T(0.5), T(-1), size - T(1))));
+		};
+
+		Triangle triangle;
+
+		pixelRange(std::min({ sx[0], sx[1], sx[2] }), std::max({ sx[0], sx[1], sx[2] }), width, triangle.MinX, triangle.MaxX);
+		pixelRange(std::min({ sy[0], sy[1], sy[2] }), std::max({ sy[0], sy[1], sy[2] }), height, triangle.MinY, triangle.MaxY);
+
+		if (triangle.MinX > triangle.MaxX || triangle.MinY > triangle.MaxY)
+			return;
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			const size_t j = (k + 1) % 3;
+
+			triangle.EdgeA[k] = sy[k] - sy[j];
+			triangle.InvEdgeA[k] = (triangle.EdgeA[k] != T(0)) ? T(1) / triangle.EdgeA[k] : T(0);
+			triangle.EdgeB[k] = sx[j] - sx[k];
+			triangle.EdgeC[k] = sx[k] * sy[j] - sy[k] * sx[j];
+		}
+
+		const T invArea = T(1) / area;
+
+		triangle.DepthA = ((sz[1] - sz[0]) * (sy[2] - sy[0]) - (sz[2] - sz[0]) * (sy[1] - sy[0])) * invArea;
+		triangle.DepthB = ((sz[2] - sz[0]) * (sx[1] - sx[0]) - (sz[1] - sz[0]) * (sx[2] - sx[0])) * invArea;
+		triangle.DepthC = sz[0] - triangle.DepthA * sx[0] - triangle.DepthB * sy[0];
+
+		*pOut++ = triangle;
+	}
+
+	template<class Function>
+	void ForEachTile(const Triangle& triangle, Function fn) const
+	{
+		// Empty slot
+		if (triangle.MinX > triangle.MaxX)
+			return;
+
+		const size_t tx0 = size_t(triangle.MinX) >> m_TileShift;
+		const size_t tx1 = size_t(triangle.MaxX) >> m_TileShift;
+		const size_t ty0 = size_t(triangle.MinY) >> m_TileShift;
+		const size_t ty1 = size_t(triangle.MaxY) >> m_TileShift;
+
+		for (size_t ty = ty0; ty <= ty1; ++ty)
+		{
+			for (size_t tx = tx0; tx <= tx1; ++tx)
+				fn(ty * m_TilesX + tx);
+		}
+	}
+
+	// Clears and rasterizes one tile, then reduces it into every hierarchy level finer than a tile
+	void RasterizeTile(size_t tile)
+	{
+		const std::int32_t tileSize = static_cast<std::int32_t>(m_Settings.TileSize);
+		const std::int32_t tileX = static_cast<std::int32_t>(tile % m_TilesX) * tileSize;
+		const std::int32_t tileY = static_cast<std::int32_t>(tile / m_TilesX) * tileSize;
+		const size_t width = m_Settings.Width;
+
+		T* pDepth = m_Levels[0].Depth.data();
+
+		for (std::int32_t y = tileY; y < tileY + tileSize; ++y)
+			std::fill_n(pDepth + y * width + tileX, tileSize, T(1));
+
+		for (index_type b = m_BinStart[tile]; b < m_BinStart[tile + 1]; ++b)
+		{
+			const Triangle& triangle = m_Triangles[m_Bins[b]];
+
+			const std::int32_t minX = std::max(triangle.MinX, tileX);
+			const std::int32_t maxX = std::min(triangle.MaxX, tileX + tileSize - 1);
+			const std::int32_t minY = std::max(triangle.MinY, tileY);
+			const std::int32_t maxY = std::min(triangle.MaxY, tileY + tileSize - 1);
+
+			const T px = T(minX) + T(0.5);
+
+			for (std::int32_t y = minY; y <= maxY; ++y)
+			{
+				const T py = T(y) + T(0.5);
+
+				// Solve each edge function for the covered span of the row rather than testing every pixel.
+				//	The solutions are clamped to the row before rounding, so truncation can stand in for ceil and floor.
+				const T spanLength = T(maxX - minX);
+				T first = T(0);
+				T last = spanLength;
+
+				for (size_t k = 0; k < 3; ++k)
+				{
+					const T a = triangle.EdgeA[k];
+					const T e = a * px + triangle.EdgeB[k] * py + triangle.EdgeC[k];
+					const T x = -e * triangle.InvEdgeA[k];
+
+					if (a > T(0))
+						first = std::max(first, std::min(x, spanLength + T(1)));
+					else if (a < T(0))
+						last = std::min(last, std::max(x, T(-1)));
+					else if (e < T(0))
+						last = T(-1);
+				}
+
+				std::int32_t begin = static_cast<std::int32_t>(first);
+				begin += (T(begin) < first) ? 1 : 0;
+
+				const std::int32_t end = static_cast<std::int32_t>(last + T(1));
+				const std::int32_t count = end - begin;
+
+				if (count <= 0)
+					continue;
+
+				const T z = triangle.DepthA * (px + T(begin)) + triangle.DepthB * py + triangle.DepthC;
+				T* pSpan = pDepth + y * width + minX + begin;
+
+				for (std::int32_t x = 0; x < count; ++x)
+					pSpan[x] = std::min(pSpan[x], z + triangle.DepthA * T(x));
+			}
+		}
+
+		for (size_t level = 1; level <= m_TileShift; ++level)
+		{
+			const Level& src = m_Levels[level - 1];
+			Level& dst = m_Levels[level];
+
+			const size_t size = m_Settings.TileSize >> level;
+			const size_t dstX = (tile % m_TilesX) * size;
+			const size_t dstY = (tile / m_TilesX) * size;
+
+			for (size_t y = dstY; y < dstY + size; ++y)
+			{
+				const T* pRow0 = &src.Depth[(2 * y) * src.Width];
+				const T* pRow1 = pRow0 + src.Width;
+				T* pOut = &dst.Depth[y * dst.Width];
+
+				for (size_t x = dstX; x < dstX + size; ++x)
+					pOut[x] = std::max(std::max(pRow0[2 * x], pRow0[2 * x + 1]), std::max(pRow1[2 * x], pRow1[2 * x + 1]));
+			}
+		}
+	}
+
+	// Tests a projected box against the coarsest level at which it spans no more than 4x4 texels
+	bool TestRect(const T* rect, bool straddles) const noexcept
+	{
+		if (straddles)
+			return true;
+
+		const T width = T(m_Settings.Width);
+		const T height = T(m_Settings.Height);
+
+		if (rect[4] > T(1) || rect[2] < T(0) || rect[3] < T(0) || rect[0] >= width || rect[1] >= height)
+			return false;
+
+		const size_t x0 = static_cast<size_t>(std::max(rect[0], T(0)));
+		const size_t y0 = static_cast<size_t>(std::max(rect[1], T(0)));
+		const size_t x1 = static_cast<size_t>(std::min(rect[2], width - T(1)));
+		const size_t y1 = static_cast<size_t>(std::min(rect[3], height - T(1)));
+
+		size_t level = 0;
+
+		while (level + 1 < m_Levels.size() && (((x1 >> level) - (x0 >> level)) >= 4 || ((y1 >> level) - (y0 >> level)) >= 4))
+			++level;
+
+		const Level& texels = m_Levels[level];
+
+		for (size_t y = y0 >> level; y <= (y1 >> level); ++y)
+		{
+			for (size_t x = x0 >> level; x <= (x1 >> level); ++x)
+			{
+				if (rect[4] <= texels.Depth[y * texels.Width + x])
+					return true;
+			}
+		}
+
+		return false;
+	}
+};
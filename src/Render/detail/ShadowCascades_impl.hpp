@@ -0,0 +1,327 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShadowCascades_decl.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "../../Geometry/AABB.h"
+#include "../../Math/Matrix.h"
+#include "../../Math/Vector.h"
+#include "../../Parallel/BatchBlock.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// ShadowCascades
+//	Splits a camera frustum into depth slices and fits a texel-snapped orthographic shadow projection to each.
+//	The slice corners of every split are computed together and transformed to light space in blocks of lanes.
+//	Each cascade is fitted to the bounding sphere of its slice, whose radius does not change as the camera turns,
+//	and its center is snapped to whole shadow map texels so that moving the camera does not make shadow edges shimmer.
+//	A tighter light-space box around each slice can also be produced for culling shadow casters.
+template<class T>
+class Epic::ShadowCascades
+{
+	static_assert(std::is_floating_point_v<T>, "ShadowCascades requires floating point positions.");
+
+public:
+	using type = Epic::ShadowCascades<T>;
+	using value_type = T;
+	using vector_type = Epic::Vector<T, 3>;
+	using matrix_type = Epic::Matrix<T, 4>;
+	using box_type = Epic::AABB<T>;
+
+	// Settings - Split and fitting parameters
+	//	SplitLambda blends logarithmic (1) and uniform (0) split distances. A nonzero MaxDistance ends the last
+	//	cascade before the camera's far plane. CasterDistance extends each cascade toward the light so that
+	//	casters outside the view still shadow it. FitCullingBounds enables the per-cascade culling boxes.
+	struct Settings
+	{
+		size_t CascadeCount = 4;
+		size_t Resolution = 2048;
+		T SplitLambda = T(0.75);
+		T MaxDistance = T(0);
+		T CasterDistance = T(0);
+		bool FitCullingBounds = true;
+	};
+
+	struct Cascade
+	{
+		T Near;
+		T Far;
+		T Radius;
+		T TexelSize;
+		matrix_type Projection;
+		matrix_type ViewProjection;
+		box_type CullingBounds;
+		matrix_type CullingViewProjection;
+	};
+
+private:
+	Settings m_Settings;
+	matrix_type m_LightView;
+
+	std::vector<T> m_Splits;
+	std::vector<vector_type> m_Corners;
+	std::vector<vector_type> m_LightCorners;
+	std::vector<Cascade> m_Cascades;
+
+public:
+	ShadowCascades() noexcept
+		: m_LightView{ Epic::Identity }
+	{ }
+
+	explicit ShadowCascades(const Settings& settings) noexcept
+		: m_Settings{ settings }, m_LightView{ Epic::Identity }
+	{ }
+
+	ShadowCascades(const ShadowCascades&) = default;
+	ShadowCascades(ShadowCascades&&) noexcept = default;
+	~ShadowCascades() = default;
+
+	ShadowCascades& operator = (const ShadowCascades&) = default;
+	ShadowCascades& operator = (ShadowCascades&&) noexcept = default;
+
+public:
+	const Settings& GetSettings() const noexcept { return m_Settings; }
+	void SetSettings(const Settings& settings) noexcept { m_Settings = settings; }
+
+public:
+	size_t CascadeCount() const noexcept { return m_Cascades.size(); }
+	const Cascade& GetCascade(size_t cascade) const noexcept { assert(cascade < m_Cascades.size()); return m_Cascades[cascade]; }
+	const std::vector<Cascade>& Cascades() const noexcept { return m_Cascades; }
+
+	// The rotation from world space to light space, shared by every cascade
+	const matrix_type& LightView() const noexcept { return m_LightView; }
+
+	// The view distances of the splits; cascade i covers [Splits()[i], Splits()[i + 1]]
+	const std::vector<T>& Splits() const noexcept { return m_Splits; }
+
+	// The world-space corners of the split planes, four per split (bottom-left, bottom-right, top-left, top-right)
+	const std::vector<vector_type>& Corners() const noexcept { return m_Corners; }
+
+public:
+	// ComputeSplits - Writes count + 1 practical split distances from znear to zfar (Zhang et al., 2006)
+	static void ComputeSplits(T znear, T zfar, size_t count, T lambda, T* pSplits) noexcept
+	{
+		assert(count > 0);
+		assert(znear > T(0) && zfar > znear);
+
+		for (size_t i = 0; i <= count; ++i)
+		{
+			const T t = T(i) / T(count);
+			const T logarithmic = znear * std::pow(zfar / znear, t);
+			const T uniform = znear + (zfar - znear) * t;
+
+			pSplits[i] = lambda * logarithmic + (T(1) - lambda) * uniform;
+		}
+
+		pSplits[0] = znear;
+		pSplits[count] = zfar;
+	}
+
+	// Fits the cascades to a camera looking down -z in view space, lit along lightDirection (the direction light travels)
+	void Update(const matrix_type& view, const matrix_type& projection, const vector_type& lightDirection)
+	{
+		const size_t count = m_Settings.CascadeCount;
+
+		assert(count > 0 && m_Settings.Resolution > 2);
+
+		const matrix_type inverse = matrix_type::InverseOf(projection * view);
+
+		const auto unproject = [&](T x, T y, T z)
+		{
+			const auto p = inverse * Vector<T, 4>{ x, y, z, T(1) };
+
+			return vector_type{ p[0] / p[3], p[1] / p[3], p[2] / p[3] };
+		};
+
+		const auto depthOf = [&](const vector_type& p)
+		{
+			return -(view.Values[2] * p[0] + view.Values[6] * p[1] + view.Values[10] * p[2] + view.Values[14]);
+		};
+
+		// The camera near plane and NDC z = 0 are finite even for an infinite projection
+		vector_type origins[4];
+		vector_type directions[4];
+
+		for (size_t c = 0; c < 4; ++c)
+		{
+			const T x = (c & 1) ? T(1) : T(-1);
+			const T y = (c & 2) ? T(1) : T(-1);
+
+			const vector_type a = unproject(x, y, T(-1));
+			const vector_type b = unproject(x, y, T(0));
+
+			origins[c] = a;
+			directions[c] = (b - a) / (depthOf(b) - depthOf(a));
+		}
+
+		const T znear = depthOf(origins[0]);
+		const auto farPoint = inverse * Vector<T, 4>{ T(0), T(0), T(1), T(1) };
+
+		T zfar = (std::abs(farPoint[3]) > std::numeric_limits<T>::epsilon() * std::abs(farPoint[2]))
+			? depthOf(vector_type{ farPoint[0] / farPoint[3], farPoint[1] / farPoint[3], farPoint[2] / farPoint[3] })
+			: std::numeric_limits<T>::infinity();
+
+		if (m_Settings.MaxDistance > T(0))
+			zfar = std::min(zfar, m_Settings.MaxDistance);
+
+		assert(std::isfinite(zfar));
+
+		m_Splits.resize(count + 1);
+		ComputeSplits(znear, zfar, count, m_Settings.SplitLambda, m_Splits.data());
+
+		m_Corners.resize(4 * (count + 1));
+
+		for (size_t i = 0; i <= count; ++i)
+		{
+			for (size_t c = 0; c < 4; ++c)
+				m_Corners[4 * i + c] = origins[c] + directions[c] * (m_Splits[i] - znear);
+		}
+
+		m_LightView = LightViewOf(lightDirection);
+		TransformCorners();
+
+		m_Cascades.resize(count);
+
+		for (size_t i = 0; i < count; ++i)
+			FitCascade(i);
+	}
+
+private:
+	// A rotation whose -z axis points along the light
+	static matrix_type LightViewOf(const vector_type& lightDirection) noexcept
+	{
+		vector_type forward = lightDirection;
+		forward.Normalize();
+
+		const vector_type up = (std::abs(forward[1]) < T(0.99)) ? vector_type{ T(0), T(1), T(0) } : vector_type{ T(1), T(0), T(0) };
+
+		vector_type right = forward.Cross(up);
+		right.Normalize();
+
+		const vector_type upAxis = right.Cross(forward);
+
+		matrix_type result = Epic::Identity;
+
+		for (size_t k = 0; k < 3; ++k)
+		{
+			result.Values[k * 4 + 0] = right[k];
+			result.Values[k * 4 + 1] = upAxis[k];
+			result.Values[k * 4 + 2] = -forward[k];
+		}
+
+		return result;
+	}
+
+	// Transforms every split corner to light space in blocks of lanes
+	void TransformCorners()
+	{
+		constexpr size_t BlockSize = detail::BatchBlockSize;
+
+		const size_t count = m_Corners.size();
+		const auto& m = m_LightView.Values;
+
+		m_LightCorners.resize(count);
+
+		T p[3][BlockSize];
+		T out[3][BlockSize];
+
+		for (size_t block = 0; block < count; block += BlockSize)
+		{
+			const size_t blockCount = std::min(BlockSize, count - block);
+
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				for (size_t k = 0; k < 3; ++k)
+					p[k][i] = m_Corners[block + i][k];
+			}
+
+			for (size_t r = 0; r < 3; ++r)
+			{
+				for (size_t i = 0; i < blockCount; ++i)
+					out[r][i] = m[r] * p[0][i] + m[4 + r] * p[1][i] + m[8 + r] * p[2][i] + m[12 + r];
+			}
+
+			for (size_t i = 0; i < blockCount; ++i)
+				m_LightCorners[block + i] = vector_type{ out[0][i], out[1][i], out[2][i] };
+		}
+	}
+
+	void FitCascade(size_t index)
+	{
+		Cascade& cascade = m_Cascades[index];
+
+		const vector_type* pCorners = &m_LightCorners[4 * index];
+
+		cascade.Near = m_Splits[index];
+		cascade.Far = m_Splits[index + 1];
+
+		// The slice moves rigidly with the camera, so the radius about its centroid is rotation invariant.
+		//	Rounding it up keeps floating point noise from changing the texel size between frames.
+		vector_type center{ T(0), T(0), T(0) };
+
+		for (size_t c = 0; c < 8; ++c)
+			center += pCorners[c];
+
+		center /= T(8);
+
+		T radiusSq = T(0);
+
+		for (size_t c = 0; c < 8; ++c)
+			radiusSq = std::max(radiusSq, (pCorners[c] - center).MagnitudeSq());
+
+		const T radius = std::ceil(std::sqrt(radiusSq) * T(16)) / T(16);
+
+		// Snap the center to whole texels in the plane of the shadow map. The map is padded by a texel on each side
+		//	so that the snapped box still holds the whole sphere.
+		const T texelSize = (T(2) * radius) / T(m_Settings.Resolution - 2);
+		const T halfSize = radius + texelSize;
+
+		center[0] = std::floor(center[0] / texelSize) * texelSize;
+		center[1] = std::floor(center[1] / texelSize) * texelSize;
+
+		cascade.Radius = radius;
+		cascade.TexelSize = texelSize;
+		cascade.Projection = CreateOrthoMatrix(
+			center[0] - halfSize, center[0] + halfSize,
+			center[1] + halfSize, center[1] - halfSize,
+			-center[2] - radius - m_Settings.CasterDistance, -center[2] + radius);
+		cascade.ViewProjection = cascade.Projection * m_LightView;
+
+		if (!m_Settings.FitCullingBounds)
+		{
+			cascade.CullingBounds = box_type{ center - vector_type{ halfSize, halfSize, radius }, center + vector_type{ halfSize, halfSize, radius } };
+			cascade.CullingBounds.Max[2] += m_Settings.CasterDistance;
+			cascade.CullingViewProjection = cascade.ViewProjection;
+			return;
+		}
+
+		// The tight light-space box of the slice, extended toward the light for casters
+		cascade.CullingBounds = box_type::FitOf(pCorners, 8);
+		cascade.CullingBounds.Max[2] += m_Settings.CasterDistance;
+
+		const box_type& bounds = cascade.CullingBounds;
+
+		cascade.CullingViewProjection = CreateOrthoMatrix(bounds.Min[0], bounds.Max[0], bounds.Max[1], bounds.Min[1], -bounds.Max[2], -bounds.Min[2]) * m_LightView;
+	}
+
+};
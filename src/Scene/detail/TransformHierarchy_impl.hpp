@@ -0,0 +1,539 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//            Copyright (c) 2019 Ronnie Brohn (EpicBrownie)      
+//
+//                Distributed under The MIT License (MIT).
+//             (See accompanying file LICENSE or copy at 
+//                 https://opensource.org/licenses/MIT)
+//
+//           Please report any bugs, typos, or suggestions to
+//             https://github.com/unstable-sort/Epic/issues
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "TransformHierarchy_decl.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../../Math/Matrix.h"
+#include "../../Math/Quaternion.h"
+#include "../../Math/Vector.h"
+#include "../../Parallel/ParallelFor.hpp"
+#include "../../Parallel/ParallelRadixSort.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+// TransformHierarchy
+//	Stores local translation/rotation/scale and world matrices in SoA arrays sorted by depth.
+//	Nodes are referenced through stable handles; their storage slots move whenever the layout is re-sorted.
+//	Update() walks the depth levels in order, recomputing only nodes whose local transform changed or
+//	whose parent was recomputed. Each level is processed in parallel, since a node only ever reads from
+//	the level above it.
+template<class T>
+class Epic::TransformHierarchy
+{
+	static_assert(std::is_floating_point_v<T>, "TransformHierarchy requires floating point transforms.");
+
+public:
+	using type = Epic::TransformHierarchy<T>;
+	using value_type = T;
+	using node_type = std::uint32_t;
+	using vector_type = Epic::Vector<T, 3>;
+	using quaternion_type = Epic::Quaternion<T>;
+	using matrix_type = Epic::Matrix<T, 4>;
+
+	static constexpr node_type InvalidNode = ~node_type(0);
+
+private:
+	static constexpr size_t MinGrainSize = 1024;
+
+private:
+	// Handle -> slot
+	std::vector<node_type> m_SlotOf;
+	std::vector<node_type> m_FreeNodes;
+
+	// Slot data
+	std::vector<node_type> m_Nodes;
+	std::vector<node_type> m_Parents;
+	std::vector<node_type> m_ParentSlots;
+	std::vector<node_type> m_Depths;
+	std::vector<vector_type> m_Translations;
+	std::vector<quaternion_type> m_Rotations;
+	std::vector<vector_type> m_Scales;
+	std::vector<matrix_type> m_Worlds;
+	std::vector<std::uint8_t> m_Dirty;
+	std::vector<std::uint8_t> m_Changed;
+
+	std::vector<size_t> m_LevelStart;
+	std::vector<node_type> m_Changes;
+	bool m_IsLayoutDirty;
+
+public:
+	TransformHierarchy() noexcept
+		: m_LevelStart{ 0 }, m_IsLayoutDirty{ false }
+	{ }
+
+	TransformHierarchy(const TransformHierarchy&) = default;
+	TransformHierarchy(TransformHierarchy&&) noexcept = default;
+	~TransformHierarchy() = default;
+
+	TransformHierarchy& operator = (const TransformHierarchy&) = default;
+	TransformHierarchy& operator = (TransformHierarchy&&) noexcept = default;
+
+public:
+	size_t Size() const noexcept { return m_Nodes.size(); }
+	bool Empty() const noexcept { return m_Nodes.empty(); }
+
+	// The number of depth levels as of the last Update()
+	size_t LevelCount() const noexcept { return m_LevelStart.size() - 1; }
+
+	bool IsValid(node_type node) const noexcept
+	{
+		return node < m_SlotOf.size() && m_SlotOf[node] != InvalidNode;
+	}
+
+	void Reserve(size_t count)
+	{
+		m_Nodes.reserve(count);
+		m_Parents.reserve(count);
+		m_ParentSlots.reserve(count);
+		m_Depths.reserve(count);
+		m_Translations.reserve(count);
+		m_Rotations.reserve(count);
+		m_Scales.reserve(count);
+		m_Worlds.reserve(count);
+		m_Dirty.reserve(count);
+		m_Changed.reserve(count);
+	}
+
+	void Clear() noexcept
+	{
+		m_SlotOf.clear();
+		m_FreeNodes.clear();
+		m_Nodes.clear();
+		m_Parents.clear();
+		m_ParentSlots.clear();
+		m_Depths.clear();
+		m_Translations.clear();
+		m_Rotations.clear();
+		m_Scales.clear();
+		m_Worlds.clear();
+		m_Dirty.clear();
+		m_Changed.clear();
+		m_Changes.clear();
+
+		m_LevelStart.assign(1, 0);
+		m_IsLayoutDirty = false;
+	}
+
+public:
+	// Creates a node with an identity local transform
+	node_type Create(node_type parent = InvalidNode)
+	{
+		return Create(parent, vector_type{ Zero }, quaternion_type{ Identity }, vector_type{ One });
+	}
+
+	node_type Create(node_type parent, vector_type translation, quaternion_type rotation, vector_type scale)
+	{
+		assert(parent == InvalidNode || IsValid(parent));
+
+		node_type node;
+
+		if (!m_FreeNodes.empty())
+		{
+			node = m_FreeNodes.back();
+			m_FreeNodes.pop_back();
+		}
+		else
+		{
+			node = static_cast<node_type>(m_SlotOf.size());
+			m_SlotOf.push_back(InvalidNode);
+		}
+
+		const auto slot = static_cast<node_type>(m_Nodes.size());
+		const node_type parentSlot = (parent == InvalidNode) ? InvalidNode : m_SlotOf[parent];
+		const node_type depth = (parent == InvalidNode) ? 0 : m_Depths[parentSlot] + 1;
+
+		// Appending keeps the layout sorted as long as the node is no shallower than the last one
+		if (!m_IsLayoutDirty && (slot == 0 || depth >= m_Depths.back()))
+		{
+			if (depth == LevelCount())
+				m_LevelStart.push_back(slot + 1);
+			else
+				m_LevelStart.back() = slot + 1;
+		}
+		else
+		{
+			m_IsLayoutDirty = true;
+		}
+
+		m_SlotOf[node] = slot;
+
+		m_Nodes.push_back(node);
+		m_Parents.push_back(parent);
+		m_ParentSlots.push_back(parentSlot);
+		m_Depths.push_back(depth);
+		m_Translations.push_back(std::move(translation));
+		m_Rotations.push_back(std::move(rotation));
+		m_Scales.push_back(std::move(scale));
+		m_Worlds.emplace_back(Identity);
+		m_Dirty.push_back(1);
+		m_Changed.push_back(0);
+
+		return node;
+	}
+
+	// Destroys a node and all of its descendants. Their handles may be reused by later calls to Create().
+	void Destroy(node_type node)
+	{
+		assert(IsValid(node));
+
+		if (m_IsLayoutDirty)
+			SortLayout();
+
+		// Descendants always follow their parent in the sorted layout
+		const size_t count = Size();
+		const size_t first = m_SlotOf[node];
+
+		std::vector<std::uint8_t> removed(count, 0);
+		removed[first] = 1;
+
+		for (size_t s = first + 1; s < count; ++s)
+		{
+			const node_type parentSlot = m_ParentSlots[s];
+			removed[s] = (parentSlot != InvalidNode) && removed[parentSlot];
+		}
+
+		size_t dest = first;
+
+		for (size_t s = first; s < count; ++s)
+		{
+			if (removed[s])
+			{
+				m_SlotOf[m_Nodes[s]] = InvalidNode;
+				m_FreeNodes.push_back(m_Nodes[s]);
+				continue;
+			}
+
+			m_Nodes[dest] = m_Nodes[s];
+			m_Parents[dest] = m_Parents[s];
+			m_Depths[dest] = m_Depths[s];
+			m_Translations[dest] = m_Translations[s];
+			m_Rotations[dest] = m_Rotations[s];
+			m_Scales[dest] = m_Scales[s];
+			m_Worlds[dest] = m_Worlds[s];
+			m_Dirty[dest] = m_Dirty[s];
+			m_Changed[dest] = m_Changed[s];
+
+			m_SlotOf[m_Nodes[dest]] = static_cast<node_type>(dest);
+
+			++dest;
+		}
+
+		Resize(dest);
+		RebuildLevels();
+	}
+
+	// Re-parents a node, keeping its local transform. Pass InvalidNode to make it a root.
+	void SetParent(node_type node, node_type parent)
+	{
+		assert(IsValid(node));
+		assert(parent == InvalidNode || IsValid(parent));
+
+		// A node cannot become a descendant of itself
+		for (node_type ancestor = parent; ancestor != InvalidNode; ancestor = m_Parents[m_SlotOf[ancestor]])
+			assert(ancestor != node);
+
+		const node_type slot = m_SlotOf[node];
+
+		m_Parents[slot] = parent;
+		m_Dirty[slot] = 1;
+		m_IsLayoutDirty = true;
+	}
+
+	node_type Parent(node_type node) const noexcept
+	{
+		assert(IsValid(node));
+		return m_Parents[m_SlotOf[node]];
+	}
+
+public:
+	const vector_type& Translation(node_type node) const noexcept { return m_Translations[SlotOf(node)]; }
+	const quaternion_type& Rotation(node_type node) const noexcept { return m_Rotations[SlotOf(node)]; }
+	const vector_type& Scale(node_type node) const noexcept { return m_Scales[SlotOf(node)]; }
+
+	// The world matrix as of the last Update()
+	const matrix_type& World(node_type node) const noexcept { return m_Worlds[SlotOf(node)]; }
+
+	matrix_type Local(node_type node) const noexcept
+	{
+		const node_type slot = SlotOf(node);
+
+		matrix_type result;
+		ComposeTRS(nullptr, m_Translations[slot], m_Rotations[slot], m_Scales[slot], result);
+
+		return result;
+	}
+
+	void SetTranslation(node_type node, vector_type translation) noexcept
+	{
+		const node_type slot = SlotOf(node);
+
+		m_Translations[slot] = std::move(translation);
+		m_Dirty[slot] = 1;
+	}
+
+	void SetRotation(node_type node, quaternion_type rotation) noexcept
+	{
+		const node_type slot = SlotOf(node);
+
+		m_Rotations[slot] = rotation;
+		m_Dirty[slot] = 1;
+	}
+
+	void SetScale(node_type node, vector_type scale) noexcept
+	{
+		const node_type slot = SlotOf(node);
+
+		m_Scales[slot] = std::move(scale);
+		m_Dirty[slot] = 1;
+	}
+
+	void SetLocal(node_type node, vector_type translation, quaternion_type rotation, vector_type scale) noexcept
+	{
+		const node_type slot = SlotOf(node);
+
+		m_Translations[slot] = std::move(translation);
+		m_Rotations[slot] = rotation;
+		m_Scales[slot] = std::move(scale);
+		m_Dirty[slot] = 1;
+	}
+
+public:
+	// Recomputes the world matrix of every dirty node and its descendants, then rebuilds the change list.
+	void Update()
+	{
+		if (m_IsLayoutDirty)
+			SortLayout();
+
+		for (size_t level = 0; level < LevelCount(); ++level)
+		{
+			const size_t begin = m_LevelStart[level];
+			const size_t end = m_LevelStart[level + 1];
+
+			ParallelFor(begin, end, ParallelGrainSize(end - begin, MinGrainSize), [&](size_t first, size_t last)
+			{
+				UpdateRange(first, last);
+			});
+		}
+
+		m_Changes.clear();
+
+		for (size_t s = 0; s < Size(); ++s)
+			if (m_Changed[s])
+				m_Changes.push_back(m_Nodes[s]);
+	}
+
+	// The nodes whose world matrix was recomputed by the last Update(), parents before children
+	const std::vector<node_type>& Changes() const noexcept { return m_Changes; }
+
+	// Invokes fn(node, world) for every node whose world matrix was recomputed by the last Update()
+	template<class Function>
+	void ForEachChange(Function fn) const
+	{
+		for (const node_type node : m_Changes)
+			fn(node, m_Worlds[m_SlotOf[node]]);
+	}
+
+private:
+	node_type SlotOf(node_type node) const noexcept
+	{
+		assert(IsValid(node));
+		return m_SlotOf[node];
+	}
+
+	void UpdateRange(size_t begin, size_t end) noexcept
+	{
+		for (size_t s = begin; s < end; ++s)
+		{
+			const node_type parentSlot = m_ParentSlots[s];
+			const bool isRoot = parentSlot == InvalidNode;
+			const bool isChanged = m_Dirty[s] || (!isRoot && m_Changed[parentSlot]);
+
+			m_Changed[s] = isChanged;
+			m_Dirty[s] = 0;
+
+			if (!isChanged)
+				continue;
+
+			ComposeTRS(isRoot ? nullptr : &m_Worlds[parentSlot], m_Translations[s], m_Rotations[s], m_Scales[s], m_Worlds[s]);
+		}
+	}
+
+	// Writes parent * TRS into result, treating both as affine transforms.
+	static void ComposeTRS(const matrix_type* pParent, const vector_type& t, const quaternion_type& q, const vector_type& s, matrix_type& result) noexcept
+	{
+		const T xx = q.x * q.x;
+		const T yy = q.y * q.y;
+		const T zz = q.z * q.z;
+		const T xy = q.x * q.y;
+		const T xz = q.x * q.z;
+		const T yz = q.y * q.z;
+		const T wx = q.w * q.x;
+		const T wy = q.w * q.y;
+		const T wz = q.w * q.z;
+
+		// The local transform as four columns of three rows
+		const T local[12] =
+		{
+			(T(1) - T(2) * (yy + zz)) * s.x, T(2) * (xy + wz) * s.x, T(2) * (xz - wy) * s.x,
+			T(2) * (xy - wz) * s.y, (T(1) - T(2) * (xx + zz)) * s.y, T(2) * (yz + wx) * s.y,
+			T(2) * (xz + wy) * s.z, T(2) * (yz - wx) * s.z, (T(1) - T(2) * (xx + yy)) * s.z,
+			t.x, t.y, t.z
+		};
+
+		auto& values = result.Values;
+
+		if (!pParent)
+		{
+			for (size_t c = 0; c < 4; ++c)
+			{
+				values[c * 4 + 0] = local[c * 3 + 0];
+				values[c * 4 + 1] = local[c * 3 + 1];
+				values[c * 4 + 2] = local[c * 3 + 2];
+				values[c * 4 + 3] = T(0);
+			}
+		}
+		else
+		{
+			const auto& parent = pParent->Values;
+
+			for (size_t c = 0; c < 4; ++c)
+			{
+				for (size_t r = 0; r < 3; ++r)
+				{
+					values[c * 4 + r] =
+						parent[0 * 4 + r] * local[c * 3 + 0] +
+						parent[1 * 4 + r] * local[c * 3 + 1] +
+						parent[2 * 4 + r] * local[c * 3 + 2];
+				}
+
+				values[c * 4 + 3] = T(0);
+			}
+
+			values[12] += parent[12];
+			values[13] += parent[13];
+			values[14] += parent[14];
+		}
+
+		values[15] = T(1);
+	}
+
+	void Resize(size_t count)
+	{
+		m_Nodes.resize(count);
+		m_Parents.resize(count);
+		m_ParentSlots.resize(count);
+		m_Depths.resize(count);
+		m_Translations.resize(count);
+		m_Rotations.resize(count);
+		m_Scales.resize(count);
+		m_Worlds.resize(count);
+		m_Dirty.resize(count);
+		m_Changed.resize(count);
+	}
+
+	// Recomputes the parent slots and level offsets of an already sorted layout
+	void RebuildLevels()
+	{
+		const size_t count = Size();
+
+		m_LevelStart.clear();
+
+		for (size_t s = 0; s < count; ++s)
+		{
+			const node_type parent = m_Parents[s];
+			m_ParentSlots[s] = (parent == InvalidNode) ? InvalidNode : m_SlotOf[parent];
+
+			while (m_LevelStart.size() <= m_Depths[s])
+				m_LevelStart.push_back(s);
+		}
+
+		m_LevelStart.push_back(count);
+	}
+
+	// Recomputes the depth of every node and stably counting-sorts the slots by depth
+	void SortLayout()
+	{
+		const size_t count = Size();
+
+		// Resolve depths by walking up to the nearest node whose depth is already known
+		constexpr node_type Unresolved = InvalidNode;
+
+		std::vector<node_type> stack;
+		std::fill(std::begin(m_Depths), std::end(m_Depths), Unresolved);
+
+		node_type maxDepth = 0;
+
+		for (size_t s = 0; s < count; ++s)
+		{
+			node_type slot = static_cast<node_type>(s);
+
+			while (m_Depths[slot] == Unresolved && m_Parents[slot] != InvalidNode)
+			{
+				stack.push_back(slot);
+				slot = m_SlotOf[m_Parents[slot]];
+			}
+
+			if (m_Depths[slot] == Unresolved)
+				m_Depths[slot] = 0;
+
+			node_type depth = m_Depths[slot];
+
+			while (!stack.empty())
+			{
+				m_Depths[stack.back()] = ++depth;
+				stack.pop_back();
+			}
+
+			maxDepth = std::max(maxDepth, m_Depths[s]);
+		}
+
+		// Counting sort by depth
+		std::vector<size_t> offsets(size_t(maxDepth) + 2, 0);
+
+		for (size_t s = 0; s < count; ++s)
+			++offsets[size_t(m_Depths[s]) + 1];
+
+		for (size_t d = 1; d < offsets.size(); ++d)
+			offsets[d] += offsets[d - 1];
+
+		std::vector<node_type> order(count);
+
+		for (size_t s = 0; s < count; ++s)
+			order[offsets[m_Depths[s]]++] = static_cast<node_type>(s);
+
+		ParallelGather(order.data(), m_Nodes);
+		ParallelGather(order.data(), m_Parents);
+		ParallelGather(order.data(), m_Depths);
+		ParallelGather(order.data(), m_Translations);
+		ParallelGather(order.data(), m_Rotations);
+		ParallelGather(order.data(), m_Scales);
+		ParallelGather(order.data(), m_Worlds);
+		ParallelGather(order.data(), m_Dirty);
+		ParallelGather(order.data(), m_Changed);
+
+		for (size_t s = 0; s < count; ++s)
+			m_SlotOf[m_Nodes[s]] = static_cast<node_type>(s);
+
+		RebuildLevels();
+
+		m_IsLayoutDirty = false;
+	}
+};